@@ -244,6 +244,13 @@
 #define HAL_CRY_ENFORCE_FALLBACK            FALSE
 #endif
 
+/**
+ * @brief   Enables the asynchronous jobs API.
+ */
+#if !defined(HAL_CRY_USE_ASYNC) || defined(__DOXYGEN__)
+#define HAL_CRY_USE_ASYNC                   FALSE
+#endif
+
 /*===========================================================================*/
 /* I2C driver related settings.                                              */
 /*===========================================================================*/
@@ -190,7 +190,7 @@ osStatus osThreadSetPriority(osThreadId thread_id, osPriority newprio) {
     tp->state = CH_STATE_CURRENT;
 #endif
     /* Re-enqueues tp with its new priority on the ready list.*/
-    chSchReadyI(queue_dequeue(tp));
+    chSchReadyI(ready_dequeue(tp));
     break;
   }
 
@@ -2030,7 +2030,7 @@ int32 OS_TaskSetPriority(uint32 task_id, uint32 new_priority) {
     tp->state = CH_STATE_CURRENT;
 #endif
     /* Re-enqueues tp with its new priority on the ready list.*/
-    chSchReadyI(queue_dequeue(tp));
+    chSchReadyI(ready_dequeue(tp));
     break;
   }
 
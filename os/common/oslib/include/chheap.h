@@ -42,7 +42,9 @@
  * @brief   Minimum alignment used for heap.
  * @note    Cannot use the sizeof operator in this macro.
  */
-#if (SIZEOF_PTR == 4) || defined(__DOXYGEN__)
+#if (SIZEOF_PTR == 8)
+#define CH_HEAP_ALIGNMENT   16U
+#elif (SIZEOF_PTR == 4) || defined(__DOXYGEN__)
 #define CH_HEAP_ALIGNMENT   8U
 #elif (SIZEOF_PTR == 2)
 #define CH_HEAP_ALIGNMENT   4U
@@ -50,10 +52,95 @@
 #error "unsupported pointer size"
 #endif
 
+/**
+ * @brief   Log2 of @p CH_HEAP_ALIGNMENT.
+ */
+#if (SIZEOF_PTR == 8)
+#define CH_HEAP_ALIGNMENT_SHIFT             4U
+#elif (SIZEOF_PTR == 4) || defined(__DOXYGEN__)
+#define CH_HEAP_ALIGNMENT_SHIFT             3U
+#else
+#define CH_HEAP_ALIGNMENT_SHIFT             2U
+#endif
+
+/**
+ * @brief   Number of bins in the allocations size histogram.
+ */
+#define CH_HEAP_PROFILING_BINS              8U
+
 /*===========================================================================*/
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   TLSF heap allocator.
+ * @details If enabled the heaps use a two-level segregated fit allocator
+ *          with O(1) allocation and release instead of the first-fit
+ *          free list.
+ * @note    The block header has the same size in both the allocators,
+ *          the TLSF heap descriptor also contains the free lists table.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
+/**
+ * @brief   TLSF second level subdivisions as a power of two.
+ * @details Each power of two size range is divided in 2^N free lists,
+ *          the allocation waste is bounded to 1/2^N of the block size.
+ */
+#if !defined(CH_CFG_HEAP_TLSF_SL_LOG2) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_TLSF_SL_LOG2            4
+#endif
+
+/**
+ * @brief   TLSF maximum block size as a power of two.
+ * @details Free blocks are kept smaller than 2^N bytes, bigger
+ *          allocation requests fail.
+ */
+#if !defined(CH_CFG_HEAP_TLSF_FL_LOG2) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_TLSF_FL_LOG2            20
+#endif
+
+/**
+ * @brief   Default heap size classes cache.
+ * @details If enabled the small blocks allocated from the default heap
+ *          are served by per size class memory pools. The pools are fed
+ *          by the heap on demand and released blocks are kept in the
+ *          pools for reuse.
+ * @note    Memory cached in the pools is not returned to the heap.
+ */
+#if !defined(CH_CFG_USE_HEAP_CACHE) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_CACHE               FALSE
+#endif
+
+/**
+ * @brief   Number of size classes in the default heap cache.
+ */
+#if !defined(CH_CFG_HEAP_CACHE_CLASSES) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_CACHE_CLASSES           4
+#endif
+
+/**
+ * @brief   Size of the smallest class in the default heap cache.
+ * @details Each class is twice the size of the previous one.
+ */
+#if !defined(CH_CFG_HEAP_CACHE_MIN_SIZE) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_CACHE_MIN_SIZE          16
+#endif
+
+/**
+ * @brief   Number of threads tracked by the heap profiling.
+ * @details Each heap records the allocations of up to N-1 threads, the
+ *          last entry is shared by all the threads not fitting the table.
+ *          The entry of a thread is released when the thread exits and
+ *          its counters are moved in the shared entry.
+ * @note    Requires @p CH_CFG_USE_MEM_PROFILING.
+ */
+#if !defined(CH_CFG_HEAP_PROFILING_THREADS) || defined(__DOXYGEN__)
+#define CH_CFG_HEAP_PROFILING_THREADS       8
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -66,6 +153,62 @@
 #error "CH_CFG_USE_HEAP requires CH_CFG_USE_MUTEXES and/or CH_CFG_USE_SEMAPHORES"
 #endif
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Number of TLSF second level free lists.
+ */
+#define CH_HEAP_TLSF_SL_COUNT   (1U << CH_CFG_HEAP_TLSF_SL_LOG2)
+
+/**
+ * @brief   Log2 of the size of the first TLSF first level range.
+ * @details Blocks below this size are kept in linearly spaced lists.
+ */
+#define CH_HEAP_TLSF_FL_SHIFT   (CH_CFG_HEAP_TLSF_SL_LOG2 +                 \
+                                 CH_HEAP_ALIGNMENT_SHIFT)
+
+/**
+ * @brief   Number of TLSF first level ranges.
+ */
+#define CH_HEAP_TLSF_FL_COUNT   ((CH_CFG_HEAP_TLSF_FL_LOG2 -                \
+                                  CH_HEAP_TLSF_FL_SHIFT) + 1U)
+
+#if (CH_CFG_HEAP_TLSF_SL_LOG2 < 1) || (CH_CFG_HEAP_TLSF_SL_LOG2 > 5)
+#error "invalid CH_CFG_HEAP_TLSF_SL_LOG2 value"
+#endif
+
+#if (CH_CFG_HEAP_TLSF_FL_LOG2 <= CH_HEAP_TLSF_FL_SHIFT) ||                  \
+    (CH_CFG_HEAP_TLSF_FL_LOG2 > 31) ||                                      \
+    (CH_CFG_HEAP_TLSF_FL_LOG2 > ((SIZEOF_PTR * 8) - 3))
+#error "invalid CH_CFG_HEAP_TLSF_FL_LOG2 value"
+#endif
+
+/**
+ * @brief   Block state flags in the upper bits of the TLSF size field.
+ */
+#define CH_HEAP_TLSF_FLAGS_MASK (~(~(size_t)0 >> 3))
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
+#if CH_CFG_USE_HEAP_CACHE == TRUE
+#if CH_CFG_USE_MEMPOOLS == FALSE
+#error "CH_CFG_USE_HEAP_CACHE requires CH_CFG_USE_MEMPOOLS"
+#endif
+
+#if (CH_CFG_HEAP_CACHE_CLASSES < 1) || (CH_CFG_HEAP_CACHE_CLASSES > 8)
+#error "invalid CH_CFG_HEAP_CACHE_CLASSES value"
+#endif
+
+#if (CH_CFG_HEAP_CACHE_MIN_SIZE < CH_HEAP_ALIGNMENT) ||                     \
+    ((CH_CFG_HEAP_CACHE_MIN_SIZE % CH_HEAP_ALIGNMENT) != 0)
+#error "invalid CH_CFG_HEAP_CACHE_MIN_SIZE value"
+#endif
+#endif /* CH_CFG_USE_HEAP_CACHE == TRUE */
+
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+#if CH_CFG_HEAP_PROFILING_THREADS < 1
+#error "invalid CH_CFG_HEAP_PROFILING_THREADS value"
+#endif
+#endif /* CH_CFG_USE_MEM_PROFILING == TRUE */
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -80,6 +223,26 @@ typedef struct memory_heap memory_heap_t;
  */
 typedef union heap_header heap_header_t;
 
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Memory heap block header.
+ * @note    Free blocks keep the previous free list link in the first word
+ *          of their area and a pointer to their header in the last word,
+ *          the block state flags are in the upper bits of the size.
+ */
+union heap_header {
+  struct {
+    heap_header_t       *next;      /**< @brief Next block in free list.    */
+    size_t              bsize;      /**< @brief Size of the area in bytes
+                                                and state flags.            */
+  } free;
+  struct {
+    memory_heap_t       *heap;      /**< @brief Block owner heap.           */
+    size_t              size;       /**< @brief Size of the area in bytes
+                                                and state flags.            */
+  } used;
+};
+#else
 /**
  * @brief   Memory heap block header.
  */
@@ -93,6 +256,43 @@ union heap_header {
     size_t              size;       /**< @brief Size of the area in bytes.  */
   } used;
 };
+#endif
+
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of the heap statistics of a thread.
+ * @note    Allocations are charged to the allocating thread and releases
+ *          to the releasing thread, a thread releasing blocks allocated by
+ *          other threads has more bytes released than allocated.
+ */
+typedef struct {
+  thread_t              *thread;    /**< @brief Tracked thread or @p NULL
+                                                for free and shared
+                                                entries.                    */
+  uint32_t              allocs;     /**< @brief Successful allocations.     */
+  uint32_t              frees;      /**< @brief Released blocks.            */
+  size_t                alloc_bytes;/**< @brief Allocated bytes.            */
+  size_t                free_bytes; /**< @brief Released bytes.             */
+} heap_thread_stats_t;
+
+/**
+ * @brief   Type of the heap statistics.
+ * @note    Sizes are the requested ones, the alignment and the block
+ *          headers overhead is not accounted.
+ */
+typedef struct {
+  uint32_t              allocs;     /**< @brief Successful allocations.     */
+  uint32_t              frees;      /**< @brief Released blocks.            */
+  uint32_t              failures;   /**< @brief Failed allocations.         */
+  size_t                used;       /**< @brief Allocated bytes.            */
+  size_t                used_max;   /**< @brief Allocated bytes high-water
+                                                mark.                       */
+  uint32_t              hist[CH_HEAP_PROFILING_BINS];
+                                    /**< @brief Allocations by size bin.    */
+  heap_thread_stats_t   threads[CH_CFG_HEAP_PROFILING_THREADS];
+                                    /**< @brief Per-thread statistics.      */
+} heap_stats_t;
+#endif
 
 /**
  * @brief   Structure describing a memory heap.
@@ -100,12 +300,28 @@ union heap_header {
 struct memory_heap {
   memgetfunc2_t         provider;   /**< @brief Memory blocks provider for
                                                 this heap.                  */
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+  uint32_t              flmap;      /**< @brief Non-empty first level
+                                                ranges bitmap.              */
+  uint32_t              slmap[CH_HEAP_TLSF_FL_COUNT];
+                                    /**< @brief Non-empty free lists
+                                                bitmaps.                    */
+  heap_header_t         *lists[CH_HEAP_TLSF_FL_COUNT][CH_HEAP_TLSF_SL_COUNT];
+                                    /**< @brief Free lists heads.           */
+  heap_header_t         *sentinel;  /**< @brief End sentinel of the last
+                                                added area.                 */
+#else
   heap_header_t         header;     /**< @brief Free blocks list header.    */
+#endif
 #if CH_CFG_USE_MUTEXES == TRUE
   mutex_t               mtx;        /**< @brief Heap access mutex.          */
 #else
   semaphore_t           sem;        /**< @brief Heap access semaphore.      */
 #endif
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+  heap_stats_t          stats;      /**< @brief Heap statistics.            */
+  memory_heap_t         *next;      /**< @brief Next profiled heap.         */
+#endif
 };
 
 /*===========================================================================*/
@@ -119,6 +335,25 @@ struct memory_heap {
   ALIGNED_VAR(CH_HEAP_ALIGNMENT)                                            \
   uint8_t name[MEM_ALIGN_NEXT((size), CH_HEAP_ALIGNMENT)]
 
+/**
+ * @brief   Size of a class of the default heap cache.
+ *
+ * @param[in] n         the class index
+ */
+#define CH_HEAP_CACHE_CLASS_SIZE(n)                                         \
+  ((size_t)CH_CFG_HEAP_CACHE_MIN_SIZE << (n))
+
+/**
+ * @brief   Upper size limit of a bin of the allocations size histogram.
+ * @details Bin @p n counts the allocations bigger than the limit of bin
+ *          @p n-1 and not bigger than its own limit, the last bin counts
+ *          all the remaining allocations.
+ *
+ * @param[in] n         the bin index
+ */
+#define CH_HEAP_PROFILING_BIN_SIZE(n)                                       \
+  ((size_t)16U << (n))
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -131,6 +366,16 @@ extern "C" {
   void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align);
   void chHeapFree(void *p);
   size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp);
+#if CH_CFG_USE_HEAP_CACHE == TRUE
+  void *chHeapCacheAllocI(size_t size);
+  void chHeapCacheFreeI(void *p);
+  size_t chHeapCacheStatus(unsigned n, uint32_t *hitsp, uint32_t *missesp);
+#endif
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  void _heap_prof_thread_exit(thread_t *tp);
+  void chHeapGetStats(memory_heap_t *heapp, heap_stats_t *hsp);
+  void chHeapResetStats(memory_heap_t *heapp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -140,8 +385,7 @@ extern "C" {
 /*===========================================================================*/
 
 /**
- * @brief   Allocates a block of memory from the heap by using the first-fit
- *          algorithm.
+ * @brief   Allocates a block of memory from the heap.
  * @details The allocated block is guaranteed to be properly aligned for a
  *          pointer data type.
  *
@@ -172,7 +416,11 @@ static inline void *chHeapAlloc(memory_heap_t *heapp, size_t size) {
  */
 static inline size_t chHeapGetSize(const void *p) {
 
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  return ((heap_header_t *)p - 1U)->used.size & ~CH_HEAP_TLSF_FLAGS_MASK;
+#else
   return ((heap_header_t *)p - 1U)->used.size;
+#endif
 }
 
 #endif /* CH_CFG_USE_HEAP == TRUE */
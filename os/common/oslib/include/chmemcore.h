@@ -57,6 +57,18 @@
 #define CH_CFG_MEMCORE_SIZE                 0
 #endif
 
+/**
+ * @brief   Memory allocators profiling.
+ * @details If enabled the core allocator and the heaps record allocation
+ *          counters, high-water marks and size histograms. The counters
+ *          can be read at runtime for diagnosing the memory pressure.
+ * @note    The heap allocation and release functions enter an additional
+ *          critical zone in order to update the counters.
+ */
+#if !defined(CH_CFG_USE_MEM_PROFILING) || defined(__DOXYGEN__)
+#define CH_CFG_USE_MEM_PROFILING            FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -91,8 +103,37 @@ typedef struct {
    * @brief   Final address.
    */
   uint8_t *endmem;
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Initial address.
+   */
+  uint8_t *basemem;
+  /**
+   * @brief   Number of successful allocations.
+   */
+  uint32_t allocs;
+  /**
+   * @brief   Number of failed allocations.
+   */
+  uint32_t failures;
+#endif
 } memcore_t;
 
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a memory core statistics snapshot.
+ */
+typedef struct {
+  size_t                size;       /**< @brief Managed memory size.        */
+  size_t                used;       /**< @brief Allocated memory size, the
+                                                core memory is never
+                                                released so this is also
+                                                its high-water mark.        */
+  uint32_t              allocs;     /**< @brief Successful allocations.     */
+  uint32_t              failures;   /**< @brief Failed allocations.         */
+} memcore_stats_t;
+#endif
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -116,6 +157,9 @@ extern "C" {
                                      unsigned align,
                                      size_t offset);
   size_t chCoreGetStatusX(void);
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  void chCoreGetStats(memcore_stats_t *csp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,14 @@
  *          library functions. The main difference is that the OS heap APIs
  *          are guaranteed to be thread safe and there is the ability to
  *          return memory blocks aligned to arbitrary powers of two.<br>
+ *          If @p CH_CFG_USE_HEAP_TLSF is enabled then a two-level
+ *          segregated fit allocator is used instead. Free blocks are kept
+ *          in lists indexed by size class, allocation and release take a
+ *          constant time regardless of the heap fragmentation.<br>
+ *          If @p CH_CFG_USE_HEAP_CACHE is enabled then the small blocks of
+ *          the default heap are served by per size class memory pools,
+ *          the pools are accessed within critical zones instead of taking
+ *          the heap mutex and can also be used from ISRs.<br>
  * @pre     In order to use the heap APIs the @p CH_CFG_USE_HEAP option must
  *          be enabled in @p chconf.h.
  * @note    Compatible with RT and NIL.
@@ -56,44 +64,903 @@
 
 #define H_BLOCK(hp)     ((hp) + 1U)
 
-#define H_LIMIT(hp)     (H_BLOCK(hp) + H_PAGES(hp))
-
 #define H_NEXT(hp)      ((hp)->free.next)
 
+#define H_HEAP(hp)      ((hp)->used.heap)
+
+#define H_SIZE(hp)      ((hp)->used.size)
+
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/*
+ * Block state flags, stored in the upper bits of the size field. The
+ * slack flag marks an used block one allocation unit larger than its
+ * aligned size because the excess space could not be split.
+ */
+#define H_FREE_FLAG     ((size_t)1 << ((sizeof (size_t) * 8U) - 1U))
+
+#define H_PREV_FREE_FLAG ((size_t)1 << ((sizeof (size_t) * 8U) - 2U))
+
+#define H_SLACK_FLAG    ((size_t)1 << ((sizeof (size_t) * 8U) - 3U))
+
+#define H_BSIZE(hp)     ((hp)->free.bsize & ~CH_HEAP_TLSF_FLAGS_MASK)
+
+#define H_IS_FREE(hp)   (((hp)->free.bsize & H_FREE_FLAG) != 0U)
+
+#define H_IS_PREV_FREE(hp) (((hp)->free.bsize & H_PREV_FREE_FLAG) != 0U)
+
+/*
+ * Size of an used block, derived from the requested size.
+ */
+#define H_USED_BSIZE(hp)                                                    \
+  (MEM_ALIGN_NEXT(H_SIZE(hp) & ~CH_HEAP_TLSF_FLAGS_MASK,                    \
+                  CH_HEAP_ALIGNMENT) +                                      \
+   (((H_SIZE(hp) & H_SLACK_FLAG) != 0U) ? CH_HEAP_ALIGNMENT : 0U))
+
+/*
+ * Previous block in the free list, stored in the first word of the free
+ * block area.
+ */
+#define H_PREVF(hp)     (*(heap_header_t **)(void *)H_BLOCK(hp))
+
+/*
+ * Previous physical block, free blocks store a pointer to their header in
+ * the last word of their area so it is only valid if the previous block
+ * is free.
+ */
+#define H_PREV(hp)      (((heap_header_t **)(void *)(hp))[-1])
+
+/*
+ * Next physical block, the last block of an area is followed by an
+ * used sentinel block of zero size.
+ */
+#define H_PHYS_NEXT(hp)                                                     \
+  ((heap_header_t *)(void *)((uint8_t *)H_BLOCK(hp) + H_BSIZE(hp)))
+
+#define H_HDR_SIZE      sizeof (heap_header_t)
+
+#define H_MIN_BSIZE     ((size_t)CH_HEAP_ALIGNMENT)
+
+#define H_MAX_BSIZE     ((size_t)1 << CH_CFG_HEAP_TLSF_FL_LOG2)
+
+/*
+ * Blocks smaller than this size are in the first level range zero.
+ */
+#define H_SMALL_BSIZE   ((size_t)1 << CH_HEAP_TLSF_FL_SHIFT)
+
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
+#define H_LIMIT(hp)     (H_BLOCK(hp) + H_PAGES(hp))
+
 #define H_PAGES(hp)     ((hp)->free.pages)
 
-#define H_HEAP(hp)      ((hp)->used.heap)
+/*
+ * Number of pages between two pointers in a MISRA-compatible way.
+ */
+#define NPAGES(p1, p2)                                                      \
+  /*lint -save -e9033 [10.8] The cast is safe.*/                            \
+  ((size_t)((p1) - (p2)))                                                   \
+  /*lint -restore*/
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
+
+#if (CH_CFG_USE_HEAP_CACHE == TRUE) || defined(__DOXYGEN__)
+/*
+ * Blocks served by the cache have no owner heap.
+ */
+#define H_IS_CACHED(hp) (H_HEAP(hp) == NULL)
+
+#define H_CACHE_MAX_SIZE                                                    \
+  CH_HEAP_CACHE_CLASS_SIZE(CH_CFG_HEAP_CACHE_CLASSES - 1)
+#endif
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_HEAP_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a class of the default heap cache.
+ */
+typedef struct {
+  memory_pool_t         pool;       /**< @brief Free blocks of the class.   */
+  uint32_t              hits;       /**< @brief Allocations served by the
+                                                pool.                       */
+  uint32_t              misses;     /**< @brief Allocations not served by
+                                                the pool.                   */
+} heap_cache_t;
+#endif
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Default heap descriptor.
+ */
+static memory_heap_t default_heap;
+
+#if (CH_CFG_USE_HEAP_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Default heap size classes cache.
+ */
+static heap_cache_t default_cache[CH_CFG_HEAP_CACHE_CLASSES];
+#endif
+
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   List of the profiled heaps.
+ */
+static memory_heap_t *profiled_heaps;
+#endif
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+#if (CH_CFG_USE_HEAP_TLSF == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the index of the least significant bit set in a word.
+ *
+ * @param[in] w         the word, it must be different from zero
+ * @return              The bit index.
+ */
+static unsigned heap_lsb(uint32_t w) {
+
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctz(w);
+#else
+  static const uint8_t debruijn[32] = {
+    0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,
+    8U,  31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,
+    10U, 9U
+  };
+
+  return (unsigned)debruijn[((w & (0U - w)) * 0x077CB531U) >> 27];
+#endif
+}
+
+/**
+ * @brief   Returns the index of the most significant bit set in a word.
+ *
+ * @param[in] w         the word, it must be different from zero
+ * @return              The bit index.
+ */
+static unsigned heap_msb(uint32_t w) {
+
+#if defined(__GNUC__)
+  return (unsigned)((sizeof (unsigned long) * 8U) - 1U) -
+         (unsigned)__builtin_clzl((unsigned long)w);
+#else
+  unsigned n = 0U;
+
+  if (w >= 0x10000U) {
+    w >>= 16;
+    n += 16U;
+  }
+  if (w >= 0x100U) {
+    w >>= 8;
+    n += 8U;
+  }
+  if (w >= 0x10U) {
+    w >>= 4;
+    n += 4U;
+  }
+  if (w >= 0x4U) {
+    w >>= 2;
+    n += 2U;
+  }
+  if (w >= 0x2U) {
+    n += 1U;
+  }
+
+  return n;
+#endif
+}
+
+/**
+ * @brief   Finds the free list of a block size.
+ *
+ * @param[in] bsize     the block size, it must be lower than
+ *                      @p H_MAX_BSIZE
+ * @param[out] flp      first level index
+ * @param[out] slp      second level index
+ */
+static void heap_mapping(size_t bsize, unsigned *flp, unsigned *slp) {
+
+  if (bsize < H_SMALL_BSIZE) {
+    /* Small blocks are in linearly spaced lists.*/
+    *flp = 0U;
+    *slp = (unsigned)(bsize >> CH_HEAP_ALIGNMENT_SHIFT);
+  }
+  else {
+    unsigned msb = heap_msb((uint32_t)bsize);
+
+    *flp = (msb - CH_HEAP_TLSF_FL_SHIFT) + 1U;
+    *slp = (unsigned)(bsize >> (msb - CH_CFG_HEAP_TLSF_SL_LOG2)) -
+           CH_HEAP_TLSF_SL_COUNT;
+  }
+}
+
+/**
+ * @brief   Inserts a block in its free list.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block
+ */
+static void heap_insert(memory_heap_t *heapp, heap_header_t *hp) {
+  heap_header_t *np = H_PHYS_NEXT(hp);
+  unsigned fl, sl;
+
+  heap_mapping(H_BSIZE(hp), &fl, &sl);
+
+  H_NEXT(hp) = heapp->lists[fl][sl];
+  H_PREVF(hp) = NULL;
+  if (H_NEXT(hp) != NULL) {
+    H_PREVF(H_NEXT(hp)) = hp;
+  }
+  heapp->lists[fl][sl] = hp;
+  heapp->slmap[fl] |= (uint32_t)1U << sl;
+  heapp->flmap     |= (uint32_t)1U << fl;
+  hp->free.bsize   |= H_FREE_FLAG;
+
+  /* Boundary tag for the next physical block.*/
+  np->free.bsize   |= H_PREV_FREE_FLAG;
+  H_PREV(np) = hp;
+}
+
+/**
+ * @brief   Removes a block from its free list.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block
+ */
+static void heap_remove(memory_heap_t *heapp, heap_header_t *hp) {
+  unsigned fl, sl;
+
+  heap_mapping(H_BSIZE(hp), &fl, &sl);
+
+  if (H_NEXT(hp) != NULL) {
+    H_PREVF(H_NEXT(hp)) = H_PREVF(hp);
+  }
+  if (H_PREVF(hp) != NULL) {
+    H_NEXT(H_PREVF(hp)) = H_NEXT(hp);
+  }
+  else {
+    heapp->lists[fl][sl] = H_NEXT(hp);
+    if (H_NEXT(hp) == NULL) {
+      /* The list is now empty.*/
+      heapp->slmap[fl] &= ~((uint32_t)1U << sl);
+      if (heapp->slmap[fl] == 0U) {
+        heapp->flmap &= ~((uint32_t)1U << fl);
+      }
+    }
+  }
+  hp->free.bsize &= ~H_FREE_FLAG;
+  H_PHYS_NEXT(hp)->free.bsize &= ~H_PREV_FREE_FLAG;
+}
+
+/**
+ * @brief   Finds and removes a free block of sufficient size.
+ * @details The search is performed in the first non-empty list whose
+ *          blocks are all large enough. If no such list exists then the
+ *          first block of the list of the requested size is tried.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] bsize     the required block size, it must be lower than
+ *                      @p H_MAX_BSIZE
+ * @return              The free block.
+ * @retval NULL         if a block cannot be found.
+ */
+static heap_header_t *heap_find(memory_heap_t *heapp, size_t bsize) {
+  heap_header_t *hp;
+  unsigned fl, sl;
+  size_t rsize;
+  uint32_t map;
+
+  /* Rounding the size up to the next list boundary.*/
+  rsize = bsize;
+  if (rsize >= H_SMALL_BSIZE) {
+    rsize += ((size_t)1 << (heap_msb((uint32_t)rsize) -
+                            CH_CFG_HEAP_TLSF_SL_LOG2)) - 1U;
+  }
+
+  if (rsize < H_MAX_BSIZE) {
+    heap_mapping(rsize, &fl, &sl);
+
+    /* Larger lists in the same first level range.*/
+    map = heapp->slmap[fl] & (~(uint32_t)0U << sl);
+    if (map == 0U) {
+      /* Larger first level ranges.*/
+      map = heapp->flmap & (~(uint32_t)0U << (fl + 1U));
+      if (map != 0U) {
+        fl = heap_lsb(map);
+        map = heapp->slmap[fl];
+      }
+    }
+
+    if (map != 0U) {
+      hp = heapp->lists[fl][heap_lsb(map)];
+      heap_remove(heapp, hp);
+
+      return hp;
+    }
+  }
+
+  /* The list of the requested size could still contain a block large
+     enough, only its first block is checked.*/
+  heap_mapping(bsize, &fl, &sl);
+  hp = heapp->lists[fl][sl];
+  if ((hp != NULL) && (H_BSIZE(hp) >= bsize)) {
+    heap_remove(heapp, hp);
+
+    return hp;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Returns a block to the free lists.
+ * @details The block is merged with its free physical neighbours, merging
+ *          is skipped if the resulting block would exceed the maximum
+ *          block size.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block
+ */
+static void heap_release(memory_heap_t *heapp, heap_header_t *hp) {
+  heap_header_t *qp;
+
+  /* Merging with the next physical block.*/
+  qp = H_PHYS_NEXT(hp);
+  if (H_IS_FREE(qp) &&
+      ((H_BSIZE(hp) + H_HDR_SIZE + H_BSIZE(qp)) < H_MAX_BSIZE)) {
+    heap_remove(heapp, qp);
+    hp->free.bsize += H_HDR_SIZE + H_BSIZE(qp);
+  }
+
+  /* Merging with the previous physical block.*/
+  if (H_IS_PREV_FREE(hp)) {
+    qp = H_PREV(hp);
+    if ((H_BSIZE(qp) + H_HDR_SIZE + H_BSIZE(hp)) < H_MAX_BSIZE) {
+      heap_remove(heapp, qp);
+      qp->free.bsize += H_HDR_SIZE + H_BSIZE(hp);
+      hp = qp;
+    }
+  }
+
+  heap_insert(heapp, hp);
+}
+
+/**
+ * @brief   Splits the excess space at the end of a block.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block
+ * @param[in] bsize     the required block size
+ */
+static void heap_split(memory_heap_t *heapp, heap_header_t *hp, size_t bsize) {
+
+  if (H_BSIZE(hp) >= (bsize + H_HDR_SIZE + H_MIN_BSIZE)) {
+    heap_header_t *fp;
+
+    /*lint -save -e9087 [11.3] Safe cast.*/
+    fp = (heap_header_t *)(void *)((uint8_t *)H_BLOCK(hp) + bsize);
+    /*lint -restore*/
+    fp->free.bsize = H_BSIZE(hp) - bsize - H_HDR_SIZE;
+    hp->free.bsize -= H_HDR_SIZE + H_BSIZE(fp);
+    heap_release(heapp, fp);
+  }
+}
+
+/**
+ * @brief   Splits the space at the start of a block needed for alignment.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        pointer to the block, it must be at least
+ *                      @p align plus the header size larger than required
+ * @param[in] align     desired memory alignment
+ * @return              The aligned block.
+ */
+static heap_header_t *heap_align(memory_heap_t *heapp, heap_header_t *hp,
+                                 unsigned align) {
+  size_t gap;
+
+  /*lint -save -e9033 [10.8] Required cast operations.*/
+  gap = (size_t)((uint8_t *)MEM_ALIGN_NEXT(H_BLOCK(hp), align) -
+                 (uint8_t *)H_BLOCK(hp));
+  /*lint restore*/
+  if (gap > 0U) {
+    heap_header_t *ahp;
+
+    /* The leading space must be able to contain a free block.*/
+    if (gap < (H_HDR_SIZE + H_MIN_BSIZE)) {
+      gap += (size_t)align;
+    }
+
+    /*lint -save -e9087 [11.3] Safe cast.*/
+    ahp = (heap_header_t *)(void *)((uint8_t *)hp + gap);
+    /*lint -restore*/
+    ahp->free.bsize = H_BSIZE(hp) - gap;
+    hp->free.bsize -= H_HDR_SIZE + H_BSIZE(ahp);
+    heap_release(heapp, hp);
+    hp = ahp;
+  }
+
+  return hp;
+}
+
+/**
+ * @brief   Initializes the heap free lists.
+ *
+ * @param[out] heapp    pointer to a heap descriptor
+ */
+static void heap_lists_init(memory_heap_t *heapp) {
+  unsigned fl, sl;
+
+  heapp->sentinel = NULL;
+  heapp->flmap = 0U;
+  for (fl = 0U; fl < CH_HEAP_TLSF_FL_COUNT; fl++) {
+    heapp->slmap[fl] = 0U;
+    for (sl = 0U; sl < CH_HEAP_TLSF_SL_COUNT; sl++) {
+      heapp->lists[fl][sl] = NULL;
+    }
+  }
+}
+
+/**
+ * @brief   Adds a memory area to the heap.
+ * @details The area is split in free blocks not exceeding the maximum
+ *          block size, the last block is followed by the end sentinel.
+ *          An area starting right after the end sentinel of the previous
+ *          area reuses it as header of its first block so that the two
+ *          areas can be merged.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] hp        area base, aligned to @p CH_HEAP_ALIGNMENT
+ * @param[in] size      area size, multiple of @p CH_HEAP_ALIGNMENT
+ */
+static void heap_add_area(memory_heap_t *heapp, heap_header_t *hp,
+                          size_t size) {
+
+  if ((heapp->sentinel != NULL) && (H_BLOCK(heapp->sentinel) == hp)) {
+    hp = heapp->sentinel;
+    size += H_HDR_SIZE;
+  }
+  else {
+    hp->free.bsize = 0U;
+  }
+
+  /* Space for the end sentinel.*/
+  size -= H_HDR_SIZE;
+  while (size >= (H_HDR_SIZE + H_MIN_BSIZE)) {
+    heap_header_t *fp;
+    size_t bsize = size - H_HDR_SIZE;
+
+    if (bsize >= H_MAX_BSIZE) {
+      bsize = H_MAX_BSIZE - H_MIN_BSIZE;
+    }
+    hp->free.bsize = (hp->free.bsize & H_PREV_FREE_FLAG) | bsize;
+    size -= H_HDR_SIZE + bsize;
+
+    /* The next header is initialized as end sentinel before releasing the
+       block.*/
+    fp = H_PHYS_NEXT(hp);
+    fp->free.bsize = 0U;
+    heap_release(heapp, hp);
+    hp = fp;
+  }
+  heapp->sentinel = hp;
+}
+#endif /* CH_CFG_USE_HEAP_TLSF == TRUE */
+
+/**
+ * @brief   Allocates a block of memory from the heap free blocks.
+ *
+ * @param[in] heapp     pointer to a heap descriptor
+ * @param[in] size      the size of the block to be allocated
+ * @param[in] align     desired memory alignment, not lower than
+ *                      @p CH_HEAP_ALIGNMENT
+ * @return              A pointer to the aligned allocated block.
+ * @retval NULL         if the block cannot be allocated.
+ */
+static void *heap_alloc(memory_heap_t *heapp, size_t size, unsigned align) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heap_header_t *hp, *ahp;
+  size_t bsize, fsize;
+#else
+  heap_header_t *qp, *hp, *ahp;
+  size_t pages;
+#endif
+
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  /* Requests exceeding the maximum block size cannot be satisfied.*/
+  if ((size >= H_MAX_BSIZE) || ((size_t)align >= H_MAX_BSIZE)) {
+    return NULL;
+  }
+
+  /* Size is aligned to the allocation unit, if an alignment larger than
+     the unit is required then the free block must also be able to contain
+     the space before the aligned area.*/
+  bsize = MEM_ALIGN_NEXT(size, CH_HEAP_ALIGNMENT);
+  fsize = bsize;
+  if (align > CH_HEAP_ALIGNMENT) {
+    fsize += (size_t)align + H_HDR_SIZE;
+  }
+  if (fsize >= H_MAX_BSIZE) {
+    return NULL;
+  }
+
+  /* Taking heap mutex/semaphore.*/
+  H_LOCK(heapp);
+
+  hp = heap_find(heapp, fsize);
+  if ((hp == NULL) && (heapp->provider != NULL)) {
+    /* More memory is required, tries to get it from the associated provider
+       as a new heap area. Consecutive areas are merged.*/
+    ahp = heapp->provider(H_HDR_SIZE + fsize + H_HDR_SIZE,
+                          CH_HEAP_ALIGNMENT,
+                          0U);
+    if (ahp != NULL) {
+      heap_add_area(heapp, ahp, H_HDR_SIZE + fsize + H_HDR_SIZE);
+      hp = heap_find(heapp, fsize);
+    }
+  }
+
+  if (hp == NULL) {
+    /* Releasing heap mutex/semaphore.*/
+    H_UNLOCK(heapp);
+
+    return NULL;
+  }
+
+  if (align > CH_HEAP_ALIGNMENT) {
+    hp = heap_align(heapp, hp, align);
+  }
+  heap_split(heapp, hp, bsize);
+
+  /* Setting in the block owner heap and size, the size field keeps the
+     previous block state.*/
+  H_SIZE(hp) = size | (H_SIZE(hp) & H_PREV_FREE_FLAG) |
+               ((H_BSIZE(hp) > bsize) ? H_SLACK_FLAG : 0U);
+  H_HEAP(hp) = heapp;
+
+  /* Releasing heap mutex/semaphore.*/
+  H_UNLOCK(heapp);
+
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  return (void *)H_BLOCK(hp);
+  /*lint -restore*/
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
+  /* Size is converted in number of elementary allocation units.*/
+  pages = MEM_ALIGN_NEXT(size, CH_HEAP_ALIGNMENT) / CH_HEAP_ALIGNMENT;
+
+  /* Taking heap mutex/semaphore.*/
+  H_LOCK(heapp);
+
+  /* Start of the free blocks list.*/
+  qp = &heapp->header;
+  while (H_NEXT(qp) != NULL) {
+
+    /* Next free block.*/
+    hp = H_NEXT(qp);
+
+    /* Pointer aligned to the requested alignment.*/
+    ahp = (heap_header_t *)MEM_ALIGN_NEXT(H_BLOCK(hp), align) - 1U;
+
+    if ((ahp < H_LIMIT(hp)) && (pages <= NPAGES(H_LIMIT(hp), ahp + 1U))) {
+      /* The block is large enough to contain a correctly aligned area
+         of sufficient size.*/
+
+      if (ahp > hp) {
+        /* The block is not properly aligned, must split it.*/
+        size_t bpages;
+
+        bpages = NPAGES(H_LIMIT(hp), H_BLOCK(ahp));
+        H_PAGES(hp) = NPAGES(ahp, H_BLOCK(hp));
+        if (bpages > pages) {
+          /* The block is bigger than required, must split the excess.*/
+          heap_header_t *fp;
+
+          /* Creating the excess block.*/
+          fp = H_BLOCK(ahp) + pages;
+          H_PAGES(fp) = (bpages - pages) - 1U;
+
+          /* Linking the excess block.*/
+          H_NEXT(fp) = H_NEXT(hp);
+          H_NEXT(hp) = fp;
+        }
+
+        hp = ahp;
+      }
+      else {
+        /* The block is already properly aligned.*/
+
+        if (H_PAGES(hp) == pages) {
+          /* Exact size, getting the whole block.*/
+          H_NEXT(qp) = H_NEXT(hp);
+        }
+        else {
+          /* The block is bigger than required, must split the excess.*/
+          heap_header_t *fp;
+
+          fp = H_BLOCK(hp) + pages;
+          H_NEXT(fp) = H_NEXT(hp);
+          H_PAGES(fp) = NPAGES(H_LIMIT(hp), H_BLOCK(fp));
+          H_NEXT(qp) = fp;
+        }
+      }
+
+      /* Setting in the block owner heap and size.*/
+      H_SIZE(hp) = size;
+      H_HEAP(hp) = heapp;
+
+      /* Releasing heap mutex/semaphore.*/
+      H_UNLOCK(heapp);
+
+      /*lint -save -e9087 [11.3] Safe cast.*/
+      return (void *)H_BLOCK(hp);
+      /*lint -restore*/
+    }
+
+    /* Next in the free blocks list.*/
+    qp = hp;
+  }
+
+  /* Releasing heap mutex/semaphore.*/
+  H_UNLOCK(heapp);
+
+  /* More memory is required, tries to get it from the associated provider
+     else fails.*/
+  if (heapp->provider != NULL) {
+    ahp = heapp->provider((pages + 1U) * CH_HEAP_ALIGNMENT,
+                          align,
+                          sizeof (heap_header_t));
+    if (ahp != NULL) {
+      hp = ahp - 1U;
+      H_HEAP(hp) = heapp;
+      H_SIZE(hp) = size;
+
+      /*lint -save -e9087 [11.3] Safe cast.*/
+      return (void *)ahp;
+      /*lint -restore*/
+    }
+  }
+
+  return NULL;
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
+}
+
+#if (CH_CFG_USE_HEAP_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the cache class of a block size.
+ *
+ * @param[in] size      the block size, it must not exceed the size of the
+ *                      largest class
+ * @return              The class.
+ */
+static heap_cache_t *heap_cache_class(size_t size) {
+  unsigned n = 0U;
+
+  while (size > CH_HEAP_CACHE_CLASS_SIZE(n)) {
+    n++;
+  }
+
+  return &default_cache[n];
+}
+
+/**
+ * @brief   Allocates a block from a cache class pool.
+ *
+ * @param[in] size      the size of the block to be allocated
+ * @return              A pointer to the allocated block.
+ * @retval NULL         if the class pool is empty.
+ *
+ * @iclass
+ */
+static void *heap_cache_alloc_i(size_t size) {
+  heap_cache_t *cp = heap_cache_class(size);
+  heap_header_t *hp;
+
+  hp = (heap_header_t *)chPoolAllocI(&cp->pool);
+  if (hp == NULL) {
+    cp->misses++;
+
+    return NULL;
+  }
+  cp->hits++;
+
+  H_HEAP(hp) = NULL;
+  H_SIZE(hp) = size;
+
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  return (void *)H_BLOCK(hp);
+  /*lint -restore*/
+}
+
+/**
+ * @brief   Allocates a block from the cache.
+ * @details If the class pool is empty then a new block of the class size
+ *          is allocated from the default heap.
+ *
+ * @param[in] size      the size of the block to be allocated
+ * @return              A pointer to the allocated block.
+ * @retval NULL         if the block cannot be allocated.
+ */
+static void *heap_cache_alloc(size_t size) {
+  heap_header_t *hp;
+  void *p;
+
+  chSysLock();
+  p = heap_cache_alloc_i(size);
+  chSysUnlock();
+
+  if (p == NULL) {
+    /* Cache miss, a new block is allocated from the heap, the class pool
+       object size includes the block header.*/
+    hp = heap_alloc(&default_heap,
+                    heap_cache_class(size)->pool.object_size,
+                    CH_HEAP_ALIGNMENT);
+    if (hp != NULL) {
+      H_HEAP(hp) = NULL;
+      H_SIZE(hp) = size;
+      p = (void *)H_BLOCK(hp);
+    }
+  }
+
+  return p;
+}
+#endif /* CH_CFG_USE_HEAP_CACHE == TRUE */
+
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Clears the heap statistics.
+ * @note    The allocated bytes counter is preserved and becomes the new
+ *          high-water mark.
+ *
+ * @param[out] hsp      pointer to the heap statistics
+ */
+static void heap_prof_reset(heap_stats_t *hsp) {
+  unsigned n;
+
+  hsp->allocs   = 0U;
+  hsp->frees    = 0U;
+  hsp->failures = 0U;
+  hsp->used_max = hsp->used;
+  for (n = 0U; n < CH_HEAP_PROFILING_BINS; n++) {
+    hsp->hist[n] = 0U;
+  }
+  for (n = 0U; n < (unsigned)CH_CFG_HEAP_PROFILING_THREADS; n++) {
+    hsp->threads[n].thread      = NULL;
+    hsp->threads[n].allocs      = 0U;
+    hsp->threads[n].frees       = 0U;
+    hsp->threads[n].alloc_bytes = 0U;
+    hsp->threads[n].free_bytes  = 0U;
+  }
+}
+
+/**
+ * @brief   Adds an heap to the list of the profiled heaps.
+ * @note    An heap initialized again is not added twice.
+ *
+ * @param[in] heapp     pointer to the heap descriptor
+ */
+static void heap_prof_link(memory_heap_t *heapp) {
+  memory_heap_t *hp;
+
+  chSysLock();
+  hp = profiled_heaps;
+  while ((hp != NULL) && (hp != heapp)) {
+    hp = hp->next;
+  }
+  if (hp == NULL) {
+    heapp->next = profiled_heaps;
+    profiled_heaps = heapp;
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the statistics entry of the current thread.
+ * @details Threads are assigned a free entry on their first allocation or
+ *          release, if the table is full then the last entry is returned.
+ *
+ * @param[in] hsp       pointer to the heap statistics
+ * @return              The thread statistics entry.
+ *
+ * @iclass
+ */
+static heap_thread_stats_t *heap_prof_thread_i(heap_stats_t *hsp) {
+  thread_t *tp = chThdGetSelfX();
+  heap_thread_stats_t *fsp = NULL;
+  unsigned n;
+
+  for (n = 0U; n < (unsigned)CH_CFG_HEAP_PROFILING_THREADS - 1U; n++) {
+    if (hsp->threads[n].thread == tp) {
+      return &hsp->threads[n];
+    }
+    if ((fsp == NULL) && (hsp->threads[n].thread == NULL)) {
+      fsp = &hsp->threads[n];
+    }
+  }
+
+  /* Entries released by exited threads can be anywhere in the table.*/
+  if (fsp != NULL) {
+    fsp->thread = tp;
+
+    return fsp;
+  }
+
+  return &hsp->threads[n];
+}
+
+/**
+ * @brief   Records an allocation in the heap statistics.
+ *
+ * @param[in] heapp     pointer to the heap descriptor
+ * @param[in] p         the allocated block or @p NULL if the allocation
+ *                      failed
+ * @param[in] size      the requested size
+ *
+ * @iclass
+ */
+static void heap_prof_alloc_i(memory_heap_t *heapp, void *p, size_t size) {
+  heap_stats_t *hsp = &heapp->stats;
+  heap_thread_stats_t *tsp;
+  unsigned n;
 
-#define H_SIZE(hp)      ((hp)->used.size)
+  if (p == NULL) {
+    hsp->failures++;
 
-/*
- * Number of pages between two pointers in a MISRA-compatible way.
- */
-#define NPAGES(p1, p2)                                                      \
-  /*lint -save -e9033 [10.8] The cast is safe.*/                            \
-  ((size_t)((p1) - (p2)))                                                   \
-  /*lint -restore*/
+    return;
+  }
 
-/*===========================================================================*/
-/* Module exported variables.                                                */
-/*===========================================================================*/
+  hsp->allocs++;
+  hsp->used += size;
+  if (hsp->used > hsp->used_max) {
+    hsp->used_max = hsp->used;
+  }
 
-/*===========================================================================*/
-/* Module local types.                                                       */
-/*===========================================================================*/
+  n = 0U;
+  while ((n < (CH_HEAP_PROFILING_BINS - 1U)) &&
+         (size > CH_HEAP_PROFILING_BIN_SIZE(n))) {
+    n++;
+  }
+  hsp->hist[n]++;
 
-/*===========================================================================*/
-/* Module local variables.                                                   */
-/*===========================================================================*/
+  tsp = heap_prof_thread_i(hsp);
+  tsp->allocs++;
+  tsp->alloc_bytes += size;
+}
 
 /**
- * @brief   Default heap descriptor.
+ * @brief   Records a release in the heap statistics.
+ *
+ * @param[in] hp        header of the block being released
+ *
+ * @iclass
  */
-static memory_heap_t default_heap;
+static void heap_prof_free_i(heap_header_t *hp) {
+  memory_heap_t *heapp = H_HEAP(hp);
+  heap_thread_stats_t *tsp;
 
-/*===========================================================================*/
-/* Module local functions.                                                   */
-/*===========================================================================*/
+#if CH_CFG_USE_HEAP_CACHE == TRUE
+  /* Cached blocks belong to the default heap.*/
+  if (H_IS_CACHED(hp)) {
+    heapp = &default_heap;
+  }
+#endif
+
+  heapp->stats.frees++;
+  heapp->stats.used -= chHeapGetSize(H_BLOCK(hp));
+
+  tsp = heap_prof_thread_i(&heapp->stats);
+  tsp->frees++;
+  tsp->free_bytes += chHeapGetSize(H_BLOCK(hp));
+}
+#endif /* CH_CFG_USE_MEM_PROFILING == TRUE */
 
 /*===========================================================================*/
 /* Module exported functions.                                                */
@@ -107,8 +974,33 @@ static memory_heap_t default_heap;
 void _heap_init(void) {
 
   default_heap.provider = chCoreAllocAlignedWithOffset;
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heap_lists_init(&default_heap);
+#else
   H_NEXT(&default_heap.header) = NULL;
   H_PAGES(&default_heap.header) = 0;
+#endif
+#if CH_CFG_USE_HEAP_CACHE == TRUE
+  {
+    unsigned n;
+
+    for (n = 0U; n < (unsigned)CH_CFG_HEAP_CACHE_CLASSES; n++) {
+      chPoolObjectInitAligned(&default_cache[n].pool,
+                              CH_HEAP_CACHE_CLASS_SIZE(n) +
+                              sizeof (heap_header_t),
+                              CH_HEAP_ALIGNMENT,
+                              NULL);
+      default_cache[n].hits   = 0U;
+      default_cache[n].misses = 0U;
+    }
+  }
+#endif
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  default_heap.stats.used = 0U;
+  heap_prof_reset(&default_heap.stats);
+  default_heap.next = NULL;
+  profiled_heaps = &default_heap;
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   chMtxObjectInit(&default_heap.mtx);
 #else
@@ -121,6 +1013,9 @@ void _heap_init(void) {
  * @note    The heap buffer base and size are adjusted if the passed buffer
  *          is not aligned to @p CH_HEAP_ALIGNMENT. This mean that the
  *          effective heap size can be less than @p size.
+ * @note    If @p CH_CFG_USE_MEM_PROFILING is enabled then the heap is
+ *          linked in the list of the profiled heaps, the descriptor must
+ *          not be deallocated.
  *
  * @param[out] heapp    pointer to the memory heap descriptor to be initialized
  * @param[in] buf       heap buffer base
@@ -139,12 +1034,26 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
   size -= (size_t)((uint8_t *)hp - (uint8_t *)buf);
   /*lint restore*/
 
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  /* Initializing the free lists then adding the whole buffer.*/
+  heapp->provider = NULL;
+  heap_lists_init(heapp);
+  size = MEM_ALIGN_PREV(size, CH_HEAP_ALIGNMENT);
+  chDbgAssert(size >= ((2U * H_HDR_SIZE) + H_MIN_BSIZE), "heap too small");
+  heap_add_area(heapp, hp, size);
+#else
   /* Initializing the heap header.*/
   heapp->provider = NULL;
   H_NEXT(&heapp->header) = hp;
   H_PAGES(&heapp->header) = 0;
   H_NEXT(hp) = NULL;
   H_PAGES(hp) = (size - sizeof (heap_header_t)) / CH_HEAP_ALIGNMENT;
+#endif
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  heapp->stats.used = 0U;
+  heap_prof_reset(&heapp->stats);
+  heap_prof_link(heapp);
+#endif
 #if (CH_CFG_USE_MUTEXES == TRUE) || defined(__DOXYGEN__)
   chMtxObjectInit(&heapp->mtx);
 #else
@@ -153,8 +1062,7 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
 }
 
 /**
- * @brief   Allocates a block of memory from the heap by using the first-fit
- *          algorithm.
+ * @brief   Allocates a block of memory from the heap.
  * @details The allocated block is guaranteed to be properly aligned to the
  *          specified alignment.
  *
@@ -170,8 +1078,7 @@ void chHeapObjectInit(memory_heap_t *heapp, void *buf, size_t size) {
  * @api
  */
 void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
-  heap_header_t *qp, *hp, *ahp;
-  size_t pages;
+  void *p;
 
   chDbgCheck((size > 0U) && MEM_IS_VALID_ALIGNMENT(align));
 
@@ -185,102 +1092,27 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
     align = CH_HEAP_ALIGNMENT;
   }
 
-  /* Size is converted in number of elementary allocation units.*/
-  pages = MEM_ALIGN_NEXT(size, CH_HEAP_ALIGNMENT) / CH_HEAP_ALIGNMENT;
-
-  /* Taking heap mutex/semaphore.*/
-  H_LOCK(heapp);
-
-  /* Start of the free blocks list.*/
-  qp = &heapp->header;
-  while (H_NEXT(qp) != NULL) {
-
-    /* Next free block.*/
-    hp = H_NEXT(qp);
-
-    /* Pointer aligned to the requested alignment.*/
-    ahp = (heap_header_t *)MEM_ALIGN_NEXT(H_BLOCK(hp), align) - 1U;
-
-    if ((ahp < H_LIMIT(hp)) && (pages <= NPAGES(H_LIMIT(hp), ahp + 1U))) {
-      /* The block is large enough to contain a correctly aligned area
-         of sufficient size.*/
-
-      if (ahp > hp) {
-        /* The block is not properly aligned, must split it.*/
-        size_t bpages;
-
-        bpages = NPAGES(H_LIMIT(hp), H_BLOCK(ahp));
-        H_PAGES(hp) = NPAGES(ahp, H_BLOCK(hp));
-        if (bpages > pages) {
-          /* The block is bigger than required, must split the excess.*/
-          heap_header_t *fp;
-
-          /* Creating the excess block.*/
-          fp = H_BLOCK(ahp) + pages;
-          H_PAGES(fp) = (bpages - pages) - 1U;
-
-          /* Linking the excess block.*/
-          H_NEXT(fp) = H_NEXT(hp);
-          H_NEXT(hp) = fp;
-        }
-
-        hp = ahp;
-      }
-      else {
-        /* The block is already properly aligned.*/
-
-        if (H_PAGES(hp) == pages) {
-          /* Exact size, getting the whole block.*/
-          H_NEXT(qp) = H_NEXT(hp);
-        }
-        else {
-          /* The block is bigger than required, must split the excess.*/
-          heap_header_t *fp;
-
-          fp = H_BLOCK(hp) + pages;
-          H_NEXT(fp) = H_NEXT(hp);
-          H_PAGES(fp) = NPAGES(H_LIMIT(hp), H_BLOCK(fp));
-          H_NEXT(qp) = fp;
-        }
-      }
-
-      /* Setting in the block owner heap and size.*/
-      H_SIZE(hp) = size;
-      H_HEAP(hp) = heapp;
-
-      /* Releasing heap mutex/semaphore.*/
-      H_UNLOCK(heapp);
-
-      /*lint -save -e9087 [11.3] Safe cast.*/
-      return (void *)H_BLOCK(hp);
-      /*lint -restore*/
-    }
-
-    /* Next in the free blocks list.*/
-    qp = hp;
+#if CH_CFG_USE_HEAP_CACHE == TRUE
+  /* Small blocks from the default heap without special alignment
+     requirements are served by the size classes cache.*/
+  if ((heapp == &default_heap) && (align == CH_HEAP_ALIGNMENT) &&
+      (size <= H_CACHE_MAX_SIZE)) {
+    p = heap_cache_alloc(size);
   }
-
-  /* Releasing heap mutex/semaphore.*/
-  H_UNLOCK(heapp);
-
-  /* More memory is required, tries to get it from the associated provider
-     else fails.*/
-  if (heapp->provider != NULL) {
-    ahp = heapp->provider((pages + 1U) * CH_HEAP_ALIGNMENT,
-                          align,
-                          sizeof (heap_header_t));
-    if (ahp != NULL) {
-      hp = ahp - 1U;
-      H_HEAP(hp) = heapp;
-      H_SIZE(hp) = size;
-
-      /*lint -save -e9087 [11.3] Safe cast.*/
-      return (void *)ahp;
-      /*lint -restore*/
-    }
+  else {
+    p = heap_alloc(heapp, size, align);
   }
+#else
+  p = heap_alloc(heapp, size, align);
+#endif
 
-  return NULL;
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  chSysLock();
+  heap_prof_alloc_i(heapp, p, size);
+  chSysUnlock();
+#endif
+
+  return p;
 }
 
 /**
@@ -291,7 +1123,11 @@ void *chHeapAllocAligned(memory_heap_t *heapp, size_t size, unsigned align) {
  * @api
  */
 void chHeapFree(void *p) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heap_header_t *hp;
+#else
   heap_header_t *qp, *hp;
+#endif
   memory_heap_t *heapp;
 
   chDbgCheck((p != NULL) && MEM_IS_ALIGNED(p, CH_HEAP_ALIGNMENT));
@@ -300,6 +1136,33 @@ void chHeapFree(void *p) {
   hp = (heap_header_t *)p - 1U;
   /*lint -restore*/
   heapp = H_HEAP(hp);
+
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  chSysLock();
+  heap_prof_free_i(hp);
+  chSysUnlock();
+#endif
+
+#if CH_CFG_USE_HEAP_CACHE == TRUE
+  /* Cached blocks are returned to their class pool.*/
+  if (H_IS_CACHED(hp)) {
+    chPoolFree(&heap_cache_class(H_SIZE(hp))->pool, (void *)hp);
+
+    return;
+  }
+#endif
+
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  /* Taking heap mutex/semaphore.*/
+  H_LOCK(heapp);
+
+  chDbgAssert(!H_IS_FREE(hp), "not allocated");
+
+  /* The block is merged with its free neighbours and inserted in the
+     free lists.*/
+  H_SIZE(hp) = H_USED_BSIZE(hp) | (H_SIZE(hp) & H_PREV_FREE_FLAG);
+  heap_release(heapp, hp);
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
   qp = &heapp->header;
 
   /* Size is converted in number of elementary allocation units.*/
@@ -332,6 +1195,7 @@ void chHeapFree(void *p) {
     }
     qp = H_NEXT(qp);
   }
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
 
   /* Releasing heap mutex/semaphore.*/
   H_UNLOCK(heapp);
@@ -355,14 +1219,51 @@ void chHeapFree(void *p) {
  * @api
  */
 size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  heap_header_t *hp;
+  unsigned fl, sl;
+  size_t n, tsize, lsize;
+#else
   heap_header_t *qp;
   size_t n, tpages, lpages;
+#endif
 
   if (heapp == NULL) {
     heapp = &default_heap;
   }
 
   H_LOCK(heapp);
+#if CH_CFG_USE_HEAP_TLSF == TRUE
+  tsize = 0U;
+  lsize = 0U;
+  n = 0U;
+  for (fl = 0U; fl < CH_HEAP_TLSF_FL_COUNT; fl++) {
+    for (sl = 0U; sl < CH_HEAP_TLSF_SL_COUNT; sl++) {
+      hp = heapp->lists[fl][sl];
+      while (hp != NULL) {
+
+        /* Updating counters.*/
+        n++;
+        tsize += H_BSIZE(hp);
+        if (H_BSIZE(hp) > lsize) {
+          lsize = H_BSIZE(hp);
+        }
+
+        hp = H_NEXT(hp);
+      }
+    }
+  }
+
+  /* Writing out fragmented free memory.*/
+  if (totalp != NULL) {
+    *totalp = tsize;
+  }
+
+  /* Writing out unfragmented free memory.*/
+  if (largestp != NULL) {
+    *largestp = lsize;
+  }
+#else /* CH_CFG_USE_HEAP_TLSF == FALSE */
   tpages = 0U;
   lpages = 0U;
   n = 0U;
@@ -389,11 +1290,192 @@ size_t chHeapStatus(memory_heap_t *heapp, size_t *totalp, size_t *largestp) {
   if (largestp != NULL) {
     *largestp = lpages * CH_HEAP_ALIGNMENT;
   }
+#endif /* CH_CFG_USE_HEAP_TLSF == FALSE */
   H_UNLOCK(heapp);
 
   return n;
 }
 
+#if (CH_CFG_USE_HEAP_CACHE == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Allocates a block of memory from the default heap cache.
+ * @details The block is taken from the pool of its size class, the pool
+ *          is not refilled from the heap.
+ *
+ * @param[in] size      the size of the block to be allocated
+ * @return              A pointer to the allocated block, it must be freed
+ *                      using @p chHeapFree() or @p chHeapCacheFreeI().
+ * @retval NULL         if the block cannot be allocated.
+ *
+ * @iclass
+ */
+void *chHeapCacheAllocI(size_t size) {
+  void *p;
+
+  chDbgCheckClassI();
+  chDbgCheck(size > 0U);
+
+  if (size > H_CACHE_MAX_SIZE) {
+    p = NULL;
+  }
+  else {
+    p = heap_cache_alloc_i(size);
+  }
+
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  heap_prof_alloc_i(&default_heap, p, size);
+#endif
+
+  return p;
+}
+
+/**
+ * @brief   Frees a block of memory allocated from the default heap cache.
+ *
+ * @param[in] p         pointer to the memory block to be freed
+ *
+ * @iclass
+ */
+void chHeapCacheFreeI(void *p) {
+  heap_header_t *hp;
+
+  chDbgCheckClassI();
+  chDbgCheck((p != NULL) && MEM_IS_ALIGNED(p, CH_HEAP_ALIGNMENT));
+
+  /*lint -save -e9087 [11.3] Safe cast.*/
+  hp = (heap_header_t *)p - 1U;
+  /*lint -restore*/
+  chDbgAssert(H_IS_CACHED(hp), "not cached");
+
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  heap_prof_free_i(hp);
+#endif
+
+  chPoolFreeI(&heap_cache_class(H_SIZE(hp))->pool, (void *)hp);
+}
+
+/**
+ * @brief   Reports the status of a class of the default heap cache.
+ * @note    The hit rate of the class is hits / (hits + misses).
+ *
+ * @param[in] n         the class index
+ * @param[in] hitsp     pointer to a variable that will receive the number
+ *                      of allocations served by the class pool or @p NULL
+ * @param[in] missesp   pointer to a variable that will receive the number
+ *                      of allocations not served by the class pool or
+ *                      @p NULL
+ * @return              The number of free blocks in the class pool.
+ *
+ * @api
+ */
+size_t chHeapCacheStatus(unsigned n, uint32_t *hitsp, uint32_t *missesp) {
+  struct pool_header *php;
+  size_t count;
+
+  chDbgCheck(n < (unsigned)CH_CFG_HEAP_CACHE_CLASSES);
+
+  chSysLock();
+  count = 0U;
+  php = default_cache[n].pool.next;
+  while (php != NULL) {
+    count++;
+    php = php->next;
+  }
+  if (hitsp != NULL) {
+    *hitsp = default_cache[n].hits;
+  }
+  if (missesp != NULL) {
+    *missesp = default_cache[n].misses;
+  }
+  chSysUnlock();
+
+  return count;
+}
+#endif /* CH_CFG_USE_HEAP_CACHE == TRUE */
+
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Releases the statistics entries of an exiting thread.
+ * @details The counters of the thread are moved in the shared entry of
+ *          each profiled heap so that a new thread, possibly created in
+ *          the same memory, starts from a free entry.
+ *
+ * @param[in] tp        pointer to the exiting thread
+ *
+ * @notapi
+ */
+void _heap_prof_thread_exit(thread_t *tp) {
+  memory_heap_t *heapp;
+
+  for (heapp = profiled_heaps; heapp != NULL; heapp = heapp->next) {
+    heap_thread_stats_t *ssp, *tsp;
+    unsigned n;
+
+    ssp = &heapp->stats.threads[CH_CFG_HEAP_PROFILING_THREADS - 1];
+    for (n = 0U; n < (unsigned)CH_CFG_HEAP_PROFILING_THREADS - 1U; n++) {
+      tsp = &heapp->stats.threads[n];
+      if (tsp->thread == tp) {
+        ssp->allocs      += tsp->allocs;
+        ssp->frees       += tsp->frees;
+        ssp->alloc_bytes += tsp->alloc_bytes;
+        ssp->free_bytes  += tsp->free_bytes;
+        tsp->thread      = NULL;
+        tsp->allocs      = 0U;
+        tsp->frees       = 0U;
+        tsp->alloc_bytes = 0U;
+        tsp->free_bytes  = 0U;
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * @brief   Returns a snapshot of the heap statistics.
+ * @note    The free space fragmentation is reported by
+ *          @p chHeapStatus().
+ *
+ * @param[in] heapp     pointer to a heap descriptor or @p NULL in order to
+ *                      access the default heap.
+ * @param[out] hsp      pointer to the @p heap_stats_t structure to be filled
+ *
+ * @api
+ */
+void chHeapGetStats(memory_heap_t *heapp, heap_stats_t *hsp) {
+
+  chDbgCheck(hsp != NULL);
+
+  if (heapp == NULL) {
+    heapp = &default_heap;
+  }
+
+  chSysLock();
+  *hsp = heapp->stats;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Resets the heap statistics.
+ * @details The counters, the histogram and the threads table are cleared,
+ *          the high-water mark restarts from the currently allocated bytes.
+ *
+ * @param[in] heapp     pointer to a heap descriptor or @p NULL in order to
+ *                      access the default heap.
+ *
+ * @api
+ */
+void chHeapResetStats(memory_heap_t *heapp) {
+
+  if (heapp == NULL) {
+    heapp = &default_heap;
+  }
+
+  chSysLock();
+  heap_prof_reset(&heapp->stats);
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_MEM_PROFILING == TRUE */
+
 #endif /* CH_CFG_USE_HEAP == TRUE */
 
 /** @} */
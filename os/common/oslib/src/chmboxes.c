@@ -54,6 +54,15 @@
 
 #if (CH_CFG_USE_MAILBOXES == TRUE) || defined(__DOXYGEN__)
 
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/* The trace hook is not defined by kernels without a trace subsystem.*/
+#if !defined(_trace_mb)
+#define _trace_mb(event, mbp, msg)
+#endif
+
 /*===========================================================================*/
 /* Module exported variables.                                                */
 /*===========================================================================*/
@@ -210,6 +219,7 @@ msg_t chMBPostTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
         mbp->wrptr = mbp->buffer;
       }
       mbp->cnt++;
+      _trace_mb(CH_TRACE_MB_POST, mbp, msg);
 
       /* If there is a reader waiting then makes it ready.*/
       chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -219,6 +229,7 @@ msg_t chMBPostTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
     }
 
     /* No space in the queue, waiting for a slot to become available.*/
+    _trace_mb(CH_TRACE_MB_FULL, mbp, msg);
     rdymsg = chThdEnqueueTimeoutS(&mbp->qw, timeout);
   } while (rdymsg == MSG_OK);
 
@@ -257,6 +268,7 @@ msg_t chMBPostI(mailbox_t *mbp, msg_t msg) {
       mbp->wrptr = mbp->buffer;
     }
     mbp->cnt++;
+    _trace_mb(CH_TRACE_MB_POST, mbp, msg);
 
     /* If there is a reader waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -335,6 +347,7 @@ msg_t chMBPostAheadTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
       }
       *mbp->rdptr = msg;
       mbp->cnt++;
+      _trace_mb(CH_TRACE_MB_POST, mbp, msg);
 
       /* If there is a reader waiting then makes it ready.*/
       chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -344,6 +357,7 @@ msg_t chMBPostAheadTimeoutS(mailbox_t *mbp, msg_t msg, sysinterval_t timeout) {
     }
 
     /* No space in the queue, waiting for a slot to become available.*/
+    _trace_mb(CH_TRACE_MB_FULL, mbp, msg);
     rdymsg = chThdEnqueueTimeoutS(&mbp->qw, timeout);
   } while (rdymsg == MSG_OK);
 
@@ -382,6 +396,7 @@ msg_t chMBPostAheadI(mailbox_t *mbp, msg_t msg) {
     }
     *mbp->rdptr = msg;
     mbp->cnt++;
+    _trace_mb(CH_TRACE_MB_POST, mbp, msg);
 
     /* If there is a reader waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qr, MSG_OK);
@@ -460,6 +475,7 @@ msg_t chMBFetchTimeoutS(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout) {
         mbp->rdptr = mbp->buffer;
       }
       mbp->cnt--;
+      _trace_mb(CH_TRACE_MB_FETCH, mbp, *msgp);
 
       /* If there is a writer waiting then makes it ready.*/
       chThdDequeueNextI(&mbp->qw, MSG_OK);
@@ -469,6 +485,7 @@ msg_t chMBFetchTimeoutS(mailbox_t *mbp, msg_t *msgp, sysinterval_t timeout) {
     }
 
     /* No message in the queue, waiting for a message to become available.*/
+    _trace_mb(CH_TRACE_MB_EMPTY, mbp, (msg_t)0);
     rdymsg = chThdEnqueueTimeoutS(&mbp->qr, timeout);
   } while (rdymsg == MSG_OK);
 
@@ -507,6 +524,7 @@ msg_t chMBFetchI(mailbox_t *mbp, msg_t *msgp) {
       mbp->rdptr = mbp->buffer;
     }
     mbp->cnt--;
+    _trace_mb(CH_TRACE_MB_FETCH, mbp, *msgp);
 
     /* If there is a writer waiting then makes it ready.*/
     chThdDequeueNextI(&mbp->qw, MSG_OK);
@@ -93,6 +93,11 @@ void _core_init(void) {
   ch_memcore.nextmem = &static_heap[0];
   ch_memcore.endmem  = &static_heap[CH_CFG_MEMCORE_SIZE];
 #endif
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  ch_memcore.basemem  = ch_memcore.nextmem;
+  ch_memcore.allocs   = 0U;
+  ch_memcore.failures = 0U;
+#endif
 }
 
 /**
@@ -123,10 +128,16 @@ void *chCoreAllocAlignedWithOffsetI(size_t size,
 
   /* Considering also the case where there is numeric overflow.*/
   if ((next > ch_memcore.endmem) || (next < ch_memcore.nextmem)) {
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+    ch_memcore.failures++;
+#endif
     return NULL;
   }
 
   ch_memcore.nextmem = next;
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  ch_memcore.allocs++;
+#endif
 
   return p;
 }
@@ -170,6 +181,30 @@ size_t chCoreGetStatusX(void) {
   return (size_t)(ch_memcore.endmem - ch_memcore.nextmem);
   /*lint -restore*/
 }
+
+#if (CH_CFG_USE_MEM_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns a snapshot of the core memory statistics.
+ *
+ * @param[out] csp      pointer to the @p memcore_stats_t structure to be
+ *                      filled
+ *
+ * @api
+ */
+void chCoreGetStats(memcore_stats_t *csp) {
+
+  chDbgCheck(csp != NULL);
+
+  chSysLock();
+  /*lint -save -e9033 [10.8] The casts are safe.*/
+  csp->size     = (size_t)(ch_memcore.endmem - ch_memcore.basemem);
+  csp->used     = (size_t)(ch_memcore.nextmem - ch_memcore.basemem);
+  /*lint -restore*/
+  csp->allocs   = ch_memcore.allocs;
+  csp->failures = ch_memcore.failures;
+  chSysUnlock();
+}
+#endif /* CH_CFG_USE_MEM_PROFILING == TRUE */
 #endif /* CH_CFG_USE_MEMCORE == TRUE */
 
 /** @} */
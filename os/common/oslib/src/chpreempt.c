@@ -124,7 +124,7 @@ void chSchDoReschedule(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = ready_fifo_remove();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
@@ -0,0 +1,135 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    SIMX64/chcore.c
+ * @brief   Simulator on x86-64 port code.
+ *
+ * @addtogroup SIMX64_GCC_CORE
+ * @{
+ */
+
+#include <time.h>
+
+#include "ch.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+bool port_isr_context_flag;
+syssts_t port_irq_sts;
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * Performs a context switch between two threads.
+ * @param ntp the thread to be switched in
+ * @param otp the thread to be switched out
+ */
+__attribute__((used))
+static void __dummy(thread_t *ntp, thread_t *otp) {
+  (void)ntp; (void)otp;
+
+  asm volatile (
+#if defined(__APPLE__)
+                ".globl _port_switch                            \n\t"
+                "_port_switch:                                  \n\t"
+#else
+                ".globl port_switch                             \n\t"
+                "port_switch:                                   \n\t"
+#endif
+                "push    %%rbp                                  \n\t"
+                "push    %%rbx                                  \n\t"
+                "push    %%r12                                  \n\t"
+                "push    %%r13                                  \n\t"
+                "push    %%r14                                  \n\t"
+                "push    %%r15                                  \n\t"
+                "movq    %%rsp, %c0(%%rsi)                      \n\t"
+                "movq    %c0(%%rdi), %%rsp                      \n\t"
+                "pop     %%r15                                  \n\t"
+                "pop     %%r14                                  \n\t"
+                "pop     %%r13                                  \n\t"
+                "pop     %%r12                                  \n\t"
+                "pop     %%rbx                                  \n\t"
+                "pop     %%rbp                                  \n\t"
+                "ret                                            \n\t"
+#if defined(__APPLE__)
+                ".globl __port_thread_start                     \n\t"
+                "__port_thread_start:                           \n\t"
+#else
+                ".globl _port_thread_start                      \n\t"
+                "_port_thread_start:                            \n\t"
+#endif
+                "movq    %%r12, %%rdi                           \n\t"
+                "movq    %%r13, %%rsi                           \n\t"
+#if defined(__APPLE__)
+                "call    __port_thread_run                      \n\t"
+#else
+                "call    _port_thread_run                       \n\t"
+#endif
+                : : "i" (offsetof(thread_t, ctx.sp)) : "memory");
+}
+
+/**
+ * @brief   Start a thread by invoking its work function.
+ * @details If the work function returns @p chThdExit() is automatically
+ *          invoked. It is invoked by the @p _port_thread_start() entry
+ *          point which takes the parameters from the initial context.
+ */
+__attribute__((noreturn, used))
+void _port_thread_run(msg_t (*pf)(void *), void *p) {
+
+  chSysUnlock();
+  pf(p);
+  chThdExit(0);
+  while(1);
+}
+
+/**
+ * @brief   Returns the current value of the realtime counter.
+ *
+ * @return              The realtime counter value.
+ */
+rtcnt_t port_rt_get_counter_value(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((rtcnt_t)ts.tv_sec * (rtcnt_t)1000000000) + (rtcnt_t)ts.tv_nsec;
+}
+
+/** @} */
@@ -58,6 +58,18 @@
 #define HAL_CRY_ENFORCE_FALLBACK            FALSE
 #endif
 
+/**
+ * @brief   Enables the asynchronous jobs API.
+ * @details When enabled, operations can be queued using @p crySubmitJob()
+ *          and their completion is notified by a callback. If the LLD is
+ *          able to run operations asynchronously then queued jobs are
+ *          chained back-to-back from its completion interrupt, else the
+ *          queue is executed by the submitting thread.
+ */
+#if !defined(HAL_CRY_USE_ASYNC) || defined(__DOXYGEN__)
+#define HAL_CRY_USE_ASYNC                   FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -108,6 +120,151 @@ typedef enum {
   cry_algo_des                              /**< DES 56, TDES 112, 168 bits.*/
 } cryalgorithm_t;
 
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of an asynchronous operation identifier.
+ */
+typedef enum {
+  cry_op_encrypt_aes_ecb = 0,
+  cry_op_decrypt_aes_ecb,
+  cry_op_encrypt_aes_cbc,
+  cry_op_decrypt_aes_cbc,
+  cry_op_encrypt_aes_cfb,
+  cry_op_decrypt_aes_cfb,
+  cry_op_encrypt_aes_ctr,
+  cry_op_decrypt_aes_ctr,
+  cry_op_encrypt_des_ecb,
+  cry_op_decrypt_des_ecb,
+  cry_op_encrypt_des_cbc,
+  cry_op_decrypt_des_cbc,
+  cry_op_sha1,
+  cry_op_sha256,
+  cry_op_sha512
+} cryop_t;
+
+/**
+ * @brief   Asynchronous job states.
+ */
+typedef enum {
+  CRY_JOB_IDLE = 0,                         /**< Never submitted.           */
+  CRY_JOB_QUEUED = 1,                       /**< Queued or in progress.     */
+  CRY_JOB_DONE = 2                          /**< Completed.                 */
+} cryjobstate_t;
+
+/**
+ * @brief   Type of an asynchronous job.
+ */
+typedef struct hal_cry_job cryjob_t;
+#endif
+
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Fall-back state of a SHA1 or SHA256 computation.
+ */
+typedef struct {
+  /**
+   * @brief   Intermediate hash value.
+   */
+  uint32_t                  h[8];
+  /**
+   * @brief   Number of bytes processed so far.
+   */
+  uint64_t                  length;
+  /**
+   * @brief   Partial block buffer.
+   */
+  uint8_t                   buf[64];
+} crysha32state_t;
+
+/**
+ * @brief   Fall-back state of a SHA512 computation.
+ */
+typedef struct {
+  /**
+   * @brief   Intermediate hash value.
+   */
+  uint64_t                  h[8];
+  /**
+   * @brief   Number of bytes processed so far.
+   */
+  uint64_t                  length;
+  /**
+   * @brief   Partial block buffer.
+   */
+  uint8_t                   buf[128];
+} crysha64state_t;
+
+/**
+ * @brief   Fall-back expanded AES key.
+ */
+typedef struct {
+  /**
+   * @brief   Number of rounds.
+   */
+  uint32_t                  nr;
+  /**
+   * @brief   Round keys, up to 15 rounds of four words.
+   */
+  uint32_t                  rk[60];
+} cryaesstate_t;
+
+/**
+ * @brief   Fall-back GHASH state.
+ */
+typedef struct {
+  /**
+   * @brief   Multiples of H, high halves.
+   */
+  uint64_t                  hh[16];
+  /**
+   * @brief   Multiples of H, low halves.
+   */
+  uint64_t                  hl[16];
+  /**
+   * @brief   Current hash value.
+   */
+  uint8_t                   y[16];
+} cryghashstate_t;
+
+/**
+ * @brief   Fall-back state of an AES-GCM computation.
+ */
+typedef struct {
+  /**
+   * @brief   Expanded encryption key.
+   */
+  cryaesstate_t             aes;
+  /**
+   * @brief   GHASH state.
+   */
+  cryghashstate_t           ghash;
+  /**
+   * @brief   Pre-counter block, used for the tag.
+   */
+  uint8_t                   j0[16];
+  /**
+   * @brief   Current counter block.
+   */
+  uint8_t                   ctr[16];
+  /**
+   * @brief   Current key stream block.
+   */
+  uint8_t                   ks[16];
+  /**
+   * @brief   Partial GHASH input block.
+   */
+  uint8_t                   buf[16];
+  /**
+   * @brief   Size of the authentication data processed so far.
+   */
+  uint64_t                  aadsize;
+  /**
+   * @brief   Size of the text processed so far.
+   */
+  uint64_t                  size;
+} crygcmstate_t;
+#endif
+
 #if HAL_CRY_ENFORCE_FALLBACK == FALSE
 /* Use the defined low level driver.*/
 #include "hal_crypto_lld.h"
@@ -123,6 +280,11 @@ typedef enum {
 #define CRY_LLD_SUPPORTS_DES                FALSE
 #define CRY_LLD_SUPPORTS_DES_ECB            FALSE
 #define CRY_LLD_SUPPORTS_DES_CBC            FALSE
+#define CRY_LLD_SUPPORTS_SHA1               FALSE
+#define CRY_LLD_SUPPORTS_SHA256             FALSE
+#define CRY_LLD_SUPPORTS_SHA512             FALSE
+#define CRY_LLD_SUPPORTS_TRNG               FALSE
+#define CRY_LLD_SUPPORTS_ASYNC              FALSE
 
 typedef uint_fast8_t crykey_t;
 
@@ -138,6 +300,10 @@ struct CRYDriver {
   cryalgorithm_t            key0_type;
   size_t                    key0_size;
   uint8_t                   key0_buffer[HAL_CRY_MAX_KEY_SIZE];
+#if HAL_CRY_USE_ASYNC == TRUE
+  cryjob_t                  *jqhead;
+  cryjob_t                  *jqtail;
+#endif
 };
 #endif
 
@@ -149,10 +315,153 @@ struct CRYDriver {
     !defined(CRY_LLD_SUPPORTS_AES_GCM) ||                                   \
     !defined(CRY_LLD_SUPPORTS_DES) ||                                       \
     !defined(CRY_LLD_SUPPORTS_DES_ECB) ||                                   \
-    !defined(CRY_LLD_SUPPORTS_DES_CBC)
+    !defined(CRY_LLD_SUPPORTS_DES_CBC) ||                                   \
+    !defined(CRY_LLD_SUPPORTS_SHA1) ||                                      \
+    !defined(CRY_LLD_SUPPORTS_SHA256) ||                                    \
+    !defined(CRY_LLD_SUPPORTS_SHA512) ||                                    \
+    !defined(CRY_LLD_SUPPORTS_TRNG)
 #error "CRYPTO LLD does not export the required switches"
 #endif
 
+/* Asynchronous operations are an optional LLD capability.*/
+#if !defined(CRY_LLD_SUPPORTS_ASYNC)
+#define CRY_LLD_SUPPORTS_ASYNC              FALSE
+#endif
+
+/* Contexts of the algorithms not supported by the LLD, the fall-back, if
+   enabled, keeps its state in there.*/
+#if (CRY_LLD_SUPPORTS_SHA1 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a SHA1 context.
+ * @note    The LLD defines its own type when it supports the algorithm.
+ */
+typedef struct {
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fall-back state.
+   */
+  crysha32state_t           fallback;
+#else
+  uint32_t                  dummy;
+#endif
+} SHA1Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA256 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a SHA256 context.
+ * @note    The LLD defines its own type when it supports the algorithm.
+ */
+typedef struct {
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fall-back state.
+   */
+  crysha32state_t           fallback;
+#else
+  uint32_t                  dummy;
+#endif
+} SHA256Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_SHA512 == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a SHA512 context.
+ * @note    The LLD defines its own type when it supports the algorithm.
+ */
+typedef struct {
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fall-back state.
+   */
+  crysha64state_t           fallback;
+#else
+  uint32_t                  dummy;
+#endif
+} SHA512Context;
+#endif
+
+#if (CRY_LLD_SUPPORTS_AES_GCM == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of an AES-GCM context.
+ * @note    The LLD defines its own type when it supports the algorithm.
+ */
+typedef struct {
+#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Fall-back state.
+   */
+  crygcmstate_t             fallback;
+#else
+  uint32_t                  dummy;
+#endif
+} AESGCMContext;
+#endif
+
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a job completion callback.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the completed job
+ */
+typedef void (*cryjobcb_t)(CRYDriver *cryp, cryjob_t *jobp);
+
+/**
+ * @brief   Structure representing an asynchronous job.
+ */
+struct hal_cry_job {
+  /**
+   * @brief   Next job in the driver queue.
+   */
+  cryjob_t                  *next;
+  /**
+   * @brief   Job state.
+   */
+  volatile cryjobstate_t    state;
+  /**
+   * @brief   Requested operation.
+   */
+  cryop_t                   op;
+  /**
+   * @brief   Key identifier, ignored by hash operations.
+   */
+  crykey_t                  key_id;
+  /**
+   * @brief   Size of the input buffer.
+   */
+  size_t                    size;
+  /**
+   * @brief   Input buffer.
+   */
+  const uint8_t             *in;
+  /**
+   * @brief   Output buffer, for hash operations it receives the digest.
+   */
+  uint8_t                   *out;
+  /**
+   * @brief   Input vector, @p NULL if not required by the operation.
+   */
+  const uint8_t             *iv;
+  /**
+   * @brief   Completion callback or @p NULL.
+   */
+  cryjobcb_t                callback;
+  /**
+   * @brief   Callback argument, not used by the driver.
+   */
+  void                      *arg;
+  /**
+   * @brief   Operation result, valid after completion.
+   */
+  cryerror_t                result;
+  /**
+   * @brief   Thread waiting for the job completion.
+   */
+  thread_reference_t        thread;
+};
+#endif
+
 /*===========================================================================*/
 /* Driver macros.                                                            */
 /*===========================================================================*/
@@ -250,6 +559,27 @@ extern "C" {
                                size_t aadsize,
                                const uint8_t *aad,
                                uint8_t *authtag);
+  cryerror_t cryAES_GCMInit(CRYDriver *cryp,
+                            AESGCMContext *gcmctxp,
+                            crykey_t key_id,
+                            const uint8_t *iv);
+  cryerror_t cryAES_GCMUpdateAAD(CRYDriver *cryp,
+                                 AESGCMContext *gcmctxp,
+                                 size_t size,
+                                 const uint8_t *aad);
+  cryerror_t cryEncryptAES_GCMUpdate(CRYDriver *cryp,
+                                     AESGCMContext *gcmctxp,
+                                     size_t size,
+                                     const uint8_t *in,
+                                     uint8_t *out);
+  cryerror_t cryDecryptAES_GCMUpdate(CRYDriver *cryp,
+                                     AESGCMContext *gcmctxp,
+                                     size_t size,
+                                     const uint8_t *in,
+                                     uint8_t *out);
+  cryerror_t cryAES_GCMFinal(CRYDriver *cryp,
+                             AESGCMContext *gcmctxp,
+                             uint8_t *authtag);
   cryerror_t cryEncryptDES(CRYDriver *cryp,
                            crykey_t key_id,
                            const uint8_t *in,
@@ -282,11 +612,199 @@ extern "C" {
                                const uint8_t *iv);
   cryerror_t crySHA1(CRYDriver *cryp, size_t size,
                      const uint8_t *in, uint8_t *out);
+  cryerror_t crySHA1Init(CRYDriver *cryp, SHA1Context *sha1ctxp);
+  cryerror_t crySHA1Update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                           size_t size, const uint8_t *in);
+  cryerror_t crySHA1Final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                          uint8_t *out);
   cryerror_t crySHA256(CRYDriver *cryp, size_t size,
                        const uint8_t *in, uint8_t *out);
+  cryerror_t crySHA256Init(CRYDriver *cryp, SHA256Context *sha256ctxp);
+  cryerror_t crySHA256Update(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                             size_t size, const uint8_t *in);
+  cryerror_t crySHA256Final(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                            uint8_t *out);
   cryerror_t crySHA512(CRYDriver *cryp, size_t size,
                        const uint8_t *in, uint8_t *out);
+  cryerror_t crySHA512Init(CRYDriver *cryp, SHA512Context *sha512ctxp);
+  cryerror_t crySHA512Update(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                             size_t size, const uint8_t *in);
+  cryerror_t crySHA512Final(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                            uint8_t *out);
   cryerror_t cryTRNG(CRYDriver *cryp, uint8_t *out);
+#if HAL_CRY_USE_ASYNC == TRUE
+  void cryJobObjectInit(cryjob_t *jobp, cryjobcb_t callback, void *arg);
+  void crySubmitJob(CRYDriver *cryp,
+                    cryjob_t *jobp,
+                    cryop_t op,
+                    crykey_t key_id,
+                    size_t size,
+                    const uint8_t *in,
+                    uint8_t *out,
+                    const uint8_t *iv);
+  cryerror_t cryWaitJob(CRYDriver *cryp, cryjob_t *jobp);
+  cryerror_t _cry_job_execute(CRYDriver *cryp, cryjob_t *jobp);
+#if CRY_LLD_SUPPORTS_ASYNC == TRUE
+  void _cry_isr_job_complete(CRYDriver *cryp, cryerror_t err);
+#endif
+#endif
+#if HAL_CRY_USE_FALLBACK == TRUE
+  cryerror_t cry_fallback_loadkey(CRYDriver *cryp,
+                                  cryalgorithm_t algorithm,
+                                  size_t size,
+                                  const uint8_t *keyp);
+  cryerror_t cry_fallback_encrypt_AES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+  cryerror_t cry_fallback_decrypt_AES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+  cryerror_t cry_fallback_encrypt_AES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+  cryerror_t cry_fallback_decrypt_AES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+  cryerror_t cry_fallback_encrypt_AES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_AES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_encrypt_AES_CFB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_AES_CFB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_encrypt_AES_CTR(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_AES_CTR(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_encrypt_AES_GCM(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv,
+                                          size_t aadsize,
+                                          const uint8_t *aad,
+                                          uint8_t *authtag);
+  cryerror_t cry_fallback_decrypt_AES_GCM(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv,
+                                          size_t aadsize,
+                                          const uint8_t *aad,
+                                          uint8_t *authtag);
+  cryerror_t cry_fallback_AES_GCM_init(CRYDriver *cryp,
+                                       crygcmstate_t *gcmp,
+                                       crykey_t key_id,
+                                       const uint8_t *iv);
+  cryerror_t cry_fallback_AES_GCM_update_aad(CRYDriver *cryp,
+                                             crygcmstate_t *gcmp,
+                                             size_t size,
+                                             const uint8_t *aad);
+  cryerror_t cry_fallback_encrypt_AES_GCM_update(CRYDriver *cryp,
+                                                 crygcmstate_t *gcmp,
+                                                 size_t size,
+                                                 const uint8_t *in,
+                                                 uint8_t *out);
+  cryerror_t cry_fallback_decrypt_AES_GCM_update(CRYDriver *cryp,
+                                                 crygcmstate_t *gcmp,
+                                                 size_t size,
+                                                 const uint8_t *in,
+                                                 uint8_t *out);
+  cryerror_t cry_fallback_AES_GCM_final(CRYDriver *cryp,
+                                        crygcmstate_t *gcmp,
+                                        uint8_t *authtag);
+  cryerror_t cry_fallback_encrypt_DES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+  cryerror_t cry_fallback_decrypt_DES(CRYDriver *cryp,
+                                      crykey_t key_id,
+                                      const uint8_t *in,
+                                      uint8_t *out);
+  cryerror_t cry_fallback_encrypt_DES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+  cryerror_t cry_fallback_decrypt_DES_ECB(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out);
+  cryerror_t cry_fallback_encrypt_DES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_decrypt_DES_CBC(CRYDriver *cryp,
+                                          crykey_t key_id,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out,
+                                          const uint8_t *iv);
+  cryerror_t cry_fallback_SHA1(CRYDriver *cryp, size_t size,
+                               const uint8_t *in, uint8_t *out);
+  cryerror_t cry_fallback_SHA1_init(CRYDriver *cryp, crysha32state_t *shap);
+  cryerror_t cry_fallback_SHA1_update(CRYDriver *cryp, crysha32state_t *shap,
+                                      size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_SHA1_final(CRYDriver *cryp, crysha32state_t *shap,
+                                     uint8_t *out);
+  cryerror_t cry_fallback_SHA256(CRYDriver *cryp, size_t size,
+                                 const uint8_t *in, uint8_t *out);
+  cryerror_t cry_fallback_SHA256_init(CRYDriver *cryp,
+                                      crysha32state_t *shap);
+  cryerror_t cry_fallback_SHA256_update(CRYDriver *cryp,
+                                        crysha32state_t *shap,
+                                        size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_SHA256_final(CRYDriver *cryp,
+                                       crysha32state_t *shap,
+                                       uint8_t *out);
+  cryerror_t cry_fallback_SHA512(CRYDriver *cryp, size_t size,
+                                 const uint8_t *in, uint8_t *out);
+  cryerror_t cry_fallback_SHA512_init(CRYDriver *cryp,
+                                      crysha64state_t *shap);
+  cryerror_t cry_fallback_SHA512_update(CRYDriver *cryp,
+                                        crysha64state_t *shap,
+                                        size_t size, const uint8_t *in);
+  cryerror_t cry_fallback_SHA512_final(CRYDriver *cryp,
+                                       crysha64state_t *shap,
+                                       uint8_t *out);
+  cryerror_t cry_fallback_TRNG(CRYDriver *cryp, uint8_t *out);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -46,6 +46,114 @@
 
 #define PAIR(a, b) (((unsigned)(a) << 2U) | (unsigned)(b))
 
+/**
+ * @name    Records checksum
+ * @{
+ */
+#if (MFS_CFG_RECORD_CRC32 == TRUE) || defined(__DOXYGEN__)
+#define MFS_RECORD_CRC_INIT         0xFFFFFFFFU
+#define mfs_record_crc(crc, data, n) crc32(crc, data, n)
+#else
+#define MFS_RECORD_CRC_INIT         0xFFFFU
+#define mfs_record_crc(crc, data, n) crc16(crc, data, n)
+#endif
+/** @} */
+
+/**
+ * @brief   Number of entries to be walked in the records index.
+ */
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+#define MFS_INDEX_SIZE(mfsp)        ((mfsp)->records_count)
+#else
+#define MFS_INDEX_SIZE(mfsp)        MFS_CFG_MAX_RECORDS
+#endif
+
+/**
+ * @brief   Identifier of the record in a records index entry.
+ */
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+#define MFS_INDEX_ID(mfsp, i)       ((mfsp)->descriptors[i].id)
+#else
+#define MFS_INDEX_ID(mfsp, i)       ((mfs_id_t)(i) + 1U)
+#endif
+
+/**
+ * @brief   Space reserved for records still to be moved by the garbage
+ *          collector.
+ */
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+#define MFS_GC_PENDING(mfsp)        ((mfsp)->gc_pending)
+#else
+#define MFS_GC_PENDING(mfsp)        0U
+#endif
+
+/**
+ * @brief   Space available for records in a log sector.
+ */
+#define MFS_LOG_PAYLOAD(mfsp)                                               \
+  ((mfsp)->log_size - (flash_offset_t)sizeof (mfs_sector_header_t))
+
+/**
+ * @brief   Invalid log sector index.
+ */
+#define MFS_LOG_NONE                0xFFFFFFFFU
+
+/**
+ * @brief   Limit of the area where records are appended.
+ */
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+#define MFS_WRITE_LIMIT(mfsp)                                               \
+  (mfs_log_get_offset(mfsp, (mfsp)->log_head) + (mfsp)->log_size)
+#else
+#define MFS_WRITE_LIMIT(mfsp)                                               \
+  (mfs_flash_get_bank_offset(mfsp, (mfsp)->current_bank) +                  \
+   (mfsp)->config->bank_size)
+#endif
+
+/**
+ * @brief   Space available for the records of the whole storage.
+ * @note    In a log-structured storage the space of two sectors is
+ *          reserved for garbage collection.
+ */
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+#define MFS_STORAGE_SIZE(mfsp)                                              \
+  ((flash_offset_t)((mfsp)->config->log_sectors - 2U) *                     \
+   MFS_LOG_PAYLOAD(mfsp))
+#else
+#define MFS_STORAGE_SIZE(mfsp)      ((mfsp)->config->bank_size)
+#endif
+
+/**
+ * @brief   Buffer used for data transfers.
+ */
+#define MFS_STAGING_BUFFER(mfsp)                                            \
+  ((mfsp)->config->buffer != NULL ? (mfsp)->config->buffer :                \
+                                    (mfsp)->buffer.data8)
+
+/**
+ * @brief   Size of the buffer used for data transfers.
+ */
+#define MFS_STAGING_SIZE(mfsp)                                              \
+  ((mfsp)->config->buffer != NULL ? (mfsp)->config->buffer_size :           \
+                                    (size_t)MFS_CFG_BUFFER_SIZE)
+
+/**
+ * @brief   Checks for a valid data header magic.
+ */
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+#define MFS_IS_HEADER_MAGIC(magic)                                          \
+  (((magic) == MFS_HEADER_MAGIC) || ((magic) == MFS_TRANSACTION_MAGIC))
+#else
+#define MFS_IS_HEADER_MAGIC(magic)  ((magic) == MFS_HEADER_MAGIC)
+#endif
+
+/**
+ * @brief   Checks for an identifier reserved to an enabled feature.
+ */
+#define MFS_IS_RESERVED_ID(id)                                              \
+  (((MFS_CFG_INDEX_CHECKPOINT == TRUE) && ((id) == MFS_CHECKPOINT_ID)) ||   \
+   ((MFS_CFG_TRANSACTION_MAX > 0) && ((id) == MFS_TRANSACTION_ID)))
+
 /**
  * @brief   Error check helper.
  */
@@ -64,70 +172,995 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
-static const uint16_t crc16_table[256] = {
-  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-  0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-  0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-  0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-  0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-  0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-  0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-  0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-  0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-  0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-  0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-  0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-  0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-  0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-  0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-  0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-  0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-  0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-  0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-  0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-  0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-  0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-  0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-  0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-  0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-  0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-  0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-  0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-  0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-  0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-  0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+#if !defined(MFS_CFG_CRC16_HOOK) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC16-CCITT look-up tables.
+ * @details Table @p k contains the CRC of each byte value followed by
+ *          @p k zero bytes.
+ */
+static const uint16_t crc16_table[MFS_CFG_CRC_SLICES][256] = {
+  {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+  },
+#if MFS_CFG_CRC_SLICES >= 4
+  {
+    0x0000, 0x3331, 0x6662, 0x5553, 0xCCC4, 0xFFF5, 0xAAA6, 0x9997,
+    0x89A9, 0xBA98, 0xEFCB, 0xDCFA, 0x456D, 0x765C, 0x230F, 0x103E,
+    0x0373, 0x3042, 0x6511, 0x5620, 0xCFB7, 0xFC86, 0xA9D5, 0x9AE4,
+    0x8ADA, 0xB9EB, 0xECB8, 0xDF89, 0x461E, 0x752F, 0x207C, 0x134D,
+    0x06E6, 0x35D7, 0x6084, 0x53B5, 0xCA22, 0xF913, 0xAC40, 0x9F71,
+    0x8F4F, 0xBC7E, 0xE92D, 0xDA1C, 0x438B, 0x70BA, 0x25E9, 0x16D8,
+    0x0595, 0x36A4, 0x63F7, 0x50C6, 0xC951, 0xFA60, 0xAF33, 0x9C02,
+    0x8C3C, 0xBF0D, 0xEA5E, 0xD96F, 0x40F8, 0x73C9, 0x269A, 0x15AB,
+    0x0DCC, 0x3EFD, 0x6BAE, 0x589F, 0xC108, 0xF239, 0xA76A, 0x945B,
+    0x8465, 0xB754, 0xE207, 0xD136, 0x48A1, 0x7B90, 0x2EC3, 0x1DF2,
+    0x0EBF, 0x3D8E, 0x68DD, 0x5BEC, 0xC27B, 0xF14A, 0xA419, 0x9728,
+    0x8716, 0xB427, 0xE174, 0xD245, 0x4BD2, 0x78E3, 0x2DB0, 0x1E81,
+    0x0B2A, 0x381B, 0x6D48, 0x5E79, 0xC7EE, 0xF4DF, 0xA18C, 0x92BD,
+    0x8283, 0xB1B2, 0xE4E1, 0xD7D0, 0x4E47, 0x7D76, 0x2825, 0x1B14,
+    0x0859, 0x3B68, 0x6E3B, 0x5D0A, 0xC49D, 0xF7AC, 0xA2FF, 0x91CE,
+    0x81F0, 0xB2C1, 0xE792, 0xD4A3, 0x4D34, 0x7E05, 0x2B56, 0x1867,
+    0x1B98, 0x28A9, 0x7DFA, 0x4ECB, 0xD75C, 0xE46D, 0xB13E, 0x820F,
+    0x9231, 0xA100, 0xF453, 0xC762, 0x5EF5, 0x6DC4, 0x3897, 0x0BA6,
+    0x18EB, 0x2BDA, 0x7E89, 0x4DB8, 0xD42F, 0xE71E, 0xB24D, 0x817C,
+    0x9142, 0xA273, 0xF720, 0xC411, 0x5D86, 0x6EB7, 0x3BE4, 0x08D5,
+    0x1D7E, 0x2E4F, 0x7B1C, 0x482D, 0xD1BA, 0xE28B, 0xB7D8, 0x84E9,
+    0x94D7, 0xA7E6, 0xF2B5, 0xC184, 0x5813, 0x6B22, 0x3E71, 0x0D40,
+    0x1E0D, 0x2D3C, 0x786F, 0x4B5E, 0xD2C9, 0xE1F8, 0xB4AB, 0x879A,
+    0x97A4, 0xA495, 0xF1C6, 0xC2F7, 0x5B60, 0x6851, 0x3D02, 0x0E33,
+    0x1654, 0x2565, 0x7036, 0x4307, 0xDA90, 0xE9A1, 0xBCF2, 0x8FC3,
+    0x9FFD, 0xACCC, 0xF99F, 0xCAAE, 0x5339, 0x6008, 0x355B, 0x066A,
+    0x1527, 0x2616, 0x7345, 0x4074, 0xD9E3, 0xEAD2, 0xBF81, 0x8CB0,
+    0x9C8E, 0xAFBF, 0xFAEC, 0xC9DD, 0x504A, 0x637B, 0x3628, 0x0519,
+    0x10B2, 0x2383, 0x76D0, 0x45E1, 0xDC76, 0xEF47, 0xBA14, 0x8925,
+    0x991B, 0xAA2A, 0xFF79, 0xCC48, 0x55DF, 0x66EE, 0x33BD, 0x008C,
+    0x13C1, 0x20F0, 0x75A3, 0x4692, 0xDF05, 0xEC34, 0xB967, 0x8A56,
+    0x9A68, 0xA959, 0xFC0A, 0xCF3B, 0x56AC, 0x659D, 0x30CE, 0x03FF
+  },
+  {
+    0x0000, 0x3730, 0x6E60, 0x5950, 0xDCC0, 0xEBF0, 0xB2A0, 0x8590,
+    0xA9A1, 0x9E91, 0xC7C1, 0xF0F1, 0x7561, 0x4251, 0x1B01, 0x2C31,
+    0x4363, 0x7453, 0x2D03, 0x1A33, 0x9FA3, 0xA893, 0xF1C3, 0xC6F3,
+    0xEAC2, 0xDDF2, 0x84A2, 0xB392, 0x3602, 0x0132, 0x5862, 0x6F52,
+    0x86C6, 0xB1F6, 0xE8A6, 0xDF96, 0x5A06, 0x6D36, 0x3466, 0x0356,
+    0x2F67, 0x1857, 0x4107, 0x7637, 0xF3A7, 0xC497, 0x9DC7, 0xAAF7,
+    0xC5A5, 0xF295, 0xABC5, 0x9CF5, 0x1965, 0x2E55, 0x7705, 0x4035,
+    0x6C04, 0x5B34, 0x0264, 0x3554, 0xB0C4, 0x87F4, 0xDEA4, 0xE994,
+    0x1DAD, 0x2A9D, 0x73CD, 0x44FD, 0xC16D, 0xF65D, 0xAF0D, 0x983D,
+    0xB40C, 0x833C, 0xDA6C, 0xED5C, 0x68CC, 0x5FFC, 0x06AC, 0x319C,
+    0x5ECE, 0x69FE, 0x30AE, 0x079E, 0x820E, 0xB53E, 0xEC6E, 0xDB5E,
+    0xF76F, 0xC05F, 0x990F, 0xAE3F, 0x2BAF, 0x1C9F, 0x45CF, 0x72FF,
+    0x9B6B, 0xAC5B, 0xF50B, 0xC23B, 0x47AB, 0x709B, 0x29CB, 0x1EFB,
+    0x32CA, 0x05FA, 0x5CAA, 0x6B9A, 0xEE0A, 0xD93A, 0x806A, 0xB75A,
+    0xD808, 0xEF38, 0xB668, 0x8158, 0x04C8, 0x33F8, 0x6AA8, 0x5D98,
+    0x71A9, 0x4699, 0x1FC9, 0x28F9, 0xAD69, 0x9A59, 0xC309, 0xF439,
+    0x3B5A, 0x0C6A, 0x553A, 0x620A, 0xE79A, 0xD0AA, 0x89FA, 0xBECA,
+    0x92FB, 0xA5CB, 0xFC9B, 0xCBAB, 0x4E3B, 0x790B, 0x205B, 0x176B,
+    0x7839, 0x4F09, 0x1659, 0x2169, 0xA4F9, 0x93C9, 0xCA99, 0xFDA9,
+    0xD198, 0xE6A8, 0xBFF8, 0x88C8, 0x0D58, 0x3A68, 0x6338, 0x5408,
+    0xBD9C, 0x8AAC, 0xD3FC, 0xE4CC, 0x615C, 0x566C, 0x0F3C, 0x380C,
+    0x143D, 0x230D, 0x7A5D, 0x4D6D, 0xC8FD, 0xFFCD, 0xA69D, 0x91AD,
+    0xFEFF, 0xC9CF, 0x909F, 0xA7AF, 0x223F, 0x150F, 0x4C5F, 0x7B6F,
+    0x575E, 0x606E, 0x393E, 0x0E0E, 0x8B9E, 0xBCAE, 0xE5FE, 0xD2CE,
+    0x26F7, 0x11C7, 0x4897, 0x7FA7, 0xFA37, 0xCD07, 0x9457, 0xA367,
+    0x8F56, 0xB866, 0xE136, 0xD606, 0x5396, 0x64A6, 0x3DF6, 0x0AC6,
+    0x6594, 0x52A4, 0x0BF4, 0x3CC4, 0xB954, 0x8E64, 0xD734, 0xE004,
+    0xCC35, 0xFB05, 0xA255, 0x9565, 0x10F5, 0x27C5, 0x7E95, 0x49A5,
+    0xA031, 0x9701, 0xCE51, 0xF961, 0x7CF1, 0x4BC1, 0x1291, 0x25A1,
+    0x0990, 0x3EA0, 0x67F0, 0x50C0, 0xD550, 0xE260, 0xBB30, 0x8C00,
+    0xE352, 0xD462, 0x8D32, 0xBA02, 0x3F92, 0x08A2, 0x51F2, 0x66C2,
+    0x4AF3, 0x7DC3, 0x2493, 0x13A3, 0x9633, 0xA103, 0xF853, 0xCF63
+  },
+  {
+    0x0000, 0x76B4, 0xED68, 0x9BDC, 0xCAF1, 0xBC45, 0x2799, 0x512D,
+    0x85C3, 0xF377, 0x68AB, 0x1E1F, 0x4F32, 0x3986, 0xA25A, 0xD4EE,
+    0x1BA7, 0x6D13, 0xF6CF, 0x807B, 0xD156, 0xA7E2, 0x3C3E, 0x4A8A,
+    0x9E64, 0xE8D0, 0x730C, 0x05B8, 0x5495, 0x2221, 0xB9FD, 0xCF49,
+    0x374E, 0x41FA, 0xDA26, 0xAC92, 0xFDBF, 0x8B0B, 0x10D7, 0x6663,
+    0xB28D, 0xC439, 0x5FE5, 0x2951, 0x787C, 0x0EC8, 0x9514, 0xE3A0,
+    0x2CE9, 0x5A5D, 0xC181, 0xB735, 0xE618, 0x90AC, 0x0B70, 0x7DC4,
+    0xA92A, 0xDF9E, 0x4442, 0x32F6, 0x63DB, 0x156F, 0x8EB3, 0xF807,
+    0x6E9C, 0x1828, 0x83F4, 0xF540, 0xA46D, 0xD2D9, 0x4905, 0x3FB1,
+    0xEB5F, 0x9DEB, 0x0637, 0x7083, 0x21AE, 0x571A, 0xCCC6, 0xBA72,
+    0x753B, 0x038F, 0x9853, 0xEEE7, 0xBFCA, 0xC97E, 0x52A2, 0x2416,
+    0xF0F8, 0x864C, 0x1D90, 0x6B24, 0x3A09, 0x4CBD, 0xD761, 0xA1D5,
+    0x59D2, 0x2F66, 0xB4BA, 0xC20E, 0x9323, 0xE597, 0x7E4B, 0x08FF,
+    0xDC11, 0xAAA5, 0x3179, 0x47CD, 0x16E0, 0x6054, 0xFB88, 0x8D3C,
+    0x4275, 0x34C1, 0xAF1D, 0xD9A9, 0x8884, 0xFE30, 0x65EC, 0x1358,
+    0xC7B6, 0xB102, 0x2ADE, 0x5C6A, 0x0D47, 0x7BF3, 0xE02F, 0x969B,
+    0xDD38, 0xAB8C, 0x3050, 0x46E4, 0x17C9, 0x617D, 0xFAA1, 0x8C15,
+    0x58FB, 0x2E4F, 0xB593, 0xC327, 0x920A, 0xE4BE, 0x7F62, 0x09D6,
+    0xC69F, 0xB02B, 0x2BF7, 0x5D43, 0x0C6E, 0x7ADA, 0xE106, 0x97B2,
+    0x435C, 0x35E8, 0xAE34, 0xD880, 0x89AD, 0xFF19, 0x64C5, 0x1271,
+    0xEA76, 0x9CC2, 0x071E, 0x71AA, 0x2087, 0x5633, 0xCDEF, 0xBB5B,
+    0x6FB5, 0x1901, 0x82DD, 0xF469, 0xA544, 0xD3F0, 0x482C, 0x3E98,
+    0xF1D1, 0x8765, 0x1CB9, 0x6A0D, 0x3B20, 0x4D94, 0xD648, 0xA0FC,
+    0x7412, 0x02A6, 0x997A, 0xEFCE, 0xBEE3, 0xC857, 0x538B, 0x253F,
+    0xB3A4, 0xC510, 0x5ECC, 0x2878, 0x7955, 0x0FE1, 0x943D, 0xE289,
+    0x3667, 0x40D3, 0xDB0F, 0xADBB, 0xFC96, 0x8A22, 0x11FE, 0x674A,
+    0xA803, 0xDEB7, 0x456B, 0x33DF, 0x62F2, 0x1446, 0x8F9A, 0xF92E,
+    0x2DC0, 0x5B74, 0xC0A8, 0xB61C, 0xE731, 0x9185, 0x0A59, 0x7CED,
+    0x84EA, 0xF25E, 0x6982, 0x1F36, 0x4E1B, 0x38AF, 0xA373, 0xD5C7,
+    0x0129, 0x779D, 0xEC41, 0x9AF5, 0xCBD8, 0xBD6C, 0x26B0, 0x5004,
+    0x9F4D, 0xE9F9, 0x7225, 0x0491, 0x55BC, 0x2308, 0xB8D4, 0xCE60,
+    0x1A8E, 0x6C3A, 0xF7E6, 0x8152, 0xD07F, 0xA6CB, 0x3D17, 0x4BA3
+  },
+#if MFS_CFG_CRC_SLICES >= 8
+  {
+    0x0000, 0xAA51, 0x4483, 0xEED2, 0x8906, 0x2357, 0xCD85, 0x67D4,
+    0x022D, 0xA87C, 0x46AE, 0xECFF, 0x8B2B, 0x217A, 0xCFA8, 0x65F9,
+    0x045A, 0xAE0B, 0x40D9, 0xEA88, 0x8D5C, 0x270D, 0xC9DF, 0x638E,
+    0x0677, 0xAC26, 0x42F4, 0xE8A5, 0x8F71, 0x2520, 0xCBF2, 0x61A3,
+    0x08B4, 0xA2E5, 0x4C37, 0xE666, 0x81B2, 0x2BE3, 0xC531, 0x6F60,
+    0x0A99, 0xA0C8, 0x4E1A, 0xE44B, 0x839F, 0x29CE, 0xC71C, 0x6D4D,
+    0x0CEE, 0xA6BF, 0x486D, 0xE23C, 0x85E8, 0x2FB9, 0xC16B, 0x6B3A,
+    0x0EC3, 0xA492, 0x4A40, 0xE011, 0x87C5, 0x2D94, 0xC346, 0x6917,
+    0x1168, 0xBB39, 0x55EB, 0xFFBA, 0x986E, 0x323F, 0xDCED, 0x76BC,
+    0x1345, 0xB914, 0x57C6, 0xFD97, 0x9A43, 0x3012, 0xDEC0, 0x7491,
+    0x1532, 0xBF63, 0x51B1, 0xFBE0, 0x9C34, 0x3665, 0xD8B7, 0x72E6,
+    0x171F, 0xBD4E, 0x539C, 0xF9CD, 0x9E19, 0x3448, 0xDA9A, 0x70CB,
+    0x19DC, 0xB38D, 0x5D5F, 0xF70E, 0x90DA, 0x3A8B, 0xD459, 0x7E08,
+    0x1BF1, 0xB1A0, 0x5F72, 0xF523, 0x92F7, 0x38A6, 0xD674, 0x7C25,
+    0x1D86, 0xB7D7, 0x5905, 0xF354, 0x9480, 0x3ED1, 0xD003, 0x7A52,
+    0x1FAB, 0xB5FA, 0x5B28, 0xF179, 0x96AD, 0x3CFC, 0xD22E, 0x787F,
+    0x22D0, 0x8881, 0x6653, 0xCC02, 0xABD6, 0x0187, 0xEF55, 0x4504,
+    0x20FD, 0x8AAC, 0x647E, 0xCE2F, 0xA9FB, 0x03AA, 0xED78, 0x4729,
+    0x268A, 0x8CDB, 0x6209, 0xC858, 0xAF8C, 0x05DD, 0xEB0F, 0x415E,
+    0x24A7, 0x8EF6, 0x6024, 0xCA75, 0xADA1, 0x07F0, 0xE922, 0x4373,
+    0x2A64, 0x8035, 0x6EE7, 0xC4B6, 0xA362, 0x0933, 0xE7E1, 0x4DB0,
+    0x2849, 0x8218, 0x6CCA, 0xC69B, 0xA14F, 0x0B1E, 0xE5CC, 0x4F9D,
+    0x2E3E, 0x846F, 0x6ABD, 0xC0EC, 0xA738, 0x0D69, 0xE3BB, 0x49EA,
+    0x2C13, 0x8642, 0x6890, 0xC2C1, 0xA515, 0x0F44, 0xE196, 0x4BC7,
+    0x33B8, 0x99E9, 0x773B, 0xDD6A, 0xBABE, 0x10EF, 0xFE3D, 0x546C,
+    0x3195, 0x9BC4, 0x7516, 0xDF47, 0xB893, 0x12C2, 0xFC10, 0x5641,
+    0x37E2, 0x9DB3, 0x7361, 0xD930, 0xBEE4, 0x14B5, 0xFA67, 0x5036,
+    0x35CF, 0x9F9E, 0x714C, 0xDB1D, 0xBCC9, 0x1698, 0xF84A, 0x521B,
+    0x3B0C, 0x915D, 0x7F8F, 0xD5DE, 0xB20A, 0x185B, 0xF689, 0x5CD8,
+    0x3921, 0x9370, 0x7DA2, 0xD7F3, 0xB027, 0x1A76, 0xF4A4, 0x5EF5,
+    0x3F56, 0x9507, 0x7BD5, 0xD184, 0xB650, 0x1C01, 0xF2D3, 0x5882,
+    0x3D7B, 0x972A, 0x79F8, 0xD3A9, 0xB47D, 0x1E2C, 0xF0FE, 0x5AAF
+  },
+  {
+    0x0000, 0x45A0, 0x8B40, 0xCEE0, 0x06A1, 0x4301, 0x8DE1, 0xC841,
+    0x0D42, 0x48E2, 0x8602, 0xC3A2, 0x0BE3, 0x4E43, 0x80A3, 0xC503,
+    0x1A84, 0x5F24, 0x91C4, 0xD464, 0x1C25, 0x5985, 0x9765, 0xD2C5,
+    0x17C6, 0x5266, 0x9C86, 0xD926, 0x1167, 0x54C7, 0x9A27, 0xDF87,
+    0x3508, 0x70A8, 0xBE48, 0xFBE8, 0x33A9, 0x7609, 0xB8E9, 0xFD49,
+    0x384A, 0x7DEA, 0xB30A, 0xF6AA, 0x3EEB, 0x7B4B, 0xB5AB, 0xF00B,
+    0x2F8C, 0x6A2C, 0xA4CC, 0xE16C, 0x292D, 0x6C8D, 0xA26D, 0xE7CD,
+    0x22CE, 0x676E, 0xA98E, 0xEC2E, 0x246F, 0x61CF, 0xAF2F, 0xEA8F,
+    0x6A10, 0x2FB0, 0xE150, 0xA4F0, 0x6CB1, 0x2911, 0xE7F1, 0xA251,
+    0x6752, 0x22F2, 0xEC12, 0xA9B2, 0x61F3, 0x2453, 0xEAB3, 0xAF13,
+    0x7094, 0x3534, 0xFBD4, 0xBE74, 0x7635, 0x3395, 0xFD75, 0xB8D5,
+    0x7DD6, 0x3876, 0xF696, 0xB336, 0x7B77, 0x3ED7, 0xF037, 0xB597,
+    0x5F18, 0x1AB8, 0xD458, 0x91F8, 0x59B9, 0x1C19, 0xD2F9, 0x9759,
+    0x525A, 0x17FA, 0xD91A, 0x9CBA, 0x54FB, 0x115B, 0xDFBB, 0x9A1B,
+    0x459C, 0x003C, 0xCEDC, 0x8B7C, 0x433D, 0x069D, 0xC87D, 0x8DDD,
+    0x48DE, 0x0D7E, 0xC39E, 0x863E, 0x4E7F, 0x0BDF, 0xC53F, 0x809F,
+    0xD420, 0x9180, 0x5F60, 0x1AC0, 0xD281, 0x9721, 0x59C1, 0x1C61,
+    0xD962, 0x9CC2, 0x5222, 0x1782, 0xDFC3, 0x9A63, 0x5483, 0x1123,
+    0xCEA4, 0x8B04, 0x45E4, 0x0044, 0xC805, 0x8DA5, 0x4345, 0x06E5,
+    0xC3E6, 0x8646, 0x48A6, 0x0D06, 0xC547, 0x80E7, 0x4E07, 0x0BA7,
+    0xE128, 0xA488, 0x6A68, 0x2FC8, 0xE789, 0xA229, 0x6CC9, 0x2969,
+    0xEC6A, 0xA9CA, 0x672A, 0x228A, 0xEACB, 0xAF6B, 0x618B, 0x242B,
+    0xFBAC, 0xBE0C, 0x70EC, 0x354C, 0xFD0D, 0xB8AD, 0x764D, 0x33ED,
+    0xF6EE, 0xB34E, 0x7DAE, 0x380E, 0xF04F, 0xB5EF, 0x7B0F, 0x3EAF,
+    0xBE30, 0xFB90, 0x3570, 0x70D0, 0xB891, 0xFD31, 0x33D1, 0x7671,
+    0xB372, 0xF6D2, 0x3832, 0x7D92, 0xB5D3, 0xF073, 0x3E93, 0x7B33,
+    0xA4B4, 0xE114, 0x2FF4, 0x6A54, 0xA215, 0xE7B5, 0x2955, 0x6CF5,
+    0xA9F6, 0xEC56, 0x22B6, 0x6716, 0xAF57, 0xEAF7, 0x2417, 0x61B7,
+    0x8B38, 0xCE98, 0x0078, 0x45D8, 0x8D99, 0xC839, 0x06D9, 0x4379,
+    0x867A, 0xC3DA, 0x0D3A, 0x489A, 0x80DB, 0xC57B, 0x0B9B, 0x4E3B,
+    0x91BC, 0xD41C, 0x1AFC, 0x5F5C, 0x971D, 0xD2BD, 0x1C5D, 0x59FD,
+    0x9CFE, 0xD95E, 0x17BE, 0x521E, 0x9A5F, 0xDFFF, 0x111F, 0x54BF
+  },
+  {
+    0x0000, 0xB861, 0x60E3, 0xD882, 0xC1C6, 0x79A7, 0xA125, 0x1944,
+    0x93AD, 0x2BCC, 0xF34E, 0x4B2F, 0x526B, 0xEA0A, 0x3288, 0x8AE9,
+    0x377B, 0x8F1A, 0x5798, 0xEFF9, 0xF6BD, 0x4EDC, 0x965E, 0x2E3F,
+    0xA4D6, 0x1CB7, 0xC435, 0x7C54, 0x6510, 0xDD71, 0x05F3, 0xBD92,
+    0x6EF6, 0xD697, 0x0E15, 0xB674, 0xAF30, 0x1751, 0xCFD3, 0x77B2,
+    0xFD5B, 0x453A, 0x9DB8, 0x25D9, 0x3C9D, 0x84FC, 0x5C7E, 0xE41F,
+    0x598D, 0xE1EC, 0x396E, 0x810F, 0x984B, 0x202A, 0xF8A8, 0x40C9,
+    0xCA20, 0x7241, 0xAAC3, 0x12A2, 0x0BE6, 0xB387, 0x6B05, 0xD364,
+    0xDDEC, 0x658D, 0xBD0F, 0x056E, 0x1C2A, 0xA44B, 0x7CC9, 0xC4A8,
+    0x4E41, 0xF620, 0x2EA2, 0x96C3, 0x8F87, 0x37E6, 0xEF64, 0x5705,
+    0xEA97, 0x52F6, 0x8A74, 0x3215, 0x2B51, 0x9330, 0x4BB2, 0xF3D3,
+    0x793A, 0xC15B, 0x19D9, 0xA1B8, 0xB8FC, 0x009D, 0xD81F, 0x607E,
+    0xB31A, 0x0B7B, 0xD3F9, 0x6B98, 0x72DC, 0xCABD, 0x123F, 0xAA5E,
+    0x20B7, 0x98D6, 0x4054, 0xF835, 0xE171, 0x5910, 0x8192, 0x39F3,
+    0x8461, 0x3C00, 0xE482, 0x5CE3, 0x45A7, 0xFDC6, 0x2544, 0x9D25,
+    0x17CC, 0xAFAD, 0x772F, 0xCF4E, 0xD60A, 0x6E6B, 0xB6E9, 0x0E88,
+    0xABF9, 0x1398, 0xCB1A, 0x737B, 0x6A3F, 0xD25E, 0x0ADC, 0xB2BD,
+    0x3854, 0x8035, 0x58B7, 0xE0D6, 0xF992, 0x41F3, 0x9971, 0x2110,
+    0x9C82, 0x24E3, 0xFC61, 0x4400, 0x5D44, 0xE525, 0x3DA7, 0x85C6,
+    0x0F2F, 0xB74E, 0x6FCC, 0xD7AD, 0xCEE9, 0x7688, 0xAE0A, 0x166B,
+    0xC50F, 0x7D6E, 0xA5EC, 0x1D8D, 0x04C9, 0xBCA8, 0x642A, 0xDC4B,
+    0x56A2, 0xEEC3, 0x3641, 0x8E20, 0x9764, 0x2F05, 0xF787, 0x4FE6,
+    0xF274, 0x4A15, 0x9297, 0x2AF6, 0x33B2, 0x8BD3, 0x5351, 0xEB30,
+    0x61D9, 0xD9B8, 0x013A, 0xB95B, 0xA01F, 0x187E, 0xC0FC, 0x789D,
+    0x7615, 0xCE74, 0x16F6, 0xAE97, 0xB7D3, 0x0FB2, 0xD730, 0x6F51,
+    0xE5B8, 0x5DD9, 0x855B, 0x3D3A, 0x247E, 0x9C1F, 0x449D, 0xFCFC,
+    0x416E, 0xF90F, 0x218D, 0x99EC, 0x80A8, 0x38C9, 0xE04B, 0x582A,
+    0xD2C3, 0x6AA2, 0xB220, 0x0A41, 0x1305, 0xAB64, 0x73E6, 0xCB87,
+    0x18E3, 0xA082, 0x7800, 0xC061, 0xD925, 0x6144, 0xB9C6, 0x01A7,
+    0x8B4E, 0x332F, 0xEBAD, 0x53CC, 0x4A88, 0xF2E9, 0x2A6B, 0x920A,
+    0x2F98, 0x97F9, 0x4F7B, 0xF71A, 0xEE5E, 0x563F, 0x8EBD, 0x36DC,
+    0xBC35, 0x0454, 0xDCD6, 0x64B7, 0x7DF3, 0xC592, 0x1D10, 0xA571
+  },
+  {
+    0x0000, 0x47D3, 0x8FA6, 0xC875, 0x0F6D, 0x48BE, 0x80CB, 0xC718,
+    0x1EDA, 0x5909, 0x917C, 0xD6AF, 0x11B7, 0x5664, 0x9E11, 0xD9C2,
+    0x3DB4, 0x7A67, 0xB212, 0xF5C1, 0x32D9, 0x750A, 0xBD7F, 0xFAAC,
+    0x236E, 0x64BD, 0xACC8, 0xEB1B, 0x2C03, 0x6BD0, 0xA3A5, 0xE476,
+    0x7B68, 0x3CBB, 0xF4CE, 0xB31D, 0x7405, 0x33D6, 0xFBA3, 0xBC70,
+    0x65B2, 0x2261, 0xEA14, 0xADC7, 0x6ADF, 0x2D0C, 0xE579, 0xA2AA,
+    0x46DC, 0x010F, 0xC97A, 0x8EA9, 0x49B1, 0x0E62, 0xC617, 0x81C4,
+    0x5806, 0x1FD5, 0xD7A0, 0x9073, 0x576B, 0x10B8, 0xD8CD, 0x9F1E,
+    0xF6D0, 0xB103, 0x7976, 0x3EA5, 0xF9BD, 0xBE6E, 0x761B, 0x31C8,
+    0xE80A, 0xAFD9, 0x67AC, 0x207F, 0xE767, 0xA0B4, 0x68C1, 0x2F12,
+    0xCB64, 0x8CB7, 0x44C2, 0x0311, 0xC409, 0x83DA, 0x4BAF, 0x0C7C,
+    0xD5BE, 0x926D, 0x5A18, 0x1DCB, 0xDAD3, 0x9D00, 0x5575, 0x12A6,
+    0x8DB8, 0xCA6B, 0x021E, 0x45CD, 0x82D5, 0xC506, 0x0D73, 0x4AA0,
+    0x9362, 0xD4B1, 0x1CC4, 0x5B17, 0x9C0F, 0xDBDC, 0x13A9, 0x547A,
+    0xB00C, 0xF7DF, 0x3FAA, 0x7879, 0xBF61, 0xF8B2, 0x30C7, 0x7714,
+    0xAED6, 0xE905, 0x2170, 0x66A3, 0xA1BB, 0xE668, 0x2E1D, 0x69CE,
+    0xFD81, 0xBA52, 0x7227, 0x35F4, 0xF2EC, 0xB53F, 0x7D4A, 0x3A99,
+    0xE35B, 0xA488, 0x6CFD, 0x2B2E, 0xEC36, 0xABE5, 0x6390, 0x2443,
+    0xC035, 0x87E6, 0x4F93, 0x0840, 0xCF58, 0x888B, 0x40FE, 0x072D,
+    0xDEEF, 0x993C, 0x5149, 0x169A, 0xD182, 0x9651, 0x5E24, 0x19F7,
+    0x86E9, 0xC13A, 0x094F, 0x4E9C, 0x8984, 0xCE57, 0x0622, 0x41F1,
+    0x9833, 0xDFE0, 0x1795, 0x5046, 0x975E, 0xD08D, 0x18F8, 0x5F2B,
+    0xBB5D, 0xFC8E, 0x34FB, 0x7328, 0xB430, 0xF3E3, 0x3B96, 0x7C45,
+    0xA587, 0xE254, 0x2A21, 0x6DF2, 0xAAEA, 0xED39, 0x254C, 0x629F,
+    0x0B51, 0x4C82, 0x84F7, 0xC324, 0x043C, 0x43EF, 0x8B9A, 0xCC49,
+    0x158B, 0x5258, 0x9A2D, 0xDDFE, 0x1AE6, 0x5D35, 0x9540, 0xD293,
+    0x36E5, 0x7136, 0xB943, 0xFE90, 0x3988, 0x7E5B, 0xB62E, 0xF1FD,
+    0x283F, 0x6FEC, 0xA799, 0xE04A, 0x2752, 0x6081, 0xA8F4, 0xEF27,
+    0x7039, 0x37EA, 0xFF9F, 0xB84C, 0x7F54, 0x3887, 0xF0F2, 0xB721,
+    0x6EE3, 0x2930, 0xE145, 0xA696, 0x618E, 0x265D, 0xEE28, 0xA9FB,
+    0x4D8D, 0x0A5E, 0xC22B, 0x85F8, 0x42E0, 0x0533, 0xCD46, 0x8A95,
+    0x5357, 0x1484, 0xDCF1, 0x9B22, 0x5C3A, 0x1BE9, 0xD39C, 0x944F
+  }
+#endif
+#endif
+};
+#endif
+
+#if ((MFS_CFG_RECORD_CRC32 == TRUE) && !defined(MFS_CFG_CRC32_HOOK)) ||     \
+    defined(__DOXYGEN__)
+/**
+ * @brief   CRC-32/MPEG-2 look-up tables.
+ * @details Table @p k contains the CRC of each byte value followed by
+ *          @p k zero bytes.
+ */
+static const uint32_t crc32_table[MFS_CFG_CRC_SLICES][256] = {
+  {
+    0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B,
+    0x1A864DB2, 0x1E475005, 0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61,
+    0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD, 0x4C11DB70, 0x48D0C6C7,
+    0x4593E01E, 0x4152FDA9, 0x5F15ADAC, 0x5BD4B01B, 0x569796C2, 0x52568B75,
+    0x6A1936C8, 0x6ED82B7F, 0x639B0DA6, 0x675A1011, 0x791D4014, 0x7DDC5DA3,
+    0x709F7B7A, 0x745E66CD, 0x9823B6E0, 0x9CE2AB57, 0x91A18D8E, 0x95609039,
+    0x8B27C03C, 0x8FE6DD8B, 0x82A5FB52, 0x8664E6E5, 0xBE2B5B58, 0xBAEA46EF,
+    0xB7A96036, 0xB3687D81, 0xAD2F2D84, 0xA9EE3033, 0xA4AD16EA, 0xA06C0B5D,
+    0xD4326D90, 0xD0F37027, 0xDDB056FE, 0xD9714B49, 0xC7361B4C, 0xC3F706FB,
+    0xCEB42022, 0xCA753D95, 0xF23A8028, 0xF6FB9D9F, 0xFBB8BB46, 0xFF79A6F1,
+    0xE13EF6F4, 0xE5FFEB43, 0xE8BCCD9A, 0xEC7DD02D, 0x34867077, 0x30476DC0,
+    0x3D044B19, 0x39C556AE, 0x278206AB, 0x23431B1C, 0x2E003DC5, 0x2AC12072,
+    0x128E9DCF, 0x164F8078, 0x1B0CA6A1, 0x1FCDBB16, 0x018AEB13, 0x054BF6A4,
+    0x0808D07D, 0x0CC9CDCA, 0x7897AB07, 0x7C56B6B0, 0x71159069, 0x75D48DDE,
+    0x6B93DDDB, 0x6F52C06C, 0x6211E6B5, 0x66D0FB02, 0x5E9F46BF, 0x5A5E5B08,
+    0x571D7DD1, 0x53DC6066, 0x4D9B3063, 0x495A2DD4, 0x44190B0D, 0x40D816BA,
+    0xACA5C697, 0xA864DB20, 0xA527FDF9, 0xA1E6E04E, 0xBFA1B04B, 0xBB60ADFC,
+    0xB6238B25, 0xB2E29692, 0x8AAD2B2F, 0x8E6C3698, 0x832F1041, 0x87EE0DF6,
+    0x99A95DF3, 0x9D684044, 0x902B669D, 0x94EA7B2A, 0xE0B41DE7, 0xE4750050,
+    0xE9362689, 0xEDF73B3E, 0xF3B06B3B, 0xF771768C, 0xFA325055, 0xFEF34DE2,
+    0xC6BCF05F, 0xC27DEDE8, 0xCF3ECB31, 0xCBFFD686, 0xD5B88683, 0xD1799B34,
+    0xDC3ABDED, 0xD8FBA05A, 0x690CE0EE, 0x6DCDFD59, 0x608EDB80, 0x644FC637,
+    0x7A089632, 0x7EC98B85, 0x738AAD5C, 0x774BB0EB, 0x4F040D56, 0x4BC510E1,
+    0x46863638, 0x42472B8F, 0x5C007B8A, 0x58C1663D, 0x558240E4, 0x51435D53,
+    0x251D3B9E, 0x21DC2629, 0x2C9F00F0, 0x285E1D47, 0x36194D42, 0x32D850F5,
+    0x3F9B762C, 0x3B5A6B9B, 0x0315D626, 0x07D4CB91, 0x0A97ED48, 0x0E56F0FF,
+    0x1011A0FA, 0x14D0BD4D, 0x19939B94, 0x1D528623, 0xF12F560E, 0xF5EE4BB9,
+    0xF8AD6D60, 0xFC6C70D7, 0xE22B20D2, 0xE6EA3D65, 0xEBA91BBC, 0xEF68060B,
+    0xD727BBB6, 0xD3E6A601, 0xDEA580D8, 0xDA649D6F, 0xC423CD6A, 0xC0E2D0DD,
+    0xCDA1F604, 0xC960EBB3, 0xBD3E8D7E, 0xB9FF90C9, 0xB4BCB610, 0xB07DABA7,
+    0xAE3AFBA2, 0xAAFBE615, 0xA7B8C0CC, 0xA379DD7B, 0x9B3660C6, 0x9FF77D71,
+    0x92B45BA8, 0x9675461F, 0x8832161A, 0x8CF30BAD, 0x81B02D74, 0x857130C3,
+    0x5D8A9099, 0x594B8D2E, 0x5408ABF7, 0x50C9B640, 0x4E8EE645, 0x4A4FFBF2,
+    0x470CDD2B, 0x43CDC09C, 0x7B827D21, 0x7F436096, 0x7200464F, 0x76C15BF8,
+    0x68860BFD, 0x6C47164A, 0x61043093, 0x65C52D24, 0x119B4BE9, 0x155A565E,
+    0x18197087, 0x1CD86D30, 0x029F3D35, 0x065E2082, 0x0B1D065B, 0x0FDC1BEC,
+    0x3793A651, 0x3352BBE6, 0x3E119D3F, 0x3AD08088, 0x2497D08D, 0x2056CD3A,
+    0x2D15EBE3, 0x29D4F654, 0xC5A92679, 0xC1683BCE, 0xCC2B1D17, 0xC8EA00A0,
+    0xD6AD50A5, 0xD26C4D12, 0xDF2F6BCB, 0xDBEE767C, 0xE3A1CBC1, 0xE760D676,
+    0xEA23F0AF, 0xEEE2ED18, 0xF0A5BD1D, 0xF464A0AA, 0xF9278673, 0xFDE69BC4,
+    0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662,
+    0x933EB0BB, 0x97FFAD0C, 0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668,
+    0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4
+  },
+#if MFS_CFG_CRC_SLICES >= 4
+  {
+    0x00000000, 0xD219C1DC, 0xA0F29E0F, 0x72EB5FD3, 0x452421A9, 0x973DE075,
+    0xE5D6BFA6, 0x37CF7E7A, 0x8A484352, 0x5851828E, 0x2ABADD5D, 0xF8A31C81,
+    0xCF6C62FB, 0x1D75A327, 0x6F9EFCF4, 0xBD873D28, 0x10519B13, 0xC2485ACF,
+    0xB0A3051C, 0x62BAC4C0, 0x5575BABA, 0x876C7B66, 0xF58724B5, 0x279EE569,
+    0x9A19D841, 0x4800199D, 0x3AEB464E, 0xE8F28792, 0xDF3DF9E8, 0x0D243834,
+    0x7FCF67E7, 0xADD6A63B, 0x20A33626, 0xF2BAF7FA, 0x8051A829, 0x524869F5,
+    0x6587178F, 0xB79ED653, 0xC5758980, 0x176C485C, 0xAAEB7574, 0x78F2B4A8,
+    0x0A19EB7B, 0xD8002AA7, 0xEFCF54DD, 0x3DD69501, 0x4F3DCAD2, 0x9D240B0E,
+    0x30F2AD35, 0xE2EB6CE9, 0x9000333A, 0x4219F2E6, 0x75D68C9C, 0xA7CF4D40,
+    0xD5241293, 0x073DD34F, 0xBABAEE67, 0x68A32FBB, 0x1A487068, 0xC851B1B4,
+    0xFF9ECFCE, 0x2D870E12, 0x5F6C51C1, 0x8D75901D, 0x41466C4C, 0x935FAD90,
+    0xE1B4F243, 0x33AD339F, 0x04624DE5, 0xD67B8C39, 0xA490D3EA, 0x76891236,
+    0xCB0E2F1E, 0x1917EEC2, 0x6BFCB111, 0xB9E570CD, 0x8E2A0EB7, 0x5C33CF6B,
+    0x2ED890B8, 0xFCC15164, 0x5117F75F, 0x830E3683, 0xF1E56950, 0x23FCA88C,
+    0x1433D6F6, 0xC62A172A, 0xB4C148F9, 0x66D88925, 0xDB5FB40D, 0x094675D1,
+    0x7BAD2A02, 0xA9B4EBDE, 0x9E7B95A4, 0x4C625478, 0x3E890BAB, 0xEC90CA77,
+    0x61E55A6A, 0xB3FC9BB6, 0xC117C465, 0x130E05B9, 0x24C17BC3, 0xF6D8BA1F,
+    0x8433E5CC, 0x562A2410, 0xEBAD1938, 0x39B4D8E4, 0x4B5F8737, 0x994646EB,
+    0xAE893891, 0x7C90F94D, 0x0E7BA69E, 0xDC626742, 0x71B4C179, 0xA3AD00A5,
+    0xD1465F76, 0x035F9EAA, 0x3490E0D0, 0xE689210C, 0x94627EDF, 0x467BBF03,
+    0xFBFC822B, 0x29E543F7, 0x5B0E1C24, 0x8917DDF8, 0xBED8A382, 0x6CC1625E,
+    0x1E2A3D8D, 0xCC33FC51, 0x828CD898, 0x50951944, 0x227E4697, 0xF067874B,
+    0xC7A8F931, 0x15B138ED, 0x675A673E, 0xB543A6E2, 0x08C49BCA, 0xDADD5A16,
+    0xA83605C5, 0x7A2FC419, 0x4DE0BA63, 0x9FF97BBF, 0xED12246C, 0x3F0BE5B0,
+    0x92DD438B, 0x40C48257, 0x322FDD84, 0xE0361C58, 0xD7F96222, 0x05E0A3FE,
+    0x770BFC2D, 0xA5123DF1, 0x189500D9, 0xCA8CC105, 0xB8679ED6, 0x6A7E5F0A,
+    0x5DB12170, 0x8FA8E0AC, 0xFD43BF7F, 0x2F5A7EA3, 0xA22FEEBE, 0x70362F62,
+    0x02DD70B1, 0xD0C4B16D, 0xE70BCF17, 0x35120ECB, 0x47F95118, 0x95E090C4,
+    0x2867ADEC, 0xFA7E6C30, 0x889533E3, 0x5A8CF23F, 0x6D438C45, 0xBF5A4D99,
+    0xCDB1124A, 0x1FA8D396, 0xB27E75AD, 0x6067B471, 0x128CEBA2, 0xC0952A7E,
+    0xF75A5404, 0x254395D8, 0x57A8CA0B, 0x85B10BD7, 0x383636FF, 0xEA2FF723,
+    0x98C4A8F0, 0x4ADD692C, 0x7D121756, 0xAF0BD68A, 0xDDE08959, 0x0FF94885,
+    0xC3CAB4D4, 0x11D37508, 0x63382ADB, 0xB121EB07, 0x86EE957D, 0x54F754A1,
+    0x261C0B72, 0xF405CAAE, 0x4982F786, 0x9B9B365A, 0xE9706989, 0x3B69A855,
+    0x0CA6D62F, 0xDEBF17F3, 0xAC544820, 0x7E4D89FC, 0xD39B2FC7, 0x0182EE1B,
+    0x7369B1C8, 0xA1707014, 0x96BF0E6E, 0x44A6CFB2, 0x364D9061, 0xE45451BD,
+    0x59D36C95, 0x8BCAAD49, 0xF921F29A, 0x2B383346, 0x1CF74D3C, 0xCEEE8CE0,
+    0xBC05D333, 0x6E1C12EF, 0xE36982F2, 0x3170432E, 0x439B1CFD, 0x9182DD21,
+    0xA64DA35B, 0x74546287, 0x06BF3D54, 0xD4A6FC88, 0x6921C1A0, 0xBB38007C,
+    0xC9D35FAF, 0x1BCA9E73, 0x2C05E009, 0xFE1C21D5, 0x8CF77E06, 0x5EEEBFDA,
+    0xF33819E1, 0x2121D83D, 0x53CA87EE, 0x81D34632, 0xB61C3848, 0x6405F994,
+    0x16EEA647, 0xC4F7679B, 0x79705AB3, 0xAB699B6F, 0xD982C4BC, 0x0B9B0560,
+    0x3C547B1A, 0xEE4DBAC6, 0x9CA6E515, 0x4EBF24C9
+  },
+  {
+    0x00000000, 0x01D8AC87, 0x03B1590E, 0x0269F589, 0x0762B21C, 0x06BA1E9B,
+    0x04D3EB12, 0x050B4795, 0x0EC56438, 0x0F1DC8BF, 0x0D743D36, 0x0CAC91B1,
+    0x09A7D624, 0x087F7AA3, 0x0A168F2A, 0x0BCE23AD, 0x1D8AC870, 0x1C5264F7,
+    0x1E3B917E, 0x1FE33DF9, 0x1AE87A6C, 0x1B30D6EB, 0x19592362, 0x18818FE5,
+    0x134FAC48, 0x129700CF, 0x10FEF546, 0x112659C1, 0x142D1E54, 0x15F5B2D3,
+    0x179C475A, 0x1644EBDD, 0x3B1590E0, 0x3ACD3C67, 0x38A4C9EE, 0x397C6569,
+    0x3C7722FC, 0x3DAF8E7B, 0x3FC67BF2, 0x3E1ED775, 0x35D0F4D8, 0x3408585F,
+    0x3661ADD6, 0x37B90151, 0x32B246C4, 0x336AEA43, 0x31031FCA, 0x30DBB34D,
+    0x269F5890, 0x2747F417, 0x252E019E, 0x24F6AD19, 0x21FDEA8C, 0x2025460B,
+    0x224CB382, 0x23941F05, 0x285A3CA8, 0x2982902F, 0x2BEB65A6, 0x2A33C921,
+    0x2F388EB4, 0x2EE02233, 0x2C89D7BA, 0x2D517B3D, 0x762B21C0, 0x77F38D47,
+    0x759A78CE, 0x7442D449, 0x714993DC, 0x70913F5B, 0x72F8CAD2, 0x73206655,
+    0x78EE45F8, 0x7936E97F, 0x7B5F1CF6, 0x7A87B071, 0x7F8CF7E4, 0x7E545B63,
+    0x7C3DAEEA, 0x7DE5026D, 0x6BA1E9B0, 0x6A794537, 0x6810B0BE, 0x69C81C39,
+    0x6CC35BAC, 0x6D1BF72B, 0x6F7202A2, 0x6EAAAE25, 0x65648D88, 0x64BC210F,
+    0x66D5D486, 0x670D7801, 0x62063F94, 0x63DE9313, 0x61B7669A, 0x606FCA1D,
+    0x4D3EB120, 0x4CE61DA7, 0x4E8FE82E, 0x4F5744A9, 0x4A5C033C, 0x4B84AFBB,
+    0x49ED5A32, 0x4835F6B5, 0x43FBD518, 0x4223799F, 0x404A8C16, 0x41922091,
+    0x44996704, 0x4541CB83, 0x47283E0A, 0x46F0928D, 0x50B47950, 0x516CD5D7,
+    0x5305205E, 0x52DD8CD9, 0x57D6CB4C, 0x560E67CB, 0x54679242, 0x55BF3EC5,
+    0x5E711D68, 0x5FA9B1EF, 0x5DC04466, 0x5C18E8E1, 0x5913AF74, 0x58CB03F3,
+    0x5AA2F67A, 0x5B7A5AFD, 0xEC564380, 0xED8EEF07, 0xEFE71A8E, 0xEE3FB609,
+    0xEB34F19C, 0xEAEC5D1B, 0xE885A892, 0xE95D0415, 0xE29327B8, 0xE34B8B3F,
+    0xE1227EB6, 0xE0FAD231, 0xE5F195A4, 0xE4293923, 0xE640CCAA, 0xE798602D,
+    0xF1DC8BF0, 0xF0042777, 0xF26DD2FE, 0xF3B57E79, 0xF6BE39EC, 0xF766956B,
+    0xF50F60E2, 0xF4D7CC65, 0xFF19EFC8, 0xFEC1434F, 0xFCA8B6C6, 0xFD701A41,
+    0xF87B5DD4, 0xF9A3F153, 0xFBCA04DA, 0xFA12A85D, 0xD743D360, 0xD69B7FE7,
+    0xD4F28A6E, 0xD52A26E9, 0xD021617C, 0xD1F9CDFB, 0xD3903872, 0xD24894F5,
+    0xD986B758, 0xD85E1BDF, 0xDA37EE56, 0xDBEF42D1, 0xDEE40544, 0xDF3CA9C3,
+    0xDD555C4A, 0xDC8DF0CD, 0xCAC91B10, 0xCB11B797, 0xC978421E, 0xC8A0EE99,
+    0xCDABA90C, 0xCC73058B, 0xCE1AF002, 0xCFC25C85, 0xC40C7F28, 0xC5D4D3AF,
+    0xC7BD2626, 0xC6658AA1, 0xC36ECD34, 0xC2B661B3, 0xC0DF943A, 0xC10738BD,
+    0x9A7D6240, 0x9BA5CEC7, 0x99CC3B4E, 0x981497C9, 0x9D1FD05C, 0x9CC77CDB,
+    0x9EAE8952, 0x9F7625D5, 0x94B80678, 0x9560AAFF, 0x97095F76, 0x96D1F3F1,
+    0x93DAB464, 0x920218E3, 0x906BED6A, 0x91B341ED, 0x87F7AA30, 0x862F06B7,
+    0x8446F33E, 0x859E5FB9, 0x8095182C, 0x814DB4AB, 0x83244122, 0x82FCEDA5,
+    0x8932CE08, 0x88EA628F, 0x8A839706, 0x8B5B3B81, 0x8E507C14, 0x8F88D093,
+    0x8DE1251A, 0x8C39899D, 0xA168F2A0, 0xA0B05E27, 0xA2D9ABAE, 0xA3010729,
+    0xA60A40BC, 0xA7D2EC3B, 0xA5BB19B2, 0xA463B535, 0xAFAD9698, 0xAE753A1F,
+    0xAC1CCF96, 0xADC46311, 0xA8CF2484, 0xA9178803, 0xAB7E7D8A, 0xAAA6D10D,
+    0xBCE23AD0, 0xBD3A9657, 0xBF5363DE, 0xBE8BCF59, 0xBB8088CC, 0xBA58244B,
+    0xB831D1C2, 0xB9E97D45, 0xB2275EE8, 0xB3FFF26F, 0xB19607E6, 0xB04EAB61,
+    0xB545ECF4, 0xB49D4073, 0xB6F4B5FA, 0xB72C197D
+  },
+  {
+    0x00000000, 0xDC6D9AB7, 0xBC1A28D9, 0x6077B26E, 0x7CF54C05, 0xA098D6B2,
+    0xC0EF64DC, 0x1C82FE6B, 0xF9EA980A, 0x258702BD, 0x45F0B0D3, 0x999D2A64,
+    0x851FD40F, 0x59724EB8, 0x3905FCD6, 0xE5686661, 0xF7142DA3, 0x2B79B714,
+    0x4B0E057A, 0x97639FCD, 0x8BE161A6, 0x578CFB11, 0x37FB497F, 0xEB96D3C8,
+    0x0EFEB5A9, 0xD2932F1E, 0xB2E49D70, 0x6E8907C7, 0x720BF9AC, 0xAE66631B,
+    0xCE11D175, 0x127C4BC2, 0xEAE946F1, 0x3684DC46, 0x56F36E28, 0x8A9EF49F,
+    0x961C0AF4, 0x4A719043, 0x2A06222D, 0xF66BB89A, 0x1303DEFB, 0xCF6E444C,
+    0xAF19F622, 0x73746C95, 0x6FF692FE, 0xB39B0849, 0xD3ECBA27, 0x0F812090,
+    0x1DFD6B52, 0xC190F1E5, 0xA1E7438B, 0x7D8AD93C, 0x61082757, 0xBD65BDE0,
+    0xDD120F8E, 0x017F9539, 0xE417F358, 0x387A69EF, 0x580DDB81, 0x84604136,
+    0x98E2BF5D, 0x448F25EA, 0x24F89784, 0xF8950D33, 0xD1139055, 0x0D7E0AE2,
+    0x6D09B88C, 0xB164223B, 0xADE6DC50, 0x718B46E7, 0x11FCF489, 0xCD916E3E,
+    0x28F9085F, 0xF49492E8, 0x94E32086, 0x488EBA31, 0x540C445A, 0x8861DEED,
+    0xE8166C83, 0x347BF634, 0x2607BDF6, 0xFA6A2741, 0x9A1D952F, 0x46700F98,
+    0x5AF2F1F3, 0x869F6B44, 0xE6E8D92A, 0x3A85439D, 0xDFED25FC, 0x0380BF4B,
+    0x63F70D25, 0xBF9A9792, 0xA31869F9, 0x7F75F34E, 0x1F024120, 0xC36FDB97,
+    0x3BFAD6A4, 0xE7974C13, 0x87E0FE7D, 0x5B8D64CA, 0x470F9AA1, 0x9B620016,
+    0xFB15B278, 0x277828CF, 0xC2104EAE, 0x1E7DD419, 0x7E0A6677, 0xA267FCC0,
+    0xBEE502AB, 0x6288981C, 0x02FF2A72, 0xDE92B0C5, 0xCCEEFB07, 0x108361B0,
+    0x70F4D3DE, 0xAC994969, 0xB01BB702, 0x6C762DB5, 0x0C019FDB, 0xD06C056C,
+    0x3504630D, 0xE969F9BA, 0x891E4BD4, 0x5573D163, 0x49F12F08, 0x959CB5BF,
+    0xF5EB07D1, 0x29869D66, 0xA6E63D1D, 0x7A8BA7AA, 0x1AFC15C4, 0xC6918F73,
+    0xDA137118, 0x067EEBAF, 0x660959C1, 0xBA64C376, 0x5F0CA517, 0x83613FA0,
+    0xE3168DCE, 0x3F7B1779, 0x23F9E912, 0xFF9473A5, 0x9FE3C1CB, 0x438E5B7C,
+    0x51F210BE, 0x8D9F8A09, 0xEDE83867, 0x3185A2D0, 0x2D075CBB, 0xF16AC60C,
+    0x911D7462, 0x4D70EED5, 0xA81888B4, 0x74751203, 0x1402A06D, 0xC86F3ADA,
+    0xD4EDC4B1, 0x08805E06, 0x68F7EC68, 0xB49A76DF, 0x4C0F7BEC, 0x9062E15B,
+    0xF0155335, 0x2C78C982, 0x30FA37E9, 0xEC97AD5E, 0x8CE01F30, 0x508D8587,
+    0xB5E5E3E6, 0x69887951, 0x09FFCB3F, 0xD5925188, 0xC910AFE3, 0x157D3554,
+    0x750A873A, 0xA9671D8D, 0xBB1B564F, 0x6776CCF8, 0x07017E96, 0xDB6CE421,
+    0xC7EE1A4A, 0x1B8380FD, 0x7BF43293, 0xA799A824, 0x42F1CE45, 0x9E9C54F2,
+    0xFEEBE69C, 0x22867C2B, 0x3E048240, 0xE26918F7, 0x821EAA99, 0x5E73302E,
+    0x77F5AD48, 0xAB9837FF, 0xCBEF8591, 0x17821F26, 0x0B00E14D, 0xD76D7BFA,
+    0xB71AC994, 0x6B775323, 0x8E1F3542, 0x5272AFF5, 0x32051D9B, 0xEE68872C,
+    0xF2EA7947, 0x2E87E3F0, 0x4EF0519E, 0x929DCB29, 0x80E180EB, 0x5C8C1A5C,
+    0x3CFBA832, 0xE0963285, 0xFC14CCEE, 0x20795659, 0x400EE437, 0x9C637E80,
+    0x790B18E1, 0xA5668256, 0xC5113038, 0x197CAA8F, 0x05FE54E4, 0xD993CE53,
+    0xB9E47C3D, 0x6589E68A, 0x9D1CEBB9, 0x4171710E, 0x2106C360, 0xFD6B59D7,
+    0xE1E9A7BC, 0x3D843D0B, 0x5DF38F65, 0x819E15D2, 0x64F673B3, 0xB89BE904,
+    0xD8EC5B6A, 0x0481C1DD, 0x18033FB6, 0xC46EA501, 0xA419176F, 0x78748DD8,
+    0x6A08C61A, 0xB6655CAD, 0xD612EEC3, 0x0A7F7474, 0x16FD8A1F, 0xCA9010A8,
+    0xAAE7A2C6, 0x768A3871, 0x93E25E10, 0x4F8FC4A7, 0x2FF876C9, 0xF395EC7E,
+    0xEF171215, 0x337A88A2, 0x530D3ACC, 0x8F60A07B
+  },
+#if MFS_CFG_CRC_SLICES >= 8
+  {
+    0x00000000, 0x490D678D, 0x921ACF1A, 0xDB17A897, 0x20F48383, 0x69F9E40E,
+    0xB2EE4C99, 0xFBE32B14, 0x41E90706, 0x08E4608B, 0xD3F3C81C, 0x9AFEAF91,
+    0x611D8485, 0x2810E308, 0xF3074B9F, 0xBA0A2C12, 0x83D20E0C, 0xCADF6981,
+    0x11C8C116, 0x58C5A69B, 0xA3268D8F, 0xEA2BEA02, 0x313C4295, 0x78312518,
+    0xC23B090A, 0x8B366E87, 0x5021C610, 0x192CA19D, 0xE2CF8A89, 0xABC2ED04,
+    0x70D54593, 0x39D8221E, 0x036501AF, 0x4A686622, 0x917FCEB5, 0xD872A938,
+    0x2391822C, 0x6A9CE5A1, 0xB18B4D36, 0xF8862ABB, 0x428C06A9, 0x0B816124,
+    0xD096C9B3, 0x999BAE3E, 0x6278852A, 0x2B75E2A7, 0xF0624A30, 0xB96F2DBD,
+    0x80B70FA3, 0xC9BA682E, 0x12ADC0B9, 0x5BA0A734, 0xA0438C20, 0xE94EEBAD,
+    0x3259433A, 0x7B5424B7, 0xC15E08A5, 0x88536F28, 0x5344C7BF, 0x1A49A032,
+    0xE1AA8B26, 0xA8A7ECAB, 0x73B0443C, 0x3ABD23B1, 0x06CA035E, 0x4FC764D3,
+    0x94D0CC44, 0xDDDDABC9, 0x263E80DD, 0x6F33E750, 0xB4244FC7, 0xFD29284A,
+    0x47230458, 0x0E2E63D5, 0xD539CB42, 0x9C34ACCF, 0x67D787DB, 0x2EDAE056,
+    0xF5CD48C1, 0xBCC02F4C, 0x85180D52, 0xCC156ADF, 0x1702C248, 0x5E0FA5C5,
+    0xA5EC8ED1, 0xECE1E95C, 0x37F641CB, 0x7EFB2646, 0xC4F10A54, 0x8DFC6DD9,
+    0x56EBC54E, 0x1FE6A2C3, 0xE40589D7, 0xAD08EE5A, 0x761F46CD, 0x3F122140,
+    0x05AF02F1, 0x4CA2657C, 0x97B5CDEB, 0xDEB8AA66, 0x255B8172, 0x6C56E6FF,
+    0xB7414E68, 0xFE4C29E5, 0x444605F7, 0x0D4B627A, 0xD65CCAED, 0x9F51AD60,
+    0x64B28674, 0x2DBFE1F9, 0xF6A8496E, 0xBFA52EE3, 0x867D0CFD, 0xCF706B70,
+    0x1467C3E7, 0x5D6AA46A, 0xA6898F7E, 0xEF84E8F3, 0x34934064, 0x7D9E27E9,
+    0xC7940BFB, 0x8E996C76, 0x558EC4E1, 0x1C83A36C, 0xE7608878, 0xAE6DEFF5,
+    0x757A4762, 0x3C7720EF, 0x0D9406BC, 0x44996131, 0x9F8EC9A6, 0xD683AE2B,
+    0x2D60853F, 0x646DE2B2, 0xBF7A4A25, 0xF6772DA8, 0x4C7D01BA, 0x05706637,
+    0xDE67CEA0, 0x976AA92D, 0x6C898239, 0x2584E5B4, 0xFE934D23, 0xB79E2AAE,
+    0x8E4608B0, 0xC74B6F3D, 0x1C5CC7AA, 0x5551A027, 0xAEB28B33, 0xE7BFECBE,
+    0x3CA84429, 0x75A523A4, 0xCFAF0FB6, 0x86A2683B, 0x5DB5C0AC, 0x14B8A721,
+    0xEF5B8C35, 0xA656EBB8, 0x7D41432F, 0x344C24A2, 0x0EF10713, 0x47FC609E,
+    0x9CEBC809, 0xD5E6AF84, 0x2E058490, 0x6708E31D, 0xBC1F4B8A, 0xF5122C07,
+    0x4F180015, 0x06156798, 0xDD02CF0F, 0x940FA882, 0x6FEC8396, 0x26E1E41B,
+    0xFDF64C8C, 0xB4FB2B01, 0x8D23091F, 0xC42E6E92, 0x1F39C605, 0x5634A188,
+    0xADD78A9C, 0xE4DAED11, 0x3FCD4586, 0x76C0220B, 0xCCCA0E19, 0x85C76994,
+    0x5ED0C103, 0x17DDA68E, 0xEC3E8D9A, 0xA533EA17, 0x7E244280, 0x3729250D,
+    0x0B5E05E2, 0x4253626F, 0x9944CAF8, 0xD049AD75, 0x2BAA8661, 0x62A7E1EC,
+    0xB9B0497B, 0xF0BD2EF6, 0x4AB702E4, 0x03BA6569, 0xD8ADCDFE, 0x91A0AA73,
+    0x6A438167, 0x234EE6EA, 0xF8594E7D, 0xB15429F0, 0x888C0BEE, 0xC1816C63,
+    0x1A96C4F4, 0x539BA379, 0xA878886D, 0xE175EFE0, 0x3A624777, 0x736F20FA,
+    0xC9650CE8, 0x80686B65, 0x5B7FC3F2, 0x1272A47F, 0xE9918F6B, 0xA09CE8E6,
+    0x7B8B4071, 0x328627FC, 0x083B044D, 0x413663C0, 0x9A21CB57, 0xD32CACDA,
+    0x28CF87CE, 0x61C2E043, 0xBAD548D4, 0xF3D82F59, 0x49D2034B, 0x00DF64C6,
+    0xDBC8CC51, 0x92C5ABDC, 0x692680C8, 0x202BE745, 0xFB3C4FD2, 0xB231285F,
+    0x8BE90A41, 0xC2E46DCC, 0x19F3C55B, 0x50FEA2D6, 0xAB1D89C2, 0xE210EE4F,
+    0x390746D8, 0x700A2155, 0xCA000D47, 0x830D6ACA, 0x581AC25D, 0x1117A5D0,
+    0xEAF48EC4, 0xA3F9E949, 0x78EE41DE, 0x31E32653
+  },
+  {
+    0x00000000, 0x1B280D78, 0x36501AF0, 0x2D781788, 0x6CA035E0, 0x77883898,
+    0x5AF02F10, 0x41D82268, 0xD9406BC0, 0xC26866B8, 0xEF107130, 0xF4387C48,
+    0xB5E05E20, 0xAEC85358, 0x83B044D0, 0x989849A8, 0xB641CA37, 0xAD69C74F,
+    0x8011D0C7, 0x9B39DDBF, 0xDAE1FFD7, 0xC1C9F2AF, 0xECB1E527, 0xF799E85F,
+    0x6F01A1F7, 0x7429AC8F, 0x5951BB07, 0x4279B67F, 0x03A19417, 0x1889996F,
+    0x35F18EE7, 0x2ED9839F, 0x684289D9, 0x736A84A1, 0x5E129329, 0x453A9E51,
+    0x04E2BC39, 0x1FCAB141, 0x32B2A6C9, 0x299AABB1, 0xB102E219, 0xAA2AEF61,
+    0x8752F8E9, 0x9C7AF591, 0xDDA2D7F9, 0xC68ADA81, 0xEBF2CD09, 0xF0DAC071,
+    0xDE0343EE, 0xC52B4E96, 0xE853591E, 0xF37B5466, 0xB2A3760E, 0xA98B7B76,
+    0x84F36CFE, 0x9FDB6186, 0x0743282E, 0x1C6B2556, 0x311332DE, 0x2A3B3FA6,
+    0x6BE31DCE, 0x70CB10B6, 0x5DB3073E, 0x469B0A46, 0xD08513B2, 0xCBAD1ECA,
+    0xE6D50942, 0xFDFD043A, 0xBC252652, 0xA70D2B2A, 0x8A753CA2, 0x915D31DA,
+    0x09C57872, 0x12ED750A, 0x3F956282, 0x24BD6FFA, 0x65654D92, 0x7E4D40EA,
+    0x53355762, 0x481D5A1A, 0x66C4D985, 0x7DECD4FD, 0x5094C375, 0x4BBCCE0D,
+    0x0A64EC65, 0x114CE11D, 0x3C34F695, 0x271CFBED, 0xBF84B245, 0xA4ACBF3D,
+    0x89D4A8B5, 0x92FCA5CD, 0xD32487A5, 0xC80C8ADD, 0xE5749D55, 0xFE5C902D,
+    0xB8C79A6B, 0xA3EF9713, 0x8E97809B, 0x95BF8DE3, 0xD467AF8B, 0xCF4FA2F3,
+    0xE237B57B, 0xF91FB803, 0x6187F1AB, 0x7AAFFCD3, 0x57D7EB5B, 0x4CFFE623,
+    0x0D27C44B, 0x160FC933, 0x3B77DEBB, 0x205FD3C3, 0x0E86505C, 0x15AE5D24,
+    0x38D64AAC, 0x23FE47D4, 0x622665BC, 0x790E68C4, 0x54767F4C, 0x4F5E7234,
+    0xD7C63B9C, 0xCCEE36E4, 0xE196216C, 0xFABE2C14, 0xBB660E7C, 0xA04E0304,
+    0x8D36148C, 0x961E19F4, 0xA5CB3AD3, 0xBEE337AB, 0x939B2023, 0x88B32D5B,
+    0xC96B0F33, 0xD243024B, 0xFF3B15C3, 0xE41318BB, 0x7C8B5113, 0x67A35C6B,
+    0x4ADB4BE3, 0x51F3469B, 0x102B64F3, 0x0B03698B, 0x267B7E03, 0x3D53737B,
+    0x138AF0E4, 0x08A2FD9C, 0x25DAEA14, 0x3EF2E76C, 0x7F2AC504, 0x6402C87C,
+    0x497ADFF4, 0x5252D28C, 0xCACA9B24, 0xD1E2965C, 0xFC9A81D4, 0xE7B28CAC,
+    0xA66AAEC4, 0xBD42A3BC, 0x903AB434, 0x8B12B94C, 0xCD89B30A, 0xD6A1BE72,
+    0xFBD9A9FA, 0xE0F1A482, 0xA12986EA, 0xBA018B92, 0x97799C1A, 0x8C519162,
+    0x14C9D8CA, 0x0FE1D5B2, 0x2299C23A, 0x39B1CF42, 0x7869ED2A, 0x6341E052,
+    0x4E39F7DA, 0x5511FAA2, 0x7BC8793D, 0x60E07445, 0x4D9863CD, 0x56B06EB5,
+    0x17684CDD, 0x0C4041A5, 0x2138562D, 0x3A105B55, 0xA28812FD, 0xB9A01F85,
+    0x94D8080D, 0x8FF00575, 0xCE28271D, 0xD5002A65, 0xF8783DED, 0xE3503095,
+    0x754E2961, 0x6E662419, 0x431E3391, 0x58363EE9, 0x19EE1C81, 0x02C611F9,
+    0x2FBE0671, 0x34960B09, 0xAC0E42A1, 0xB7264FD9, 0x9A5E5851, 0x81765529,
+    0xC0AE7741, 0xDB867A39, 0xF6FE6DB1, 0xEDD660C9, 0xC30FE356, 0xD827EE2E,
+    0xF55FF9A6, 0xEE77F4DE, 0xAFAFD6B6, 0xB487DBCE, 0x99FFCC46, 0x82D7C13E,
+    0x1A4F8896, 0x016785EE, 0x2C1F9266, 0x37379F1E, 0x76EFBD76, 0x6DC7B00E,
+    0x40BFA786, 0x5B97AAFE, 0x1D0CA0B8, 0x0624ADC0, 0x2B5CBA48, 0x3074B730,
+    0x71AC9558, 0x6A849820, 0x47FC8FA8, 0x5CD482D0, 0xC44CCB78, 0xDF64C600,
+    0xF21CD188, 0xE934DCF0, 0xA8ECFE98, 0xB3C4F3E0, 0x9EBCE468, 0x8594E910,
+    0xAB4D6A8F, 0xB06567F7, 0x9D1D707F, 0x86357D07, 0xC7ED5F6F, 0xDCC55217,
+    0xF1BD459F, 0xEA9548E7, 0x720D014F, 0x69250C37, 0x445D1BBF, 0x5F7516C7,
+    0x1EAD34AF, 0x058539D7, 0x28FD2E5F, 0x33D52327
+  },
+  {
+    0x00000000, 0x4F576811, 0x9EAED022, 0xD1F9B833, 0x399CBDF3, 0x76CBD5E2,
+    0xA7326DD1, 0xE86505C0, 0x73397BE6, 0x3C6E13F7, 0xED97ABC4, 0xA2C0C3D5,
+    0x4AA5C615, 0x05F2AE04, 0xD40B1637, 0x9B5C7E26, 0xE672F7CC, 0xA9259FDD,
+    0x78DC27EE, 0x378B4FFF, 0xDFEE4A3F, 0x90B9222E, 0x41409A1D, 0x0E17F20C,
+    0x954B8C2A, 0xDA1CE43B, 0x0BE55C08, 0x44B23419, 0xACD731D9, 0xE38059C8,
+    0x3279E1FB, 0x7D2E89EA, 0xC824F22F, 0x87739A3E, 0x568A220D, 0x19DD4A1C,
+    0xF1B84FDC, 0xBEEF27CD, 0x6F169FFE, 0x2041F7EF, 0xBB1D89C9, 0xF44AE1D8,
+    0x25B359EB, 0x6AE431FA, 0x8281343A, 0xCDD65C2B, 0x1C2FE418, 0x53788C09,
+    0x2E5605E3, 0x61016DF2, 0xB0F8D5C1, 0xFFAFBDD0, 0x17CAB810, 0x589DD001,
+    0x89646832, 0xC6330023, 0x5D6F7E05, 0x12381614, 0xC3C1AE27, 0x8C96C636,
+    0x64F3C3F6, 0x2BA4ABE7, 0xFA5D13D4, 0xB50A7BC5, 0x9488F9E9, 0xDBDF91F8,
+    0x0A2629CB, 0x457141DA, 0xAD14441A, 0xE2432C0B, 0x33BA9438, 0x7CEDFC29,
+    0xE7B1820F, 0xA8E6EA1E, 0x791F522D, 0x36483A3C, 0xDE2D3FFC, 0x917A57ED,
+    0x4083EFDE, 0x0FD487CF, 0x72FA0E25, 0x3DAD6634, 0xEC54DE07, 0xA303B616,
+    0x4B66B3D6, 0x0431DBC7, 0xD5C863F4, 0x9A9F0BE5, 0x01C375C3, 0x4E941DD2,
+    0x9F6DA5E1, 0xD03ACDF0, 0x385FC830, 0x7708A021, 0xA6F11812, 0xE9A67003,
+    0x5CAC0BC6, 0x13FB63D7, 0xC202DBE4, 0x8D55B3F5, 0x6530B635, 0x2A67DE24,
+    0xFB9E6617, 0xB4C90E06, 0x2F957020, 0x60C21831, 0xB13BA002, 0xFE6CC813,
+    0x1609CDD3, 0x595EA5C2, 0x88A71DF1, 0xC7F075E0, 0xBADEFC0A, 0xF589941B,
+    0x24702C28, 0x6B274439, 0x834241F9, 0xCC1529E8, 0x1DEC91DB, 0x52BBF9CA,
+    0xC9E787EC, 0x86B0EFFD, 0x574957CE, 0x181E3FDF, 0xF07B3A1F, 0xBF2C520E,
+    0x6ED5EA3D, 0x2182822C, 0x2DD0EE65, 0x62878674, 0xB37E3E47, 0xFC295656,
+    0x144C5396, 0x5B1B3B87, 0x8AE283B4, 0xC5B5EBA5, 0x5EE99583, 0x11BEFD92,
+    0xC04745A1, 0x8F102DB0, 0x67752870, 0x28224061, 0xF9DBF852, 0xB68C9043,
+    0xCBA219A9, 0x84F571B8, 0x550CC98B, 0x1A5BA19A, 0xF23EA45A, 0xBD69CC4B,
+    0x6C907478, 0x23C71C69, 0xB89B624F, 0xF7CC0A5E, 0x2635B26D, 0x6962DA7C,
+    0x8107DFBC, 0xCE50B7AD, 0x1FA90F9E, 0x50FE678F, 0xE5F41C4A, 0xAAA3745B,
+    0x7B5ACC68, 0x340DA479, 0xDC68A1B9, 0x933FC9A8, 0x42C6719B, 0x0D91198A,
+    0x96CD67AC, 0xD99A0FBD, 0x0863B78E, 0x4734DF9F, 0xAF51DA5F, 0xE006B24E,
+    0x31FF0A7D, 0x7EA8626C, 0x0386EB86, 0x4CD18397, 0x9D283BA4, 0xD27F53B5,
+    0x3A1A5675, 0x754D3E64, 0xA4B48657, 0xEBE3EE46, 0x70BF9060, 0x3FE8F871,
+    0xEE114042, 0xA1462853, 0x49232D93, 0x06744582, 0xD78DFDB1, 0x98DA95A0,
+    0xB958178C, 0xF60F7F9D, 0x27F6C7AE, 0x68A1AFBF, 0x80C4AA7F, 0xCF93C26E,
+    0x1E6A7A5D, 0x513D124C, 0xCA616C6A, 0x8536047B, 0x54CFBC48, 0x1B98D459,
+    0xF3FDD199, 0xBCAAB988, 0x6D5301BB, 0x220469AA, 0x5F2AE040, 0x107D8851,
+    0xC1843062, 0x8ED35873, 0x66B65DB3, 0x29E135A2, 0xF8188D91, 0xB74FE580,
+    0x2C139BA6, 0x6344F3B7, 0xB2BD4B84, 0xFDEA2395, 0x158F2655, 0x5AD84E44,
+    0x8B21F677, 0xC4769E66, 0x717CE5A3, 0x3E2B8DB2, 0xEFD23581, 0xA0855D90,
+    0x48E05850, 0x07B73041, 0xD64E8872, 0x9919E063, 0x02459E45, 0x4D12F654,
+    0x9CEB4E67, 0xD3BC2676, 0x3BD923B6, 0x748E4BA7, 0xA577F394, 0xEA209B85,
+    0x970E126F, 0xD8597A7E, 0x09A0C24D, 0x46F7AA5C, 0xAE92AF9C, 0xE1C5C78D,
+    0x303C7FBE, 0x7F6B17AF, 0xE4376989, 0xAB600198, 0x7A99B9AB, 0x35CED1BA,
+    0xDDABD47A, 0x92FCBC6B, 0x43050458, 0x0C526C49
+  },
+  {
+    0x00000000, 0x5BA1DCCA, 0xB743B994, 0xECE2655E, 0x6A466E9F, 0x31E7B255,
+    0xDD05D70B, 0x86A40BC1, 0xD48CDD3E, 0x8F2D01F4, 0x63CF64AA, 0x386EB860,
+    0xBECAB3A1, 0xE56B6F6B, 0x09890A35, 0x5228D6FF, 0xADD8A7CB, 0xF6797B01,
+    0x1A9B1E5F, 0x413AC295, 0xC79EC954, 0x9C3F159E, 0x70DD70C0, 0x2B7CAC0A,
+    0x79547AF5, 0x22F5A63F, 0xCE17C361, 0x95B61FAB, 0x1312146A, 0x48B3C8A0,
+    0xA451ADFE, 0xFFF07134, 0x5F705221, 0x04D18EEB, 0xE833EBB5, 0xB392377F,
+    0x35363CBE, 0x6E97E074, 0x8275852A, 0xD9D459E0, 0x8BFC8F1F, 0xD05D53D5,
+    0x3CBF368B, 0x671EEA41, 0xE1BAE180, 0xBA1B3D4A, 0x56F95814, 0x0D5884DE,
+    0xF2A8F5EA, 0xA9092920, 0x45EB4C7E, 0x1E4A90B4, 0x98EE9B75, 0xC34F47BF,
+    0x2FAD22E1, 0x740CFE2B, 0x262428D4, 0x7D85F41E, 0x91679140, 0xCAC64D8A,
+    0x4C62464B, 0x17C39A81, 0xFB21FFDF, 0xA0802315, 0xBEE0A442, 0xE5417888,
+    0x09A31DD6, 0x5202C11C, 0xD4A6CADD, 0x8F071617, 0x63E57349, 0x3844AF83,
+    0x6A6C797C, 0x31CDA5B6, 0xDD2FC0E8, 0x868E1C22, 0x002A17E3, 0x5B8BCB29,
+    0xB769AE77, 0xECC872BD, 0x13380389, 0x4899DF43, 0xA47BBA1D, 0xFFDA66D7,
+    0x797E6D16, 0x22DFB1DC, 0xCE3DD482, 0x959C0848, 0xC7B4DEB7, 0x9C15027D,
+    0x70F76723, 0x2B56BBE9, 0xADF2B028, 0xF6536CE2, 0x1AB109BC, 0x4110D576,
+    0xE190F663, 0xBA312AA9, 0x56D34FF7, 0x0D72933D, 0x8BD698FC, 0xD0774436,
+    0x3C952168, 0x6734FDA2, 0x351C2B5D, 0x6EBDF797, 0x825F92C9, 0xD9FE4E03,
+    0x5F5A45C2, 0x04FB9908, 0xE819FC56, 0xB3B8209C, 0x4C4851A8, 0x17E98D62,
+    0xFB0BE83C, 0xA0AA34F6, 0x260E3F37, 0x7DAFE3FD, 0x914D86A3, 0xCAEC5A69,
+    0x98C48C96, 0xC365505C, 0x2F873502, 0x7426E9C8, 0xF282E209, 0xA9233EC3,
+    0x45C15B9D, 0x1E608757, 0x79005533, 0x22A189F9, 0xCE43ECA7, 0x95E2306D,
+    0x13463BAC, 0x48E7E766, 0xA4058238, 0xFFA45EF2, 0xAD8C880D, 0xF62D54C7,
+    0x1ACF3199, 0x416EED53, 0xC7CAE692, 0x9C6B3A58, 0x70895F06, 0x2B2883CC,
+    0xD4D8F2F8, 0x8F792E32, 0x639B4B6C, 0x383A97A6, 0xBE9E9C67, 0xE53F40AD,
+    0x09DD25F3, 0x527CF939, 0x00542FC6, 0x5BF5F30C, 0xB7179652, 0xECB64A98,
+    0x6A124159, 0x31B39D93, 0xDD51F8CD, 0x86F02407, 0x26700712, 0x7DD1DBD8,
+    0x9133BE86, 0xCA92624C, 0x4C36698D, 0x1797B547, 0xFB75D019, 0xA0D40CD3,
+    0xF2FCDA2C, 0xA95D06E6, 0x45BF63B8, 0x1E1EBF72, 0x98BAB4B3, 0xC31B6879,
+    0x2FF90D27, 0x7458D1ED, 0x8BA8A0D9, 0xD0097C13, 0x3CEB194D, 0x674AC587,
+    0xE1EECE46, 0xBA4F128C, 0x56AD77D2, 0x0D0CAB18, 0x5F247DE7, 0x0485A12D,
+    0xE867C473, 0xB3C618B9, 0x35621378, 0x6EC3CFB2, 0x8221AAEC, 0xD9807626,
+    0xC7E0F171, 0x9C412DBB, 0x70A348E5, 0x2B02942F, 0xADA69FEE, 0xF6074324,
+    0x1AE5267A, 0x4144FAB0, 0x136C2C4F, 0x48CDF085, 0xA42F95DB, 0xFF8E4911,
+    0x792A42D0, 0x228B9E1A, 0xCE69FB44, 0x95C8278E, 0x6A3856BA, 0x31998A70,
+    0xDD7BEF2E, 0x86DA33E4, 0x007E3825, 0x5BDFE4EF, 0xB73D81B1, 0xEC9C5D7B,
+    0xBEB48B84, 0xE515574E, 0x09F73210, 0x5256EEDA, 0xD4F2E51B, 0x8F5339D1,
+    0x63B15C8F, 0x38108045, 0x9890A350, 0xC3317F9A, 0x2FD31AC4, 0x7472C60E,
+    0xF2D6CDCF, 0xA9771105, 0x4595745B, 0x1E34A891, 0x4C1C7E6E, 0x17BDA2A4,
+    0xFB5FC7FA, 0xA0FE1B30, 0x265A10F1, 0x7DFBCC3B, 0x9119A965, 0xCAB875AF,
+    0x3548049B, 0x6EE9D851, 0x820BBD0F, 0xD9AA61C5, 0x5F0E6A04, 0x04AFB6CE,
+    0xE84DD390, 0xB3EC0F5A, 0xE1C4D9A5, 0xBA65056F, 0x56876031, 0x0D26BCFB,
+    0x8B82B73A, 0xD0236BF0, 0x3CC10EAE, 0x6760D264
+  }
+#endif
+#endif
 };
+#endif
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
-uint16_t crc16(uint16_t crc, const uint8_t *data, size_t n) {
+/**
+ * @brief   CRC16-CCITT calculation.
+ * @note    The CRC is calculated MSB-first without output XOR, the
+ *          initial value is specified by the caller.
+ *
+ * @param[in] crc       initial or previous CRC value
+ * @param[in] data      pointer to the data buffer
+ * @param[in] n         number of bytes in the buffer
+ * @return              The updated CRC value.
+ *
+ * @notapi
+ */
+static uint16_t crc16(uint16_t crc, const uint8_t *data, size_t n) {
+
+#if defined(MFS_CFG_CRC16_HOOK)
+  return MFS_CFG_CRC16_HOOK(crc, data, n);
+#else
+#if MFS_CFG_CRC_SLICES == 8
+  while (n >= 8U) {
+    crc ^= (uint16_t)(((uint16_t)data[0] << 8U) | (uint16_t)data[1]);
+    crc = crc16_table[7][crc >> 8U]     ^ crc16_table[6][crc & 0xFFU] ^
+          crc16_table[5][data[2]]       ^ crc16_table[4][data[3]]     ^
+          crc16_table[3][data[4]]       ^ crc16_table[2][data[5]]     ^
+          crc16_table[1][data[6]]       ^ crc16_table[0][data[7]];
+    data += 8;
+    n    -= 8U;
+  }
+#elif MFS_CFG_CRC_SLICES == 4
+  while (n >= 4U) {
+    crc ^= (uint16_t)(((uint16_t)data[0] << 8U) | (uint16_t)data[1]);
+    crc = crc16_table[3][crc >> 8U]     ^ crc16_table[2][crc & 0xFFU] ^
+          crc16_table[1][data[2]]       ^ crc16_table[0][data[3]];
+    data += 4;
+    n    -= 4U;
+  }
+#endif
 
   while (n > 0U) {
-    crc = (crc << 8U) ^ crc16_table[(crc >> 8U) ^ (uint16_t)*data];
+    crc = (uint16_t)(crc << 8U) ^ crc16_table[0][(crc >> 8U) ^ (uint16_t)*data];
     data++;
     n--;
   }
 
   return crc;
+#endif
 }
 
-static void mfs_state_reset(MFSDriver *mfsp) {
+#if (MFS_CFG_RECORD_CRC32 == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   CRC-32/MPEG-2 calculation.
+ * @note    The CRC is calculated MSB-first without output XOR, the
+ *          initial value is specified by the caller. This is the same
+ *          algorithm implemented by the STM32 CRC unit in its default
+ *          configuration.
+ *
+ * @param[in] crc       initial or previous CRC value
+ * @param[in] data      pointer to the data buffer
+ * @param[in] n         number of bytes in the buffer
+ * @return              The updated CRC value.
+ *
+ * @notapi
+ */
+static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t n) {
+
+#if defined(MFS_CFG_CRC32_HOOK)
+  return MFS_CFG_CRC32_HOOK(crc, data, n);
+#else
+#if MFS_CFG_CRC_SLICES >= 4
+  while (n >= (size_t)MFS_CFG_CRC_SLICES) {
+    crc ^= ((uint32_t)data[0] << 24U) | ((uint32_t)data[1] << 16U) |
+           ((uint32_t)data[2] << 8U)  |  (uint32_t)data[3];
+#if MFS_CFG_CRC_SLICES == 8
+    crc = crc32_table[7][crc >> 24U]          ^
+          crc32_table[6][(crc >> 16U) & 0xFFU] ^
+          crc32_table[5][(crc >> 8U) & 0xFFU]  ^
+          crc32_table[4][crc & 0xFFU]          ^
+          crc32_table[3][data[4]] ^ crc32_table[2][data[5]] ^
+          crc32_table[1][data[6]] ^ crc32_table[0][data[7]];
+#else
+    crc = crc32_table[3][crc >> 24U]          ^
+          crc32_table[2][(crc >> 16U) & 0xFFU] ^
+          crc32_table[1][(crc >> 8U) & 0xFFU]  ^
+          crc32_table[0][crc & 0xFFU];
+#endif
+    data += MFS_CFG_CRC_SLICES;
+    n    -= (size_t)MFS_CFG_CRC_SLICES;
+  }
+#endif
+
+  while (n > 0U) {
+    crc = (crc << 8U) ^ crc32_table[0][(crc >> 24U) ^ (uint32_t)*data];
+    data++;
+    n--;
+  }
+
+  return crc;
+#endif
+}
+#endif /* MFS_CFG_RECORD_CRC32 == TRUE */
+
+static void mfs_index_reset(MFSDriver *mfsp) {
   unsigned i;
 
+  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+    mfsp->descriptors[i].offset = 0U;
+    mfsp->descriptors[i].size   = 0U;
+  }
+#if MFS_CFG_SPARSE_IDS == TRUE
+  mfsp->records_count   = 0U;
+#endif
+}
+
+static void mfs_state_reset(MFSDriver *mfsp) {
+
   mfsp->current_bank    = MFS_BANK_0;
   mfsp->current_counter = 0U;
   mfsp->next_offset     = 0U;
   mfsp->used_space      = 0U;
 
-  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
-    mfsp->descriptors[i].offset = 0U;
-    mfsp->descriptors[i].size   = 0U;
+  mfs_index_reset(mfsp);
+#if MFS_CFG_LOG_SECTORS > 0
+  mfsp->log_head        = 0U;
+  memset((void *)mfsp->log, 0, sizeof (mfsp->log));
+#endif
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+  mfsp->checkpoint_offset = 0U;
+#endif
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  mfsp->gc_state        = MFS_GC_IDLE;
+  mfsp->gc_index        = 0U;
+  mfsp->gc_pending      = 0U;
+#endif
+}
+
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Binary search in the records index.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @return              Position of the first entry with an identifier
+ *                      greater or equal than @p id.
+ *
+ * @notapi
+ */
+static uint32_t mfs_index_search(MFSDriver *mfsp, mfs_id_t id) {
+  uint32_t lo = 0U, hi = mfsp->records_count;
+
+  while (lo < hi) {
+    uint32_t mid = lo + ((hi - lo) / 2U);
+
+    if (mfsp->descriptors[mid].id < id) {
+      lo = mid + 1U;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+#endif
+
+/**
+ * @brief   Finds a record in the records index.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @return              Pointer to the record descriptor.
+ * @retval NULL         if the record does not exist.
+ *
+ * @notapi
+ */
+static mfs_record_descriptor_t *mfs_index_find(MFSDriver *mfsp,
+                                               mfs_id_t id) {
+#if MFS_CFG_SPARSE_IDS == TRUE
+  uint32_t i = mfs_index_search(mfsp, id);
+
+  if ((i < mfsp->records_count) && (mfsp->descriptors[i].id == id)) {
+    return &mfsp->descriptors[i];
+  }
+#else
+  if (mfsp->descriptors[id - 1U].offset != 0U) {
+    return &mfsp->descriptors[id - 1U];
+  }
+#endif
+
+  return NULL;
+}
+
+/**
+ * @brief   Creates or updates a record in the records index.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @param[in] offset    offset of the record header
+ * @param[in] size      record data size
+ * @return              The operation status.
+ * @retval MFS_ERR_OUT_OF_MEM if the records index is full.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_index_update(MFSDriver *mfsp, mfs_id_t id,
+                                    flash_offset_t offset, uint32_t size) {
+#if MFS_CFG_SPARSE_IDS == TRUE
+  uint32_t i = mfs_index_search(mfsp, id);
+
+  if ((i >= mfsp->records_count) || (mfsp->descriptors[i].id != id)) {
+    /* New record, making space in the index.*/
+    if (mfsp->records_count >= (uint32_t)MFS_CFG_MAX_RECORDS) {
+      return MFS_ERR_OUT_OF_MEM;
+    }
+    memmove((void *)&mfsp->descriptors[i + 1U],
+            (void *)&mfsp->descriptors[i],
+            (mfsp->records_count - i) * sizeof (mfs_record_descriptor_t));
+    mfsp->records_count++;
+    mfsp->descriptors[i].id = id;
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* Keeping the collector position on the same entry.*/
+    if (i < mfsp->gc_index) {
+      mfsp->gc_index++;
+    }
+#endif
+  }
+#else
+  uint32_t i = id - 1U;
+#endif
+
+  mfsp->descriptors[i].offset = offset;
+  mfsp->descriptors[i].size   = size;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Removes a record from the records index.
+ * @note    Nothing happens if the record does not exist.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ *
+ * @notapi
+ */
+static void mfs_index_remove(MFSDriver *mfsp, mfs_id_t id) {
+#if MFS_CFG_SPARSE_IDS == TRUE
+  uint32_t i = mfs_index_search(mfsp, id);
+
+  if ((i < mfsp->records_count) && (mfsp->descriptors[i].id == id)) {
+    mfsp->records_count--;
+    memmove((void *)&mfsp->descriptors[i],
+            (void *)&mfsp->descriptors[i + 1U],
+            (mfsp->records_count - i) * sizeof (mfs_record_descriptor_t));
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* Keeping the collector position on the same entry.*/
+    if (i < mfsp->gc_index) {
+      mfsp->gc_index--;
+    }
+#endif
+  }
+#else
+  mfsp->descriptors[id - 1U].offset = 0U;
+  mfsp->descriptors[id - 1U].size   = 0U;
+#endif
+}
+
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Applies the operations of a transaction to the records index.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ * @retval MFS_ERR_OUT_OF_MEM if the records index is full.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_tr_apply(MFSDriver *mfsp) {
+  uint32_t i;
+
+  for (i = 0U; i < mfsp->tr_nops; i++) {
+    mfs_transaction_op_t *top = &mfsp->tr_ops[i];
+
+    if (top->size == 0U) {
+      mfs_index_remove(mfsp, top->id);
+    }
+    else {
+      RET_ON_ERROR(mfs_index_update(mfsp, top->id, top->offset, top->size));
+    }
   }
+  mfsp->tr_nops = 0U;
+
+  return MFS_NO_ERROR;
+}
+#endif
+
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the offset of a log sector.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] i         index of the sector in the log
+ * @return              The sector offset.
+ *
+ * @notapi
+ */
+static flash_offset_t mfs_log_get_offset(MFSDriver *mfsp, uint32_t i) {
+
+  return flashGetSectorOffset(mfsp->config->flashp,
+                              mfsp->config->log_start + (flash_sector_t)i);
 }
 
+/**
+ * @brief   Returns the index of the log sector containing an offset.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] offset    flash offset
+ * @return              The index of the sector in the log.
+ *
+ * @notapi
+ */
+static uint32_t mfs_log_get_sector(MFSDriver *mfsp, flash_offset_t offset) {
+
+  return (uint32_t)((offset - mfs_log_get_offset(mfsp, 0U)) / mfsp->log_size);
+}
+#else
 static flash_offset_t mfs_flash_get_bank_offset(MFSDriver *mfsp,
                                                 mfs_bank_t bank) {
 
@@ -136,6 +1169,7 @@ static flash_offset_t mfs_flash_get_bank_offset(MFSDriver *mfsp,
                               flashGetSectorOffset(mfsp->config->flashp,
                                                    mfsp->config->bank1_start);
 }
+#endif
 
 /**
  * @brief   Flash read.
@@ -185,13 +1219,15 @@ static mfs_error_t mfs_flash_write(MFSDriver *mfsp,
     mfsp->state = MFS_ERROR;
     return MFS_ERR_FLASH_FAILURE;
   }
+  mfsp->gc_stats.programmed_bytes += (uint32_t)n;
 
 #if MFS_CFG_WRITE_VERIFY == TRUE
   /* Verifying the written data by reading it back and comparing.*/
   while (n > 0U) {
-    size_t chunk = n <= MFS_CFG_BUFFER_SIZE ? n : MFS_CFG_BUFFER_SIZE;
-    RET_ON_ERROR(mfs_flash_read(mfsp, offset, chunk, mfsp->buffer.data8));
-    if (memcmp((void *)mfsp->buffer.data8, (void *)wp, chunk)) {
+    size_t chunk = n <= MFS_STAGING_SIZE(mfsp) ? n : MFS_STAGING_SIZE(mfsp);
+    RET_ON_ERROR(mfs_flash_read(mfsp, offset, chunk,
+                                MFS_STAGING_BUFFER(mfsp)));
+    if (memcmp((void *)MFS_STAGING_BUFFER(mfsp), (void *)wp, chunk)) {
       mfsp->state = MFS_ERROR;
       return MFS_ERR_FLASH_FAILURE;
     }
@@ -221,19 +1257,20 @@ static mfs_error_t mfs_flash_copy(MFSDriver *mfsp,
                                   flash_offset_t doffset,
                                   flash_offset_t soffset,
                                   uint32_t n) {
+  uint8_t *bp = MFS_STAGING_BUFFER(mfsp);
+  size_t size = MFS_STAGING_SIZE(mfsp);
 
-  /* Splitting the operation in smaller operations because the buffer is
-     small.*/
+  /* Splitting the operation in buffer-sized operations aligned to the
+     buffer size in the destination.*/
   while (n > 0U) {
     /* Data size that can be written in a single program page operation.*/
-    size_t chunk = (size_t)(((doffset | (MFS_CFG_BUFFER_SIZE - 1U)) + 1U) -
-                            doffset);
+    size_t chunk = (size_t)(((doffset | (size - 1U)) + 1U) - doffset);
     if (chunk > n) {
       chunk = n;
     }
 
-    RET_ON_ERROR(mfs_flash_read(mfsp, soffset, chunk, mfsp->buffer.data8));
-    RET_ON_ERROR(mfs_flash_write(mfsp, doffset, chunk, mfsp->buffer.data8));
+    RET_ON_ERROR(mfs_flash_read(mfsp, soffset, chunk, bp));
+    RET_ON_ERROR(mfs_flash_write(mfsp, doffset, chunk, bp));
 
     /* Next page.*/
     soffset += chunk;
@@ -244,6 +1281,59 @@ static mfs_error_t mfs_flash_copy(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+/**
+ * @brief   Record copy.
+ * @note    Records written by a transaction are copied using the normal
+ *          header magic because the transaction end marker is not copied
+ *          along with them.
+ * @note    In a log-structured storage the header magic is written last,
+ *          an interrupted copy is detected as garbage on mount.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] doffset   destination flash offset
+ * @param[in] soffset   source flash offset
+ * @param[in] n         record size including the header
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_record_copy(MFSDriver *mfsp,
+                                   flash_offset_t doffset,
+                                   flash_offset_t soffset,
+                                   uint32_t n) {
+#if MFS_CFG_LOG_SECTORS > 0
+  uint32_t magic = (uint32_t)MFS_HEADER_MAGIC;
+
+  RET_ON_ERROR(mfs_flash_read(mfsp, soffset, sizeof (mfs_data_header_t),
+                              mfsp->buffer.data8));
+  mfsp->buffer.dhdr.fields.magic = mfsp->config->erased;
+  RET_ON_ERROR(mfs_flash_write(mfsp, doffset, sizeof (mfs_data_header_t),
+                               mfsp->buffer.data8));
+  RET_ON_ERROR(mfs_flash_copy(mfsp,
+                              doffset + (flash_offset_t)sizeof (mfs_data_header_t),
+                              soffset + (flash_offset_t)sizeof (mfs_data_header_t),
+                              n - (uint32_t)sizeof (mfs_data_header_t)));
+
+  return mfs_flash_write(mfsp, doffset, sizeof (uint32_t),
+                         (const uint8_t *)&magic);
+#elif MFS_CFG_TRANSACTION_MAX > 0
+
+  RET_ON_ERROR(mfs_flash_read(mfsp, soffset, sizeof (mfs_data_header_t),
+                              mfsp->buffer.data8));
+  mfsp->buffer.dhdr.fields.magic = (uint32_t)MFS_HEADER_MAGIC;
+  RET_ON_ERROR(mfs_flash_write(mfsp, doffset, sizeof (mfs_data_header_t),
+                               mfsp->buffer.data8));
+
+  return mfs_flash_copy(mfsp,
+                        doffset + (flash_offset_t)sizeof (mfs_data_header_t),
+                        soffset + (flash_offset_t)sizeof (mfs_data_header_t),
+                        n - (uint32_t)sizeof (mfs_data_header_t));
+#else
+
+  return mfs_flash_copy(mfsp, doffset, soffset, n);
+#endif
+}
+
 /**
  * @brief   Verifies integrity of a record.
  *
@@ -263,24 +1353,52 @@ static mfs_error_t mfs_record_check(MFSDriver *mfsp,
                                     mfs_record_state_t *sts) {
   unsigned i;
 
-  for (i = 0; i < 3; i++) {
+  for (i = 0; i < sizeof (dhdrp->hdr32) / sizeof (uint32_t); i++) {
     if (dhdrp->hdr32[i] != mfsp->config->erased) {
       /* Not erased must verify the header.*/
-      if ((dhdrp->fields.magic != MFS_HEADER_MAGIC) ||
+      if (!MFS_IS_HEADER_MAGIC(dhdrp->fields.magic) ||
           (dhdrp->fields.id < (uint16_t)1) ||
-          (dhdrp->fields.id > (uint16_t)MFS_CFG_MAX_RECORDS) ||
+          ((dhdrp->fields.id > (uint16_t)MFS_ID_MAX) &&
+           !MFS_IS_RESERVED_ID(dhdrp->fields.id)) ||
+#if MFS_CFG_RECORD_CRC32 == TRUE
+          (dhdrp->fields.reserved1 != (uint16_t)mfsp->config->erased) ||
+#endif
           (dhdrp->fields.size + sizeof (mfs_data_header_t) > limit - offset)) {
         *sts = MFS_RECORD_GARBAGE;
         return MFS_NO_ERROR;
       }
 #if MFS_CFG_STRONG_CHECKING == TRUE
-      {
-        /* TODO: Checking the CRC while reading the record data.*/
-        (void)mfsp;
+      if (dhdrp->fields.size > 0U) {
+        mfs_data_header_t dhdr = *dhdrp;
+        flash_offset_t data_offset;
+        uint32_t n;
+        mfs_crc_t crc;
+
+        /* Checking the CRC while reading the record data, the header is
+           saved because the transient buffer could be used for it.*/
+        data_offset = offset + (flash_offset_t)sizeof (mfs_data_header_t);
+        n           = dhdr.fields.size;
+        crc         = MFS_RECORD_CRC_INIT;
+        while (n > 0U) {
+          size_t chunk = n <= MFS_STAGING_SIZE(mfsp) ?
+                         n : MFS_STAGING_SIZE(mfsp);
+
+          RET_ON_ERROR(mfs_flash_read(mfsp, data_offset, chunk,
+                                      MFS_STAGING_BUFFER(mfsp)));
+          crc = mfs_record_crc(crc, MFS_STAGING_BUFFER(mfsp), chunk);
+          data_offset += (flash_offset_t)chunk;
+          n           -= (uint32_t)chunk;
+        }
+        *dhdrp = dhdr;
+
+        if (crc != dhdr.fields.crc) {
+          *sts = MFS_RECORD_CRC;
+          return MFS_NO_ERROR;
+        }
       }
-#else
-      (void)mfsp;
 #endif
+      *sts = MFS_RECORD_OK;
+      return MFS_NO_ERROR;
     }
   }
 
@@ -290,45 +1408,60 @@ static mfs_error_t mfs_record_check(MFSDriver *mfsp,
 }
 
 /**
- * @brief   Erases and verifies all sectors belonging to a bank.
+ * @brief   Erases and verifies a flash sector.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
- * @param[in] bank      bank to be erased
+ * @param[in] sector    sector to be erased
  * @return              The operation status.
  *
  * @notapi
  */
-static mfs_error_t mfs_bank_erase(MFSDriver *mfsp, mfs_bank_t bank) {
-  flash_sector_t sector, end;
+static mfs_error_t mfs_flash_erase(MFSDriver *mfsp, flash_sector_t sector) {
+  flash_error_t ferr;
 
-  if (bank == MFS_BANK_0) {
-    sector = mfsp->config->bank0_start;
-    end    = mfsp->config->bank0_start + mfsp->config->bank0_sectors;
-  }
-  else {
-    sector = mfsp->config->bank1_start;
-    end    = mfsp->config->bank1_start + mfsp->config->bank1_sectors;
+  ferr = flashStartEraseSector(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashWaitErase(mfsp->config->flashp);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  ferr = flashVerifyErase(mfsp->config->flashp, sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
   }
 
-  while (sector < end) {
-    flash_error_t ferr;
-
-    ferr = flashStartEraseSector(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashWaitErase(mfsp->config->flashp);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
-    ferr = flashVerifyErase(mfsp->config->flashp, sector);
-    if (ferr != FLASH_NO_ERROR) {
-      mfsp->state = MFS_ERROR;
-      return MFS_ERR_FLASH_FAILURE;
-    }
+  return MFS_NO_ERROR;
+}
+
+#if (MFS_CFG_LOG_SECTORS == 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Erases and verifies all sectors belonging to a bank.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] bank      bank to be erased
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_erase(MFSDriver *mfsp, mfs_bank_t bank) {
+  flash_sector_t sector, end;
+
+  if (bank == MFS_BANK_0) {
+    sector = mfsp->config->bank0_start;
+    end    = mfsp->config->bank0_start + mfsp->config->bank0_sectors;
+  }
+  else {
+    sector = mfsp->config->bank1_start;
+    end    = mfsp->config->bank1_start + mfsp->config->bank1_sectors;
+  }
 
+  while (sector < end) {
+    RET_ON_ERROR(mfs_flash_erase(mfsp, sector));
     sector++;
   }
 
@@ -410,38 +1543,40 @@ static mfs_error_t mfs_bank_write_header(MFSDriver *mfsp,
                          sizeof (mfs_bank_header_t),
                          bhdr.hdr8);
 }
+#endif /* MFS_CFG_LOG_SECTORS == 0 */
 
 /**
  * @brief   Scans blocks searching for records.
  * @note    The block integrity is strongly checked.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
- * @param[in] bank      the bank identifier
+ * @param[in] hdr_offset offset of the first record to be scanned
+ * @param[in] end_offset end of the area to be scanned
  * @param[out] statep   bank state, it can be:
  *                      - MFS_BANK_PARTIAL
  *                      - MFS_BANK_OK
  *                      .
  *
- * @param[in] foundcb   callback to be called for each found record or @p NULL
- * @param[in] endcb     callback to be called after scanning or @p NULL
- *
  * @return              The operation status.
  *
  * @notapi
  */
 static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
-                                         mfs_bank_t bank,
+                                         flash_offset_t hdr_offset,
+                                         flash_offset_t end_offset,
                                          mfs_bank_state_t *statep) {
-  flash_offset_t hdr_offset, start_offset, end_offset;
   mfs_record_state_t sts;
   bool warning = false;
 
-  start_offset = mfs_flash_get_bank_offset(mfsp, bank);
-  end_offset   = start_offset + mfsp->config->bank_size;
+#if MFS_CFG_TRANSACTION_MAX > 0
+  mfsp->tr_nops = 0U;
+#endif
 
-  /* Scanning records.*/
-  hdr_offset = start_offset + (flash_offset_t)sizeof(mfs_bank_header_t);
-  while (hdr_offset < end_offset) {
+  /* Scanning records, a tail shorter than a header cannot contain a
+     record, it is left there by erase operations using the reserved
+     header space.*/
+  while (hdr_offset + (flash_offset_t)sizeof (mfs_data_header_t) <=
+         end_offset) {
     /* Reading the current record header.*/
     RET_ON_ERROR(mfs_flash_read(mfsp, hdr_offset,
                                 sizeof (mfs_data_header_t),
@@ -458,22 +1593,108 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
       /* Record OK.*/
       uint32_t size = mfsp->buffer.dhdr.fields.size;
 
+#if MFS_CFG_TRANSACTION_MAX > 0
+      if (mfsp->buffer.dhdr.fields.magic == MFS_TRANSACTION_MAGIC) {
+        mfs_transaction_op_t *top;
+
+        /* Transaction record, it is applied when the end marker is
+           found.*/
+        if (mfsp->buffer.dhdr.fields.id > (uint16_t)MFS_ID_MAX) {
+          warning = true;
+          break;
+        }
+
+        /* Only the most recent records can belong to the transaction
+           being scanned, older ones are left over an interrupted one.*/
+        if (mfsp->tr_nops >= (uint32_t)MFS_CFG_TRANSACTION_MAX) {
+          warning = true;
+          mfsp->tr_nops--;
+          memmove((void *)&mfsp->tr_ops[0], (void *)&mfsp->tr_ops[1],
+                  mfsp->tr_nops * sizeof (mfs_transaction_op_t));
+        }
+        top = &mfsp->tr_ops[mfsp->tr_nops];
+        top->id     = (mfs_id_t)mfsp->buffer.dhdr.fields.id;
+        top->offset = hdr_offset;
+        top->size   = size;
+        mfsp->tr_nops++;
+        hdr_offset += (flash_offset_t)sizeof (mfs_data_header_t) +
+                      (flash_offset_t)size;
+        continue;
+      }
+
+      if (mfsp->buffer.dhdr.fields.id == (uint16_t)MFS_TRANSACTION_ID) {
+        uint32_t nops = (uint32_t)mfsp->buffer.dhdr.fields.crc;
+
+        /* Transaction end marker, the checksum field contains the number
+           of committed operations or zero if rolled back. The committed
+           records are the ones immediately preceding the marker, records
+           before them are left over an interrupted transaction.*/
+        if ((nops > 0U) && (nops != mfsp->tr_nops)) {
+          warning = true;
+        }
+        if ((nops > 0U) && (nops <= mfsp->tr_nops)) {
+          memmove((void *)&mfsp->tr_ops[0],
+                  (void *)&mfsp->tr_ops[mfsp->tr_nops - nops],
+                  nops * sizeof (mfs_transaction_op_t));
+          mfsp->tr_nops = nops;
+          RET_ON_ERROR(mfs_tr_apply(mfsp));
+        }
+        mfsp->tr_nops = 0U;
+        hdr_offset += (flash_offset_t)sizeof (mfs_data_header_t) +
+                      (flash_offset_t)size;
+        continue;
+      }
+
+      if (mfsp->tr_nops > 0U) {
+        /* Transaction records without an end marker, discarded.*/
+        warning = true;
+        mfsp->tr_nops = 0U;
+      }
+#endif
+
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+      /* Checkpoints are not part of the records index.*/
+      if (mfsp->buffer.dhdr.fields.id == (uint16_t)MFS_CHECKPOINT_ID) {
+        hdr_offset += (flash_offset_t)sizeof (mfs_data_header_t) +
+                      (flash_offset_t)size;
+        continue;
+      }
+#endif
+
       /* Zero-sized records are erase markers.*/
       if (size == 0U) {
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].offset = 0U;
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].size   = 0U;
+        mfs_index_remove(mfsp, (mfs_id_t)mfsp->buffer.dhdr.fields.id);
       }
       else {
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].offset = hdr_offset;
-        mfsp->descriptors[mfsp->buffer.dhdr.fields.id - 1U].size   = size;
+        RET_ON_ERROR(mfs_index_update(mfsp,
+                                      (mfs_id_t)mfsp->buffer.dhdr.fields.id,
+                                      hdr_offset, size));
       }
+
+      /* On the next header.*/
+      hdr_offset += (flash_offset_t)sizeof (mfs_data_header_t) +
+                    (flash_offset_t)size;
     }
     else if (sts == MFS_RECORD_CRC) {
       /* Record payload corrupted, scan can continue because the header
          is OK.*/
       warning = true;
+#if MFS_CFG_TRANSACTION_MAX > 0
+      /* A transaction containing a corrupted record is discarded, its
+         end marker will not match the number of records.*/
+      mfsp->tr_nops = 0U;
+#endif
+      hdr_offset += (flash_offset_t)sizeof (mfs_data_header_t) +
+                    (flash_offset_t)mfsp->buffer.dhdr.fields.size;
     }
     else {
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+      /* Padding left over an interrupted write is skipped.*/
+      if (mfsp->buffer.dhdr.hdr8[0] == (uint8_t)~mfsp->config->erased) {
+        hdr_offset++;
+        continue;
+      }
+#endif
       /* Unrecognized header, scanning cannot continue.*/
       warning = true;
       break;
@@ -484,6 +1705,14 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
     return MFS_ERR_INTERNAL;
   }
 
+#if MFS_CFG_TRANSACTION_MAX > 0
+  if (mfsp->tr_nops > 0U) {
+    /* Interrupted transaction, its records are discarded.*/
+    warning = true;
+    mfsp->tr_nops = 0U;
+  }
+#endif
+
   /* Final.*/
   mfsp->next_offset = hdr_offset;
 
@@ -497,6 +1726,7 @@ static mfs_error_t mfs_bank_scan_records(MFSDriver *mfsp,
   return MFS_NO_ERROR;
 }
 
+#if (MFS_CFG_LOG_SECTORS == 0) || defined(__DOXYGEN__)
 /**
  * @brief   Determines the state of a bank.
  * @note    This function does not test the bank integrity by scanning
@@ -562,10 +1792,302 @@ static mfs_error_t mfs_bank_get_state(MFSDriver *mfsp,
   if (err == MFS_NO_ERROR) {
     *statep = MFS_BANK_ERASED;
   }
+  else if (err == MFS_ERR_NOT_ERASED) {
+    /* Erased header but not erased data, it happens when an erase
+       operation has been interrupted, the bank is garbage.*/
+    err = MFS_NO_ERROR;
+  }
 
   return err;
 }
+#endif /* MFS_CFG_LOG_SECTORS == 0 */
+
+/**
+ * @brief   Calculates the used space from the records index.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ *
+ * @notapi
+ */
+static void mfs_state_update_used_space(MFSDriver *mfsp) {
+  unsigned i;
+
+#if MFS_CFG_LOG_SECTORS > 0
+  /* Live records are also accounted to the sector containing them.*/
+  mfsp->used_space = 0U;
+  for (i = 0; i < mfsp->config->log_sectors; i++) {
+    mfsp->log[i].live = 0U;
+  }
+  for (i = 0; i < MFS_INDEX_SIZE(mfsp); i++) {
+    if (mfsp->descriptors[i].offset != 0U) {
+      flash_offset_t size = mfsp->descriptors[i].size +
+                            sizeof (mfs_data_header_t);
+
+      mfsp->log[mfs_log_get_sector(mfsp,
+                                   mfsp->descriptors[i].offset)].live += size;
+      mfsp->used_space += size;
+    }
+  }
+#else
+  mfsp->used_space = MFS_BANK_DATA_OFFSET;
+  for (i = 0; i < MFS_INDEX_SIZE(mfsp); i++) {
+    if (mfsp->descriptors[i].offset != 0U) {
+      mfsp->used_space += mfsp->descriptors[i].size + sizeof (mfs_data_header_t);
+    }
+  }
+#endif
+}
+
+#if (MFS_CFG_INDEX_CHECKPOINT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Fills a checkpoint entry from a records index entry.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] i         records index entry
+ * @param[in] bank_offset offset of the current bank
+ * @param[out] ep       pointer to the checkpoint entry
+ *
+ * @notapi
+ */
+static void mfs_checkpoint_entry(MFSDriver *mfsp, uint32_t i,
+                                 flash_offset_t bank_offset,
+                                 mfs_checkpoint_entry_t *ep) {
+
+  ep->id     = (uint32_t)MFS_INDEX_ID(mfsp, i);
+  ep->offset = (uint32_t)(mfsp->descriptors[i].offset - bank_offset);
+  ep->size   = mfsp->descriptors[i].size;
+}
+
+/**
+ * @brief   Writes a checkpoint of the records index in the current bank.
+ * @details The checkpoint is a record with identifier @p MFS_CHECKPOINT_ID
+ *          written at the current position, its offset is then written in
+ *          the first free checkpoint slot.
+ * @note    Nothing is written if the records index is already covered by
+ *          a checkpoint, if there are records still to be moved by the
+ *          collector, if all slots are used or if there is not enough
+ *          space left.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] reserve   space to be left free after the checkpoint
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_write_checkpoint(MFSDriver *mfsp,
+                                             flash_offset_t reserve) {
+  flash_offset_t bank_offset, cp_offset, data_offset;
+  mfs_checkpoint_entry_t entry;
+  mfs_crc_t crc;
+  uint32_t i, slot, size;
+  size_t n;
+
+  if (mfsp->next_offset == mfsp->checkpoint_offset) {
+    return MFS_NO_ERROR;
+  }
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  if (mfsp->gc_state == MFS_GC_MOVING) {
+    return MFS_NO_ERROR;
+  }
+#endif
+
+  bank_offset = mfs_flash_get_bank_offset(mfsp, mfsp->current_bank);
+  cp_offset   = mfsp->next_offset;
+
+  /* Searching for a free slot.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp,
+                              bank_offset + sizeof (mfs_bank_header_t),
+                              MFS_CFG_CHECKPOINT_SLOTS * sizeof (uint32_t),
+                              mfsp->buffer.data8));
+  for (slot = 0U; slot < (uint32_t)MFS_CFG_CHECKPOINT_SLOTS; slot++) {
+    if (mfsp->buffer.data32[slot] == mfsp->config->erased) {
+      break;
+    }
+  }
+  if (slot >= (uint32_t)MFS_CFG_CHECKPOINT_SLOTS) {
+    return MFS_NO_ERROR;
+  }
+
+  /* Checkpoint size and CRC.*/
+  size = 0U;
+  crc  = MFS_RECORD_CRC_INIT;
+  for (i = 0U; i < MFS_INDEX_SIZE(mfsp); i++) {
+    if (mfsp->descriptors[i].offset != 0U) {
+      mfs_checkpoint_entry(mfsp, i, bank_offset, &entry);
+      crc   = mfs_record_crc(crc, (const uint8_t *)&entry, sizeof (entry));
+      size += (uint32_t)sizeof (mfs_checkpoint_entry_t);
+    }
+  }
+  if ((flash_offset_t)sizeof (mfs_data_header_t) + size + reserve >
+      (bank_offset + mfsp->config->bank_size) - cp_offset) {
+    return MFS_NO_ERROR;
+  }
+
+  /* Writing the header without the magic, it will be written last.*/
+  mfsp->buffer.dhdr.fields.magic = (uint32_t)mfsp->config->erased;
+  mfsp->buffer.dhdr.fields.id    = (uint16_t)MFS_CHECKPOINT_ID;
+#if MFS_CFG_RECORD_CRC32 == TRUE
+  mfsp->buffer.dhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
+#endif
+  mfsp->buffer.dhdr.fields.size  = size;
+  mfsp->buffer.dhdr.fields.crc   = crc;
+  RET_ON_ERROR(mfs_flash_write(mfsp, cp_offset,
+                               sizeof (mfs_data_header_t),
+                               mfsp->buffer.data8));
+
+  /* Writing the entries, as many as fit in the buffer at time.*/
+  data_offset = cp_offset + (flash_offset_t)sizeof (mfs_data_header_t);
+  n = 0U;
+  for (i = 0U; i < MFS_INDEX_SIZE(mfsp); i++) {
+    if (mfsp->descriptors[i].offset != 0U) {
+      mfs_checkpoint_entry(mfsp, i, bank_offset, &entry);
+      memcpy((void *)&mfsp->buffer.data8[n], (const void *)&entry,
+             sizeof (entry));
+      n += sizeof (entry);
+      if (n + sizeof (entry) > MFS_CFG_BUFFER_SIZE) {
+        RET_ON_ERROR(mfs_flash_write(mfsp, data_offset, n,
+                                     mfsp->buffer.data8));
+        data_offset += (flash_offset_t)n;
+        n = 0U;
+      }
+    }
+  }
+  if (n > 0U) {
+    RET_ON_ERROR(mfs_flash_write(mfsp, data_offset, n, mfsp->buffer.data8));
+    data_offset += (flash_offset_t)n;
+  }
+
+  /* Writing the magic number, it seals the checkpoint.*/
+  mfsp->buffer.dhdr.fields.magic = (uint32_t)MFS_HEADER_MAGIC;
+  RET_ON_ERROR(mfs_flash_write(mfsp, cp_offset,
+                               sizeof (uint32_t),
+                               mfsp->buffer.data8));
+  mfsp->next_offset = data_offset;
+
+  /* The slot is written last, it makes the checkpoint visible on mount.*/
+  mfsp->buffer.data32[0] = (uint32_t)(cp_offset - bank_offset);
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               bank_offset + sizeof (mfs_bank_header_t) +
+                               (slot * sizeof (uint32_t)),
+                               sizeof (uint32_t),
+                               mfsp->buffer.data8));
+  mfsp->checkpoint_offset = data_offset;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Loads the most recent checkpoint of a bank in the records index.
+ * @details The checkpoint and its entries are validated, if the validation
+ *          fails then the records index is left empty and the whole bank
+ *          has to be scanned.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] bank      the bank identifier
+ * @param[out] offsetp  offset of the first record not covered by the
+ *                      checkpoint
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_load_checkpoint(MFSDriver *mfsp,
+                                            mfs_bank_t bank,
+                                            flash_offset_t *offsetp) {
+  flash_offset_t bank_offset, cp_offset, data_offset;
+  mfs_checkpoint_entry_t entry;
+  mfs_crc_t crc, cp_crc;
+  uint32_t slot, size, last_id;
+  bool valid;
+
+  bank_offset = mfs_flash_get_bank_offset(mfsp, bank);
+  *offsetp    = bank_offset + MFS_BANK_DATA_OFFSET;
+
+  /* Searching for the last used slot.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp,
+                              bank_offset + sizeof (mfs_bank_header_t),
+                              MFS_CFG_CHECKPOINT_SLOTS * sizeof (uint32_t),
+                              mfsp->buffer.data8));
+  for (slot = (uint32_t)MFS_CFG_CHECKPOINT_SLOTS; slot > 0U; slot--) {
+    if (mfsp->buffer.data32[slot - 1U] != mfsp->config->erased) {
+      break;
+    }
+  }
+  if (slot == 0U) {
+    return MFS_NO_ERROR;
+  }
+  cp_offset = (flash_offset_t)mfsp->buffer.data32[slot - 1U];
+  if ((cp_offset < MFS_BANK_DATA_OFFSET) ||
+      (cp_offset > mfsp->config->bank_size - sizeof (mfs_data_header_t))) {
+    return MFS_NO_ERROR;
+  }
+  cp_offset += bank_offset;
+
+  /* Checking the checkpoint header.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp, cp_offset,
+                              sizeof (mfs_data_header_t),
+                              (void *)&mfsp->buffer.dhdr));
+  if ((mfsp->buffer.dhdr.fields.magic != MFS_HEADER_MAGIC) ||
+      (mfsp->buffer.dhdr.fields.id != (uint16_t)MFS_CHECKPOINT_ID) ||
+#if MFS_CFG_RECORD_CRC32 == TRUE
+      (mfsp->buffer.dhdr.fields.reserved1 != (uint16_t)mfsp->config->erased) ||
+#endif
+      ((mfsp->buffer.dhdr.fields.size % sizeof (mfs_checkpoint_entry_t)) != 0U) ||
+      (mfsp->buffer.dhdr.fields.size + sizeof (mfs_data_header_t) >
+       (bank_offset + mfsp->config->bank_size) - cp_offset)) {
+    return MFS_NO_ERROR;
+  }
+  size   = mfsp->buffer.dhdr.fields.size;
+  cp_crc = mfsp->buffer.dhdr.fields.crc;
+
+  /* Loading entries, records must precede the checkpoint and be sorted
+     by identifier.*/
+  data_offset = cp_offset + (flash_offset_t)sizeof (mfs_data_header_t);
+  crc         = MFS_RECORD_CRC_INIT;
+  last_id     = 0U;
+  valid       = true;
+  while (valid && (size > 0U)) {
+    size_t i, chunk = (MFS_CFG_BUFFER_SIZE / sizeof (mfs_checkpoint_entry_t)) *
+                      sizeof (mfs_checkpoint_entry_t);
+    if (chunk > size) {
+      chunk = size;
+    }
+
+    RET_ON_ERROR(mfs_flash_read(mfsp, data_offset, chunk,
+                                mfsp->buffer.data8));
+    crc = mfs_record_crc(crc, mfsp->buffer.data8, chunk);
+    for (i = 0U; i < chunk; i += sizeof (mfs_checkpoint_entry_t)) {
+      memcpy((void *)&entry, (const void *)&mfsp->buffer.data8[i],
+             sizeof (entry));
+      if ((entry.id <= last_id) || (entry.id > (uint32_t)MFS_ID_MAX) ||
+          (entry.size == 0U) || (entry.offset < MFS_BANK_DATA_OFFSET) ||
+          (entry.offset > cp_offset - bank_offset) ||
+          (entry.size + sizeof (mfs_data_header_t) >
+           (cp_offset - bank_offset) - entry.offset) ||
+          (mfs_index_update(mfsp, (mfs_id_t)entry.id,
+                            bank_offset + entry.offset,
+                            entry.size) != MFS_NO_ERROR)) {
+        valid = false;
+        break;
+      }
+      last_id = entry.id;
+    }
+    data_offset += (flash_offset_t)chunk;
+    size        -= (uint32_t)chunk;
+  }
+
+  if (!valid || (crc != cp_crc)) {
+    mfs_index_reset(mfsp);
+    return MFS_NO_ERROR;
+  }
+
+  *offsetp = data_offset;
+  mfsp->checkpoint_offset = data_offset;
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_INDEX_CHECKPOINT == TRUE */
 
+#if (MFS_CFG_LOG_SECTORS == 0) || defined(__DOXYGEN__)
 /**
  * @brief   Selects a bank as current.
  * @note    The bank header is assumed to be valid.
@@ -585,37 +2107,1051 @@ static mfs_error_t mfs_bank_get_state(MFSDriver *mfsp,
 static mfs_error_t mfs_bank_mount(MFSDriver *mfsp,
                                   mfs_bank_t bank,
                                   mfs_bank_state_t *statep) {
-  unsigned i;
+  flash_offset_t offset;
 
   /* Resetting the bank state, then reading the required header data.*/
   mfs_state_reset(mfsp);
   RET_ON_ERROR(mfs_bank_get_state(mfsp, bank, statep, &mfsp->current_counter));
   mfsp->current_bank = bank;
 
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+  /* Records covered by the most recent checkpoint are not scanned.*/
+  RET_ON_ERROR(mfs_bank_load_checkpoint(mfsp, bank, &offset));
+#else
+  offset = mfs_flash_get_bank_offset(mfsp, bank) + MFS_BANK_DATA_OFFSET;
+#endif
+
   /* Scanning for the most recent instance of all records.*/
-  RET_ON_ERROR(mfs_bank_scan_records(mfsp, bank, statep));
+  RET_ON_ERROR(mfs_bank_scan_records(mfsp, offset, MFS_WRITE_LIMIT(mfsp),
+                                     statep));
 
   /* Calculating the effective used size.*/
-  mfsp->used_space = sizeof (mfs_bank_header_t);
-  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
-    if (mfsp->descriptors[i].offset != 0U) {
-      mfsp->used_space += mfsp->descriptors[i].size + sizeof (mfs_data_header_t);
+  mfs_state_update_used_space(mfsp);
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_LOG_SECTORS == 0 */
+
+/**
+ * @brief   Accounts time spent in garbage collection.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] start     system time at the start of the activity
+ *
+ * @notapi
+ */
+static void mfs_gc_account(MFSDriver *mfsp, systime_t start) {
+  sysinterval_t t = osalTimeDiffX(start, osalOsGetSystemTimeX());
+
+  mfsp->gc_stats.total_time += t;
+  if (t > mfsp->gc_stats.worst_time) {
+    mfsp->gc_stats.worst_time = t;
+  }
+}
+
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Checks if a record still has to be moved by the collector.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] offset    offset of the record header
+ * @return              The record state.
+ * @retval true         if the record is in the source bank.
+ *
+ * @notapi
+ */
+static bool mfs_gc_is_pending(MFSDriver *mfsp, flash_offset_t offset) {
+  flash_offset_t start = mfs_flash_get_bank_offset(mfsp, mfsp->current_bank);
+
+  return (mfsp->gc_state == MFS_GC_MOVING) &&
+         ((offset < start) || (offset >= start + mfsp->config->bank_size));
+}
+
+/**
+ * @brief   Removes an obsolete record from the records to be moved.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] dp        descriptor of the obsolete record
+ *
+ * @notapi
+ */
+static void mfs_gc_discard(MFSDriver *mfsp, mfs_record_descriptor_t *dp) {
+
+  if (mfs_gc_is_pending(mfsp, dp->offset)) {
+    mfsp->gc_pending -= dp->size + sizeof (mfs_data_header_t);
+  }
+}
+
+/**
+ * @brief   Enters the records moving phase.
+ * @note    The bank not in use becomes the source bank.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ *
+ * @notapi
+ */
+static void mfs_gc_begin_moving(MFSDriver *mfsp) {
+  uint32_t i;
+
+  mfsp->gc_state   = MFS_GC_MOVING;
+  mfsp->gc_index   = 0U;
+  mfsp->gc_pending = 0U;
+  for (i = 0; i < MFS_INDEX_SIZE(mfsp); i++) {
+    if ((mfsp->descriptors[i].offset != 0U) &&
+        mfs_gc_is_pending(mfsp, mfsp->descriptors[i].offset)) {
+      mfsp->gc_pending += mfsp->descriptors[i].size +
+                          sizeof (mfs_data_header_t);
+    }
+  }
+}
+
+/**
+ * @brief   Moves records from the source bank.
+ * @details When all records have been moved the source bank erase phase
+ *          is entered.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] n         maximum number of records to be moved
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_move(MFSDriver *mfsp, uint32_t n) {
+  mfs_bank_t sbank;
+
+  while (mfsp->gc_index < MFS_INDEX_SIZE(mfsp)) {
+    mfs_record_descriptor_t *dp = &mfsp->descriptors[mfsp->gc_index];
+
+    if ((dp->offset != 0U) && mfs_gc_is_pending(mfsp, dp->offset)) {
+      uint32_t totsize = dp->size + sizeof (mfs_data_header_t);
+
+      if (n == 0U) {
+        return MFS_NO_ERROR;
+      }
+      n--;
+
+      RET_ON_ERROR(mfs_record_copy(mfsp, mfsp->next_offset,
+                                   dp->offset, totsize));
+      dp->offset         = mfsp->next_offset;
+      mfsp->next_offset += totsize;
+      mfsp->gc_pending  -= totsize;
+      mfsp->gc_stats.moved_records++;
+      mfsp->gc_stats.moved_bytes += totsize;
+    }
+    mfsp->gc_index++;
+  }
+
+  /* All records moved, the source bank can be erased.*/
+  sbank = mfsp->current_bank == MFS_BANK_0 ? MFS_BANK_1 : MFS_BANK_0;
+  if (sbank == MFS_BANK_0) {
+    mfsp->gc_sector = mfsp->config->bank0_start;
+    mfsp->gc_end    = mfsp->config->bank0_start + mfsp->config->bank0_sectors;
+  }
+  else {
+    mfsp->gc_sector = mfsp->config->bank1_start;
+    mfsp->gc_end    = mfsp->config->bank1_start + mfsp->config->bank1_sectors;
+  }
+  mfsp->gc_pending = 0U;
+  mfsp->gc_state   = MFS_GC_ERASING;
+
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+  /* All records are in the current bank, checkpoint of the index.*/
+  RET_ON_ERROR(mfs_bank_write_checkpoint(mfsp, 0U));
+#endif
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Starts erasing the next sector of the source bank.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_erase_start(MFSDriver *mfsp) {
+  flash_error_t ferr;
+
+  ferr = flashStartEraseSector(mfsp->config->flashp, mfsp->gc_sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  mfsp->gc_state = MFS_GC_WAITING;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Verifies a sector after its erase operation completed.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_erase_end(MFSDriver *mfsp) {
+  flash_error_t ferr;
+
+  ferr = flashVerifyErase(mfsp->config->flashp, mfsp->gc_sector);
+  if (ferr != FLASH_NO_ERROR) {
+    mfsp->state = MFS_ERROR;
+    return MFS_ERR_FLASH_FAILURE;
+  }
+  mfsp->gc_stats.erased_sectors++;
+
+  /* Next sector, if any.*/
+  mfsp->gc_sector++;
+  mfsp->gc_state = mfsp->gc_sector < mfsp->gc_end ? MFS_GC_ERASING :
+                                                    MFS_GC_IDLE;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Waits for the sector erase in progress, if any.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_erase_wait(MFSDriver *mfsp) {
+  flash_error_t ferr;
+
+  if (mfsp->gc_state == MFS_GC_WAITING) {
+    ferr = flashWaitErase(mfsp->config->flashp);
+    if (ferr != FLASH_NO_ERROR) {
+      mfsp->state = MFS_ERROR;
+      return MFS_ERR_FLASH_FAILURE;
+    }
+    RET_ON_ERROR(mfs_gc_erase_end(mfsp));
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Completes the garbage collection in progress, if any.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_finish(MFSDriver *mfsp) {
+
+  while (mfsp->gc_state != MFS_GC_IDLE) {
+    if (mfsp->gc_state == MFS_GC_MOVING) {
+      RET_ON_ERROR(mfs_gc_move(mfsp, (uint32_t)MFS_CFG_MAX_RECORDS));
+    }
+    else if (mfsp->gc_state == MFS_GC_ERASING) {
+      RET_ON_ERROR(mfs_gc_erase_start(mfsp));
+    }
+    else {
+      RET_ON_ERROR(mfs_gc_erase_wait(mfsp));
+    }
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Makes sure the flash is not busy because a collection step.
+ * @note    The worst case is waiting for a single sector erase.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_wait(MFSDriver *mfsp) {
+
+  if (mfsp->gc_state == MFS_GC_WAITING) {
+    systime_t start = osalOsGetSystemTimeX();
+
+    RET_ON_ERROR(mfs_gc_erase_wait(mfsp));
+    mfs_gc_account(mfsp, start);
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Performs a bounded garbage collection step.
+ * @details A step moves up to @p MFS_CFG_GC_STEP_RECORDS records, starts
+ *          a sector erase or checks if the erase in progress is finished,
+ *          it never waits for the flash.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[out] msecp    suggested delay before the next step or @p NULL
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_gc_step(MFSDriver *mfsp, uint32_t *msecp) {
+  systime_t start = osalOsGetSystemTimeX();
+  uint32_t msec = 0U;
+  flash_error_t ferr;
+
+  switch (mfsp->gc_state) {
+  case MFS_GC_MOVING:
+    RET_ON_ERROR(mfs_gc_move(mfsp, (uint32_t)MFS_CFG_GC_STEP_RECORDS));
+    break;
+  case MFS_GC_ERASING:
+    RET_ON_ERROR(mfs_gc_erase_start(mfsp));
+    break;
+  case MFS_GC_WAITING:
+    ferr = flashQueryErase(mfsp->config->flashp, &msec);
+    if (ferr == FLASH_NO_ERROR) {
+      msec = 0U;
+      RET_ON_ERROR(mfs_gc_erase_end(mfsp));
+    }
+    else if (ferr != FLASH_BUSY_ERASING) {
+      mfsp->state = MFS_ERROR;
+      return MFS_ERR_FLASH_FAILURE;
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (mfsp->gc_state != MFS_GC_IDLE) {
+    mfs_gc_account(mfsp, start);
+  }
+  if (msecp != NULL) {
+    *msecp = msec;
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Fills the garbage left by an interrupted write with padding.
+ * @details The area between the scan end and the last written location
+ *          is programmed with the complement of the erased value, the
+ *          scan skips it on the next mounts.
+ * @note    This requires a flash allowing to program locations already
+ *          programmed.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_pad(MFSDriver *mfsp) {
+  flash_offset_t end;
+
+  /* Searching backward for the last written location.*/
+  end = mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
+        mfsp->config->bank_size;
+  while (end > mfsp->next_offset) {
+    size_t i, chunk = end - mfsp->next_offset;
+
+    if (chunk > MFS_CFG_BUFFER_SIZE) {
+      chunk = MFS_CFG_BUFFER_SIZE;
+    }
+    RET_ON_ERROR(mfs_flash_read(mfsp, end - chunk, chunk,
+                                mfsp->buffer.data8));
+    for (i = chunk; i > 0U; i--) {
+      if (mfsp->buffer.data8[i - 1U] != (uint8_t)mfsp->config->erased) {
+        break;
+      }
+    }
+    if (i > 0U) {
+      end = end - chunk + i;
+      break;
+    }
+    end -= chunk;
+  }
+
+  /* Programming the padding.*/
+  while (mfsp->next_offset < end) {
+    size_t chunk = (size_t)(((mfsp->next_offset | (MFS_CFG_BUFFER_SIZE - 1U)) + 1U) -
+                            mfsp->next_offset);
+    if (chunk > end - mfsp->next_offset) {
+      chunk = end - mfsp->next_offset;
+    }
+
+    memset((void *)mfsp->buffer.data8, ~mfsp->config->erased, chunk);
+    RET_ON_ERROR(mfs_flash_write(mfsp, mfsp->next_offset, chunk,
+                                 mfsp->buffer.data8));
+    mfsp->next_offset += chunk;
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Mounts both banks after an interrupted collection.
+ * @details The older bank is scanned first then the newer bank, records
+ *          in the newer bank supersede the older ones. The collection is
+ *          resumed from the moving phase.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] bank      the newer bank
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_bank_mount_pair(MFSDriver *mfsp, mfs_bank_t bank) {
+  mfs_bank_t obank = bank == MFS_BANK_0 ? MFS_BANK_1 : MFS_BANK_0;
+  mfs_bank_state_t sts;
+
+  mfs_state_reset(mfsp);
+  RET_ON_ERROR(mfs_bank_scan_records(mfsp,
+                                     mfs_flash_get_bank_offset(mfsp, obank) +
+                                     MFS_BANK_DATA_OFFSET,
+                                     mfs_flash_get_bank_offset(mfsp, obank) +
+                                     mfsp->config->bank_size,
+                                     &sts));
+  RET_ON_ERROR(mfs_bank_get_state(mfsp, bank, &sts, &mfsp->current_counter));
+  mfsp->current_bank = bank;
+  RET_ON_ERROR(mfs_bank_scan_records(mfsp,
+                                     mfs_flash_get_bank_offset(mfsp, bank) +
+                                     MFS_BANK_DATA_OFFSET,
+                                     MFS_WRITE_LIMIT(mfsp),
+                                     &sts));
+
+  /* The newer bank cannot be compacted while the older one still
+     contains records, garbage is covered with padding instead.*/
+  if (sts == MFS_BANK_PARTIAL) {
+    RET_ON_ERROR(mfs_bank_pad(mfsp));
+  }
+
+  mfs_state_update_used_space(mfsp);
+  mfs_gc_begin_moving(mfsp);
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_INCREMENTAL_GC == TRUE */
+
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Writes the erase count in the header of an erased log sector.
+ * @details The magic is written after the count, a sector with a valid
+ *          magic always has a valid erase count.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] i         index of the sector in the log
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_log_write_erases(MFSDriver *mfsp, uint32_t i) {
+  mfs_sector_header_t shdr;
+
+  shdr.fields.magic  = MFS_SECTOR_MAGIC;
+  shdr.fields.erases = mfsp->log[i].erases;
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               mfs_log_get_offset(mfsp, i) +
+                               (flash_offset_t)sizeof (uint32_t),
+                               sizeof (uint32_t),
+                               &shdr.hdr8[sizeof (uint32_t)]));
+
+  return mfs_flash_write(mfsp, mfs_log_get_offset(mfsp, i),
+                         sizeof (uint32_t), shdr.hdr8);
+}
+
+/**
+ * @brief   Erases a log sector and makes it a free sector.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] i         index of the sector in the log
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_log_erase(MFSDriver *mfsp, uint32_t i) {
+
+  RET_ON_ERROR(mfs_flash_erase(mfsp,
+                               mfsp->config->log_start + (flash_sector_t)i));
+  mfsp->log[i].sequence = 0U;
+  mfsp->log[i].erases++;
+  mfsp->log[i].used     = 0U;
+  mfsp->log[i].live     = 0U;
+
+  return mfs_log_write_erases(mfsp, i);
+}
+
+/**
+ * @brief   Returns the number of free log sectors.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The number of free sectors.
+ *
+ * @notapi
+ */
+static uint32_t mfs_log_get_free(MFSDriver *mfsp) {
+  uint32_t i, n = 0U;
+
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    if (mfsp->log[i].sequence == 0U) {
+      n++;
+    }
+  }
+
+  return n;
+}
+
+/**
+ * @brief   Adds a free sector to the log.
+ * @details The least erased free sector is selected, records are appended
+ *          to it from now on.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] source    sequence number of the sector collected into the
+ *                      new one or the erased value
+ * @return              The operation status.
+ * @retval MFS_ERR_OUT_OF_MEM if there are no free sectors.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_log_open(MFSDriver *mfsp, uint32_t source) {
+  mfs_sector_header_t shdr;
+  uint32_t i, head = MFS_LOG_NONE;
+
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    if ((mfsp->log[i].sequence == 0U) &&
+        ((head == MFS_LOG_NONE) ||
+         (mfsp->log[i].erases < mfsp->log[head].erases))) {
+      head = i;
+    }
+  }
+  if (head == MFS_LOG_NONE) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+
+  /* The previous sector is not written anymore.*/
+  if (mfsp->log[mfsp->log_head].sequence != 0U) {
+    mfsp->log[mfsp->log_head].used = mfsp->next_offset -
+                                     mfs_log_get_offset(mfsp, mfsp->log_head);
+  }
+
+  /* Writing the header fields following the erase count.*/
+  shdr.fields.magic     = MFS_SECTOR_MAGIC;
+  shdr.fields.erases    = mfsp->log[head].erases;
+  shdr.fields.sequence  = mfsp->current_counter + 1U;
+  shdr.fields.source    = source;
+  shdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
+  shdr.fields.crc       = crc16(0xFFFFU, shdr.hdr8,
+                                sizeof (mfs_sector_header_t) -
+                                sizeof (uint32_t) - sizeof (uint16_t));
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               mfs_log_get_offset(mfsp, head) +
+                               2U * (flash_offset_t)sizeof (uint32_t),
+                               sizeof (mfs_sector_header_t) -
+                               3U * sizeof (uint32_t),
+                               &shdr.hdr8[2U * sizeof (uint32_t)]));
+
+  /* New sector being written.*/
+  mfsp->current_counter    = shdr.fields.sequence;
+  mfsp->log_head           = head;
+  mfsp->log[head].sequence = shdr.fields.sequence;
+  mfsp->log[head].used     = (flash_offset_t)sizeof (mfs_sector_header_t);
+  mfsp->log[head].live     = 0U;
+  mfsp->next_offset        = mfs_log_get_offset(mfsp, head) +
+                             (flash_offset_t)sizeof (mfs_sector_header_t);
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Adds a sector to the log if the sector being written is full.
+ * @details A sector is added only while another one remains free for the
+ *          garbage collector, no records are moved.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] reserve   space required by the operation
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_log_extend(MFSDriver *mfsp, flash_offset_t reserve) {
+
+  if ((reserve > MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset) &&
+      (mfs_log_get_free(mfsp) >= 2U)) {
+    return mfs_log_open(mfsp, mfsp->config->erased);
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Determines the state of a log sector.
+ * @note    This function does not test the sector integrity by scanning
+ *          the data area, it just checks the header.
+ * @note    The erase count is set to the erased value if it cannot be
+ *          read from the header.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] i         index of the sector in the log
+ * @param[out] statep   sector state, it can be:
+ *                      - MFS_SECTOR_ERASED
+ *                      - MFS_SECTOR_FREE
+ *                      - MFS_SECTOR_GARBAGE
+ *                      - MFS_SECTOR_OK
+ *                      .
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_log_get_state(MFSDriver *mfsp,
+                                     uint32_t i,
+                                     mfs_sector_state_t *statep) {
+  mfs_sector_header_t *shdrp = &mfsp->buffer.shdr;
+  flash_error_t ferr;
+  unsigned j;
+
+  /* Worst case is default.*/
+  *statep = MFS_SECTOR_GARBAGE;
+  mfsp->log[i].erases = mfsp->config->erased;
+
+  /* Reading the sector header.*/
+  RET_ON_ERROR(mfs_flash_read(mfsp, mfs_log_get_offset(mfsp, i),
+                              sizeof (mfs_sector_header_t), shdrp->hdr8));
+
+  /* Checking the special case where the header is erased.*/
+  for (j = 0; j < 6; j++) {
+    if (shdrp->hdr32[j] != mfsp->config->erased) {
+      break;
+    }
+  }
+  if (j >= 6) {
+    /* If the header is erased then it could be the whole sector erased.*/
+    ferr = flashVerifyErase(mfsp->config->flashp,
+                            mfsp->config->log_start + (flash_sector_t)i);
+    if (ferr == FLASH_NO_ERROR) {
+      *statep = MFS_SECTOR_ERASED;
+    }
+    else if (ferr != FLASH_ERROR_VERIFY) {
+      mfsp->state = MFS_ERROR;
+      return MFS_ERR_FLASH_FAILURE;
+    }
+    return MFS_NO_ERROR;
+  }
+
+  /* The erase count is known if the magic has been written.*/
+  if ((shdrp->fields.magic != MFS_SECTOR_MAGIC) ||
+      (shdrp->fields.erases == mfsp->config->erased)) {
+    return MFS_NO_ERROR;
+  }
+  mfsp->log[i].erases = shdrp->fields.erases;
+
+  /* Free sector, the sector has not been added to the log yet.*/
+  for (j = 2; j < 6; j++) {
+    if (shdrp->hdr32[j] != mfsp->config->erased) {
+      break;
+    }
+  }
+  if (j >= 6) {
+    *statep = MFS_SECTOR_FREE;
+    return MFS_NO_ERROR;
+  }
+
+  /* Checking header fields integrity.*/
+  if ((shdrp->fields.sequence == 0U) ||
+      (shdrp->fields.sequence == mfsp->config->erased) ||
+      (shdrp->fields.reserved1 != (uint16_t)mfsp->config->erased) ||
+      (shdrp->fields.crc != crc16(0xFFFFU, shdrp->hdr8,
+                                  sizeof (mfs_sector_header_t) -
+                                  sizeof (uint32_t) - sizeof (uint16_t)))) {
+    return MFS_NO_ERROR;
+  }
+
+  mfsp->log[i].sequence = shdrp->fields.sequence;
+  *statep = MFS_SECTOR_OK;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Collects a log sector.
+ * @details The live records of the sector are appended to the log then
+ *          the sector is erased. If the live records do not fit the
+ *          sector being written then a free sector is added to the log,
+ *          its header refers to the collected sector and marks the end of
+ *          the copy, an interrupted collection is completed or undone on
+ *          mount.
+ * @note    Erase markers are copied as long as older sectors could
+ *          contain instances of the erased records.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] victim    index of the sector to be collected
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_log_collect(MFSDriver *mfsp, uint32_t victim) {
+  flash_offset_t offset, end;
+  uint32_t i, sequence = mfsp->log[victim].sequence;
+  bool older = false, fresh = false;
+
+  /* Checking for sectors older than the collected one.*/
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    if ((mfsp->log[i].sequence != 0U) && (mfsp->log[i].sequence < sequence)) {
+      older = true;
+    }
+  }
+
+  /* A sector cannot be collected into itself.*/
+  if ((victim == mfsp->log_head) ||
+      (mfsp->log[victim].live > MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset)) {
+    RET_ON_ERROR(mfs_log_open(mfsp, sequence));
+    fresh = true;
+  }
+
+  /* Copying the most recent record instances only.*/
+  offset = mfs_log_get_offset(mfsp, victim) +
+           (flash_offset_t)sizeof (mfs_sector_header_t);
+  end    = mfs_log_get_offset(mfsp, victim) + mfsp->log[victim].used;
+  while (offset + (flash_offset_t)sizeof (mfs_data_header_t) <= end) {
+    mfs_record_descriptor_t *dp = NULL;
+    uint32_t totsize;
+    mfs_id_t id;
+    bool copy;
+
+    RET_ON_ERROR(mfs_flash_read(mfsp, offset, sizeof (mfs_data_header_t),
+                                mfsp->buffer.data8));
+    if (!MFS_IS_HEADER_MAGIC(mfsp->buffer.dhdr.fields.magic)) {
+      return MFS_ERR_INTERNAL;
+    }
+    id      = (mfs_id_t)mfsp->buffer.dhdr.fields.id;
+    totsize = mfsp->buffer.dhdr.fields.size + sizeof (mfs_data_header_t);
+
+    if ((id < 1U) || (id > (mfs_id_t)MFS_ID_MAX)) {
+      /* Transaction end markers are not required anymore.*/
+      copy = false;
+    }
+    else if (totsize == sizeof (mfs_data_header_t)) {
+      /* Erase marker.*/
+      copy = older && (mfs_index_find(mfsp, id) == NULL);
+    }
+    else {
+      dp   = mfs_index_find(mfsp, id);
+      copy = (dp != NULL) && (dp->offset == offset);
+    }
+
+    if (copy) {
+      if (totsize > MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset) {
+        if (fresh) {
+          return MFS_ERR_INTERNAL;
+        }
+        RET_ON_ERROR(mfs_log_open(mfsp, sequence));
+        fresh = true;
+      }
+      RET_ON_ERROR(mfs_record_copy(mfsp, mfsp->next_offset, offset, totsize));
+      if (dp != NULL) {
+        dp->offset = mfsp->next_offset;
+        mfsp->log[victim].live -= totsize;
+        mfsp->log[mfsp->log_head].live += totsize;
+      }
+      mfsp->next_offset += totsize;
+      mfsp->gc_stats.moved_records++;
+      mfsp->gc_stats.moved_bytes += totsize;
+    }
+
+    offset += totsize;
+  }
+
+  /* Marking the end of the copy before erasing the collected sector.*/
+  if (fresh) {
+    uint32_t collected = ~mfsp->config->erased;
+
+    RET_ON_ERROR(mfs_flash_write(mfsp,
+                                 mfs_log_get_offset(mfsp, mfsp->log_head) +
+                                 (flash_offset_t)sizeof (mfs_sector_header_t) -
+                                 (flash_offset_t)sizeof (uint32_t),
+                                 sizeof (uint32_t),
+                                 (const uint8_t *)&collected));
+  }
+
+  RET_ON_ERROR(mfs_log_erase(mfsp, victim));
+  mfsp->gc_stats.collections++;
+  mfsp->gc_stats.erased_sectors++;
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Selects the next sector to be collected.
+ * @details The sector with the most space used by obsolete records is
+ *          selected, the least erased one among equals. If wear leveling
+ *          is allowed and the least erased sector in use lags behind the
+ *          most erased sector by more than @p MFS_CFG_LOG_WEAR_THRESHOLD
+ *          erase cycles then it is selected instead.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in,out] levelp wear leveling enable, it is cleared if a sector is
+ *                      selected for wear leveling
+ * @return              The index of the selected sector.
+ * @retval MFS_LOG_NONE if there is nothing to be collected.
+ *
+ * @notapi
+ */
+static uint32_t mfs_log_select(MFSDriver *mfsp, bool *levelp) {
+  uint32_t i, victim = MFS_LOG_NONE, cold = MFS_LOG_NONE, max = 0U;
+  flash_offset_t best = 0U;
+
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    mfs_log_sector_t *lsp = &mfsp->log[i];
+    flash_offset_t dead;
+
+    if (lsp->erases > max) {
+      max = lsp->erases;
+    }
+
+    /* Only sectors not being written are candidates.*/
+    if ((lsp->sequence == 0U) || (i == mfsp->log_head)) {
+      continue;
+    }
+
+    if ((cold == MFS_LOG_NONE) || (lsp->erases < mfsp->log[cold].erases)) {
+      cold = i;
+    }
+
+    dead = lsp->used - (flash_offset_t)sizeof (mfs_sector_header_t) -
+           lsp->live;
+    if ((dead > best) ||
+        ((dead == best) && (victim != MFS_LOG_NONE) &&
+         (lsp->erases < mfsp->log[victim].erases))) {
+      best   = dead;
+      victim = i;
+    }
+  }
+
+  /* Static wear leveling, data is moved out of a sector lagging behind.*/
+  if (*levelp && (cold != MFS_LOG_NONE) &&
+      (max - mfsp->log[cold].erases > (uint32_t)MFS_CFG_LOG_WEAR_THRESHOLD)) {
+    *levelp = false;
+    return cold;
+  }
+
+  return victim;
+}
+
+/**
+ * @brief   Enforces a garbage collection.
+ * @details Sectors are collected until the sector being written has space
+ *          for @p reserve bytes, a free sector is always left for the
+ *          collector. If @p reserve is zero then all the sectors
+ *          containing obsolete records are collected.
+ *
+ * @param[out] mfsp     pointer to the @p MFSDriver object
+ * @param[in] reserve   space required after the collection by the
+ *                      operation triggering it
+ * @return              The operation status.
+ * @retval MFS_ERR_OUT_OF_MEM if the space cannot be reclaimed.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp,
+                                       flash_offset_t reserve) {
+  systime_t start = osalOsGetSystemTimeX();
+  bool level = true;
+  uint32_t n;
+
+  for (n = 0U; n < 2U * mfsp->config->log_sectors; n++) {
+    uint32_t victim;
+
+    if (reserve > 0U) {
+      /* Done when the sector being written has enough space.*/
+      RET_ON_ERROR(mfs_log_extend(mfsp, reserve));
+      if (reserve <= MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset) {
+        break;
+      }
+    }
+
+    victim = mfs_log_select(mfsp, &level);
+    if (victim == MFS_LOG_NONE) {
+      break;
+    }
+    RET_ON_ERROR(mfs_log_collect(mfsp, victim));
+  }
+
+  mfs_gc_account(mfsp, start);
+
+  if (reserve > MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Performs a flash partition mount attempt.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ *
+ * @api
+ */
+static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
+  mfs_sector_state_t states[MFS_CFG_LOG_SECTORS];
+  mfs_bank_state_t sts;
+  uint32_t i, head, last, max = 0U;
+  bool warning = false;
+
+  mfs_state_reset(mfsp);
+
+  /* Assessing the state of all sectors.*/
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    RET_ON_ERROR(mfs_log_get_state(mfsp, i, &states[i]));
+    if ((mfsp->log[i].erases != mfsp->config->erased) &&
+        (mfsp->log[i].erases > max)) {
+      max = mfsp->log[i].erases;
+    }
+  }
+
+  /* Sectors not belonging to the log become free sectors, unknown erase
+     counts are assumed to be the highest known one.*/
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    if (mfsp->log[i].erases == mfsp->config->erased) {
+      mfsp->log[i].erases = max;
+    }
+    if (states[i] == MFS_SECTOR_GARBAGE) {
+      RET_ON_ERROR(mfs_log_erase(mfsp, i));
+      warning = true;
+    }
+    else if (states[i] == MFS_SECTOR_ERASED) {
+      RET_ON_ERROR(mfs_log_write_erases(mfsp, i));
+    }
+  }
+
+  /* The most recent sector refers to the sector being collected into it,
+     if that sector still exists then the collection has been
+     interrupted.*/
+  head = MFS_LOG_NONE;
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    if ((mfsp->log[i].sequence != 0U) &&
+        ((head == MFS_LOG_NONE) ||
+         (mfsp->log[i].sequence > mfsp->log[head].sequence))) {
+      head = i;
+    }
+  }
+  if (head != MFS_LOG_NONE) {
+    RET_ON_ERROR(mfs_flash_read(mfsp, mfs_log_get_offset(mfsp, head),
+                                sizeof (mfs_sector_header_t),
+                                mfsp->buffer.data8));
+    for (i = 0U; i < mfsp->config->log_sectors; i++) {
+      if ((i != head) && (mfsp->log[i].sequence != 0U) &&
+          (mfsp->log[i].sequence == mfsp->buffer.shdr.fields.source)) {
+        if (mfsp->buffer.shdr.fields.collected == mfsp->config->erased) {
+          /* Records were still being copied, the copies are discarded.*/
+          RET_ON_ERROR(mfs_log_erase(mfsp, head));
+        }
+        else {
+          /* All records have been copied, the erase of the collected
+             sector has been interrupted.*/
+          RET_ON_ERROR(mfs_log_erase(mfsp, i));
+        }
+        warning = true;
+        break;
+      }
+    }
+  }
+
+  /* Scanning the sectors in log order for the most recent instance of all
+     records.*/
+  last = 0U;
+  while (true) {
+    uint32_t next = MFS_LOG_NONE;
+    flash_offset_t offset;
+
+    for (i = 0U; i < mfsp->config->log_sectors; i++) {
+      if ((mfsp->log[i].sequence > last) &&
+          ((next == MFS_LOG_NONE) ||
+           (mfsp->log[i].sequence < mfsp->log[next].sequence))) {
+        next = i;
+      }
+    }
+    if (next == MFS_LOG_NONE) {
+      break;
+    }
+
+    offset = mfs_log_get_offset(mfsp, next);
+    RET_ON_ERROR(mfs_bank_scan_records(mfsp,
+                                       offset +
+                                       (flash_offset_t)sizeof (mfs_sector_header_t),
+                                       offset + mfsp->log_size,
+                                       &sts));
+    mfsp->log[next].used  = mfsp->next_offset - offset;
+    if (sts == MFS_BANK_PARTIAL) {
+      states[next] = MFS_SECTOR_PARTIAL;
+      warning = true;
+    }
+    mfsp->log_head        = next;
+    mfsp->current_counter = mfsp->log[next].sequence;
+    last                  = mfsp->log[next].sequence;
+  }
+
+  /* Empty log, first initialization.*/
+  if (mfsp->current_counter == 0U) {
+    RET_ON_ERROR(mfs_log_open(mfsp, mfsp->config->erased));
+  }
+
+  /* Calculating the effective used size.*/
+  mfs_state_update_used_space(mfsp);
+
+  /* Sectors containing garbage are collected in order to remove
+     anomalies, without free sectors a damaged sector being written is
+     just not written anymore.*/
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    if ((states[i] == MFS_SECTOR_PARTIAL) && (mfsp->log[i].sequence != 0U)) {
+      if (mfs_log_get_free(mfsp) > 0U) {
+        RET_ON_ERROR(mfs_log_collect(mfsp, i));
+      }
+      else if (i == mfsp->log_head) {
+        mfsp->next_offset = MFS_WRITE_LIMIT(mfsp);
+      }
     }
   }
 
-  return MFS_NO_ERROR;
+  return warning ? MFS_WARN_REPAIR : MFS_NO_ERROR;
 }
 
+#else /* MFS_CFG_LOG_SECTORS == 0 */
 /**
  * @brief   Enforces a garbage collection.
  * @details Storage data is compacted into a single bank.
+ * @note    In incremental mode a pending collection is completed, then
+ *          a new one is started by switching bank, records are moved
+ *          later by collection steps.
  *
  * @param[out] mfsp     pointer to the @p MFSDriver object
+ * @param[in] reserve   space required after the collection by the
+ *                      operation triggering it
  * @return              The operation status.
  *
  * @notapi
  */
-static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
+static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp,
+                                       flash_offset_t reserve) {
+  systime_t start = osalOsGetSystemTimeX();
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  mfs_bank_t dbank;
+
+  /* Space is reserved by the caller for records still to be moved.*/
+  (void)reserve;
+
+  /* The other bank must be fully erased before it can be used.*/
+  RET_ON_ERROR(mfs_gc_finish(mfsp));
+
+  dbank = mfsp->current_bank == MFS_BANK_0 ? MFS_BANK_1 : MFS_BANK_0;
+
+  /* The header is written before moving data, until the source bank is
+     erased both banks are valid and are merged on mount.*/
+  RET_ON_ERROR(mfs_bank_write_header(mfsp, dbank, mfsp->current_counter + 1U));
+
+  /* New current bank.*/
+  mfsp->current_bank = dbank;
+  mfsp->current_counter += 1U;
+  mfsp->next_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
+                      MFS_BANK_DATA_OFFSET;
+  mfs_gc_begin_moving(mfsp);
+  mfsp->gc_stats.collections++;
+#else
   unsigned i;
   mfs_bank_t sbank, dbank;
   flash_offset_t dest_offset;
@@ -630,17 +3166,19 @@ static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
 
   /* Write address.*/
   dest_offset = mfs_flash_get_bank_offset(mfsp, dbank) +
-                sizeof (mfs_bank_header_t);
+                MFS_BANK_DATA_OFFSET;
 
   /* Copying the most recent record instances only.*/
-  for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+  for (i = 0; i < MFS_INDEX_SIZE(mfsp); i++) {
     uint32_t totsize = mfsp->descriptors[i].size + sizeof (mfs_data_header_t);
     if (mfsp->descriptors[i].offset != 0) {
-      RET_ON_ERROR(mfs_flash_copy(mfsp, dest_offset,
-                                  mfsp->descriptors[i].offset,
-                                  totsize));
+      RET_ON_ERROR(mfs_record_copy(mfsp, dest_offset,
+                                   mfsp->descriptors[i].offset,
+                                   totsize));
       mfsp->descriptors[i].offset = dest_offset;
       dest_offset += totsize;
+      mfsp->gc_stats.moved_records++;
+      mfsp->gc_stats.moved_bytes += totsize;
     }
   }
 
@@ -649,11 +3187,26 @@ static mfs_error_t mfs_garbage_collect(MFSDriver *mfsp) {
   mfsp->current_counter += 1U;
   mfsp->next_offset = dest_offset;
 
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+  /* Checkpoint of the compacted index, the space required by the
+     operation triggering the collection is preserved.*/
+  RET_ON_ERROR(mfs_bank_write_checkpoint(mfsp, reserve));
+#else
+  (void)reserve;
+#endif
+
   /* The header is written after the data.*/
   RET_ON_ERROR(mfs_bank_write_header(mfsp, dbank, mfsp->current_counter));
 
   /* The source bank is erased last.*/
   RET_ON_ERROR(mfs_bank_erase(mfsp, sbank));
+  mfsp->gc_stats.collections++;
+  mfsp->gc_stats.erased_sectors += sbank == MFS_BANK_0 ?
+                                   mfsp->config->bank0_sectors :
+                                   mfsp->config->bank1_sectors;
+#endif
+
+  mfs_gc_account(mfsp, start);
 
   return MFS_NO_ERROR;
 }
@@ -687,6 +3240,14 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
     break;
 
   case PAIR(MFS_BANK_OK, MFS_BANK_OK):
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* Both banks appear to be valid, a garbage collection has been
+       interrupted, the newer bank is mounted over the older one and the
+       collection is resumed.*/
+    RET_ON_ERROR(mfs_bank_mount_pair(mfsp, cnt0 > cnt1 ? MFS_BANK_0 :
+                                                         MFS_BANK_1));
+    return MFS_WARN_REPAIR;
+#else
     /* Both banks appear to be valid but one must be newer, erasing the
        older one.*/
     if (cnt0 > cnt1) {
@@ -701,6 +3262,7 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
     }
     warning = true;
     break;
+#endif
 
   case PAIR(MFS_BANK_GARBAGE, MFS_BANK_GARBAGE):
     /* Both banks are unreadable, reinitializing.*/
@@ -766,12 +3328,13 @@ static mfs_error_t mfs_try_mount(MFSDriver *mfsp) {
   /* In case of detected problems then a garbage collection is performed in
      order to repair/remove anomalies.*/
   if (sts == MFS_BANK_PARTIAL) {
-    RET_ON_ERROR(mfs_garbage_collect(mfsp));
+    RET_ON_ERROR(mfs_garbage_collect(mfsp, 0U));
     warning = true;
   }
 
   return warning ? MFS_WARN_REPAIR : MFS_NO_ERROR;
 }
+#endif /* MFS_CFG_LOG_SECTORS == 0 */
 
 /**
  * @brief   Configures and activates a MFS driver.
@@ -815,6 +3378,147 @@ mfs_error_t mfs_mount(MFSDriver *mfsp) {
   return MFS_ERR_FLASH_FAILURE;
 }
 
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Finds the last operation on a record in the transaction.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record identifier
+ * @return              Pointer to the operation.
+ * @retval NULL         if the record is not affected by the transaction.
+ *
+ * @notapi
+ */
+static mfs_transaction_op_t *mfs_tr_find(MFSDriver *mfsp, mfs_id_t id) {
+  uint32_t i;
+
+  for (i = mfsp->tr_nops; i > 0U; i--) {
+    if (mfsp->tr_ops[i - 1U].id == id) {
+      return &mfsp->tr_ops[i - 1U];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief   Writes a record as part of the transaction.
+ * @details The header and the first part of the data are programmed
+ *          together from the transient buffer, the remaining data is
+ *          programmed in a single operation from the caller buffer. The
+ *          record becomes valid when the transaction end marker is
+ *          written.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] id        record numeric identifier
+ * @param[in] n         size of data to be written, zero for an erase
+ * @param[in] buffer    pointer to a buffer for record data
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_tr_write(MFSDriver *mfsp, mfs_id_t id,
+                                size_t n, const uint8_t *buffer) {
+  mfs_transaction_op_t *top;
+  size_t chunk = 0U;
+#if MFS_CFG_SPARSE_IDS == TRUE
+  bool created;
+#endif
+
+  if (mfsp->tr_nops >= (uint32_t)MFS_CFG_TRANSACTION_MAX) {
+    return MFS_ERR_TRANSACTION_NUM;
+  }
+  if ((flash_offset_t)sizeof (mfs_data_header_t) + (flash_offset_t)n >
+      mfsp->tr_limit_offset - mfsp->tr_next_offset) {
+    return MFS_ERR_TRANSACTION_SIZE;
+  }
+
+#if MFS_CFG_SPARSE_IDS == TRUE
+  /* Records created by the transaction must fit the records index on
+     commit.*/
+  created = (n > 0U) && (mfs_tr_find(mfsp, id) == NULL) &&
+            (mfs_index_find(mfsp, id) == NULL);
+  if (created && (mfsp->records_count + mfsp->tr_new_records >=
+                  (uint32_t)MFS_CFG_MAX_RECORDS)) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+#endif
+
+  /* The header is complete, the transaction end marker seals it.*/
+  mfsp->buffer.dhdr.fields.magic = (uint32_t)MFS_TRANSACTION_MAGIC;
+  mfsp->buffer.dhdr.fields.id    = (uint16_t)id;
+#if MFS_CFG_RECORD_CRC32 == TRUE
+  mfsp->buffer.dhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
+#endif
+  mfsp->buffer.dhdr.fields.size  = (uint32_t)n;
+  mfsp->buffer.dhdr.fields.crc   = (mfs_crc_t)0;
+  if (n > 0U) {
+    mfsp->buffer.dhdr.fields.crc = mfs_record_crc(MFS_RECORD_CRC_INIT,
+                                                  buffer, n);
+    chunk = MFS_CFG_BUFFER_SIZE - sizeof (mfs_data_header_t);
+    if (chunk > n) {
+      chunk = n;
+    }
+    memcpy((void *)&mfsp->buffer.data8[sizeof (mfs_data_header_t)],
+           (const void *)buffer, chunk);
+  }
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               mfsp->tr_next_offset,
+                               sizeof (mfs_data_header_t) + chunk,
+                               mfsp->buffer.data8));
+  if (n > chunk) {
+    RET_ON_ERROR(mfs_flash_write(mfsp,
+                                 mfsp->tr_next_offset +
+                                 sizeof (mfs_data_header_t) + chunk,
+                                 n - chunk,
+                                 buffer + chunk));
+  }
+
+  top = &mfsp->tr_ops[mfsp->tr_nops];
+  top->id     = id;
+  top->offset = mfsp->tr_next_offset;
+  top->size   = (uint32_t)n;
+  mfsp->tr_nops++;
+  mfsp->tr_next_offset += sizeof (mfs_data_header_t) + n;
+  mfsp->gc_stats.written_bytes += sizeof (mfs_data_header_t) + n;
+#if MFS_CFG_SPARSE_IDS == TRUE
+  if (created) {
+    mfsp->tr_new_records++;
+  }
+#endif
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Closes the transaction by writing its end marker.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] nops      number of committed operations, zero if the
+ *                      transaction is rolled back
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static mfs_error_t mfs_tr_end(MFSDriver *mfsp, uint32_t nops) {
+
+  mfsp->buffer.dhdr.fields.magic = (uint32_t)MFS_HEADER_MAGIC;
+  mfsp->buffer.dhdr.fields.id    = (uint16_t)MFS_TRANSACTION_ID;
+#if MFS_CFG_RECORD_CRC32 == TRUE
+  mfsp->buffer.dhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
+#endif
+  mfsp->buffer.dhdr.fields.size  = (uint32_t)0;
+  mfsp->buffer.dhdr.fields.crc   = (mfs_crc_t)nops;
+  RET_ON_ERROR(mfs_flash_write(mfsp,
+                               mfsp->tr_next_offset,
+                               sizeof (mfs_data_header_t),
+                               mfsp->buffer.data8));
+  mfsp->next_offset = mfsp->tr_next_offset + sizeof (mfs_data_header_t);
+
+  return MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_TRANSACTION_MAX > 0 */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -832,10 +3536,13 @@ void mfsObjectInit(MFSDriver *mfsp) {
 
   mfsp->state = MFS_STOP;
   mfsp->config = NULL;
+  mfsp->current_counter = 0U;
+  memset((void *)&mfsp->gc_stats, 0, sizeof (mfs_gc_stats_t));
 }
 
 /**
  * @brief   Configures and activates a MFS driver.
+ * @note    An open transaction is discarded.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] config    pointer to the configuration
@@ -851,17 +3558,30 @@ void mfsObjectInit(MFSDriver *mfsp) {
 mfs_error_t mfsStart(MFSDriver *mfsp, const MFSConfig *config) {
 
   osalDbgCheck((mfsp != NULL) && (config != NULL));
+  osalDbgCheck((config->buffer == NULL) ||
+               ((config->buffer_size >= (size_t)MFS_CFG_BUFFER_SIZE) &&
+                ((config->buffer_size & (config->buffer_size - 1U)) == 0U)));
   osalDbgAssert((mfsp->state == MFS_STOP) || (mfsp->state == MFS_READY) ||
+                (mfsp->state == MFS_TRANSACTION) ||
                 (mfsp->state == MFS_ERROR), "invalid state");
+#if MFS_CFG_LOG_SECTORS > 0
+  osalDbgCheck((config->log_sectors >= 3U) &&
+               (config->log_sectors <= (flash_sector_t)MFS_CFG_LOG_SECTORS));
+#endif
 
   /* Storing configuration.*/
   mfsp->config = config;
+#if MFS_CFG_LOG_SECTORS > 0
+  mfsp->log_size = (flash_offset_t)flashGetSectorSize(config->flashp,
+                                                      config->log_start);
+#endif
 
   return mfs_mount(mfsp);
 } 
 
 /**
  * @brief   Deactivates a MFS driver.
+ * @note    An open transaction is discarded.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  *
@@ -871,14 +3591,28 @@ void mfsStop(MFSDriver *mfsp) {
 
   osalDbgCheck(mfsp != NULL);
   osalDbgAssert((mfsp->state == MFS_STOP) || (mfsp->state == MFS_READY) ||
+                (mfsp->state == MFS_TRANSACTION) ||
                 (mfsp->state == MFS_ERROR), "invalid state");
 
+  if (mfsp->state == MFS_READY) {
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* The flash is not left busy, the collection is resumed on mount.*/
+    (void) mfs_gc_wait(mfsp);
+#endif
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+    /* Clean shutdown, checkpoint of records written after the last one.*/
+    (void) mfs_bank_write_checkpoint(mfsp, 0U);
+#endif
+  }
+
   mfsp->config = NULL;
   mfsp->state = MFS_STOP;
 }
 
 /**
  * @brief   Destroys the state of the managed storage by erasing the flash.
+ * @note    In a log-structured storage the sectors erase counts are
+ *          preserved.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @return              The operation status.
@@ -891,6 +3625,11 @@ void mfsStop(MFSDriver *mfsp) {
  * @api
  */
 mfs_error_t mfsErase(MFSDriver *mfsp) {
+#if MFS_CFG_LOG_SECTORS > 0
+  uint32_t i;
+#else
+  uint32_t counter;
+#endif
 
   osalDbgCheck(mfsp != NULL);
 
@@ -898,18 +3637,35 @@ mfs_error_t mfsErase(MFSDriver *mfsp) {
     return MFS_ERR_INV_STATE;
   }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  RET_ON_ERROR(mfs_gc_wait(mfsp));
+#endif
+
+#if MFS_CFG_LOG_SECTORS > 0
+  /* All sectors become free sectors, each one keeps its erase count.*/
+  for (i = 0U; i < mfsp->config->log_sectors; i++) {
+    RET_ON_ERROR(mfs_log_erase(mfsp, i));
+  }
+#else
+  /* The banks counter is not restarted, the erase is accounted as a bank
+     swap.*/
+  counter = mfsp->current_counter;
   RET_ON_ERROR(mfs_bank_erase(mfsp, MFS_BANK_0));
   RET_ON_ERROR(mfs_bank_erase(mfsp, MFS_BANK_1));
+  RET_ON_ERROR(mfs_bank_write_header(mfsp, MFS_BANK_0, counter + 1U));
+#endif
 
   return mfs_mount(mfsp);
 }
 
 /**
  * @brief   Retrieves and reads a data record.
+ * @note    Within a transaction the record is read as it was before the
+ *          transaction start.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
- *                      @p 1 and @p MFS_CFG_MAX_RECORDS
+ *                      @p 1 and @p MFS_ID_MAX
  * @param[in,out] np    on input is the maximum buffer size, on return it is
  *                      the size of the data copied into the buffer
  * @param[out] buffer   pointer to a buffer for record data
@@ -927,41 +3683,48 @@ mfs_error_t mfsErase(MFSDriver *mfsp) {
  */
 mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
                           size_t *np, uint8_t *buffer) {
-  uint16_t crc;
+  mfs_record_descriptor_t *dp;
+  mfs_crc_t crc;
 
   osalDbgCheck((mfsp != NULL) &&
-               (id >= 1) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
+               (id >= 1) && (id <= (mfs_id_t)MFS_ID_MAX) &&
                (np != NULL) && (buffer != NULL));
 
-  if (mfsp->state != MFS_READY) {
+  if ((mfsp->state != MFS_READY) && (mfsp->state != MFS_TRANSACTION)) {
     return MFS_ERR_INV_STATE;
   }
 
   /* Checking if the requested record actually exists.*/
-  if (mfsp->descriptors[id - 1U].offset == 0U) {
+  dp = mfs_index_find(mfsp, id);
+  if (dp == NULL) {
     return MFS_ERR_NOT_FOUND;
   }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* The flash could be busy erasing.*/
+  RET_ON_ERROR(mfs_gc_wait(mfsp));
+#endif
+
   /* Making sure to not overflow the buffer.*/
-  if (*np < mfsp->descriptors[id - 1U].size) {
+  if (*np < dp->size) {
     return MFS_ERR_INV_SIZE;
   }
 
   /* Header read from flash.*/
   RET_ON_ERROR(mfs_flash_read(mfsp,
-                              mfsp->descriptors[id - 1U].offset,
-                              *np,
+                              dp->offset,
+                              sizeof (mfs_data_header_t),
                               mfsp->buffer.data8));
 
   /* Data read from flash.*/
-  *np = mfsp->descriptors[id - 1U].size;
+  *np = dp->size;
   RET_ON_ERROR(mfs_flash_read(mfsp,
-                              mfsp->descriptors[id - 1U].offset + sizeof (mfs_data_header_t),
+                              dp->offset + sizeof (mfs_data_header_t),
                               *np,
                               buffer));
 
   /* Checking CRC.*/
-  crc = crc16(0xFFFFU, buffer, *np);
+  crc = mfs_record_crc(MFS_RECORD_CRC_INIT, buffer, *np);
   if (crc != mfsp->buffer.dhdr.fields.crc) {
     mfsp->state = MFS_ERROR;
     return MFS_ERR_FLASH_FAILURE;
@@ -972,10 +3735,12 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
 
 /**
  * @brief   Creates or updates a data record.
+ * @note    Within a transaction the record is written as part of the
+ *          transaction.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
- *                      @p 1 and @p MFS_CFG_MAX_RECORDS
+ *                      @p 1 and @p MFS_ID_MAX
  * @param[in] n         size of data to be written, it cannot be zero
  * @param[in] buffer    pointer to a buffer for record data
  * @return              The operation status.
@@ -984,6 +3749,10 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
  * @retval MFS_ERR_INV_STATE if the driver is in not in @p MSG_READY state.
  * @retval MFS_ERR_OUT_OF_MEM if there is not enough flash space for the
  *                      operation.
+ * @retval MFS_ERR_TRANSACTION_NUM if the transaction operations buffer is
+ *                      full.
+ * @retval MFS_ERR_TRANSACTION_SIZE if the transaction allocated space is
+ *                      exceeded.
  * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
  *                      failures. Makes the driver enter the @p MFS_ERROR state.
  * @retval MFS_ERR_INTERNAL if an internal logic failure is detected.
@@ -992,13 +3761,20 @@ mfs_error_t mfsReadRecord(MFSDriver *mfsp, mfs_id_t id,
  */
 mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
                            size_t n, const uint8_t *buffer) {
+  mfs_record_descriptor_t *dp;
   flash_offset_t free, required;
   bool warning = false;
 
   osalDbgCheck((mfsp != NULL) &&
-               (id >= 1) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS) &&
+               (id >= 1) && (id <= (mfs_id_t)MFS_ID_MAX) &&
                (n > 0U) && (buffer != NULL));
 
+#if MFS_CFG_TRANSACTION_MAX > 0
+  if (mfsp->state == MFS_TRANSACTION) {
+    return mfs_tr_write(mfsp, id, n, buffer);
+  }
+#endif
+
   if (mfsp->state != MFS_READY) {
     return MFS_ERR_INV_STATE;
   }
@@ -1009,25 +3785,53 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
      for an erase operation after the space has been fully allocated.*/
   required = ((flash_offset_t)sizeof (mfs_data_header_t) * 2U) +
              (flash_offset_t)n;
-  if (required > mfsp->config->bank_size - mfsp->used_space) {
+  if (required > MFS_STORAGE_SIZE(mfsp) - mfsp->used_space) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+#if MFS_CFG_LOG_SECTORS > 0
+  /* Records cannot span across sectors.*/
+  if (required > MFS_LOG_PAYLOAD(mfsp)) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+#endif
+
+#if MFS_CFG_SPARSE_IDS == TRUE
+  /* A new record requires a free slot in the records index.*/
+  if ((mfs_index_find(mfsp, id) == NULL) &&
+      (mfsp->records_count >= (uint32_t)MFS_CFG_MAX_RECORDS)) {
     return MFS_ERR_OUT_OF_MEM;
   }
+#endif
+
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* The flash could be busy erasing.*/
+  RET_ON_ERROR(mfs_gc_wait(mfsp));
+#endif
+
+#if MFS_CFG_LOG_SECTORS > 0
+  /* Moving to a new sector does not require a garbage collection.*/
+  RET_ON_ERROR(mfs_log_extend(mfsp, required));
+#endif
 
-  /* Checking for immediately (not compacted) available space.*/
-  free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
-          mfsp->config->bank_size) - mfsp->next_offset;
-  if (required > free) {
+  /* Checking for immediately (not compacted) available space, the space
+     for records still to be moved by the collector is reserved.*/
+  free = MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset;
+  if (required + MFS_GC_PENDING(mfsp) > free) {
     /* We need to perform a garbage collection, there is enough space
        but it has to be freed.*/
     warning = true;
-    RET_ON_ERROR(mfs_garbage_collect(mfsp));
+    RET_ON_ERROR(mfs_garbage_collect(mfsp, required));
   }
 
   /* Writing the data header without the magic, it will be written last.*/
   mfsp->buffer.dhdr.fields.magic = (uint32_t)mfsp->config->erased;
   mfsp->buffer.dhdr.fields.id    = (uint16_t)id;
+#if MFS_CFG_RECORD_CRC32 == TRUE
+  mfsp->buffer.dhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
+#endif
   mfsp->buffer.dhdr.fields.size  = (uint32_t)n;
-  mfsp->buffer.dhdr.fields.crc   = crc16(0xFFFFU, buffer, n);
+  mfsp->buffer.dhdr.fields.crc   = mfs_record_crc(MFS_RECORD_CRC_INIT,
+                                                  buffer, n);
   RET_ON_ERROR(mfs_flash_write(mfsp,
                                mfsp->next_offset,
                                sizeof (mfs_data_header_t),
@@ -1048,30 +3852,52 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
 
   /* The size of the old record instance, if present, must be subtracted
      to the total used size.*/
-  if (mfsp->descriptors[id - 1U].offset != 0U) {
-    mfsp->used_space -= sizeof (mfs_data_header_t) +
-                        mfsp->descriptors[id - 1U].size;
+  dp = mfs_index_find(mfsp, id);
+  if (dp != NULL) {
+    mfsp->used_space -= sizeof (mfs_data_header_t) + dp->size;
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    mfs_gc_discard(mfsp, dp);
+#endif
+#if MFS_CFG_LOG_SECTORS > 0
+    mfsp->log[mfs_log_get_sector(mfsp, dp->offset)].live -=
+        sizeof (mfs_data_header_t) + dp->size;
+#endif
   }
 
   /* Adjusting bank-related metadata.*/
-  mfsp->descriptors[id - 1U].offset = mfsp->next_offset;
-  mfsp->descriptors[id - 1U].size   = (uint32_t)n;
+#if MFS_CFG_LOG_SECTORS > 0
+  mfsp->log[mfsp->log_head].live += sizeof (mfs_data_header_t) + n;
+#endif
+  RET_ON_ERROR(mfs_index_update(mfsp, id, mfsp->next_offset, (uint32_t)n));
   mfsp->next_offset += sizeof (mfs_data_header_t) + n;
   mfsp->used_space  += sizeof (mfs_data_header_t) + n;
+  mfsp->gc_stats.written_bytes += sizeof (mfs_data_header_t) + n;
+
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* Bounded garbage collection work.*/
+  RET_ON_ERROR(mfs_gc_step(mfsp, NULL));
+#endif
 
   return warning ? MFS_WARN_GC : MFS_NO_ERROR;
 }
 
 /**
  * @brief   Erases a data record.
+ * @note    Within a transaction the record is erased as part of the
+ *          transaction.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @param[in] id        record numeric identifier, the valid range is between
- *                      @p 1 and @p MFS_CFG_MAX_RECORDS
+ *                      @p 1 and @p MFS_ID_MAX
  * @return              The operation status.
  * @retval MFS_NO_ERROR if the operation has been successfully completed.
  * @retval MFS_WARN_GC  if the operation triggered a garbage collection.
  * @retval MFS_ERR_INV_STATE if the driver is in not in @p MSG_READY state.
+ * @retval MFS_ERR_NOT_FOUND if the specified id does not exists.
+ * @retval MFS_ERR_TRANSACTION_NUM if the transaction operations buffer is
+ *                      full.
+ * @retval MFS_ERR_TRANSACTION_SIZE if the transaction allocated space is
+ *                      exceeded.
  * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
  *                      failures. Makes the driver enter the @p MFS_ERROR state.
  * @retval MFS_ERR_INTERNAL if an internal logic failure is detected.
@@ -1079,55 +3905,95 @@ mfs_error_t mfsWriteRecord(MFSDriver *mfsp, mfs_id_t id,
  * @api
  */
 mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
+  mfs_record_descriptor_t *dp;
   flash_offset_t free, required;
   bool warning = false;
 
   osalDbgCheck((mfsp != NULL) &&
-               (id >= 1U) && (id <= (mfs_id_t)MFS_CFG_MAX_RECORDS));
+               (id >= 1U) && (id <= (mfs_id_t)MFS_ID_MAX));
+
+#if MFS_CFG_TRANSACTION_MAX > 0
+  if (mfsp->state == MFS_TRANSACTION) {
+    mfs_transaction_op_t *top = mfs_tr_find(mfsp, id);
+
+    /* The record must exist at this point of the transaction.*/
+    if ((top != NULL) ? (top->size == 0U) :
+                        (mfs_index_find(mfsp, id) == NULL)) {
+      return MFS_ERR_NOT_FOUND;
+    }
+
+    return mfs_tr_write(mfsp, id, 0U, NULL);
+  }
+#endif
 
   if (mfsp->state != MFS_READY) {
     return MFS_ERR_INV_STATE;
   }
 
   /* Checking if the requested record actually exists.*/
-  if (mfsp->descriptors[id - 1U].offset == 0U) {
+  dp = mfs_index_find(mfsp, id);
+  if (dp == NULL) {
     return MFS_ERR_NOT_FOUND;
   }
 
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* The flash could be busy erasing.*/
+  RET_ON_ERROR(mfs_gc_wait(mfsp));
+#endif
+
   /* If the required space is beyond the available (compacted) block
      size then an internal error is returned, it should never happen.*/
   required = (flash_offset_t)sizeof (mfs_data_header_t);
-  if (required > mfsp->config->bank_size - mfsp->used_space) {
+  if (required > MFS_STORAGE_SIZE(mfsp) - mfsp->used_space) {
     return MFS_ERR_INTERNAL;
   }
 
-  /* Checking for immediately (not compacted) available space.*/
-  free = (mfs_flash_get_bank_offset(mfsp, mfsp->current_bank) +
-          mfsp->config->bank_size) - mfsp->next_offset;
-  if (required > free) {
+#if MFS_CFG_LOG_SECTORS > 0
+  /* Moving to a new sector does not require a garbage collection.*/
+  RET_ON_ERROR(mfs_log_extend(mfsp, required));
+#endif
+
+  /* Checking for immediately (not compacted) available space, the space
+     for records still to be moved by the collector is reserved.*/
+  free = MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset;
+  if (required + MFS_GC_PENDING(mfsp) > free) {
     /* We need to perform a garbage collection, there is enough space
        but it has to be freed.*/
     warning = true;
-    RET_ON_ERROR(mfs_garbage_collect(mfsp));
+    RET_ON_ERROR(mfs_garbage_collect(mfsp, required));
   }
 
   /* Writing the data header with size set to zero, it means that the
      record is logically erased.*/
   mfsp->buffer.dhdr.fields.magic = (uint32_t)MFS_HEADER_MAGIC;
   mfsp->buffer.dhdr.fields.id    = (uint16_t)id;
+#if MFS_CFG_RECORD_CRC32 == TRUE
+  mfsp->buffer.dhdr.fields.reserved1 = (uint16_t)mfsp->config->erased;
+#endif
   mfsp->buffer.dhdr.fields.size  = (uint32_t)0;
-  mfsp->buffer.dhdr.fields.crc   = (uint16_t)0;
+  mfsp->buffer.dhdr.fields.crc   = (mfs_crc_t)0;
   RET_ON_ERROR(mfs_flash_write(mfsp,
                                mfsp->next_offset,
                                sizeof (mfs_data_header_t),
                                mfsp->buffer.data8));
 
   /* Adjusting bank-related metadata.*/
-  mfsp->used_space  -= sizeof (mfs_data_header_t) +
-                       mfsp->descriptors[id - 1U].size;
+  mfsp->used_space  -= sizeof (mfs_data_header_t) + dp->size;
+#if MFS_CFG_LOG_SECTORS > 0
+  mfsp->log[mfs_log_get_sector(mfsp, dp->offset)].live -=
+      sizeof (mfs_data_header_t) + dp->size;
+#endif
   mfsp->next_offset += sizeof (mfs_data_header_t);
-  mfsp->descriptors[id - 1U].offset = 0U;
-  mfsp->descriptors[id - 1U].size   = 0U;
+  mfsp->gc_stats.written_bytes += sizeof (mfs_data_header_t);
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  mfs_gc_discard(mfsp, dp);
+#endif
+  mfs_index_remove(mfsp, id);
+
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* Bounded garbage collection work.*/
+  RET_ON_ERROR(mfs_gc_step(mfsp, NULL));
+#endif
 
   return warning ? MFS_WARN_GC : MFS_NO_ERROR;
 }
@@ -1136,6 +4002,8 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
  * @brief   Enforces a garbage collection operation.
  * @details Garbage collection involves: integrity check, optionally repairs,
  *          obsolete data removal, data compaction and a flash bank swap.
+ * @note    In a log-structured storage all the sectors containing obsolete
+ *          records are collected, except the one being written.
  *
  * @param[in] mfsp      pointer to the @p MFSDriver object
  * @return              The operation status.
@@ -1148,6 +4016,55 @@ mfs_error_t mfsEraseRecord(MFSDriver *mfsp, mfs_id_t id) {
  * @api
  */
 mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp) {
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  systime_t start;
+#endif
+
+  osalDbgCheck(mfsp != NULL);
+
+  if (mfsp->state != MFS_READY) {
+    return MFS_ERR_INV_STATE;
+  }
+
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  RET_ON_ERROR(mfs_gc_wait(mfsp));
+  RET_ON_ERROR(mfs_garbage_collect(mfsp, 0U));
+
+  /* The collection is completed synchronously.*/
+  start = osalOsGetSystemTimeX();
+  RET_ON_ERROR(mfs_gc_finish(mfsp));
+  mfs_gc_account(mfsp, start);
+
+  return MFS_NO_ERROR;
+#else
+  return mfs_garbage_collect(mfsp, 0U);
+#endif
+}
+
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Performs a garbage collection step.
+ * @details A step performs a bounded amount of work without waiting for
+ *          the flash: it moves up to @p MFS_CFG_GC_STEP_RECORDS records,
+ *          starts a sector erase or checks for its completion. This
+ *          function is meant to be called periodically, for example
+ *          from a low priority thread, in order to complete collections
+ *          in background.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[out] msecp    suggested delay in milliseconds before calling
+ *                      this function again, it can be @p NULL
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR if there is no garbage collection work pending.
+ * @retval MFS_WARN_GC  if there is still garbage collection work pending.
+ * @retval MFS_ERR_INV_STATE if the driver is in not in @p MSG_READY state.
+ * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
+ *                      failures. Makes the driver enter the @p MFS_ERROR state.
+ *
+ * @api
+ */
+mfs_error_t mfsPerformGarbageCollectionStep(MFSDriver *mfsp,
+                                            uint32_t *msecp) {
 
   osalDbgCheck(mfsp != NULL);
 
@@ -1155,7 +4072,168 @@ mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp) {
     return MFS_ERR_INV_STATE;
   }
 
-  return mfs_garbage_collect(mfsp);
+  RET_ON_ERROR(mfs_gc_step(mfsp, msecp));
+
+  return mfsp->gc_state != MFS_GC_IDLE ? MFS_WARN_GC : MFS_NO_ERROR;
+}
+#endif /* MFS_CFG_INCREMENTAL_GC == TRUE */
+
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Starts a transaction.
+ * @details Records written or erased until @p mfsCommitTransaction() are
+ *          packed contiguously in the space allocated here and become
+ *          visible at once on commit. On power loss either all or none
+ *          of the transaction operations are found on mount.
+ * @note    The allocated space must include the data size of written
+ *          records plus @p sizeof(mfs_data_header_t) for each write or
+ *          erase operation.
+ * @note    Garbage collection is not performed during a transaction, if
+ *          required it is performed here.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] size      space to be allocated for the transaction
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR if the operation has been successfully completed.
+ * @retval MFS_WARN_GC  if the operation triggered a garbage collection.
+ * @retval MFS_ERR_INV_STATE if the driver is in not in @p MSG_READY state.
+ * @retval MFS_ERR_OUT_OF_MEM if there is not enough flash space for the
+ *                      transaction.
+ * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
+ *                      failures. Makes the driver enter the @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsStartTransaction(MFSDriver *mfsp, size_t size) {
+  flash_offset_t free, required;
+  bool warning = false;
+
+  osalDbgCheck((mfsp != NULL) && (size >= sizeof (mfs_data_header_t)));
+
+  if (mfsp->state != MFS_READY) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  /* The space for the end marker and for one extra header is reserved
+     in addition to the transaction space.*/
+  required = ((flash_offset_t)sizeof (mfs_data_header_t) * 2U) +
+             (flash_offset_t)size;
+  if (required > MFS_STORAGE_SIZE(mfsp) - mfsp->used_space) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+#if MFS_CFG_LOG_SECTORS > 0
+  /* A transaction cannot span across sectors.*/
+  if (required > MFS_LOG_PAYLOAD(mfsp)) {
+    return MFS_ERR_OUT_OF_MEM;
+  }
+#endif
+
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* The flash could be busy erasing.*/
+  RET_ON_ERROR(mfs_gc_wait(mfsp));
+#endif
+
+#if MFS_CFG_LOG_SECTORS > 0
+  /* Moving to a new sector does not require a garbage collection.*/
+  RET_ON_ERROR(mfs_log_extend(mfsp, required));
+#endif
+
+  /* Checking for immediately (not compacted) available space, the space
+     for records still to be moved by the collector is reserved.*/
+  free = MFS_WRITE_LIMIT(mfsp) - mfsp->next_offset;
+  if (required + MFS_GC_PENDING(mfsp) > free) {
+    warning = true;
+    RET_ON_ERROR(mfs_garbage_collect(mfsp, required));
+  }
+
+  mfsp->tr_next_offset  = mfsp->next_offset;
+  mfsp->tr_limit_offset = mfsp->next_offset + (flash_offset_t)size;
+  mfsp->tr_nops         = 0U;
+#if MFS_CFG_SPARSE_IDS == TRUE
+  mfsp->tr_new_records  = 0U;
+#endif
+  mfsp->state           = MFS_TRANSACTION;
+
+  return warning ? MFS_WARN_GC : MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Commits the current transaction.
+ * @details A single end marker is written after the transaction records,
+ *          all operations become effective at once.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR if the operation has been successfully completed.
+ * @retval MFS_ERR_INV_STATE if the driver is in not in @p MFS_TRANSACTION
+ *                      state.
+ * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
+ *                      failures. Makes the driver enter the @p MFS_ERROR state.
+ * @retval MFS_ERR_INTERNAL if an internal logic failure is detected.
+ *
+ * @api
+ */
+mfs_error_t mfsCommitTransaction(MFSDriver *mfsp) {
+
+  osalDbgCheck(mfsp != NULL);
+
+  if (mfsp->state != MFS_TRANSACTION) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  if (mfsp->tr_nops > 0U) {
+    RET_ON_ERROR(mfs_tr_end(mfsp, mfsp->tr_nops));
+    RET_ON_ERROR(mfs_tr_apply(mfsp));
+    mfs_state_update_used_space(mfsp);
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+    /* Records superseded by the transaction no more need to be moved.*/
+    if (mfsp->gc_state == MFS_GC_MOVING) {
+      mfs_gc_begin_moving(mfsp);
+    }
+#endif
+  }
+  mfsp->state = MFS_READY;
+
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  /* Bounded garbage collection work.*/
+  RET_ON_ERROR(mfs_gc_step(mfsp, NULL));
+#endif
+
+  return MFS_NO_ERROR;
+}
+
+/**
+ * @brief   Rolls back the current transaction.
+ * @details The transaction records are discarded, the space they use is
+ *          recovered by the next garbage collection.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              The operation status.
+ * @retval MFS_NO_ERROR if the operation has been successfully completed.
+ * @retval MFS_ERR_INV_STATE if the driver is in not in @p MFS_TRANSACTION
+ *                      state.
+ * @retval MFS_ERR_FLASH_FAILURE if the flash memory is unusable because HW
+ *                      failures. Makes the driver enter the @p MFS_ERROR state.
+ *
+ * @api
+ */
+mfs_error_t mfsRollbackTransaction(MFSDriver *mfsp) {
+
+  osalDbgCheck(mfsp != NULL);
+
+  if (mfsp->state != MFS_TRANSACTION) {
+    return MFS_ERR_INV_STATE;
+  }
+
+  if (mfsp->tr_nops > 0U) {
+    RET_ON_ERROR(mfs_tr_end(mfsp, 0U));
+    mfsp->tr_nops = 0U;
+  }
+  mfsp->state = MFS_READY;
+
+  return MFS_NO_ERROR;
 }
+#endif /* MFS_CFG_TRANSACTION_MAX > 0 */
 
 /** @} */
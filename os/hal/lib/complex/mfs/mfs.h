@@ -35,7 +35,24 @@
 
 #define MFS_BANK_MAGIC_1                    0xEC705ADEU
 #define MFS_BANK_MAGIC_2                    0xF0339CC5U
+#define MFS_SECTOR_MAGIC                    0xEC705ADFU
 #define MFS_HEADER_MAGIC                    0x5FAE45F0U
+#define MFS_TRANSACTION_MAGIC               0x5FAE45F1U
+
+/**
+ * @brief   Highest record identifier when sparse identifiers are enabled.
+ */
+#define MFS_ID_MAX_SPARSE                   0xFFFDU
+
+/**
+ * @brief   Identifier reserved to transaction end markers.
+ */
+#define MFS_TRANSACTION_ID                  0xFFFEU
+
+/**
+ * @brief   Identifier reserved to index checkpoint records.
+ */
+#define MFS_CHECKPOINT_ID                   0xFFFFU
 
 /*===========================================================================*/
 /* Driver pre-compile time settings.                                         */
@@ -48,11 +65,120 @@
 /**
  * @brief   Maximum number of indexed records in the managed storage.
  * @note    Record indexes go from 0 to @p MFS_CFG_MAX_RECORDS - 1.
+ * @note    If @p MFS_CFG_SPARSE_IDS is enabled then this is the capacity
+ *          of the records index, identifiers can span the whole range.
  */
 #if !defined(MFS_CFG_MAX_RECORDS) || defined(__DOXYGEN__)
 #define MFS_CFG_MAX_RECORDS                 32
 #endif
 
+/**
+ * @brief   Enables sparse record identifiers.
+ * @details Records identifiers can be any value between @p 1 and
+ *          @p MFS_ID_MAX_SPARSE, records are kept in an index sorted by
+ *          identifier and searched in logarithmic time. The index only
+ *          contains records actually present in the storage.
+ * @note    The RAM cost is 4 bytes per index entry larger than the direct
+ *          mapped table used when this option is disabled.
+ */
+#if !defined(MFS_CFG_SPARSE_IDS) || defined(__DOXYGEN__)
+#define MFS_CFG_SPARSE_IDS                  FALSE
+#endif
+
+/**
+ * @brief   Enables incremental garbage collection.
+ * @details Garbage collection is split in bounded steps: the bank switch
+ *          happens immediately, then live records are moved from the old
+ *          bank a few at time and the old bank is erased one sector at
+ *          time. Steps are performed after each write or erase operation
+ *          and can be performed by the application using
+ *          @p mfsPerformGarbageCollectionStep(), for example from a low
+ *          priority thread.
+ * @note    The worst case latency of an operation becomes the time of a
+ *          sector erase plus @p MFS_CFG_GC_STEP_RECORDS records moves
+ *          as long as steps keep up with writes, otherwise the pending
+ *          collection is completed synchronously.
+ */
+#if !defined(MFS_CFG_INCREMENTAL_GC) || defined(__DOXYGEN__)
+#define MFS_CFG_INCREMENTAL_GC              FALSE
+#endif
+
+/**
+ * @brief   Number of records moved by each garbage collection step.
+ */
+#if !defined(MFS_CFG_GC_STEP_RECORDS) || defined(__DOXYGEN__)
+#define MFS_CFG_GC_STEP_RECORDS             2
+#endif
+
+/**
+ * @brief   Enables the records index checkpoint.
+ * @details A compact copy of the records index is written in the bank
+ *          after each garbage collection and on @p mfsStop(). On mount the
+ *          most recent checkpoint is loaded and only the records written
+ *          after it are scanned, mount time no more depends on the number
+ *          of records in the bank. An invalid checkpoint causes a full
+ *          scan.
+ * @note    Records covered by the checkpoint are not checked on mount,
+ *          errors would be detected on read.
+ * @note    The bank layout changes, banks written with the other layout
+ *          are not recognized and are discarded on mount.
+ */
+#if !defined(MFS_CFG_INDEX_CHECKPOINT) || defined(__DOXYGEN__)
+#define MFS_CFG_INDEX_CHECKPOINT            FALSE
+#endif
+
+/**
+ * @brief   Number of checkpoint slots in a bank.
+ * @details Slots are reserved after the bank header, each checkpoint
+ *          written in a bank uses one. When all slots are used no more
+ *          checkpoints are written in the bank.
+ */
+#if !defined(MFS_CFG_CHECKPOINT_SLOTS) || defined(__DOXYGEN__)
+#define MFS_CFG_CHECKPOINT_SLOTS            8
+#endif
+
+/**
+ * @brief   Maximum number of operations in a transaction.
+ * @details Writes and erases performed between @p mfsStartTransaction()
+ *          and @p mfsCommitTransaction() become visible at once on
+ *          commit, on power loss either all or none of them are found
+ *          on mount. Zero disables transactions.
+ * @note    The RAM cost is 12 bytes per operation.
+ */
+#if !defined(MFS_CFG_TRANSACTION_MAX) || defined(__DOXYGEN__)
+#define MFS_CFG_TRANSACTION_MAX             0
+#endif
+
+/**
+ * @brief   Maximum number of sectors in a log-structured storage.
+ * @details If not zero then the storage is a log of flash sectors instead
+ *          of a pair of banks. Records are appended to the most recent
+ *          sector, when space is required the sector with the most space
+ *          used by obsolete records is collected: its live records are
+ *          appended to the log and that sector alone is erased. Sector
+ *          headers keep the number of erase cycles of each sector, free
+ *          sectors are used least erased first.
+ * @note    The space of two sectors is reserved for garbage collection
+ *          and a record cannot be larger than a sector.
+ * @note    Incremental garbage collection and the records index
+ *          checkpoint are not supported by this layout.
+ * @note    The RAM cost is 16 bytes per sector.
+ */
+#if !defined(MFS_CFG_LOG_SECTORS) || defined(__DOXYGEN__)
+#define MFS_CFG_LOG_SECTORS                 0
+#endif
+
+/**
+ * @brief   Erase cycles difference triggering static wear leveling.
+ * @details When the least erased sector in use lags behind the most
+ *          erased sector by more than this number of erase cycles then it
+ *          is collected even if it only contains live records, its data
+ *          is moved to more worn sectors.
+ */
+#if !defined(MFS_CFG_LOG_WEAR_THRESHOLD) || defined(__DOXYGEN__)
+#define MFS_CFG_LOG_WEAR_THRESHOLD          16
+#endif
+
 /**
  * @brief   Maximum number of repair attempts on partition mount.
  */
@@ -87,16 +213,104 @@
 #if !defined(MFS_CFG_BUFFER_SIZE) || defined(__DOXYGEN__)
 #define MFS_CFG_BUFFER_SIZE                 32
 #endif
+
+/**
+ * @brief   Number of bytes processed per iteration by the CRC engines.
+ * @details Larger values make checksum calculations faster at the cost of
+ *          larger look-up tables, each CRC16 table is 512 bytes large and
+ *          each CRC32 table is 1kB large.
+ * @note    Allowed values are 1, 4 and 8.
+ */
+#if !defined(MFS_CFG_CRC_SLICES) || defined(__DOXYGEN__)
+#define MFS_CFG_CRC_SLICES                  4
+#endif
+
+/**
+ * @brief   Enables CRC32 checksums on data records.
+ * @details Data records are protected by a CRC-32/MPEG-2 checksum instead
+ *          of a CRC16-CCITT, this improves errors detection on large
+ *          records. Data headers grow from 12 to 16 bytes.
+ * @note    Records written using the other format are not recognized and
+ *          are discarded on mount.
+ */
+#if !defined(MFS_CFG_RECORD_CRC32) || defined(__DOXYGEN__)
+#define MFS_CFG_RECORD_CRC32                FALSE
+#endif
+
+/**
+ * @brief   CRC16 engine override.
+ * @details If defined then this function-like macro is used for CRC16
+ *          calculations instead of the software engine, it allows to use
+ *          a CRC hardware unit where present.
+ * @note    The result must be a CRC16-CCITT calculated MSB-first without
+ *          output XOR, starting from the value passed in @p crc.
+ */
+#if defined(__DOXYGEN__)
+#define MFS_CFG_CRC16_HOOK(crc, data, n)
+#endif
+
+/**
+ * @brief   CRC32 engine override.
+ * @details If defined then this function-like macro is used for CRC32
+ *          calculations instead of the software engine, it allows to use
+ *          a CRC hardware unit where present.
+ * @note    The result must be a CRC-32/MPEG-2 (polynomial 0x04C11DB7)
+ *          calculated MSB-first without output XOR, starting from the
+ *          value passed in @p crc.
+ */
+#if defined(__DOXYGEN__)
+#define MFS_CFG_CRC32_HOOK(crc, data, n)
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
-#if MFS_CFG_MAX_RECORDS < 0
+#if (MFS_CFG_MAX_RECORDS < 0) || (MFS_CFG_MAX_RECORDS > MFS_ID_MAX_SPARSE)
 #error "invalid MFS_CFG_MAX_RECORDS value"
 #endif
 
+/**
+ * @brief   Highest valid record identifier.
+ */
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+#define MFS_ID_MAX                          MFS_ID_MAX_SPARSE
+#else
+#define MFS_ID_MAX                          MFS_CFG_MAX_RECORDS
+#endif
+
+/**
+ * @brief   Offset of the first record from the start of a bank.
+ * @note    The checkpoint slots, if enabled, follow the bank header.
+ */
+#if (MFS_CFG_INDEX_CHECKPOINT == TRUE) || defined(__DOXYGEN__)
+#define MFS_BANK_DATA_OFFSET                                                \
+  ((flash_offset_t)sizeof (mfs_bank_header_t) +                             \
+   ((flash_offset_t)MFS_CFG_CHECKPOINT_SLOTS * sizeof (uint32_t)))
+#else
+#define MFS_BANK_DATA_OFFSET                                                \
+  ((flash_offset_t)sizeof (mfs_bank_header_t))
+#endif
+
+#if (MFS_CFG_TRANSACTION_MAX < 0) || (MFS_CFG_TRANSACTION_MAX > 0xFFFF)
+#error "invalid MFS_CFG_TRANSACTION_MAX value"
+#endif
+
+#if (MFS_CFG_LOG_SECTORS < 0) || (MFS_CFG_LOG_SECTORS == 1) ||              \
+    (MFS_CFG_LOG_SECTORS == 2)
+#error "invalid MFS_CFG_LOG_SECTORS value"
+#endif
+
+#if (MFS_CFG_LOG_SECTORS > 0) &&                                            \
+    ((MFS_CFG_INCREMENTAL_GC == TRUE) || (MFS_CFG_INDEX_CHECKPOINT == TRUE))
+#error "MFS_CFG_LOG_SECTORS requires MFS_CFG_INCREMENTAL_GC and MFS_CFG_INDEX_CHECKPOINT disabled"
+#endif
+
+#if MFS_CFG_LOG_WEAR_THRESHOLD < 1
+#error "invalid MFS_CFG_LOG_WEAR_THRESHOLD value"
+#endif
+
 #if (MFS_CFG_MAX_REPAIR_ATTEMPTS < 1) || (MFS_CFG_MAX_REPAIR_ATTEMPTS > 10)
 #error "invalid MFS_MAX_REPAIR_ATTEMPTS value"
 #endif
@@ -109,6 +323,20 @@
 #error "MFS_CFG_BUFFER_SIZE is not a power of two"
 #endif
 
+#if (MFS_CFG_CRC_SLICES != 1) && (MFS_CFG_CRC_SLICES != 4) &&               \
+    (MFS_CFG_CRC_SLICES != 8)
+#error "invalid MFS_CFG_CRC_SLICES value"
+#endif
+
+#if MFS_CFG_GC_STEP_RECORDS < 1
+#error "invalid MFS_CFG_GC_STEP_RECORDS value"
+#endif
+
+#if (MFS_CFG_CHECKPOINT_SLOTS < 1) ||                                       \
+    (MFS_CFG_CHECKPOINT_SLOTS * 4 > MFS_CFG_BUFFER_SIZE)
+#error "invalid MFS_CFG_CHECKPOINT_SLOTS value"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -128,7 +356,8 @@ typedef enum {
   MFS_UNINIT = 0,
   MFS_STOP = 1,
   MFS_READY = 2,
-  MFS_ERROR = 3
+  MFS_TRANSACTION = 3,
+  MFS_ERROR = 4
 } mfs_state_t;
 
 /**
@@ -146,7 +375,9 @@ typedef enum {
   MFS_ERR_OUT_OF_MEM = -4,
   MFS_ERR_NOT_ERASED = -5,
   MFS_ERR_FLASH_FAILURE = -6,
-  MFS_ERR_INTERNAL = -7
+  MFS_ERR_INTERNAL = -7,
+  MFS_ERR_TRANSACTION_NUM = -8,
+  MFS_ERR_TRANSACTION_SIZE = -9
 } mfs_error_t;
 
 /**
@@ -159,6 +390,17 @@ typedef enum {
   MFS_BANK_GARBAGE = 3
 } mfs_bank_state_t;
 
+/**
+ * @brief   Type of a log sector state assessment.
+ */
+typedef enum {
+  MFS_SECTOR_ERASED = 0,
+  MFS_SECTOR_FREE = 1,
+  MFS_SECTOR_OK = 2,
+  MFS_SECTOR_PARTIAL = 3,
+  MFS_SECTOR_GARBAGE = 4
+} mfs_sector_state_t;
+
 /**
  * @brief   Type of a record state assessment.
  */
@@ -169,6 +411,58 @@ typedef enum {
   MFS_RECORD_GARBAGE = 3
 } mfs_record_state_t;
 
+/**
+ * @brief   Type of a garbage collection state.
+ */
+typedef enum {
+  MFS_GC_IDLE = 0,
+  MFS_GC_MOVING = 1,
+  MFS_GC_ERASING = 2,
+  MFS_GC_WAITING = 3
+} mfs_gc_state_t;
+
+/**
+ * @brief   Type of garbage collection statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Number of garbage collections started.
+   */
+  uint32_t                  collections;
+  /**
+   * @brief   Number of records moved between banks.
+   */
+  uint32_t                  moved_records;
+  /**
+   * @brief   Number of sectors erased.
+   */
+  uint32_t                  erased_sectors;
+  /**
+   * @brief   Bytes written by the application, records headers included.
+   */
+  uint32_t                  written_bytes;
+  /**
+   * @brief   Bytes moved between banks.
+   */
+  uint32_t                  moved_bytes;
+  /**
+   * @brief   Bytes programmed in flash.
+   * @details The ratio between this value and @p written_bytes is the
+   *          write amplification.
+   */
+  uint32_t                  programmed_bytes;
+  /**
+   * @brief   Total time spent in garbage collection.
+   */
+  sysinterval_t             total_time;
+  /**
+   * @brief   Longest uninterrupted garbage collection activity.
+   * @details This is the worst case latency added by garbage collection
+   *          to a single operation.
+   */
+  sysinterval_t             worst_time;
+} mfs_gc_stats_t;
+
 /**
  * @brief   Type of a record identifier.
  */
@@ -207,6 +501,86 @@ typedef union {
   uint32_t                  hdr32[4];
 } mfs_bank_header_t;
 
+/**
+ * @brief   Type of a log sector header.
+ * @note    The header resides in the first 24 bytes of a sector. The erase
+ *          count and the magic are written after erasing the sector, the
+ *          other fields when the sector is added to the log.
+ */
+typedef union {
+  struct {
+    /**
+     * @brief   Sector magic.
+     */
+    uint32_t                magic;
+    /**
+     * @brief   Number of erase cycles endured by the sector.
+     */
+    uint32_t                erases;
+    /**
+     * @brief   Position of the sector in the log.
+     * @details Records in sectors with a higher sequence number supersede
+     *          the records in the older sectors.
+     */
+    uint32_t                sequence;
+    /**
+     * @brief   Sequence number of the sector collected into this one.
+     * @note    Erased value if the sector has not been added to the log by
+     *          a garbage collection.
+     */
+    uint32_t                source;
+    /**
+     * @brief   Reserved field.
+     */
+    uint16_t                reserved1;
+    /**
+     * @brief   Header CRC.
+     */
+    uint16_t                crc;
+    /**
+     * @brief   Collection end marker.
+     * @details It is written when all live records of the @p source sector
+     *          have been copied, before erasing it.
+     */
+    uint32_t                collected;
+  } fields;
+  uint8_t                   hdr8[24];
+  uint32_t                  hdr32[6];
+} mfs_sector_header_t;
+
+/**
+ * @brief   Type of a log sector descriptor.
+ */
+typedef struct {
+  /**
+   * @brief   Sequence number of the sector, zero if the sector is free.
+   */
+  uint32_t                  sequence;
+  /**
+   * @brief   Number of erase cycles endured by the sector.
+   */
+  uint32_t                  erases;
+  /**
+   * @brief   Used space in the sector, header included.
+   * @note    For the sector being written it is updated when a new sector
+   *          is added to the log.
+   */
+  flash_offset_t            used;
+  /**
+   * @brief   Space used by the most recent instance of the records.
+   */
+  flash_offset_t            live;
+} mfs_log_sector_t;
+
+/**
+ * @brief   Type of a data record checksum.
+ */
+#if (MFS_CFG_RECORD_CRC32 == TRUE) || defined(__DOXYGEN__)
+typedef uint32_t mfs_crc_t;
+#else
+typedef uint16_t mfs_crc_t;
+#endif
+
 /**
  * @brief   Type of a data block header.
  * @details This structure is placed before each written data block.
@@ -221,10 +595,27 @@ typedef union {
      * @brief   Data identifier.
      */
     uint16_t                id;
+#if (MFS_CFG_RECORD_CRC32 == TRUE) || defined(__DOXYGEN__)
+    /**
+     * @brief   Reserved field.
+     */
+    uint16_t                reserved1;
+    /**
+     * @brief   Data size.
+     */
+    uint32_t                size;
     /**
      * @brief   Data CRC.
      */
-    uint16_t                crc;
+    mfs_crc_t               crc;
+  } fields;
+  uint8_t                   hdr8[16];
+  uint32_t                  hdr32[4];
+#else
+    /**
+     * @brief   Data CRC.
+     */
+    mfs_crc_t               crc;
     /**
      * @brief   Data size.
      */
@@ -232,9 +623,19 @@ typedef union {
   } fields;
   uint8_t                   hdr8[12];
   uint32_t                  hdr32[3];
+#endif
 } mfs_data_header_t;
 
+/**
+ * @brief   Type of a record descriptor.
+ */
 typedef struct {
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Record identifier.
+   */
+  mfs_id_t                  id;
+#endif
   /**
    * @brief   Offset of the record header.
    */
@@ -245,6 +646,44 @@ typedef struct {
   uint32_t                  size;
 } mfs_record_descriptor_t;
 
+/**
+ * @brief   Type of an index checkpoint entry.
+ * @details A checkpoint record contains an array of entries, one for each
+ *          record in the bank, sorted by identifier.
+ */
+typedef struct {
+  /**
+   * @brief   Record identifier.
+   */
+  uint32_t                  id;
+  /**
+   * @brief   Offset of the record header from the bank start.
+   */
+  uint32_t                  offset;
+  /**
+   * @brief   Record data size.
+   */
+  uint32_t                  size;
+} mfs_checkpoint_entry_t;
+
+/**
+ * @brief   Type of a transaction operation.
+ */
+typedef struct {
+  /**
+   * @brief   Record identifier.
+   */
+  mfs_id_t                  id;
+  /**
+   * @brief   Offset of the record header.
+   */
+  flash_offset_t            offset;
+  /**
+   * @brief   Record data size, zero for an erase operation.
+   */
+  uint32_t                  size;
+} mfs_transaction_op_t;
+
 /**
  * @brief   Type of a MFS configuration structure.
  */
@@ -257,6 +696,18 @@ typedef struct {
    * @brief   Erased value.
    */
   uint32_t                  erased;
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Base sector index for the log.
+   */
+  flash_sector_t            log_start;
+  /**
+   * @brief   Number of sectors for the log.
+   * @note    The sectors must be all of the same size, there must be at
+   *          least three and not more than @p MFS_CFG_LOG_SECTORS.
+   */
+  flash_sector_t            log_sectors;
+#else
   /**
    * @brief   Banks size.
    */
@@ -281,6 +732,23 @@ typedef struct {
    *          @p bank_size.
    */
   flash_sector_t            bank1_sectors;
+#endif
+  /**
+   * @brief   Staging buffer for data transfers or @p NULL.
+   * @details If specified then it is used instead of the internal buffer
+   *          for copying and verifying data, a large buffer reduces the
+   *          number of flash operations during garbage collection and
+   *          when writing large records.
+   * @note    The buffer is used exclusively by this MFS instance.
+   */
+  uint8_t                   *buffer;
+  /**
+   * @brief   Staging buffer size.
+   * @note    The size must be a power of two not smaller than
+   *          @p MFS_CFG_BUFFER_SIZE, a multiple of the flash program page
+   *          size works best.
+   */
+  size_t                    buffer_size;
 } MFSConfig;
 
 /**
@@ -303,6 +771,8 @@ typedef struct {
   mfs_bank_t                current_bank;
   /**
    * @brief   Usage counter of the current bank.
+   * @note    In a log-structured storage it is the sequence number of the
+   *          sector being written.
    */
   uint32_t                  current_counter;
   /**
@@ -313,17 +783,104 @@ typedef struct {
    * @brief   Used space in the current bank without considering erased records.
    */
   flash_offset_t            used_space;
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Size of the log sectors.
+   */
+  flash_offset_t            log_size;
+  /**
+   * @brief   Sector being written.
+   */
+  uint32_t                  log_head;
+  /**
+   * @brief   State of the log sectors.
+   */
+  mfs_log_sector_t          log[MFS_CFG_LOG_SECTORS];
+#endif
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Number of records in the index.
+   */
+  uint32_t                  records_count;
+  /**
+   * @brief   Index of the most recent instance of the records.
+   * @note    Only the first @p records_count entries are valid, entries
+   *          are sorted by identifier.
+   */
+  mfs_record_descriptor_t   descriptors[MFS_CFG_MAX_RECORDS];
+#else
   /**
    * @brief   Offsets of the most recent instance of the records.
    * @note    Zero means that there is not a record with that id.
    */
   mfs_record_descriptor_t   descriptors[MFS_CFG_MAX_RECORDS];
+#endif
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Garbage collection state.
+   * @note    While a collection is in progress the bank not in use is
+   *          the source bank.
+   */
+  mfs_gc_state_t            gc_state;
+  /**
+   * @brief   Next records index entry to be examined.
+   */
+  uint32_t                  gc_index;
+  /**
+   * @brief   Space required by the records still to be moved.
+   */
+  flash_offset_t            gc_pending;
+  /**
+   * @brief   Next sector to be erased.
+   */
+  flash_sector_t            gc_sector;
+  /**
+   * @brief   Source bank sectors limit.
+   */
+  flash_sector_t            gc_end;
+#endif
+#if (MFS_CFG_INDEX_CHECKPOINT == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Value of @p next_offset after the last checkpoint.
+   * @note    Zero if the records index is not covered by a checkpoint.
+   */
+  flash_offset_t            checkpoint_offset;
+#endif
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+  /**
+   * @brief   Pointer to the next free position in the transaction space.
+   */
+  flash_offset_t            tr_next_offset;
+  /**
+   * @brief   Limit of the space reserved by the transaction.
+   */
+  flash_offset_t            tr_limit_offset;
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Number of records created by the transaction.
+   */
+  uint32_t                  tr_new_records;
+#endif
+  /**
+   * @brief   Number of operations in the transaction.
+   */
+  uint32_t                  tr_nops;
+  /**
+   * @brief   Operations performed in the transaction.
+   */
+  mfs_transaction_op_t      tr_ops[MFS_CFG_TRANSACTION_MAX];
+#endif
+  /**
+   * @brief   Garbage collection statistics.
+   */
+  mfs_gc_stats_t            gc_stats;
   /**
    * @brief   Transient buffer.
    */
   union {
     mfs_data_header_t       dhdr;
     mfs_bank_header_t       bhdr;
+    mfs_sector_header_t     shdr;
     uint8_t                 data8[MFS_CFG_BUFFER_SIZE];
     uint16_t                data16[MFS_CFG_BUFFER_SIZE / sizeof (uint16_t)];
     uint32_t                data32[MFS_CFG_BUFFER_SIZE / sizeof (uint32_t)];
@@ -342,6 +899,51 @@ typedef struct {
 #define MFS_IS_WARNING(err) ((err) > MFS_NO_ERROR)
 /** @} */
 
+/**
+ * @brief   Returns the garbage collection statistics.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              Pointer to the @p mfs_gc_stats_t structure.
+ *
+ * @xclass
+ */
+#define mfsGetGarbageCollectionStats(mfsp) (&(mfsp)->gc_stats)
+
+/**
+ * @brief   Returns the number of bank swaps since the storage was created.
+ * @details Each swap erases a bank, garbage collections and calls to
+ *          @p mfsErase() are both accounted. The sectors of a bank are
+ *          always erased together and the two banks are used alternately
+ *          so the sectors have been erased about half this number of
+ *          times, there is no uneven wear to be leveled.
+ * @note    The value is zero if the storage is not mounted.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @return              Number of bank swaps.
+ *
+ * @xclass
+ */
+#if (MFS_CFG_LOG_SECTORS == 0) || defined(__DOXYGEN__)
+#define mfsGetBankSwaps(mfsp)                                                \
+  ((mfsp)->current_counter > 0U ? (mfsp)->current_counter - 1U : 0U)
+#endif
+
+/**
+ * @brief   Returns the number of erase cycles endured by a log sector.
+ * @details The count is kept in the sector header, it is preserved by
+ *          garbage collections and by @p mfsErase().
+ * @note    This macro is available in a log-structured storage only.
+ *
+ * @param[in] mfsp      pointer to the @p MFSDriver object
+ * @param[in] i         index of the sector in the log
+ * @return              Number of erase cycles.
+ *
+ * @xclass
+ */
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+#define mfsGetSectorErases(mfsp, i) ((mfsp)->log[i].erases)
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -359,6 +961,15 @@ extern "C" {
                              size_t n, const uint8_t *buffer);
   mfs_error_t mfsEraseRecord(MFSDriver *devp, mfs_id_t id);
   mfs_error_t mfsPerformGarbageCollection(MFSDriver *mfsp);
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  mfs_error_t mfsPerformGarbageCollectionStep(MFSDriver *mfsp,
+                                              uint32_t *msecp);
+#endif
+#if MFS_CFG_TRANSACTION_MAX > 0
+  mfs_error_t mfsStartTransaction(MFSDriver *mfsp, size_t size);
+  mfs_error_t mfsCommitTransaction(MFSDriver *mfsp);
+  mfs_error_t mfsRollbackTransaction(MFSDriver *mfsp);
+#endif
 #ifdef __cplusplus
 }
 #endif
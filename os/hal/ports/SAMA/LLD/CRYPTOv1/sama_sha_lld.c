@@ -24,15 +24,6 @@ static inline uint32_t min_u32(uint32_t a, uint32_t b)
 {
 	return a < b ? a : b;
 }
-struct sha_data {
-	uint32_t remaining;
-	uint32_t processed;
-	uint32_t block_size;
-	uint32_t output_size;
-	shadalgo_t algo;
-	uint8_t hmac;
-};
-
 
 static uint32_t shaOutputSize(shadalgo_t algo);
 static uint32_t shadPaddedMessSize(uint8_t mode, uint32_t len);
@@ -100,30 +91,27 @@ int sha_finish(CRYDriver *cryp,struct sha_data *shadata,const uint8_t* buffer,ui
 	return 0;
 }
 
-cryerror_t sama_sha_lld_process(CRYDriver *cryp,
+/**
+ * @brief   Starts a SHA computation.
+ * @note    The driver mutex is taken here and released by
+ *          @p sama_sha_lld_final(), only one hash at time can be in
+ *          progress.
+ */
+cryerror_t sama_sha_lld_init(CRYDriver *cryp,
 										shaparams_t *params,
-										const uint8_t *in,
-										uint8_t *out,
-										size_t indata_len
+										struct sha_data *shadata
 										)
 {
 	uint32_t algoregval;
-	struct sha_data shadata;
 
-	if (!(cryp->enabledPer & SHA_PER)) {
-		cryp->enabledPer |= SHA_PER;
-		pmcEnableSHA();
-	}
-
-	osalMutexLock(&cryp->mutex);
+	shadata->processed = 0;
+	shadata->remaining = 0;
+	shadata->output_size = shaOutputSize(params->algo);
+	shadata->block_size = shaBlockSize(params->algo);
+	shadata->algo = params->algo;
+	shadata->hmac = 0;
 
-	shadata.processed = 0;
-	shadata.remaining = 0;
-	shadata.output_size = shaOutputSize(params->algo);
-	shadata.block_size = shaBlockSize(params->algo);
-	shadata.algo = params->algo;
-
-	if (shadata.output_size == 0) {
+	if (shadata->output_size == 0) {
 		return CRY_ERR_INV_ALGO;
 	}
 
@@ -151,6 +139,13 @@ cryerror_t sama_sha_lld_process(CRYDriver *cryp,
 		return CRY_ERR_INV_ALGO;
 	}
 
+	if (!(cryp->enabledPer & SHA_PER)) {
+		cryp->enabledPer |= SHA_PER;
+		pmcEnableSHA();
+	}
+
+	osalMutexLock(&cryp->mutex);
+
 	//soft reset
 	SHA->SHA_CR = SHA_CR_SWRST;
 
@@ -184,6 +179,19 @@ cryerror_t sama_sha_lld_process(CRYDriver *cryp,
 	//enable interrupt
 	SHA->SHA_IER = SHA_IER_DATRDY;
 
+	return CRY_NOERROR;
+}
+
+/**
+ * @brief   Feeds data to a SHA computation started by
+ *          @p sama_sha_lld_init().
+ */
+cryerror_t sama_sha_lld_update(CRYDriver *cryp,
+										struct sha_data *shadata,
+										const uint8_t *in,
+										size_t indata_len
+										)
+{
 	uint32_t buf_in_size;
 	const uint8_t *p = in;
 
@@ -191,23 +199,59 @@ cryerror_t sama_sha_lld_process(CRYDriver *cryp,
 		buf_in_size = min_u32(indata_len, SHA_UPDATE_LEN);
 
 		//First block
-		if (!shadata.processed) {
+		if (!shadata->processed) {
 			SHA->SHA_CR = SHA_CR_FIRST;
 		}
 
-		update(cryp, &shadata, in, buf_in_size);
+		update(cryp, shadata, p, buf_in_size);
 
 		p += buf_in_size;
 		indata_len -= buf_in_size;
 	}
 
-	sha_finish(cryp, &shadata, out, shadata.output_size);
+	return CRY_NOERROR;
+}
+
+/**
+ * @brief   Pads the message, reads the digest and releases the driver.
+ */
+cryerror_t sama_sha_lld_final(CRYDriver *cryp,
+										struct sha_data *shadata,
+										uint8_t *out
+										)
+{
+	//First block, empty or short message
+	if (!shadata->processed) {
+		SHA->SHA_CR = SHA_CR_FIRST;
+	}
+
+	sha_finish(cryp, shadata, out, shadata->output_size);
 
 	osalMutexUnlock(&cryp->mutex);
 
 	return CRY_NOERROR;
 }
 
+cryerror_t sama_sha_lld_process(CRYDriver *cryp,
+										shaparams_t *params,
+										const uint8_t *in,
+										uint8_t *out,
+										size_t indata_len
+										)
+{
+	struct sha_data shadata;
+	cryerror_t ret;
+
+	ret = sama_sha_lld_init(cryp, params, &shadata);
+	if (ret != CRY_NOERROR) {
+		return ret;
+	}
+
+	sama_sha_lld_update(cryp, &shadata, in, indata_len);
+
+	return sama_sha_lld_final(cryp, &shadata, out);
+}
+
 
 static uint32_t shaOutputSize(shadalgo_t algo)
 {
@@ -18,6 +18,19 @@
 
 
 
+cryerror_t sama_sha_lld_init(CRYDriver *cryp,
+										shaparams_t *params,
+										struct sha_data *shadata
+										);
+cryerror_t sama_sha_lld_update(CRYDriver *cryp,
+										struct sha_data *shadata,
+										const uint8_t *in,
+										size_t indata_len
+										);
+cryerror_t sama_sha_lld_final(CRYDriver *cryp,
+										struct sha_data *shadata,
+										uint8_t *out
+										);
 cryerror_t sama_sha_lld_process(CRYDriver *cryp,
 										shaparams_t *params,
 										const uint8_t *in,
@@ -1160,6 +1160,59 @@ cryerror_t cry_lld_SHA1(CRYDriver *cryp, size_t size,
   return ret;
 }
 
+/**
+ * @brief   Hash initialization using SHA1.
+ * @note    The hardware is locked until @p cry_lld_SHA1_final() is
+ *          invoked.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha1ctxp pointer to a SHA1 context
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA1_init(CRYDriver *cryp, SHA1Context *sha1ctxp) {
+  shaparams_t params = {CRY_SHA_1};
+
+  return sama_sha_lld_init(cryp, &params, &sha1ctxp->shadata);
+}
+
+/**
+ * @brief   Hash update using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp  pointer to a SHA1 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA1_update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                               size_t size, const uint8_t *in) {
+
+  return sama_sha_lld_update(cryp, &sha1ctxp->shadata, in, size);
+}
+
+/**
+ * @brief   Hash finalization using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp  pointer to a SHA1 context
+ * @param[out] out      160 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA1_final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                              uint8_t *out) {
+
+  return sama_sha_lld_final(cryp, &sha1ctxp->shadata, out);
+}
+
 /**
  * @brief   Hash using SHA256.
  *
@@ -1191,6 +1244,59 @@ cryerror_t cry_lld_SHA256(CRYDriver *cryp, size_t size,
 	  return ret;
 }
 
+/**
+ * @brief   Hash initialization using SHA256.
+ * @note    The hardware is locked until @p cry_lld_SHA256_final() is
+ *          invoked.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha256ctxp pointer to a SHA256 context
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA256_init(CRYDriver *cryp, SHA256Context *sha256ctxp) {
+  shaparams_t params = {CRY_SHA_256};
+
+  return sama_sha_lld_init(cryp, &params, &sha256ctxp->shadata);
+}
+
+/**
+ * @brief   Hash update using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp pointer to a SHA256 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA256_update(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                                 size_t size, const uint8_t *in) {
+
+  return sama_sha_lld_update(cryp, &sha256ctxp->shadata, in, size);
+}
+
+/**
+ * @brief   Hash finalization using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp pointer to a SHA256 context
+ * @param[out] out      256 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA256_final(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                                uint8_t *out) {
+
+  return sama_sha_lld_final(cryp, &sha256ctxp->shadata, out);
+}
+
 /**
  * @brief   Hash using SHA512.
  *
@@ -1222,6 +1328,59 @@ cryerror_t cry_lld_SHA512(CRYDriver *cryp, size_t size,
 	  return ret;
 }
 
+/**
+ * @brief   Hash initialization using SHA512.
+ * @note    The hardware is locked until @p cry_lld_SHA512_final() is
+ *          invoked.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha512ctxp pointer to a SHA512 context
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA512_init(CRYDriver *cryp, SHA512Context *sha512ctxp) {
+  shaparams_t params = {CRY_SHA_512};
+
+  return sama_sha_lld_init(cryp, &params, &sha512ctxp->shadata);
+}
+
+/**
+ * @brief   Hash update using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp pointer to a SHA512 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA512_update(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                                 size_t size, const uint8_t *in) {
+
+  return sama_sha_lld_update(cryp, &sha512ctxp->shadata, in, size);
+}
+
+/**
+ * @brief   Hash finalization using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp pointer to a SHA512 context
+ * @param[out] out      512 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA512_final(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                                uint8_t *out) {
+
+  return sama_sha_lld_final(cryp, &sha512ctxp->shadata, out);
+}
+
 /**
  * @brief   True random numbers generator.
  *
@@ -48,6 +48,7 @@
 #define CRY_LLD_SUPPORTS_SHA256             TRUE
 #define CRY_LLD_SUPPORTS_SHA512             TRUE
 #define CRY_LLD_SUPPORTS_TRNG               TRUE
+#define CRY_LLD_SUPPORTS_ASYNC              FALSE
 /** @{ */
 
 /*===========================================================================*/
@@ -112,6 +113,39 @@ typedef struct
 	shadalgo_t algo;
 }shaparams_t;
 
+/**
+ * @brief   State of a SHA computation in progress.
+ */
+struct sha_data {
+	uint32_t remaining;
+	uint32_t processed;
+	uint32_t block_size;
+	uint32_t output_size;
+	shadalgo_t algo;
+	uint8_t hmac;
+};
+
+/**
+ * @brief   Type of a SHA1 context.
+ */
+typedef struct {
+  struct sha_data           shadata;
+} SHA1Context;
+
+/**
+ * @brief   Type of a SHA256 context.
+ */
+typedef struct {
+  struct sha_data           shadata;
+} SHA256Context;
+
+/**
+ * @brief   Type of a SHA512 context.
+ */
+typedef struct {
+  struct sha_data           shadata;
+} SHA512Context;
+
 /**
  * @brief   CRY key identifier type.
  */
@@ -178,11 +212,15 @@ struct CRYDriver {
    * @brief   Size of transient key.
    */
   size_t                    key0_size;
-#if (HAL_CRY_USE_FALLBACK == TRUE) || defined(__DOXYGEN__)
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the jobs queue, the first job is the active one.
+   */
+  cryjob_t                  *jqhead;
   /**
-   * @brief   Key buffer for the fall-back implementation.
+   * @brief   Tail of the jobs queue.
    */
-  uint8_t                   key0_buffer[HAL_CRY_MAX_KEY_SIZE];
+  cryjob_t                  *jqtail;
 #endif
 #if defined(CRY_DRIVER_EXT_FIELDS)
   CRY_DRIVER_EXT_FIELDS
@@ -316,10 +354,25 @@ extern "C" {
                                      const uint8_t *iv);
   cryerror_t cry_lld_SHA1(CRYDriver *cryp, size_t size,
                           const uint8_t *in, uint8_t *out);
+  cryerror_t cry_lld_SHA1_init(CRYDriver *cryp, SHA1Context *sha1ctxp);
+  cryerror_t cry_lld_SHA1_update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                 size_t size, const uint8_t *in);
+  cryerror_t cry_lld_SHA1_final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                uint8_t *out);
   cryerror_t cry_lld_SHA256(CRYDriver *cryp, size_t size,
                             const uint8_t *in, uint8_t *out);
+  cryerror_t cry_lld_SHA256_init(CRYDriver *cryp, SHA256Context *sha256ctxp);
+  cryerror_t cry_lld_SHA256_update(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                                   size_t size, const uint8_t *in);
+  cryerror_t cry_lld_SHA256_final(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                                  uint8_t *out);
   cryerror_t cry_lld_SHA512(CRYDriver *cryp, size_t size,
                             const uint8_t *in, uint8_t *out);
+  cryerror_t cry_lld_SHA512_init(CRYDriver *cryp, SHA512Context *sha512ctxp);
+  cryerror_t cry_lld_SHA512_update(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                                   size_t size, const uint8_t *in);
+  cryerror_t cry_lld_SHA512_final(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                                  uint8_t *out);
   cryerror_t cry_lld_TRNG(CRYDriver *cryp, uint8_t *out);
 #ifdef __cplusplus
 }
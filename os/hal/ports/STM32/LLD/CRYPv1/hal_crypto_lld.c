@@ -624,6 +624,147 @@ cryerror_t cry_lld_decrypt_AES_GCM(CRYDriver *cryp,
   return CRY_ERR_INV_ALGO;
 }
 
+/**
+ * @brief   Incremental AES-GCM initialization.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] gcmctxp  pointer to an AES-GCM context
+ * @param[in] key_id    the key to be used for the operation, zero is
+ *                      the transient key, other values are keys stored
+ *                      in an unspecified way
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_AES_GCM_init(CRYDriver *cryp,
+                                AESGCMContext *gcmctxp,
+                                crykey_t key_id,
+                                const uint8_t *iv) {
+
+  (void)cryp;
+  (void)gcmctxp;
+  (void)key_id;
+  (void)iv;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Incremental AES-GCM authentication data input.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmctxp pointer to an AES-GCM context
+ * @param[in] size      size of the authentication data
+ * @param[in] aad       buffer containing the authentication data
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_AES_GCM_update_aad(CRYDriver *cryp,
+                                      AESGCMContext *gcmctxp,
+                                      size_t size,
+                                      const uint8_t *aad) {
+
+  (void)cryp;
+  (void)gcmctxp;
+  (void)size;
+  (void)aad;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Incremental AES-GCM encryption.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmctxp pointer to an AES-GCM context
+ * @param[in] size      size of both buffers
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_encrypt_AES_GCM_update(CRYDriver *cryp,
+                                          AESGCMContext *gcmctxp,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out) {
+
+  (void)cryp;
+  (void)gcmctxp;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Incremental AES-GCM decryption.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmctxp pointer to an AES-GCM context
+ * @param[in] size      size of both buffers
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_decrypt_AES_GCM_update(CRYDriver *cryp,
+                                          AESGCMContext *gcmctxp,
+                                          size_t size,
+                                          const uint8_t *in,
+                                          uint8_t *out) {
+
+  (void)cryp;
+  (void)gcmctxp;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Incremental AES-GCM finalization.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmctxp pointer to an AES-GCM context
+ * @param[out] authtag  128 bits buffer for the generated authentication tag
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_AES_GCM_final(CRYDriver *cryp,
+                                 AESGCMContext *gcmctxp,
+                                 uint8_t *authtag) {
+
+  (void)cryp;
+  (void)gcmctxp;
+  (void)authtag;
+
+  return CRY_ERR_INV_ALGO;
+}
+
 /**
  * @brief   Encryption of a single block using (T)DES.
  * @note    The implementation of this function must guarantee that it can
@@ -881,6 +1022,78 @@ cryerror_t cry_lld_SHA1(CRYDriver *cryp, size_t size,
   return CRY_ERR_INV_ALGO;
 }
 
+/**
+ * @brief   Hash initialization using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha1ctxp pointer to a SHA1 context
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA1_init(CRYDriver *cryp,
+                             SHA1Context *sha1ctxp) {
+
+  (void)cryp;
+  (void)sha1ctxp;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Hash update using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp  pointer to a SHA1 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA1_update(CRYDriver *cryp,
+                               SHA1Context *sha1ctxp,
+                               size_t size,
+                               const uint8_t *in) {
+
+  (void)cryp;
+  (void)sha1ctxp;
+  (void)size;
+  (void)in;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Hash finalization using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp  pointer to a SHA1 context
+ * @param[out] out      160 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA1_final(CRYDriver *cryp,
+                              SHA1Context *sha1ctxp,
+                              uint8_t *out) {
+
+  (void)cryp;
+  (void)sha1ctxp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
 /**
  * @brief   Hash using SHA256.
  *
@@ -906,6 +1119,78 @@ cryerror_t cry_lld_SHA256(CRYDriver *cryp, size_t size,
   return CRY_ERR_INV_ALGO;
 }
 
+/**
+ * @brief   Hash initialization using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha256ctxp pointer to a SHA256 context
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA256_init(CRYDriver *cryp,
+                               SHA256Context *sha256ctxp) {
+
+  (void)cryp;
+  (void)sha256ctxp;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Hash update using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp pointer to a SHA256 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA256_update(CRYDriver *cryp,
+                                 SHA256Context *sha256ctxp,
+                                 size_t size,
+                                 const uint8_t *in) {
+
+  (void)cryp;
+  (void)sha256ctxp;
+  (void)size;
+  (void)in;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Hash finalization using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp pointer to a SHA256 context
+ * @param[out] out      256 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA256_final(CRYDriver *cryp,
+                                SHA256Context *sha256ctxp,
+                                uint8_t *out) {
+
+  (void)cryp;
+  (void)sha256ctxp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
 /**
  * @brief   Hash using SHA512.
  *
@@ -931,6 +1216,78 @@ cryerror_t cry_lld_SHA512(CRYDriver *cryp, size_t size,
   return CRY_ERR_INV_ALGO;
 }
 
+/**
+ * @brief   Hash initialization using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha512ctxp pointer to a SHA512 context
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA512_init(CRYDriver *cryp,
+                               SHA512Context *sha512ctxp) {
+
+  (void)cryp;
+  (void)sha512ctxp;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Hash update using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp pointer to a SHA512 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA512_update(CRYDriver *cryp,
+                                 SHA512Context *sha512ctxp,
+                                 size_t size,
+                                 const uint8_t *in) {
+
+  (void)cryp;
+  (void)sha512ctxp;
+  (void)size;
+  (void)in;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+/**
+ * @brief   Hash finalization using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp pointer to a SHA512 context
+ * @param[out] out      512 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cry_lld_SHA512_final(CRYDriver *cryp,
+                                SHA512Context *sha512ctxp,
+                                uint8_t *out) {
+
+  (void)cryp;
+  (void)sha512ctxp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
 /**
  * @brief   True random numbers generator.
  *
@@ -0,0 +1,182 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/hal_crypto_lld.c
+ * @brief   Simulator cryptographic subsystem low level driver source.
+ *
+ * @addtogroup CRYPTO
+ * @{
+ */
+
+#include "hal.h"
+
+#if ((HAL_USE_CRY == TRUE) && (HAL_CRY_ENFORCE_FALLBACK == FALSE)) ||        \
+    defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/** @brief CRY1 driver identifier.*/
+#if (SIM_CRY_USE_CRY1 == TRUE) || defined(__DOXYGEN__)
+CRYDriver CRYD1;
+#endif
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver interrupt handlers.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Simulated engine interrupt.
+ * @details Executes the started job, if any, and notifies its completion,
+ *          the next queued job is started by the completion handler and
+ *          served by the next check.
+ *
+ * @return              @p true if an interrupt has been served.
+ *
+ * @notapi
+ */
+bool cry_lld_interrupt_pending(void) {
+#if (HAL_CRY_USE_ASYNC == TRUE) && (SIM_CRY_USE_ENGINE == TRUE) &&           \
+    (SIM_CRY_USE_CRY1 == TRUE)
+  cryjob_t *jobp = CRYD1.job;
+  cryerror_t err;
+
+  if (jobp == NULL) {
+    return false;
+  }
+
+  OSAL_IRQ_PROLOGUE();
+
+  CRYD1.job = NULL;
+  err = _cry_job_execute(&CRYD1, jobp);
+  _cry_isr_job_complete(&CRYD1, err);
+
+  OSAL_IRQ_EPILOGUE();
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Low level crypto driver initialization.
+ *
+ * @notapi
+ */
+void cry_lld_init(void) {
+
+#if SIM_CRY_USE_CRY1 == TRUE
+  cryObjectInit(&CRYD1);
+#endif
+}
+
+/**
+ * @brief   Configures and activates the crypto peripheral.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ *
+ * @notapi
+ */
+void cry_lld_start(CRYDriver *cryp) {
+
+#if (HAL_CRY_USE_ASYNC == TRUE) && (SIM_CRY_USE_ENGINE == TRUE)
+  if (cryp->state == CRY_STOP) {
+    cryp->job = NULL;
+  }
+#else
+  (void)cryp;
+#endif
+}
+
+/**
+ * @brief   Deactivates the crypto peripheral.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ *
+ * @notapi
+ */
+void cry_lld_stop(CRYDriver *cryp) {
+
+  (void)cryp;
+}
+
+/**
+ * @brief   Initializes the transient key for a specific algorithm.
+ * @note    Keys are handled by the fall-back implementation.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] algorithm the algorithm identifier
+ * @param[in] size      key size in bytes
+ * @param[in] keyp      pointer to the key data
+ * @return              The operation status.
+ * @retval CRY_ERR_INV_ALGO     always, the fall-back stores the key.
+ *
+ * @notapi
+ */
+cryerror_t cry_lld_loadkey(CRYDriver *cryp,
+                           cryalgorithm_t algorithm,
+                           size_t size,
+                           const uint8_t *keyp) {
+
+  (void)cryp;
+  (void)algorithm;
+  (void)size;
+  (void)keyp;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+#if ((HAL_CRY_USE_ASYNC == TRUE) && (SIM_CRY_USE_ENGINE == TRUE)) ||         \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Starts an asynchronous job.
+ * @details The job is executed on the next interrupt check.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the job to be started
+ *
+ * @iclass
+ */
+void cry_lld_start_job(CRYDriver *cryp, cryjob_t *jobp) {
+
+  osalDbgAssert(cryp->job == NULL, "engine busy");
+
+  cryp->job = jobp;
+}
+#endif
+
+#endif /* (HAL_USE_CRY == TRUE) && (HAL_CRY_ENFORCE_FALLBACK == FALSE) */
+
+/** @} */
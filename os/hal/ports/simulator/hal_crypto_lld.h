@@ -0,0 +1,239 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    simulator/hal_crypto_lld.h
+ * @brief   Simulator cryptographic subsystem low level driver header.
+ * @details The algorithms are implemented by the software fall-back, the
+ *          driver simulates an engine completing one asynchronous job for
+ *          each interrupt check. With the engine disabled the jobs are
+ *          executed synchronously by the HAL.
+ *
+ * @addtogroup CRYPTO
+ * @{
+ */
+
+#ifndef HAL_CRYPTO_LLD_H
+#define HAL_CRYPTO_LLD_H
+
+#if (HAL_USE_CRY == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Driver capability switches
+ * @{
+ */
+#define CRY_LLD_SUPPORTS_AES                FALSE
+#define CRY_LLD_SUPPORTS_AES_ECB            FALSE
+#define CRY_LLD_SUPPORTS_AES_CBC            FALSE
+#define CRY_LLD_SUPPORTS_AES_CFB            FALSE
+#define CRY_LLD_SUPPORTS_AES_CTR            FALSE
+#define CRY_LLD_SUPPORTS_AES_GCM            FALSE
+#define CRY_LLD_SUPPORTS_DES                FALSE
+#define CRY_LLD_SUPPORTS_DES_ECB            FALSE
+#define CRY_LLD_SUPPORTS_DES_CBC            FALSE
+#define CRY_LLD_SUPPORTS_SHA1               FALSE
+#define CRY_LLD_SUPPORTS_SHA256             FALSE
+#define CRY_LLD_SUPPORTS_SHA512             FALSE
+#define CRY_LLD_SUPPORTS_TRNG               FALSE
+#define CRY_LLD_SUPPORTS_ASYNC              SIM_CRY_USE_ENGINE
+/** @} */
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   CRY1 driver enable switch.
+ * @details If set to @p TRUE the support for CRY1 is included.
+ * @note    The default is @p TRUE.
+ */
+#if !defined(SIM_CRY_USE_CRY1) || defined(__DOXYGEN__)
+#define SIM_CRY_USE_CRY1                    TRUE
+#endif
+
+/**
+ * @brief   Simulated engine enable switch.
+ * @details If set to @p TRUE the queued jobs are executed by a simulated
+ *          engine from the interrupt checks, if set to @p FALSE the
+ *          driver does not declare asynchronous support and the jobs are
+ *          executed by the submitting threads.
+ * @note    The default is @p TRUE.
+ */
+#if !defined(SIM_CRY_USE_ENGINE) || defined(__DOXYGEN__)
+#define SIM_CRY_USE_ENGINE                  TRUE
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if HAL_CRY_USE_FALLBACK == FALSE
+#error "the simulator CRY driver requires HAL_CRY_USE_FALLBACK"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   CRY key identifier type.
+ */
+typedef uint32_t crykey_t;
+
+/**
+ * @brief   Type of a structure representing an CRY driver.
+ */
+typedef struct CRYDriver CRYDriver;
+
+/**
+ * @brief   Data transfer mode.
+ * @note    The simulator always transfers data by software, the mode is
+ *          accepted for compatibility with the hardware drivers.
+ */
+typedef enum {
+  TRANSFER_DMA = 0,
+  TRANSFER_POLLING
+} crytransfermode_t;
+
+/**
+ * @brief   AES-CFB segment size.
+ * @note    The fall-back only implements 128 bits segments.
+ */
+typedef enum {
+  AES_CFBS_128 = 0
+} aesciphersize_t;
+
+/**
+ * @brief   (T)DES algorithm.
+ * @note    The fall-back selects DES or TDES from the key size.
+ */
+typedef enum {
+  TDES_ALGO_SINGLE = 0,
+  TDES_ALGO_TRIPLE
+} tdes_algo_t;
+
+/**
+ * @brief   Driver configuration structure.
+ * @note    The fields are ignored by the simulator, they are present in
+ *          order to share the test and application code with the
+ *          hardware drivers.
+ */
+typedef struct {
+  /**
+   * @brief   Data transfer mode.
+   */
+  crytransfermode_t         transfer_mode;
+  /**
+   * @brief   AES-CFB segment size.
+   */
+  uint32_t                  cfbs;
+  /**
+   * @brief   (T)DES algorithm.
+   */
+  tdes_algo_t               tdes_algo;
+} CRYConfig;
+
+/**
+ * @brief   Structure representing an CRY driver.
+ */
+struct CRYDriver {
+  /**
+   * @brief   Driver state.
+   */
+  crystate_t                state;
+  /**
+   * @brief   Current configuration data.
+   */
+  const CRYConfig           *config;
+  /**
+   * @brief   Algorithm type of transient key.
+   */
+  cryalgorithm_t            key0_type;
+  /**
+   * @brief   Size of transient key.
+   */
+  size_t                    key0_size;
+  /**
+   * @brief   Key buffer for the fall-back implementation.
+   */
+  uint8_t                   key0_buffer[HAL_CRY_MAX_KEY_SIZE];
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the jobs queue, the first job is the active one.
+   */
+  cryjob_t                  *jqhead;
+  /**
+   * @brief   Tail of the jobs queue.
+   */
+  cryjob_t                  *jqtail;
+#endif
+#if ((HAL_CRY_USE_ASYNC == TRUE) && (SIM_CRY_USE_ENGINE == TRUE)) ||         \
+    defined(__DOXYGEN__)
+  /**
+   * @brief   Job started on the simulated engine.
+   */
+  cryjob_t                  *job;
+#endif
+#if defined(CRY_DRIVER_EXT_FIELDS)
+  CRY_DRIVER_EXT_FIELDS
+#endif
+  /* End of the mandatory fields.*/
+};
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (SIM_CRY_USE_CRY1 == TRUE) && !defined(__DOXYGEN__)
+extern CRYDriver CRYD1;
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void cry_lld_init(void);
+  void cry_lld_start(CRYDriver *cryp);
+  void cry_lld_stop(CRYDriver *cryp);
+  cryerror_t cry_lld_loadkey(CRYDriver *cryp,
+                             cryalgorithm_t algorithm,
+                             size_t size,
+                             const uint8_t *keyp);
+#if (HAL_CRY_USE_ASYNC == TRUE) && (SIM_CRY_USE_ENGINE == TRUE)
+  void cry_lld_start_job(CRYDriver *cryp, cryjob_t *jobp);
+#endif
+  bool cry_lld_interrupt_pending(void);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_USE_CRY == TRUE */
+
+#endif /* HAL_CRYPTO_LLD_H */
+
+/** @} */
@@ -22,6 +22,12 @@
  * @{
  */
 
+#if defined(WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 #include "hal.h"
 
 #if (OSAL_ST_MODE != OSAL_ST_MODE_NONE) || defined(__DOXYGEN__)
@@ -30,6 +36,16 @@
 /* Driver local definitions.                                                 */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of ticks in a full wrap of the system time counter.
+ */
+#define ST_COUNTER_WRAP                     ((uint64_t)1 << OSAL_ST_RESOLUTION)
+
+/**
+ * @brief   Nanoseconds in a second.
+ */
+#define ST_NS_PER_SECOND                    1000000000ULL
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -42,10 +58,84 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
+#if !SIM_USE_VIRTUAL_TIME || defined(__DOXYGEN__)
+/**
+ * @brief   Host time at driver initialization, in nanoseconds.
+ */
+static uint64_t start_ns;
+#endif
+
+#if SIM_USE_VIRTUAL_TIME || defined(__DOXYGEN__)
+/**
+ * @brief   Virtual time as ticks elapsed since initialization.
+ */
+static uint64_t virtual_ticks;
+#endif
+
+/**
+ * @brief   Last counter value returned to the kernel.
+ */
+static uint64_t last_ticks;
+
+/**
+ * @brief   Alarm enable flag.
+ */
+static bool alarm_active;
+
+/**
+ * @brief   Alarm time as programmed.
+ */
+static systime_t alarm_time;
+
+/**
+ * @brief   Alarm time as an absolute 64 bits ticks count.
+ */
+static uint64_t alarm_ticks;
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if !SIM_USE_VIRTUAL_TIME || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the host monotonic time in nanoseconds.
+ */
+static uint64_t st_get_host_ns(void) {
+#if defined(WIN32)
+  LARGE_INTEGER n, f;
+
+  QueryPerformanceCounter(&n);
+  QueryPerformanceFrequency(&f);
+
+  return (((uint64_t)n.QuadPart / (uint64_t)f.QuadPart) * ST_NS_PER_SECOND) +
+         ((((uint64_t)n.QuadPart % (uint64_t)f.QuadPart) * ST_NS_PER_SECOND) /
+          (uint64_t)f.QuadPart);
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ((uint64_t)ts.tv_sec * ST_NS_PER_SECOND) + (uint64_t)ts.tv_nsec;
+#endif
+}
+#endif /* !SIM_USE_VIRTUAL_TIME */
+
+/**
+ * @brief   Returns the number of ticks elapsed since initialization.
+ * @note    This is the non-wrapping counterpart of the system time.
+ */
+static uint64_t st_get_ticks(void) {
+#if SIM_USE_VIRTUAL_TIME
+  return virtual_ticks;
+#else
+  uint64_t ns = st_get_host_ns() - start_ns;
+
+  return ((ns / ST_NS_PER_SECOND) * (uint64_t)OSAL_ST_FREQUENCY) +
+         (((ns % ST_NS_PER_SECOND) * (uint64_t)OSAL_ST_FREQUENCY) /
+          ST_NS_PER_SECOND);
+#endif
+}
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -60,7 +150,191 @@
  * @notapi
  */
 void st_lld_init(void) {
+
+#if SIM_USE_VIRTUAL_TIME
+  virtual_ticks = (uint64_t)0;
+#else
+  start_ns     = st_get_host_ns();
+#endif
+  last_ticks   = (uint64_t)0;
+  alarm_active = false;
+  alarm_time   = (systime_t)0;
+  alarm_ticks  = (uint64_t)0;
+}
+
+/**
+ * @brief   Returns the time counter value.
+ *
+ * @return              The counter value.
+ *
+ * @notapi
+ */
+systime_t st_lld_get_counter(void) {
+
+  last_ticks = st_get_ticks();
+
+  return (systime_t)last_ticks;
+}
+
+/**
+ * @brief   Starts the alarm.
+ * @note    Makes sure that no spurious alarms are triggered after
+ *          this call.
+ *
+ * @param[in] time      the time to be set for the first alarm
+ *
+ * @notapi
+ */
+void st_lld_start_alarm(systime_t time) {
+
+  st_lld_set_alarm(time);
+  alarm_active = true;
+}
+
+/**
+ * @brief   Stops the alarm interrupt.
+ *
+ * @notapi
+ */
+void st_lld_stop_alarm(void) {
+
+  alarm_active = false;
+}
+
+/**
+ * @brief   Sets the alarm time.
+ * @details The alarm is matched on the next occurrence of the specified
+ *          counter value, exactly like a compare unit would do.
+ * @note    The kernel computes the alarm time from the last counter value
+ *          it read, the distance is taken from that value so alarms up to
+ *          @p TIME_MAX_SYSTIME ticks ahead are kept. If the host preempted
+ *          the simulator after that read then the alarm time can be already
+ *          elapsed, it is matched on the next poll instead of waiting for a
+ *          full counter wrap.
+ *
+ * @param[in] time      the time to be set for the next alarm
+ *
+ * @notapi
+ */
+void st_lld_set_alarm(systime_t time) {
+
+  alarm_time  = time;
+  alarm_ticks = last_ticks +
+                (uint64_t)(systime_t)(time - (systime_t)last_ticks);
+}
+
+/**
+ * @brief   Returns the current alarm time.
+ *
+ * @return              The currently set alarm time.
+ *
+ * @notapi
+ */
+systime_t st_lld_get_alarm(void) {
+
+  return alarm_time;
+}
+
+/**
+ * @brief   Determines if the alarm is active.
+ *
+ * @return              The alarm status.
+ * @retval false        if the alarm is not active.
+ * @retval true         is the alarm is active
+ *
+ * @notapi
+ */
+bool st_lld_is_alarm_active(void) {
+
+  return alarm_active;
+}
+
+/**
+ * @brief   Returns the host time left before the alarm is matched.
+ * @note    The alarm is assumed to be active.
+ *
+ * @return              The time in nanoseconds, zero if the alarm is
+ *                      already due.
+ *
+ * @notapi
+ */
+uint64_t st_lld_get_alarm_delay_ns(void) {
+#if SIM_USE_VIRTUAL_TIME
+
+  /* There is no host time to wait for in virtual time mode.*/
+  return (uint64_t)0;
+#else
+  uint64_t ns, deadline, ticks = alarm_ticks;
+
+  /* Host time of the alarm tick rounded up, relative to initialization.*/
+  deadline = ((ticks / (uint64_t)OSAL_ST_FREQUENCY) * ST_NS_PER_SECOND) +
+             ((((ticks % (uint64_t)OSAL_ST_FREQUENCY) * ST_NS_PER_SECOND) +
+               (uint64_t)OSAL_ST_FREQUENCY - 1U) / (uint64_t)OSAL_ST_FREQUENCY);
+  ns = st_get_host_ns() - start_ns;
+  if (ns >= deadline) {
+    return (uint64_t)0;
+  }
+  return deadline - ns;
+#endif
+}
+
+/**
+ * @brief   Alarm interrupt simulation.
+ * @details If the alarm time has been reached then the OS timer handler is
+ *          invoked.
+ *
+ * @return              The interrupt status.
+ * @retval false        if the alarm interrupt was not pending.
+ * @retval true         if the alarm interrupt has been served.
+ *
+ * @notapi
+ */
+bool st_lld_interrupt_pending(void) {
+  uint64_t now = st_get_ticks();
+
+  if (!alarm_active || (now < alarm_ticks)) {
+    return false;
+  }
+
+  /* Like a real compare unit the alarm would match again only after a full
+     counter wrap, the handler normally reprograms or stops it.*/
+  alarm_ticks += ST_COUNTER_WRAP;
+
+  OSAL_IRQ_PROLOGUE();
+
+  osalSysLockFromISR();
+  osalOsTimerHandlerI();
+  osalSysUnlockFromISR();
+
+  OSAL_IRQ_EPILOGUE();
+
+  return true;
+}
+
+#if SIM_USE_VIRTUAL_TIME || defined(__DOXYGEN__)
+/**
+ * @brief   Advances the virtual time by one tick.
+ *
+ * @notapi
+ */
+void st_lld_advance_time(void) {
+
+  virtual_ticks++;
+}
+
+/**
+ * @brief   Makes the virtual time jump to the alarm time.
+ * @note    The alarm is assumed to be active.
+ *
+ * @notapi
+ */
+void st_lld_skip_to_alarm(void) {
+
+  if (alarm_ticks > virtual_ticks) {
+    virtual_ticks = alarm_ticks;
+  }
 }
+#endif /* SIM_USE_VIRTUAL_TIME */
 
 #endif /* OSAL_ST_MODE != OSAL_ST_MODE_NONE */
 
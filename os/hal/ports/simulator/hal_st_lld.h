@@ -35,6 +35,27 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Virtual time switch.
+ * @details If set to @p TRUE the system time is decoupled from the host
+ *          time, it only advances when polled from busy loops or, when the
+ *          system is idle, it jumps straight to the next deadline.
+ * @note    The default is @p FALSE.
+ * @note    Only supported by the Posix simulator.
+ */
+#if !defined(SIM_USE_VIRTUAL_TIME) || defined(__DOXYGEN__)
+#define SIM_USE_VIRTUAL_TIME                FALSE
+#endif
+
+/**
+ * @brief   Virtual time polls per tick.
+ * @details Number of polls from busy loops required to make the virtual
+ *          time advance by one tick, it models the cost of a poll.
+ */
+#if !defined(SIM_VIRTUAL_POLLS_PER_TICK) || defined(__DOXYGEN__)
+#define SIM_VIRTUAL_POLLS_PER_TICK          16
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -55,87 +76,22 @@
 extern "C" {
 #endif
   void st_lld_init(void);
+  systime_t st_lld_get_counter(void);
+  void st_lld_start_alarm(systime_t time);
+  void st_lld_stop_alarm(void);
+  void st_lld_set_alarm(systime_t time);
+  systime_t st_lld_get_alarm(void);
+  bool st_lld_is_alarm_active(void);
+  uint64_t st_lld_get_alarm_delay_ns(void);
+  bool st_lld_interrupt_pending(void);
+#if SIM_USE_VIRTUAL_TIME
+  void st_lld_advance_time(void);
+  void st_lld_skip_to_alarm(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
 
-/*===========================================================================*/
-/* Driver inline functions.                                                  */
-/*===========================================================================*/
-
-/**
- * @brief   Returns the time counter value.
- *
- * @return              The counter value.
- *
- * @notapi
- */
-static inline systime_t st_lld_get_counter(void) {
-
-  return (systime_t)0;
-}
-
-/**
- * @brief   Starts the alarm.
- * @note    Makes sure that no spurious alarms are triggered after
- *          this call.
- *
- * @param[in] time      the time to be set for the first alarm
- *
- * @notapi
- */
-static inline void st_lld_start_alarm(systime_t time) {
-
-  (void)time;
-}
-
-/**
- * @brief   Stops the alarm interrupt.
- *
- * @notapi
- */
-static inline void st_lld_stop_alarm(void) {
-
-}
-
-/**
- * @brief   Sets the alarm time.
- *
- * @param[in] time      the time to be set for the next alarm
- *
- * @notapi
- */
-static inline void st_lld_set_alarm(systime_t time) {
-
-  (void)time;
-}
-
-/**
- * @brief   Returns the current alarm time.
- *
- * @return              The currently set alarm time.
- *
- * @notapi
- */
-static inline systime_t st_lld_get_alarm(void) {
-
-  return (systime_t)0;
-}
-
-/**
- * @brief   Determines if the alarm is active.
- *
- * @return              The alarm status.
- * @retval false        if the alarm is not active.
- * @retval true         is the alarm is active
- *
- * @notapi
- */
-static inline bool st_lld_is_alarm_active(void) {
-
-  return false;
-}
-
 #endif /* HAL_ST_LLD_H */
 
 /** @} */
@@ -24,10 +24,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/time.h>
+#include <time.h>
 
 #include "hal.h"
 
+#if SIM_USE_EVENT_WAIT
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -36,13 +41,214 @@
 /* Driver local variables and types.                                         */
 /*===========================================================================*/
 
-static struct timeval nextcnt;
-static struct timeval tick = {0UL, 1000000UL / OSAL_ST_FREQUENCY};
+#if ((OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC) && !SIM_USE_VIRTUAL_TIME) ||   \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Host time of the next system tick.
+ */
+static struct timespec nextcnt;
+#endif
+
+#if SIM_USE_VIRTUAL_TIME || defined(__DOXYGEN__)
+/**
+ * @brief   Polls counter for the virtual time.
+ */
+static unsigned virtual_polls;
+#endif
+
+#if SIM_USE_EVENT_WAIT || defined(__DOXYGEN__)
+/**
+ * @brief   Host @p epoll instance used by the idle wait.
+ */
+static int epoll_fd = -1;
+
+/**
+ * @brief   Host one-shot timer armed on the next virtual timer deadline.
+ */
+static int timer_fd = -1;
+#endif
 
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC) || defined(__DOXYGEN__)
+/**
+ * @brief   System ticks simulation.
+ *
+ * @param[in] n         number of ticks to be served
+ */
+static void sim_serve_ticks(sysinterval_t n) {
+
+  CH_IRQ_PROLOGUE();
+
+  chSysLockFromISR();
+  while (n > (sysinterval_t)0) {
+    chSysTimerHandlerI();
+    n--;
+  }
+  chSysUnlockFromISR();
+
+  CH_IRQ_EPILOGUE();
+
+  _dbg_check_lock();
+  if (chSchIsPreemptionRequired())
+    chSchDoReschedule();
+  _dbg_check_unlock();
+}
+#endif /* OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC */
+
+#if ((OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC) && !SIM_USE_VIRTUAL_TIME) ||   \
+    defined(__DOXYGEN__)
+/**
+ * @brief   Advances an host time by the specified number of system ticks.
+ *
+ * @param[in,out] tsp   pointer to the host time
+ * @param[in] ticks     number of ticks to be added
+ */
+static void sim_add_ticks(struct timespec *tsp, sysinterval_t ticks) {
+  uint64_t ns;
+
+  ns = (uint64_t)tsp->tv_nsec +
+       ((uint64_t)ticks * (1000000000ULL / (uint64_t)OSAL_ST_FREQUENCY));
+  tsp->tv_sec  += (time_t)(ns / 1000000000ULL);
+  tsp->tv_nsec  = (long)(ns % 1000000000ULL);
+}
+
+/**
+ * @brief   Checks if an host time has been reached.
+ *
+ * @param[in] tsp       pointer to the host time to be checked
+ * @return              The check result.
+ * @retval false        if the time is still in the future.
+ * @retval true         if the time has been reached.
+ */
+static bool sim_time_reached(const struct timespec *tsp) {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  if (now.tv_sec != tsp->tv_sec) {
+    return now.tv_sec > tsp->tv_sec;
+  }
+  return now.tv_nsec >= tsp->tv_nsec;
+}
+#endif /* (OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC) && !SIM_USE_VIRTUAL_TIME */
+
+#if SIM_USE_VIRTUAL_TIME || defined(__DOXYGEN__)
+/**
+ * @brief   Advances the virtual time.
+ * @details When invoked from the idle thread the time jumps straight to the
+ *          next deadline, when invoked from a polling loop a single tick
+ *          elapses every @p SIM_VIRTUAL_POLLS_PER_TICK polls. The time never
+ *          advances by itself, this makes runs reproducible.
+ *
+ * @return              The operation result.
+ * @retval false        if the time has not been advanced.
+ * @retval true         if the time has been advanced.
+ */
+static bool sim_advance_virtual_time(void) {
+  bool idle = chThdGetPriorityX() == IDLEPRIO;
+
+  if (!idle) {
+    if (++virtual_polls < (unsigned)SIM_VIRTUAL_POLLS_PER_TICK) {
+      return false;
+    }
+    virtual_polls = 0U;
+  }
+
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  sysinterval_t ticks = (sysinterval_t)1;
+
+  if (idle) {
+    bool armed;
+
+    chSysLock();
+    armed = chVTGetTimersStateI(&ticks);
+    chSysUnlock();
+
+    if (!armed) {
+      return false;
+    }
+  }
+
+  sim_serve_ticks(ticks);
+#else /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+  if (idle) {
+    if (!st_lld_is_alarm_active()) {
+      return false;
+    }
+    st_lld_skip_to_alarm();
+  }
+  else {
+    st_lld_advance_time();
+  }
+
+  if (st_lld_interrupt_pending()) {
+    _dbg_check_lock();
+    if (chSchIsPreemptionRequired())
+      chSchDoReschedule();
+    _dbg_check_unlock();
+  }
+#endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+
+  return true;
+}
+#endif /* SIM_USE_VIRTUAL_TIME */
+
+#if SIM_USE_EVENT_WAIT || defined(__DOXYGEN__)
+/**
+ * @brief   Blocks the host process until there is something to do.
+ * @details The host timer is armed on the tick that will trigger the first
+ *          virtual timer in the list (or on the ST alarm in free running
+ *          mode), if there is none the timer is left disarmed and only I/O
+ *          activity can end the wait.
+ */
+static void sim_wait_events(void) {
+  struct itimerspec its = {{0, 0}, {0, 0}};
+  struct epoll_event ev;
+#if SIM_USE_VIRTUAL_TIME
+  /* The wait happens only when there are no deadlines to jump to, the host
+     timer is not used.*/
+  (void)its;
+#elif OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  sysinterval_t ticks;
+  bool armed;
+
+  chSysLock();
+  armed = chVTGetTimersStateI(&ticks);
+  chSysUnlock();
+
+  if (armed) {
+    /* The next tick is already scheduled at "nextcnt".*/
+    its.it_value = nextcnt;
+    if (ticks > (sysinterval_t)1) {
+      sim_add_ticks(&its.it_value, ticks - (sysinterval_t)1);
+    }
+  }
+
+  /* Re-arming also clears any stale expiration from the previous wait.*/
+  (void) timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+#else /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+  if (st_lld_is_alarm_active()) {
+    uint64_t ns = st_lld_get_alarm_delay_ns();
+
+    /* A zero value would disarm the timer, an alarm already due must
+       expire immediately instead.*/
+    if (ns == (uint64_t)0) {
+      ns = (uint64_t)1;
+    }
+    its.it_value.tv_sec  = (time_t)(ns / 1000000000ULL);
+    its.it_value.tv_nsec = (long)(ns % 1000000000ULL);
+  }
+
+  /* Re-arming also clears any stale expiration from the previous wait.*/
+  (void) timerfd_settime(timer_fd, 0, &its, NULL);
+#endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+  (void) epoll_wait(epoll_fd, &ev, 1, -1);
+}
+#endif /* SIM_USE_EVENT_WAIT */
+
 /*===========================================================================*/
 /* Driver interrupt handlers.                                                */
 /*===========================================================================*/
@@ -61,15 +267,51 @@ void hal_lld_init(void) {
 #else
   puts("ChibiOS/RT simulator (Linux)\n");
 #endif
-  gettimeofday(&nextcnt, NULL);
-  timeradd(&nextcnt, &tick, &nextcnt);
+#if (OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC) && !SIM_USE_VIRTUAL_TIME
+  clock_gettime(CLOCK_MONOTONIC, &nextcnt);
+  sim_add_ticks(&nextcnt, (sysinterval_t)1);
+#endif
+
+#if SIM_USE_EVENT_WAIT
+  epoll_fd = epoll_create1(0);
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, 0);
+  if ((epoll_fd == -1) || (timer_fd == -1)) {
+    printf("Unable to create the host event sources\n");
+    exit(1);
+  }
+  _sim_add_event_source(timer_fd);
+#endif
 }
 
+#if SIM_USE_EVENT_WAIT || defined(__DOXYGEN__)
+/**
+ * @brief   Adds an host file descriptor to the idle wait event sources.
+ * @details The idle wait is terminated when new data arrives on the
+ *          descriptor or when the peer closes the connection.
+ * @note    The descriptor is edge triggered, data left unread does not
+ *          terminate the following waits. Drivers must not rely on the
+ *          wait for data they did not consume, all sources are polled
+ *          again before each wait.
+ * @note    Closed descriptors are removed automatically by the host.
+ *
+ * @param[in] fd        the host file descriptor
+ */
+void _sim_add_event_source(int fd) {
+  struct epoll_event ev;
+
+  ev.events  = EPOLLIN | EPOLLRDHUP | EPOLLET;
+  ev.data.fd = fd;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    printf("Unable to register an host event source\n");
+    exit(1);
+  }
+}
+#endif /* SIM_USE_EVENT_WAIT */
+
 /**
  * @brief   Interrupt simulation.
  */
 void _sim_check_for_interrupts(void) {
-  struct timeval tv;
 
 #if HAL_USE_SERIAL
   if (sd_lld_interrupt_pending()) {
@@ -81,23 +323,43 @@ void _sim_check_for_interrupts(void) {
   }
 #endif
 
-  gettimeofday(&tv, NULL);
-  if (timercmp(&tv, &nextcnt, >=)) {
-    timeradd(&nextcnt, &tick, &nextcnt);
-
-    CH_IRQ_PROLOGUE();
-
-    chSysLockFromISR();
-    chSysTimerHandlerI();
-    chSysUnlockFromISR();
-
-    CH_IRQ_EPILOGUE();
+#if HAL_USE_CRY && !HAL_CRY_ENFORCE_FALLBACK
+  if (cry_lld_interrupt_pending()) {
+    _dbg_check_lock();
+    if (chSchIsPreemptionRequired())
+      chSchDoReschedule();
+    _dbg_check_unlock();
+    return;
+  }
+#endif
 
+#if SIM_USE_VIRTUAL_TIME
+  if (sim_advance_virtual_time()) {
+    return;
+  }
+#elif OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
+  if (sim_time_reached(&nextcnt)) {
+    sim_add_ticks(&nextcnt, (sysinterval_t)1);
+    sim_serve_ticks((sysinterval_t)1);
+    return;
+  }
+#else /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+  if (st_lld_interrupt_pending()) {
     _dbg_check_lock();
     if (chSchIsPreemptionRequired())
       chSchDoReschedule();
     _dbg_check_unlock();
+    return;
   }
+#endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+
+#if SIM_USE_EVENT_WAIT
+  /* Only the idle thread is allowed to block the host, the test code polls
+     this function from busy loops while waiting for time to pass.*/
+  if (chThdGetPriorityX() == IDLEPRIO) {
+    sim_wait_events();
+  }
+#endif
 }
 
 /** @} */
@@ -53,10 +53,27 @@
 /* Driver pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Blocking idle wait switch.
+ * @details If set to @p TRUE the idle thread blocks the host process on
+ *          @p epoll until the next virtual timer deadline or until activity
+ *          on a registered event source (the simulated serial sockets).
+ *          If set to @p FALSE the host time is polled continuously.
+ * @note    The default is @p FALSE.
+ * @note    Requires Linux @p epoll and @p timerfd support.
+ */
+#if !defined(SIM_USE_EVENT_WAIT) || defined(__DOXYGEN__)
+#define SIM_USE_EVENT_WAIT                  FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if SIM_USE_EVENT_WAIT && !defined(__linux__)
+#error "SIM_USE_EVENT_WAIT requires a Linux host"
+#endif
+
 /*===========================================================================*/
 /* Driver data structures and types.                                         */
 /*===========================================================================*/
@@ -70,6 +87,9 @@ extern "C" {
 #endif
   void hal_lld_init(void);
   void _sim_check_for_interrupts(void);
+#if SIM_USE_EVENT_WAIT
+  void _sim_add_event_source(int fd);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -100,6 +100,9 @@ static void init(SerialDriver *sdp, uint16_t port) {
     printf("%s: Error listening socket\n", sdp->com_name);
     goto abort;
   }
+#if SIM_USE_EVENT_WAIT
+  _sim_add_event_source(sdp->com_listen);
+#endif
   printf("Full Duplex Channel %s listening on port %d\n", sdp->com_name, port);
   return;
 
@@ -129,6 +132,9 @@ static bool connint(SerialDriver *sdp) {
       printf("%s: Unable to setup non blocking mode on data socket\n", sdp->com_name);
       goto abort;
     }
+#if SIM_USE_EVENT_WAIT
+    _sim_add_event_source(sdp->com_data);
+#endif
 
     osalSysLockFromISR();
     chnAddFlagsI(sdp, CHN_CONNECTED);
@@ -148,12 +154,21 @@ static bool inint(SerialDriver *sdp) {
 
   if (sdp->com_data != -1) {
     int i;
+    size_t space;
     uint8_t data[32];
 
     /*
-     * Input.
+     * Input, the data is left in the socket while the input queue is
+     * full so that the peer is throttled instead of losing data.
      */
-    int n = recv(sdp->com_data, data, sizeof(data), 0);
+    osalSysLockFromISR();
+    space = iqGetEmptyI(&sdp->iqueue);
+    osalSysUnlockFromISR();
+    if (space == 0U)
+      return false;
+    if (space > sizeof(data))
+      space = sizeof(data);
+    int n = recv(sdp->com_data, data, space, 0);
     switch (n) {
     case 0:
       close(sdp->com_data);
@@ -0,0 +1,575 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sim_flash.c
+ * @brief   Simulated flash device code.
+ *
+ * @addtogroup SIM_FLASH
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+#include "sim_flash.h"
+
+#if SIM_FLASH_USE_FILES == TRUE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+static const flash_descriptor_t *sim_flash_get_descriptor(void *instance);
+static flash_error_t sim_flash_read(void *instance, flash_offset_t offset,
+                                    size_t n, uint8_t *rp);
+static flash_error_t sim_flash_program(void *instance, flash_offset_t offset,
+                                       size_t n, const uint8_t *pp);
+static flash_error_t sim_flash_start_erase_all(void *instance);
+static flash_error_t sim_flash_start_erase_sector(void *instance,
+                                                  flash_sector_t sector);
+static flash_error_t sim_flash_query_erase(void *instance, uint32_t *msec);
+static flash_error_t sim_flash_verify_erase(void *instance,
+                                            flash_sector_t sector);
+
+/**
+ * @brief   Virtual methods table.
+ */
+static const struct SimFlashDriverVMT sim_flash_vmt = {
+  sim_flash_get_descriptor, sim_flash_read, sim_flash_program,
+  sim_flash_start_erase_all, sim_flash_start_erase_sector,
+  sim_flash_query_erase, sim_flash_verify_erase
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Accounts a byte for the power cut injection.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ * @return              The power state.
+ * @retval false        if power is still present.
+ * @retval true         if power has just been cut.
+ *
+ * @notapi
+ */
+static bool sim_flash_power_tick(SimFlashDriver *devp) {
+
+  if (devp->cut_countdown > 0U) {
+    devp->cut_countdown--;
+    if (devp->cut_countdown == 0U) {
+      devp->powered_off = true;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Simulates the device busy time.
+ * @details Simulated interrupts are served while the device is busy, this
+ *          makes the system time advance during sequences of flash
+ *          operations not involving waits.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ *
+ * @notapi
+ */
+static void sim_flash_busy(SimFlashDriver *devp) {
+
+  (void)devp;
+
+  _sim_check_for_interrupts();
+}
+
+/**
+ * @brief   Erases a sector.
+ * @note    On a power cut the sector is left partially erased.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ * @param[in] sector    sector to be erased
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static flash_error_t sim_flash_erase(SimFlashDriver *devp,
+                                     flash_sector_t sector) {
+  flash_offset_t offset;
+  uint32_t i, size;
+
+  offset = flashGetSectorOffset((BaseFlash *)devp, sector);
+  size   = flashGetSectorSize((BaseFlash *)devp, sector);
+
+  devp->stats.erases++;
+  devp->stats.busy_time += (uint64_t)devp->config->erase_time * 1000U;
+  if (devp->config->erase_counters != NULL) {
+    devp->config->erase_counters[sector]++;
+  }
+
+  for (i = 0U; i < size; i++) {
+    devp->memory[offset + i] = SIM_FLASH_ERASED_VALUE;
+    if (sim_flash_power_tick(devp)) {
+      return FLASH_ERROR_HW_FAILURE;
+    }
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+/**
+ * @brief   Starts the modeled erase time.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ * @param[in] n         number of erased sectors
+ *
+ * @notapi
+ */
+static void sim_flash_start_erase_time(SimFlashDriver *devp, uint32_t n) {
+
+  if (devp->config->erase_time > 0U) {
+    devp->state          = FLASH_ERASE;
+    devp->erase_start    = osalOsGetSystemTimeX();
+    devp->erase_interval = OSAL_MS2I(devp->config->erase_time * n);
+  }
+}
+
+static const flash_descriptor_t *sim_flash_get_descriptor(void *instance) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state != FLASH_UNINIT) && (devp->state != FLASH_STOP),
+                "invalid state");
+
+  return &devp->descriptor;
+}
+
+static flash_error_t sim_flash_read(void *instance, flash_offset_t offset,
+                                    size_t n, uint8_t *rp) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+
+  osalDbgCheck((instance != NULL) && (rp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= devp->size);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  if (devp->powered_off) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  devp->stats.reads++;
+  devp->stats.read_bytes += (uint32_t)n;
+  memcpy(rp, &devp->memory[offset], n);
+  sim_flash_busy(devp);
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_flash_program(void *instance, flash_offset_t offset,
+                                       size_t n, const uint8_t *pp) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+  uint32_t page_mask;
+
+  osalDbgCheck((instance != NULL) && (pp != NULL) && (n > 0U));
+  osalDbgCheck((size_t)offset + n <= devp->size);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  if (devp->powered_off) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  /* FLASH_PGM state while the operation is performed.*/
+  devp->state = FLASH_PGM;
+  devp->stats.programs++;
+
+  /* Data is programmed page by page.*/
+  page_mask = devp->descriptor.page_size - 1U;
+  while (n > 0U) {
+    size_t i;
+
+    /* Data size that can be written in a single program page operation.*/
+    size_t chunk = (size_t)(((offset | page_mask) + 1U) - offset);
+    if (chunk > n) {
+      chunk = n;
+    }
+
+    devp->stats.busy_time += (uint64_t)devp->config->program_time;
+
+    for (i = 0U; i < chunk; i++) {
+      uint8_t *p = &devp->memory[offset + i];
+
+      /* Non re-writable devices can only program erased locations.*/
+      if (((devp->descriptor.attributes & FLASH_ATTR_REWRITABLE) == 0U) &&
+          (*p != SIM_FLASH_ERASED_VALUE) && (pp[i] != SIM_FLASH_ERASED_VALUE)) {
+        devp->state = FLASH_READY;
+        return FLASH_ERROR_PROGRAM;
+      }
+
+      /* NOR semantic, bits can only be cleared.*/
+      if (sim_flash_power_tick(devp)) {
+        /* Power lost while programming, only some bits made it.*/
+        *p &= pp[i] | 0xF0U;
+        devp->state = FLASH_READY;
+        return FLASH_ERROR_HW_FAILURE;
+      }
+      *p &= pp[i];
+      devp->stats.program_bytes++;
+    }
+
+    /* Next page.*/
+    offset += chunk;
+    pp     += chunk;
+    n      -= chunk;
+  }
+
+  /* Ready state again.*/
+  devp->state = FLASH_READY;
+  sim_flash_busy(devp);
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_flash_start_erase_all(void *instance) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+  flash_sector_t sector;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  if (devp->powered_off) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  for (sector = 0U; sector < devp->descriptor.sectors_count; sector++) {
+    flash_error_t err = sim_flash_erase(devp, sector);
+    if (err != FLASH_NO_ERROR) {
+      return err;
+    }
+  }
+
+  sim_flash_start_erase_time(devp, devp->descriptor.sectors_count);
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_flash_start_erase_sector(void *instance,
+                                                  flash_sector_t sector) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+  flash_error_t err;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgCheck(sector < devp->descriptor.sectors_count);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  if (devp->powered_off) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  err = sim_flash_erase(devp, sector);
+  if (err == FLASH_NO_ERROR) {
+    sim_flash_start_erase_time(devp, 1U);
+  }
+
+  return err;
+}
+
+static flash_error_t sim_flash_query_erase(void *instance, uint32_t *msec) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  if (devp->powered_off) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  /* If there is an erase in progress then the modeled time is checked.*/
+  if (devp->state == FLASH_ERASE) {
+    sysinterval_t elapsed = osalTimeDiffX(devp->erase_start,
+                                          osalOsGetSystemTimeX());
+
+    if (elapsed < devp->erase_interval) {
+      /* Recommended time before polling again, this is a simplified
+         implementation.*/
+      if (msec != NULL) {
+        *msec = 1U;
+      }
+
+      return FLASH_BUSY_ERASING;
+    }
+
+    /* The device is ready to accept commands.*/
+    devp->state = FLASH_READY;
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+static flash_error_t sim_flash_verify_erase(void *instance,
+                                            flash_sector_t sector) {
+  SimFlashDriver *devp = (SimFlashDriver *)instance;
+  flash_offset_t offset;
+  uint32_t i, size;
+
+  osalDbgCheck(instance != NULL);
+  osalDbgCheck(sector < devp->descriptor.sectors_count);
+  osalDbgAssert((devp->state == FLASH_READY) || (devp->state == FLASH_ERASE),
+                "invalid state");
+
+  if (devp->powered_off) {
+    return FLASH_ERROR_HW_FAILURE;
+  }
+
+  if (devp->state == FLASH_ERASE) {
+    return FLASH_BUSY_ERASING;
+  }
+
+  offset = flashGetSectorOffset((BaseFlash *)devp, sector);
+  size   = flashGetSectorSize((BaseFlash *)devp, sector);
+  for (i = 0U; i < size; i++) {
+    if (devp->memory[offset + i] != SIM_FLASH_ERASED_VALUE) {
+      return FLASH_ERROR_VERIFY;
+    }
+  }
+
+  return FLASH_NO_ERROR;
+}
+
+#if (SIM_FLASH_USE_FILES == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Maps the backing file in memory.
+ * @note    Files not matching the device size are re-initialized in
+ *          the erased state.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ *
+ * @notapi
+ */
+static void sim_flash_map_file(SimFlashDriver *devp) {
+  struct stat st;
+  bool erase;
+  void *p;
+  int fd;
+
+  fd = open(devp->config->filename, O_RDWR | O_CREAT, 0666);
+  if (fd < 0) {
+    osalSysHalt("flash file open failure");
+  }
+
+  erase = (fstat(fd, &st) != 0) || ((size_t)st.st_size != devp->size);
+  if (erase && (ftruncate(fd, (off_t)devp->size) != 0)) {
+    osalSysHalt("flash file size failure");
+  }
+
+  p = mmap(NULL, devp->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (p == MAP_FAILED) {
+    osalSysHalt("flash file mapping failure");
+  }
+
+  devp->memory = (uint8_t *)p;
+  if (erase) {
+    memset(devp->memory, SIM_FLASH_ERASED_VALUE, devp->size);
+  }
+}
+#endif /* SIM_FLASH_USE_FILES == TRUE */
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes an instance.
+ *
+ * @param[out] devp     pointer to the @p SimFlashDriver object
+ *
+ * @init
+ */
+void simflashObjectInit(SimFlashDriver *devp) {
+
+  osalDbgCheck(devp != NULL);
+
+  devp->vmt           = &sim_flash_vmt;
+  devp->state         = FLASH_STOP;
+  devp->config        = NULL;
+  devp->memory        = NULL;
+  devp->cut_countdown = 0U;
+  devp->powered_off   = false;
+  simflashResetStats(devp);
+}
+
+/**
+ * @brief   Configures and activates a simulated flash device.
+ * @details The memory content is preserved, starting a device after an
+ *          injected power cut simulates a reboot.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ * @param[in] config    pointer to the configuration
+ *
+ * @api
+ */
+void simflashStart(SimFlashDriver *devp, const SimFlashConfig *config) {
+
+  osalDbgCheck((devp != NULL) && (config != NULL));
+  osalDbgCheck((config->page_size & (config->page_size - 1U)) == 0U);
+  osalDbgAssert(devp->state != FLASH_UNINIT, "invalid state");
+
+  if (devp->state == FLASH_STOP) {
+    devp->config                   = config;
+    devp->descriptor.attributes    = config->attributes |
+                                     FLASH_ATTR_ERASED_IS_ONE;
+    devp->descriptor.page_size     = config->page_size;
+    devp->descriptor.sectors_count = config->sectors_count;
+    devp->descriptor.sectors       = config->sectors;
+    devp->descriptor.sectors_size  = config->sectors_size;
+    devp->descriptor.address       = 0U;
+
+    /* Device size.*/
+    if (config->sectors == NULL) {
+      devp->size = (size_t)config->sectors_count *
+                   (size_t)config->sectors_size;
+    }
+    else {
+      const flash_sector_descriptor_t *sdp;
+
+      sdp = &config->sectors[config->sectors_count - 1U];
+      devp->size = (size_t)sdp->offset + (size_t)sdp->size;
+    }
+
+#if SIM_FLASH_USE_FILES == TRUE
+    if (config->memory == NULL) {
+      osalDbgCheck(config->filename != NULL);
+
+      sim_flash_map_file(devp);
+    }
+    else {
+      devp->memory = config->memory;
+    }
+#else
+    osalDbgCheck(config->memory != NULL);
+
+    devp->memory = config->memory;
+#endif
+
+    /* Power is restored.*/
+    devp->cut_countdown = 0U;
+    devp->powered_off   = false;
+
+    devp->state = FLASH_READY;
+  }
+}
+
+/**
+ * @brief   Deactivates a simulated flash device.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ *
+ * @api
+ */
+void simflashStop(SimFlashDriver *devp) {
+
+  osalDbgCheck(devp != NULL);
+  osalDbgAssert(devp->state != FLASH_UNINIT, "invalid state");
+
+  if (devp->state != FLASH_STOP) {
+#if SIM_FLASH_USE_FILES == TRUE
+    if (devp->config->memory == NULL) {
+      (void)munmap((void *)devp->memory, devp->size);
+    }
+#endif
+
+    /* Deleting current configuration.*/
+    devp->config = NULL;
+    devp->memory = NULL;
+
+    /* Driver stopped.*/
+    devp->state = FLASH_STOP;
+  }
+}
+
+/**
+ * @brief   Resets the device statistics.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ *
+ * @api
+ */
+void simflashResetStats(SimFlashDriver *devp) {
+
+  osalDbgCheck(devp != NULL);
+
+  memset(&devp->stats, 0, sizeof (sim_flash_stats_t));
+}
+
+/**
+ * @brief   Schedules a power cut.
+ * @details The power is cut while programming or erasing the n-th byte
+ *          from now, the operation is left incomplete and any further
+ *          operation fails with @p FLASH_ERROR_HW_FAILURE until the device
+ *          is stopped and restarted.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ * @param[in] n         number of bytes before the power cut, zero cancels
+ *                      a scheduled power cut
+ *
+ * @api
+ */
+void simflashSchedulePowerCut(SimFlashDriver *devp, uint32_t n) {
+
+  osalDbgCheck(devp != NULL);
+
+  devp->cut_countdown = n;
+}
+
+/** @} */
@@ -0,0 +1,265 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    sim_flash.h
+ * @brief   Simulated flash device header.
+ *
+ * @addtogroup SIM_FLASH
+ * @{
+ */
+
+#ifndef SIM_FLASH_H
+#define SIM_FLASH_H
+
+#include "hal_flash.h"
+
+/*===========================================================================*/
+/* Driver constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Value of erased flash bytes.
+ */
+#define SIM_FLASH_ERASED_VALUE              0xFFU
+
+/*===========================================================================*/
+/* Driver pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @name    Configuration options
+ * @{
+ */
+/**
+ * @brief   Enables support for file-backed devices.
+ * @note    Requires a host implementing @p mmap().
+ */
+#if !defined(SIM_FLASH_USE_FILES) || defined(__DOXYGEN__)
+#if defined(_WIN32)
+#define SIM_FLASH_USE_FILES                 FALSE
+#else
+#define SIM_FLASH_USE_FILES                 TRUE
+#endif
+#endif
+/** @} */
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (SIM_FLASH_USE_FILES == TRUE) && defined(_WIN32)
+#error "SIM_FLASH_USE_FILES not supported on this host"
+#endif
+
+/*===========================================================================*/
+/* Driver data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a simulated flash device configuration.
+ */
+typedef struct {
+  /**
+   * @brief   Memory array backing the device.
+   * @note    The array size must match the total size of the sectors.
+   * @note    If @p NULL then the device is backed by the file specified
+   *          by @p filename.
+   */
+  uint8_t                       *memory;
+#if (SIM_FLASH_USE_FILES == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Name of the file backing the device.
+   * @note    The file is created erased if it does not exist, its content
+   *          is preserved across runs.
+   */
+  const char                    *filename;
+#endif
+  /**
+   * @brief   Device attributes.
+   * @note    If @p FLASH_ATTR_REWRITABLE is specified then already
+   *          programmed locations can be programmed again clearing more
+   *          bits, else programming a location not in the erased state
+   *          fails.
+   */
+  uint32_t                      attributes;
+  /**
+   * @brief   Size of write page.
+   */
+  uint32_t                      page_size;
+  /**
+   * @brief   Number of sectors in the device.
+   */
+  flash_sector_t                sectors_count;
+  /**
+   * @brief   List of sectors for devices with non-uniform sector sizes.
+   * @note    If @p NULL then the device has uniform sectors size equal
+   *          to @p sectors_size.
+   */
+  const flash_sector_descriptor_t *sectors;
+  /**
+   * @brief   Size of sectors for devices with uniform sector size.
+   */
+  uint32_t                      sectors_size;
+  /**
+   * @brief   Modeled time for programming a page in microseconds.
+   */
+  uint32_t                      program_time;
+  /**
+   * @brief   Modeled time for erasing a sector in milliseconds.
+   * @note    Erase operations are really carried on in background and
+   *          @p flashQueryErase() reports a busy device until the time
+   *          elapsed.
+   */
+  uint32_t                      erase_time;
+  /**
+   * @brief   Per-sector erase counters or @p NULL.
+   * @note    The array must have @p sectors_count elements.
+   */
+  uint32_t                      *erase_counters;
+} SimFlashConfig;
+
+/**
+ * @brief   Type of simulated flash device statistics.
+ */
+typedef struct {
+  /**
+   * @brief   Number of read operations.
+   */
+  uint32_t                      reads;
+  /**
+   * @brief   Number of read bytes.
+   */
+  uint32_t                      read_bytes;
+  /**
+   * @brief   Number of program operations.
+   */
+  uint32_t                      programs;
+  /**
+   * @brief   Number of programmed bytes.
+   */
+  uint32_t                      program_bytes;
+  /**
+   * @brief   Number of erased sectors.
+   */
+  uint32_t                      erases;
+  /**
+   * @brief   Modeled busy time in microseconds.
+   */
+  uint64_t                      busy_time;
+} sim_flash_stats_t;
+
+/**
+ * @brief   @p SimFlashDriver specific methods.
+ */
+#define _sim_flash_methods                                                  \
+  _base_flash_methods
+
+/**
+ * @extends BaseFlashVMT
+ *
+ * @brief   @p SimFlashDriver virtual methods table.
+ */
+struct SimFlashDriverVMT {
+  _sim_flash_methods
+};
+
+/**
+ * @extends BaseFlash
+ *
+ * @brief   Type of a simulated flash device.
+ */
+typedef struct {
+  /**
+   * @brief   SimFlashDriver Virtual Methods Table.
+   */
+  const struct SimFlashDriverVMT *vmt;
+  _base_flash_data
+  /**
+   * @brief   Current configuration data.
+   */
+  const SimFlashConfig          *config;
+  /**
+   * @brief   Device descriptor.
+   */
+  flash_descriptor_t            descriptor;
+  /**
+   * @brief   Memory array backing the device.
+   */
+  uint8_t                       *memory;
+  /**
+   * @brief   Total size of the device.
+   */
+  size_t                        size;
+  /**
+   * @brief   Start time of the erase operation in progress.
+   */
+  systime_t                     erase_start;
+  /**
+   * @brief   Duration of the erase operation in progress.
+   */
+  sysinterval_t                 erase_interval;
+  /**
+   * @brief   Bytes to be programmed or erased before a power cut.
+   * @note    Zero means that power cuts are disabled.
+   */
+  uint32_t                      cut_countdown;
+  /**
+   * @brief   Power is off after an injected power cut.
+   */
+  bool                          powered_off;
+  /**
+   * @brief   Device statistics.
+   */
+  sim_flash_stats_t             stats;
+} SimFlashDriver;
+
+/*===========================================================================*/
+/* Driver macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Returns a pointer to the device statistics.
+ *
+ * @param[in] devp      pointer to the @p SimFlashDriver object
+ * @return              Pointer to the statistics structure.
+ *
+ * @api
+ */
+#define simflashGetStats(devp) (&(devp)->stats)
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void simflashObjectInit(SimFlashDriver *devp);
+  void simflashStart(SimFlashDriver *devp, const SimFlashConfig *config);
+  void simflashStop(SimFlashDriver *devp);
+  void simflashResetStats(SimFlashDriver *devp);
+  void simflashSchedulePowerCut(SimFlashDriver *devp, uint32_t n);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIM_FLASH_H */
+
+/** @} */
@@ -24,6 +24,10 @@
 
 #include "hal.h"
 
+#if SIM_USE_VIRTUAL_TIME
+#error "SIM_USE_VIRTUAL_TIME not supported by the Win32 simulator"
+#endif
+
 /*===========================================================================*/
 /* Driver exported variables.                                                */
 /*===========================================================================*/
@@ -75,7 +79,9 @@ void hal_lld_init(void) {
  * @brief   Interrupt simulation.
  */
 void _sim_check_for_interrupts(void) {
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
   LARGE_INTEGER n;
+#endif
 
 #if HAL_USE_SERIAL
   if (sd_lld_interrupt_pending()) {
@@ -87,6 +93,17 @@ void _sim_check_for_interrupts(void) {
   }
 #endif
 
+#if HAL_USE_CRY && !HAL_CRY_ENFORCE_FALLBACK
+  if (cry_lld_interrupt_pending()) {
+    _dbg_check_lock();
+    if (chSchIsPreemptionRequired())
+      chSchDoReschedule();
+    _dbg_check_unlock();
+    return;
+  }
+#endif
+
+#if OSAL_ST_MODE == OSAL_ST_MODE_PERIODIC
   /* Interrupt Timer simulation (10ms interval).*/
   QueryPerformanceCounter(&n);
   if (n.QuadPart > nextcnt.QuadPart) {
@@ -105,6 +122,14 @@ void _sim_check_for_interrupts(void) {
       chSchDoReschedule();
     _dbg_check_unlock();
   }
+#else /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
+  if (st_lld_interrupt_pending()) {
+    _dbg_check_lock();
+    if (chSchIsPreemptionRequired())
+      chSchDoReschedule();
+    _dbg_check_unlock();
+  }
+#endif /* OSAL_ST_MODE == OSAL_ST_MODE_FREERUNNING */
 }
 
 /** @} */
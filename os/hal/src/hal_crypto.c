@@ -42,6 +42,70 @@
 /* Driver local functions.                                                   */
 /*===========================================================================*/
 
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Removes the completed job from the head of the queue.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] err       result of the completed job
+ * @return              The completed job.
+ *
+ * @notapi
+ */
+static cryjob_t *cry_job_dequeue(CRYDriver *cryp, cryerror_t err) {
+  cryjob_t *jobp = cryp->jqhead;
+
+  osalDbgAssert(jobp != NULL, "no active job");
+
+  cryp->jqhead = jobp->next;
+  if (cryp->jqhead == NULL) {
+    cryp->jqtail = NULL;
+  }
+  jobp->result = err;
+
+  return jobp;
+}
+
+#if (CRY_LLD_SUPPORTS_ASYNC == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Executes the queued jobs synchronously.
+ * @details Jobs submitted by other threads while the queue is being
+ *          executed are served by this loop too.
+ * @note    The next job is taken in the same critical zone that removes
+ *          the completed one, once the queue has been found empty the
+ *          jobs submitted later are executed by their own submitters.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      the job at the head of the queue
+ *
+ * @notapi
+ */
+static void cry_job_run(CRYDriver *cryp, cryjob_t *jobp) {
+
+  while (jobp != NULL) {
+    cryerror_t err = _cry_job_execute(cryp, jobp);
+    cryjob_t *nextp;
+
+    osalSysLock();
+    (void) cry_job_dequeue(cryp, err);
+    nextp = cryp->jqhead;
+    osalSysUnlock();
+
+    if (jobp->callback != NULL) {
+      jobp->callback(cryp, jobp);
+    }
+
+    osalSysLock();
+    jobp->state = CRY_JOB_DONE;
+    osalThreadResumeS(&jobp->thread, MSG_OK);
+    osalSysUnlock();
+
+    jobp = nextp;
+  }
+}
+#endif
+#endif /* HAL_CRY_USE_ASYNC == TRUE */
+
 /*===========================================================================*/
 /* Driver exported functions.                                                */
 /*===========================================================================*/
@@ -71,6 +135,12 @@ void cryObjectInit(CRYDriver *cryp) {
 
   cryp->state    = CRY_STOP;
   cryp->config   = NULL;
+  cryp->key0_type = cry_algo_none;
+  cryp->key0_size = (size_t)0;
+#if HAL_CRY_USE_ASYNC == TRUE
+  cryp->jqhead    = NULL;
+  cryp->jqtail    = NULL;
+#endif
 #if defined(CRY_DRIVER_EXT_INIT_HOOK)
   CRY_DRIVER_EXT_INIT_HOOK(cryp);
 #endif
@@ -115,6 +185,9 @@ void cryStop(CRYDriver *cryp) {
 
   osalDbgAssert((cryp->state == CRY_STOP) || (cryp->state == CRY_READY),
                 "invalid state");
+#if HAL_CRY_USE_ASYNC == TRUE
+  osalDbgAssert(cryp->jqhead == NULL, "jobs pending");
+#endif
 
 #if HAL_CRY_ENFORCE_FALLBACK == FALSE
   cry_lld_stop(cryp);
@@ -164,6 +237,11 @@ cryerror_t cryLoadTransientKey(CRYDriver *cryp,
   if (err == CRY_ERR_INV_ALGO) {
     err = cry_fallback_loadkey(cryp, algorithm, size, keyp);
   }
+  else if (err == CRY_NOERROR) {
+    /* The key is also made available to the fall-back because the LLD
+       could not support all modes of the algorithm.*/
+    (void) cry_fallback_loadkey(cryp, algorithm, size, keyp);
+  }
 #endif
 
   if (err == CRY_NOERROR) {
@@ -280,7 +358,8 @@ cryerror_t cryDecryptAES(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -293,11 +372,14 @@ cryerror_t cryEncryptAES_ECB(CRYDriver *cryp,
                              const uint8_t *in,
                              uint8_t *out) {
 
-  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               ((size & (size_t)15) == (size_t)0));
+  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_ECB == TRUE
   return cry_lld_encrypt_AES_ECB(cryp, key_id, size, in, out);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -330,7 +412,8 @@ cryerror_t cryEncryptAES_ECB(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -343,11 +426,14 @@ cryerror_t cryDecryptAES_ECB(CRYDriver *cryp,
                              const uint8_t *in,
                              uint8_t *out) {
 
-  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               ((size & (size_t)15) == (size_t)0));
+  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_ECB == TRUE
   return cry_lld_decrypt_AES_ECB(cryp, key_id, size, in, out);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -381,7 +467,8 @@ cryerror_t cryDecryptAES_ECB(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -396,10 +483,14 @@ cryerror_t cryEncryptAES_CBC(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)15) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_CBC == TRUE
   return cry_lld_encrypt_AES_CBC(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -434,7 +525,8 @@ cryerror_t cryEncryptAES_CBC(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -449,10 +541,14 @@ cryerror_t cryDecryptAES_CBC(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)15) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_CBC == TRUE
   return cry_lld_decrypt_AES_CBC(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -487,7 +583,8 @@ cryerror_t cryDecryptAES_CBC(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -502,10 +599,14 @@ cryerror_t cryEncryptAES_CFB(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)15) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_CFB == TRUE
   return cry_lld_encrypt_AES_CFB(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -540,7 +641,8 @@ cryerror_t cryEncryptAES_CFB(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -555,10 +657,14 @@ cryerror_t cryDecryptAES_CFB(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)15) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_CFB == TRUE
   return cry_lld_decrypt_AES_CFB(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -594,7 +700,8 @@ cryerror_t cryDecryptAES_CFB(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -609,10 +716,14 @@ cryerror_t cryEncryptAES_CTR(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)15) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_CTR == TRUE
   return cry_lld_encrypt_AES_CTR(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -623,8 +734,7 @@ cryerror_t cryEncryptAES_CTR(CRYDriver *cryp,
   (void)size;
   (void)in;
   (void)out;
-  (void)nonce;
-  (void)cnt;
+  (void)iv;
 
   return CRY_ERR_INV_ALGO;
 #endif
@@ -649,7 +759,8 @@ cryerror_t cryEncryptAES_CTR(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 16.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -664,10 +775,14 @@ cryerror_t cryDecryptAES_CTR(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)15) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)15) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_AES_CTR == TRUE
   return cry_lld_decrypt_AES_CTR(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -678,8 +793,7 @@ cryerror_t cryDecryptAES_CTR(CRYDriver *cryp,
   (void)size;
   (void)in;
   (void)out;
-  (void)nonce;
-  (void)cnt;
+  (void)iv;
 
   return CRY_ERR_INV_ALGO;
 #endif
@@ -821,6 +935,215 @@ cryerror_t cryDecryptAES_GCM(CRYDriver *cryp,
 #endif
 }
 
+/**
+ * @brief   Incremental AES-GCM initialization.
+ * @details The operation is performed in steps: any number of calls to
+ *          @p cryAES_GCMUpdateAAD(), then any number of calls to either
+ *          @p cryEncryptAES_GCMUpdate() or @p cryDecryptAES_GCMUpdate()
+ *          and finally a call to @p cryAES_GCMFinal().
+ * @note    The sizes passed to the update functions must be multiples of
+ *          16 except for the last call of each phase.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] gcmctxp  pointer to an AES-GCM context to be initialized
+ * @param[in] key_id    the key to be used for the operation, zero is the
+ *                      transient key, other values are keys stored in an
+ *                      unspecified way
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
+ *                              or refers to an empty key slot.
+ *
+ * @api
+ */
+cryerror_t cryAES_GCMInit(CRYDriver *cryp,
+                          AESGCMContext *gcmctxp,
+                          crykey_t key_id,
+                          const uint8_t *iv) {
+
+  osalDbgCheck((cryp != NULL) && (gcmctxp != NULL) && (iv != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_AES_GCM == TRUE
+  return cry_lld_AES_GCM_init(cryp, gcmctxp, key_id, iv);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_AES_GCM_init(cryp, &gcmctxp->fallback, key_id, iv);
+#else
+  (void)cryp;
+  (void)gcmctxp;
+  (void)key_id;
+  (void)iv;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Incremental AES-GCM authentication data input.
+ * @note    All the authentication data must be fed before the text.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] gcmctxp   pointer to an AES-GCM context
+ * @param[in] size      size of the authentication data
+ * @param[in] aad       buffer containing the authentication data
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cryAES_GCMUpdateAAD(CRYDriver *cryp,
+                               AESGCMContext *gcmctxp,
+                               size_t size,
+                               const uint8_t *aad) {
+
+  osalDbgCheck((cryp != NULL) && (gcmctxp != NULL) &&
+               ((aad != NULL) || (size == (size_t)0)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_AES_GCM == TRUE
+  return cry_lld_AES_GCM_update_aad(cryp, gcmctxp, size, aad);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_AES_GCM_update_aad(cryp, &gcmctxp->fallback,
+                                         size, aad);
+#else
+  (void)cryp;
+  (void)gcmctxp;
+  (void)size;
+  (void)aad;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Incremental AES-GCM encryption.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] gcmctxp   pointer to an AES-GCM context
+ * @param[in] size      size of both buffers
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cryEncryptAES_GCMUpdate(CRYDriver *cryp,
+                                   AESGCMContext *gcmctxp,
+                                   size_t size,
+                                   const uint8_t *in,
+                                   uint8_t *out) {
+
+  osalDbgCheck((cryp != NULL) && (gcmctxp != NULL) &&
+               (((in != NULL) && (out != NULL)) || (size == (size_t)0)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_AES_GCM == TRUE
+  return cry_lld_encrypt_AES_GCM_update(cryp, gcmctxp, size, in, out);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_encrypt_AES_GCM_update(cryp, &gcmctxp->fallback,
+                                             size, in, out);
+#else
+  (void)cryp;
+  (void)gcmctxp;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Incremental AES-GCM decryption.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] gcmctxp   pointer to an AES-GCM context
+ * @param[in] size      size of both buffers
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cryDecryptAES_GCMUpdate(CRYDriver *cryp,
+                                   AESGCMContext *gcmctxp,
+                                   size_t size,
+                                   const uint8_t *in,
+                                   uint8_t *out) {
+
+  osalDbgCheck((cryp != NULL) && (gcmctxp != NULL) &&
+               (((in != NULL) && (out != NULL)) || (size == (size_t)0)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_AES_GCM == TRUE
+  return cry_lld_decrypt_AES_GCM_update(cryp, gcmctxp, size, in, out);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_decrypt_AES_GCM_update(cryp, &gcmctxp->fallback,
+                                             size, in, out);
+#else
+  (void)cryp;
+  (void)gcmctxp;
+  (void)size;
+  (void)in;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Incremental AES-GCM finalization.
+ * @note    On decryption it is responsibility of the caller to compare
+ *          the generated tag with the received one.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] gcmctxp   pointer to an AES-GCM context
+ * @param[out] authtag  128 bits buffer for the generated authentication tag
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t cryAES_GCMFinal(CRYDriver *cryp,
+                           AESGCMContext *gcmctxp,
+                           uint8_t *authtag) {
+
+  osalDbgCheck((cryp != NULL) && (gcmctxp != NULL) && (authtag != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_AES_GCM == TRUE
+  return cry_lld_AES_GCM_final(cryp, gcmctxp, authtag);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_AES_GCM_final(cryp, &gcmctxp->fallback, authtag);
+#else
+  (void)cryp;
+  (void)gcmctxp;
+  (void)authtag;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
 /**
  * @brief   Encryption of a single block using (T)DES.
  * @note    The implementation of this function must guarantee that it can
@@ -927,7 +1250,8 @@ cryerror_t cryDecryptDES(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 8.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -940,11 +1264,14 @@ cryerror_t cryEncryptDES_ECB(CRYDriver *cryp,
                               const uint8_t *in,
                               uint8_t *out) {
 
-  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               ((size & (size_t)7) == (size_t)0));
+  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)7) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_DES_ECB == TRUE
   return cry_lld_encrypt_DES_ECB(cryp, key_id, size, in, out);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -977,7 +1304,8 @@ cryerror_t cryEncryptDES_ECB(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 8.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -990,11 +1318,14 @@ cryerror_t cryDecryptDES_ECB(CRYDriver *cryp,
                              const uint8_t *in,
                              uint8_t *out) {
 
-  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               ((size & (size_t)7) == (size_t)0));
+  osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)7) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_DES_ECB == TRUE
   return cry_lld_decrypt_DES_ECB(cryp, key_id, size, in, out);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -1028,7 +1359,8 @@ cryerror_t cryDecryptDES_ECB(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 8.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -1043,10 +1375,14 @@ cryerror_t cryEncryptDES_CBC(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)7) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)7) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_DES_CBC == TRUE
   return cry_lld_encrypt_DES_CBC(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -1081,7 +1417,8 @@ cryerror_t cryEncryptDES_CBC(CRYDriver *cryp,
  * @return              The operation status.
  * @retval CRY_NOERROR          if the operation succeeded.
  * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
- *                              device instance.
+ *                              device instance or if @p size is not a
+ *                              multiple of 8.
  * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
  * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid
  *                              or refers to an empty key slot.
@@ -1096,10 +1433,14 @@ cryerror_t cryDecryptDES_CBC(CRYDriver *cryp,
                              const uint8_t *iv) {
 
   osalDbgCheck((cryp != NULL) && (in != NULL) && (out != NULL) &&
-               (iv != NULL) && ((size & (size_t)7) == (size_t)0));
+               (iv != NULL));
 
   osalDbgAssert(cryp->state == CRY_READY, "not ready");
 
+  if ((size & (size_t)7) != (size_t)0) {
+    return CRY_ERR_INV_ALGO;
+  }
+
 #if CRY_LLD_SUPPORTS_DES_CBC == TRUE
   return cry_lld_decrypt_DES_CBC(cryp, key_id, size, in, out, iv);
 #elif HAL_CRY_USE_FALLBACK == TRUE
@@ -1152,6 +1493,108 @@ cryerror_t crySHA1(CRYDriver *cryp, size_t size,
 #endif
 }
 
+/**
+ * @brief   Hash initialization using SHA1.
+ * @note    Use of this algorithm is not recommended because proven weak.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha1ctxp pointer to a SHA1 context to be initialized
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA1Init(CRYDriver *cryp, SHA1Context *sha1ctxp) {
+
+  osalDbgCheck((cryp != NULL) && (sha1ctxp != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA1 == TRUE
+  return cry_lld_SHA1_init(cryp, sha1ctxp);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA1_init(cryp, &sha1ctxp->fallback);
+#else
+  (void)cryp;
+  (void)sha1ctxp;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Hash update using SHA1.
+ * @note    The data can be fed in chunks of any size.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp  pointer to a SHA1 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA1Update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                         size_t size, const uint8_t *in) {
+
+  osalDbgCheck((cryp != NULL) && (sha1ctxp != NULL) &&
+               ((in != NULL) || (size == (size_t)0)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA1 == TRUE
+  return cry_lld_SHA1_update(cryp, sha1ctxp, size, in);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA1_update(cryp, &sha1ctxp->fallback, size, in);
+#else
+  (void)cryp;
+  (void)sha1ctxp;
+  (void)size;
+  (void)in;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Hash finalization using SHA1.
+ * @note    The context must be initialized again before being reused.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha1ctxp  pointer to a SHA1 context
+ * @param[out] out      160 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA1Final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                        uint8_t *out) {
+
+  osalDbgCheck((cryp != NULL) && (sha1ctxp != NULL) && (out != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA1 == TRUE
+  return cry_lld_SHA1_final(cryp, sha1ctxp, out);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA1_final(cryp, &sha1ctxp->fallback, out);
+#else
+  (void)cryp;
+  (void)sha1ctxp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
 /**
  * @brief   Hash using SHA256.
  *
@@ -1187,6 +1630,107 @@ cryerror_t crySHA256(CRYDriver *cryp, size_t size,
 #endif
 }
 
+/**
+ * @brief   Hash initialization using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha256ctxp pointer to a SHA256 context to be initialized
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA256Init(CRYDriver *cryp, SHA256Context *sha256ctxp) {
+
+  osalDbgCheck((cryp != NULL) && (sha256ctxp != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA256 == TRUE
+  return cry_lld_SHA256_init(cryp, sha256ctxp);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA256_init(cryp, &sha256ctxp->fallback);
+#else
+  (void)cryp;
+  (void)sha256ctxp;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Hash update using SHA256.
+ * @note    The data can be fed in chunks of any size.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp pointer to a SHA256 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA256Update(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                           size_t size, const uint8_t *in) {
+
+  osalDbgCheck((cryp != NULL) && (sha256ctxp != NULL) &&
+               ((in != NULL) || (size == (size_t)0)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA256 == TRUE
+  return cry_lld_SHA256_update(cryp, sha256ctxp, size, in);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA256_update(cryp, &sha256ctxp->fallback, size, in);
+#else
+  (void)cryp;
+  (void)sha256ctxp;
+  (void)size;
+  (void)in;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Hash finalization using SHA256.
+ * @note    The context must be initialized again before being reused.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha256ctxp pointer to a SHA256 context
+ * @param[out] out      256 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA256Final(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                          uint8_t *out) {
+
+  osalDbgCheck((cryp != NULL) && (sha256ctxp != NULL) && (out != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA256 == TRUE
+  return cry_lld_SHA256_final(cryp, sha256ctxp, out);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA256_final(cryp, &sha256ctxp->fallback, out);
+#else
+  (void)cryp;
+  (void)sha256ctxp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
 /**
  * @brief   Hash using SHA512.
  *
@@ -1222,6 +1766,107 @@ cryerror_t crySHA512(CRYDriver *cryp, size_t size,
 #endif
 }
 
+/**
+ * @brief   Hash initialization using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] sha512ctxp pointer to a SHA512 context to be initialized
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA512Init(CRYDriver *cryp, SHA512Context *sha512ctxp) {
+
+  osalDbgCheck((cryp != NULL) && (sha512ctxp != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA512 == TRUE
+  return cry_lld_SHA512_init(cryp, sha512ctxp);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA512_init(cryp, &sha512ctxp->fallback);
+#else
+  (void)cryp;
+  (void)sha512ctxp;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Hash update using SHA512.
+ * @note    The data can be fed in chunks of any size.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp pointer to a SHA512 context
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA512Update(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                           size_t size, const uint8_t *in) {
+
+  osalDbgCheck((cryp != NULL) && (sha512ctxp != NULL) &&
+               ((in != NULL) || (size == (size_t)0)));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA512 == TRUE
+  return cry_lld_SHA512_update(cryp, sha512ctxp, size, in);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA512_update(cryp, &sha512ctxp->fallback, size, in);
+#else
+  (void)cryp;
+  (void)sha512ctxp;
+  (void)size;
+  (void)in;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
+/**
+ * @brief   Hash finalization using SHA512.
+ * @note    The context must be initialized again before being reused.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] sha512ctxp pointer to a SHA512 context
+ * @param[out] out      512 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the operation is unsupported on this
+ *                              device instance.
+ *
+ * @api
+ */
+cryerror_t crySHA512Final(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                          uint8_t *out) {
+
+  osalDbgCheck((cryp != NULL) && (sha512ctxp != NULL) && (out != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+
+#if CRY_LLD_SUPPORTS_SHA512 == TRUE
+  return cry_lld_SHA512_final(cryp, sha512ctxp, out);
+#elif HAL_CRY_USE_FALLBACK == TRUE
+  return cry_fallback_SHA512_final(cryp, &sha512ctxp->fallback, out);
+#else
+  (void)cryp;
+  (void)sha512ctxp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+#endif
+}
+
 /**
  * @brief   True random numbers generator.
  *
@@ -1252,6 +1897,242 @@ cryerror_t cryTRNG(CRYDriver *cryp, uint8_t *out) {
 #endif
 }
 
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Initializes a @p cryjob_t object.
+ *
+ * @param[out] jobp     pointer to the @p cryjob_t object
+ * @param[in] callback  completion callback or @p NULL
+ * @param[in] arg       callback argument
+ *
+ * @init
+ */
+void cryJobObjectInit(cryjob_t *jobp, cryjobcb_t callback, void *arg) {
+
+  jobp->next     = NULL;
+  jobp->state    = CRY_JOB_IDLE;
+  jobp->callback = callback;
+  jobp->arg      = arg;
+  jobp->result   = CRY_NOERROR;
+  jobp->thread   = NULL;
+}
+
+/**
+ * @brief   Queues an operation for asynchronous execution.
+ * @details The job is appended to the driver queue, jobs are executed in
+ *          submission order. If the LLD supports asynchronous operations
+ *          then the function returns immediately and the next job is
+ *          started from the completion interrupt of the previous one, the
+ *          callback is invoked from ISR context. If the LLD does not
+ *          support asynchronous operations then the first thread that
+ *          finds the queue empty executes it, callbacks are invoked from
+ *          that thread.
+ * @note    The buffers and the transient key must stay valid and unchanged
+ *          until the job completes.
+ * @note    A job must not be resubmitted before its completion, the
+ *          callback must not submit jobs.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the @p cryjob_t object
+ * @param[in] op        the operation to be performed
+ * @param[in] key_id    the key to be used for the operation, ignored by
+ *                      hash operations
+ * @param[in] size      size of the input buffer
+ * @param[in] in        input buffer
+ * @param[out] out      output buffer, for hash operations it receives the
+ *                      digest
+ * @param[in] iv        input vector or @p NULL if not required by the
+ *                      operation
+ *
+ * @api
+ */
+void crySubmitJob(CRYDriver *cryp,
+                  cryjob_t *jobp,
+                  cryop_t op,
+                  crykey_t key_id,
+                  size_t size,
+                  const uint8_t *in,
+                  uint8_t *out,
+                  const uint8_t *iv) {
+  bool idle;
+
+  osalDbgCheck((cryp != NULL) && (jobp != NULL) &&
+               ((in != NULL) || (size == (size_t)0)) && (out != NULL));
+
+  osalDbgAssert(cryp->state == CRY_READY, "not ready");
+  osalDbgAssert(jobp->state != CRY_JOB_QUEUED, "already queued");
+
+  jobp->next   = NULL;
+  jobp->op     = op;
+  jobp->key_id = key_id;
+  jobp->size   = size;
+  jobp->in     = in;
+  jobp->out    = out;
+  jobp->iv     = iv;
+  jobp->result = CRY_NOERROR;
+
+  osalSysLock();
+  jobp->state = CRY_JOB_QUEUED;
+  idle = (bool)(cryp->jqhead == NULL);
+  if (idle) {
+    cryp->jqhead = jobp;
+  }
+  else {
+    cryp->jqtail->next = jobp;
+  }
+  cryp->jqtail = jobp;
+#if CRY_LLD_SUPPORTS_ASYNC == TRUE
+  if (idle) {
+    cry_lld_start_job(cryp, jobp);
+  }
+  osalSysUnlock();
+#else
+  osalSysUnlock();
+
+  if (idle) {
+    cry_job_run(cryp, jobp);
+  }
+#endif
+}
+
+/**
+ * @brief   Waits for a job completion.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the @p cryjob_t object
+ * @return              The operation status of the job.
+ *
+ * @api
+ */
+cryerror_t cryWaitJob(CRYDriver *cryp, cryjob_t *jobp) {
+
+  osalDbgCheck((cryp != NULL) && (jobp != NULL));
+
+  osalSysLock();
+  if (jobp->state == CRY_JOB_QUEUED) {
+    (void) osalThreadSuspendS(&jobp->thread);
+  }
+  osalSysUnlock();
+
+  return jobp->result;
+}
+
+/**
+ * @brief   Executes a job using the synchronous API.
+ * @note    This function is meant to be used by LLDs that execute jobs
+ *          by software.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] jobp      pointer to the @p cryjob_t object
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+cryerror_t _cry_job_execute(CRYDriver *cryp, cryjob_t *jobp) {
+  cryerror_t err;
+
+  switch (jobp->op) {
+  case cry_op_encrypt_aes_ecb:
+    err = cryEncryptAES_ECB(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out);
+    break;
+  case cry_op_decrypt_aes_ecb:
+    err = cryDecryptAES_ECB(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out);
+    break;
+  case cry_op_encrypt_aes_cbc:
+    err = cryEncryptAES_CBC(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_decrypt_aes_cbc:
+    err = cryDecryptAES_CBC(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_encrypt_aes_cfb:
+    err = cryEncryptAES_CFB(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_decrypt_aes_cfb:
+    err = cryDecryptAES_CFB(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_encrypt_aes_ctr:
+    err = cryEncryptAES_CTR(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_decrypt_aes_ctr:
+    err = cryDecryptAES_CTR(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_encrypt_des_ecb:
+    err = cryEncryptDES_ECB(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out);
+    break;
+  case cry_op_decrypt_des_ecb:
+    err = cryDecryptDES_ECB(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out);
+    break;
+  case cry_op_encrypt_des_cbc:
+    err = cryEncryptDES_CBC(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_decrypt_des_cbc:
+    err = cryDecryptDES_CBC(cryp, jobp->key_id, jobp->size,
+                            jobp->in, jobp->out, jobp->iv);
+    break;
+  case cry_op_sha1:
+    err = crySHA1(cryp, jobp->size, jobp->in, jobp->out);
+    break;
+  case cry_op_sha256:
+    err = crySHA256(cryp, jobp->size, jobp->in, jobp->out);
+    break;
+  case cry_op_sha512:
+    err = crySHA512(cryp, jobp->size, jobp->in, jobp->out);
+    break;
+  default:
+    err = CRY_ERR_INV_ALGO;
+    break;
+  }
+
+  return err;
+}
+
+#if (CRY_LLD_SUPPORTS_ASYNC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Job completion handler.
+ * @details The completed job is removed from the queue and the next one,
+ *          if any, is started before invoking the callback so that the
+ *          hardware is kept busy.
+ * @note    This function is meant to be invoked by the LLD completion
+ *          interrupt handler.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] err       result of the completed job
+ *
+ * @notapi
+ */
+void _cry_isr_job_complete(CRYDriver *cryp, cryerror_t err) {
+  cryjob_t *jobp;
+
+  osalSysLockFromISR();
+  jobp = cry_job_dequeue(cryp, err);
+  if (cryp->jqhead != NULL) {
+    cry_lld_start_job(cryp, cryp->jqhead);
+  }
+  osalSysUnlockFromISR();
+
+  if (jobp->callback != NULL) {
+    jobp->callback(cryp, jobp);
+  }
+
+  osalSysLockFromISR();
+  jobp->state = CRY_JOB_DONE;
+  osalThreadResumeI(&jobp->thread, MSG_OK);
+  osalSysUnlockFromISR();
+}
+#endif /* CRY_LLD_SUPPORTS_ASYNC == TRUE */
+#endif /* HAL_CRY_USE_ASYNC == TRUE */
+
 #endif /* HAL_USE_CRY == TRUE */
 
 /** @} */
@@ -0,0 +1,2661 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    hal_crypto_fallback.c
+ * @brief   Cryptographic Driver software fall-back code.
+ * @details Portable implementations of the algorithms exported by the
+ *          cryptographic driver, used for the operations not supported
+ *          by the underlying hardware. All algorithms are table-driven,
+ *          tables are constant and can be placed in flash.
+ * @note    The implementations are not hardened against timing or power
+ *          side channel attacks.
+ *
+ * @addtogroup CRYPTO
+ * @{
+ */
+
+#include <string.h>
+
+#include "hal.h"
+
+#if ((HAL_USE_CRY == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE)) ||            \
+    defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Driver local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Size of an AES block.
+ */
+#define AES_BLOCK_SIZE              16U
+
+/**
+ * @brief   Size of a DES block.
+ */
+#define DES_BLOCK_SIZE              8U
+
+/**
+ * @brief   Number of DES rounds.
+ */
+#define DES_ROUNDS                  16U
+
+/**
+ * @name    Bytes and words manipulation macros
+ * @{
+ */
+#define ROR32(x, n)                 (((x) >> (n)) | ((x) << (32U - (n))))
+#define ROR64(x, n)                 (((x) >> (n)) | ((x) << (64U - (n))))
+
+#define GET_U32_BE(p)                                                       \
+  (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) |                    \
+   ((uint32_t)(p)[2] << 8)  | ((uint32_t)(p)[3]))
+
+#define PUT_U32_BE(p, v) do {                                               \
+  (p)[0] = (uint8_t)((v) >> 24);                                            \
+  (p)[1] = (uint8_t)((v) >> 16);                                            \
+  (p)[2] = (uint8_t)((v) >> 8);                                             \
+  (p)[3] = (uint8_t)(v);                                                    \
+} while (false)
+
+#define GET_U64_BE(p)                                                       \
+  (((uint64_t)GET_U32_BE(p) << 32) | (uint64_t)GET_U32_BE((p) + 4))
+
+#define PUT_U64_BE(p, v) do {                                               \
+  PUT_U32_BE((p), (uint32_t)((v) >> 32));                                   \
+  PUT_U32_BE((p) + 4, (uint32_t)(v));                                       \
+} while (false)
+/** @} */
+
+/*===========================================================================*/
+/* Driver exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Driver local variables and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Expanded DES/TDES key.
+ * @note    Each sub-key is stored as eight 6 bits chunks, one for each
+ *          S-box.
+ */
+typedef struct {
+  /**
+   * @brief   Number of DES stages, 1 for DES, 3 for TDES.
+   */
+  unsigned                  stages;
+  /**
+   * @brief   Sub-keys of each stage.
+   */
+  uint8_t                   sk[3][DES_ROUNDS][8];
+} des_context_t;
+
+/**
+ * @brief   Type of a SHA-1/SHA-256 compression function.
+ */
+typedef void (*sha32_compress_t)(uint32_t *h, const uint8_t *data);
+
+/**
+ * @brief   AES S-box.
+ */
+static const uint8_t aes_sbox[256] = {
+  0x63U, 0x7CU, 0x77U, 0x7BU, 0xF2U, 0x6BU, 0x6FU, 0xC5U,
+  0x30U, 0x01U, 0x67U, 0x2BU, 0xFEU, 0xD7U, 0xABU, 0x76U,
+  0xCAU, 0x82U, 0xC9U, 0x7DU, 0xFAU, 0x59U, 0x47U, 0xF0U,
+  0xADU, 0xD4U, 0xA2U, 0xAFU, 0x9CU, 0xA4U, 0x72U, 0xC0U,
+  0xB7U, 0xFDU, 0x93U, 0x26U, 0x36U, 0x3FU, 0xF7U, 0xCCU,
+  0x34U, 0xA5U, 0xE5U, 0xF1U, 0x71U, 0xD8U, 0x31U, 0x15U,
+  0x04U, 0xC7U, 0x23U, 0xC3U, 0x18U, 0x96U, 0x05U, 0x9AU,
+  0x07U, 0x12U, 0x80U, 0xE2U, 0xEBU, 0x27U, 0xB2U, 0x75U,
+  0x09U, 0x83U, 0x2CU, 0x1AU, 0x1BU, 0x6EU, 0x5AU, 0xA0U,
+  0x52U, 0x3BU, 0xD6U, 0xB3U, 0x29U, 0xE3U, 0x2FU, 0x84U,
+  0x53U, 0xD1U, 0x00U, 0xEDU, 0x20U, 0xFCU, 0xB1U, 0x5BU,
+  0x6AU, 0xCBU, 0xBEU, 0x39U, 0x4AU, 0x4CU, 0x58U, 0xCFU,
+  0xD0U, 0xEFU, 0xAAU, 0xFBU, 0x43U, 0x4DU, 0x33U, 0x85U,
+  0x45U, 0xF9U, 0x02U, 0x7FU, 0x50U, 0x3CU, 0x9FU, 0xA8U,
+  0x51U, 0xA3U, 0x40U, 0x8FU, 0x92U, 0x9DU, 0x38U, 0xF5U,
+  0xBCU, 0xB6U, 0xDAU, 0x21U, 0x10U, 0xFFU, 0xF3U, 0xD2U,
+  0xCDU, 0x0CU, 0x13U, 0xECU, 0x5FU, 0x97U, 0x44U, 0x17U,
+  0xC4U, 0xA7U, 0x7EU, 0x3DU, 0x64U, 0x5DU, 0x19U, 0x73U,
+  0x60U, 0x81U, 0x4FU, 0xDCU, 0x22U, 0x2AU, 0x90U, 0x88U,
+  0x46U, 0xEEU, 0xB8U, 0x14U, 0xDEU, 0x5EU, 0x0BU, 0xDBU,
+  0xE0U, 0x32U, 0x3AU, 0x0AU, 0x49U, 0x06U, 0x24U, 0x5CU,
+  0xC2U, 0xD3U, 0xACU, 0x62U, 0x91U, 0x95U, 0xE4U, 0x79U,
+  0xE7U, 0xC8U, 0x37U, 0x6DU, 0x8DU, 0xD5U, 0x4EU, 0xA9U,
+  0x6CU, 0x56U, 0xF4U, 0xEAU, 0x65U, 0x7AU, 0xAEU, 0x08U,
+  0xBAU, 0x78U, 0x25U, 0x2EU, 0x1CU, 0xA6U, 0xB4U, 0xC6U,
+  0xE8U, 0xDDU, 0x74U, 0x1FU, 0x4BU, 0xBDU, 0x8BU, 0x8AU,
+  0x70U, 0x3EU, 0xB5U, 0x66U, 0x48U, 0x03U, 0xF6U, 0x0EU,
+  0x61U, 0x35U, 0x57U, 0xB9U, 0x86U, 0xC1U, 0x1DU, 0x9EU,
+  0xE1U, 0xF8U, 0x98U, 0x11U, 0x69U, 0xD9U, 0x8EU, 0x94U,
+  0x9BU, 0x1EU, 0x87U, 0xE9U, 0xCEU, 0x55U, 0x28U, 0xDFU,
+  0x8CU, 0xA1U, 0x89U, 0x0DU, 0xBFU, 0xE6U, 0x42U, 0x68U,
+  0x41U, 0x99U, 0x2DU, 0x0FU, 0xB0U, 0x54U, 0xBBU, 0x16U
+};
+
+/**
+ * @brief   AES inverse S-box.
+ */
+static const uint8_t aes_isbox[256] = {
+  0x52U, 0x09U, 0x6AU, 0xD5U, 0x30U, 0x36U, 0xA5U, 0x38U,
+  0xBFU, 0x40U, 0xA3U, 0x9EU, 0x81U, 0xF3U, 0xD7U, 0xFBU,
+  0x7CU, 0xE3U, 0x39U, 0x82U, 0x9BU, 0x2FU, 0xFFU, 0x87U,
+  0x34U, 0x8EU, 0x43U, 0x44U, 0xC4U, 0xDEU, 0xE9U, 0xCBU,
+  0x54U, 0x7BU, 0x94U, 0x32U, 0xA6U, 0xC2U, 0x23U, 0x3DU,
+  0xEEU, 0x4CU, 0x95U, 0x0BU, 0x42U, 0xFAU, 0xC3U, 0x4EU,
+  0x08U, 0x2EU, 0xA1U, 0x66U, 0x28U, 0xD9U, 0x24U, 0xB2U,
+  0x76U, 0x5BU, 0xA2U, 0x49U, 0x6DU, 0x8BU, 0xD1U, 0x25U,
+  0x72U, 0xF8U, 0xF6U, 0x64U, 0x86U, 0x68U, 0x98U, 0x16U,
+  0xD4U, 0xA4U, 0x5CU, 0xCCU, 0x5DU, 0x65U, 0xB6U, 0x92U,
+  0x6CU, 0x70U, 0x48U, 0x50U, 0xFDU, 0xEDU, 0xB9U, 0xDAU,
+  0x5EU, 0x15U, 0x46U, 0x57U, 0xA7U, 0x8DU, 0x9DU, 0x84U,
+  0x90U, 0xD8U, 0xABU, 0x00U, 0x8CU, 0xBCU, 0xD3U, 0x0AU,
+  0xF7U, 0xE4U, 0x58U, 0x05U, 0xB8U, 0xB3U, 0x45U, 0x06U,
+  0xD0U, 0x2CU, 0x1EU, 0x8FU, 0xCAU, 0x3FU, 0x0FU, 0x02U,
+  0xC1U, 0xAFU, 0xBDU, 0x03U, 0x01U, 0x13U, 0x8AU, 0x6BU,
+  0x3AU, 0x91U, 0x11U, 0x41U, 0x4FU, 0x67U, 0xDCU, 0xEAU,
+  0x97U, 0xF2U, 0xCFU, 0xCEU, 0xF0U, 0xB4U, 0xE6U, 0x73U,
+  0x96U, 0xACU, 0x74U, 0x22U, 0xE7U, 0xADU, 0x35U, 0x85U,
+  0xE2U, 0xF9U, 0x37U, 0xE8U, 0x1CU, 0x75U, 0xDFU, 0x6EU,
+  0x47U, 0xF1U, 0x1AU, 0x71U, 0x1DU, 0x29U, 0xC5U, 0x89U,
+  0x6FU, 0xB7U, 0x62U, 0x0EU, 0xAAU, 0x18U, 0xBEU, 0x1BU,
+  0xFCU, 0x56U, 0x3EU, 0x4BU, 0xC6U, 0xD2U, 0x79U, 0x20U,
+  0x9AU, 0xDBU, 0xC0U, 0xFEU, 0x78U, 0xCDU, 0x5AU, 0xF4U,
+  0x1FU, 0xDDU, 0xA8U, 0x33U, 0x88U, 0x07U, 0xC7U, 0x31U,
+  0xB1U, 0x12U, 0x10U, 0x59U, 0x27U, 0x80U, 0xECU, 0x5FU,
+  0x60U, 0x51U, 0x7FU, 0xA9U, 0x19U, 0xB5U, 0x4AU, 0x0DU,
+  0x2DU, 0xE5U, 0x7AU, 0x9FU, 0x93U, 0xC9U, 0x9CU, 0xEFU,
+  0xA0U, 0xE0U, 0x3BU, 0x4DU, 0xAEU, 0x2AU, 0xF5U, 0xB0U,
+  0xC8U, 0xEBU, 0xBBU, 0x3CU, 0x83U, 0x53U, 0x99U, 0x61U,
+  0x17U, 0x2BU, 0x04U, 0x7EU, 0xBAU, 0x77U, 0xD6U, 0x26U,
+  0xE1U, 0x69U, 0x14U, 0x63U, 0x55U, 0x21U, 0x0CU, 0x7DU
+};
+
+/**
+ * @brief   AES encryption round table.
+ * @details Each entry is the S-box output multiplied by the MixColumns
+ *          column (2, 1, 1, 3), the other three tables of the classic
+ *          implementation are obtained by rotation.
+ */
+static const uint32_t aes_te[256] = {
+  0xC66363A5U, 0xF87C7C84U, 0xEE777799U, 0xF67B7B8DU,
+  0xFFF2F20DU, 0xD66B6BBDU, 0xDE6F6FB1U, 0x91C5C554U,
+  0x60303050U, 0x02010103U, 0xCE6767A9U, 0x562B2B7DU,
+  0xE7FEFE19U, 0xB5D7D762U, 0x4DABABE6U, 0xEC76769AU,
+  0x8FCACA45U, 0x1F82829DU, 0x89C9C940U, 0xFA7D7D87U,
+  0xEFFAFA15U, 0xB25959EBU, 0x8E4747C9U, 0xFBF0F00BU,
+  0x41ADADECU, 0xB3D4D467U, 0x5FA2A2FDU, 0x45AFAFEAU,
+  0x239C9CBFU, 0x53A4A4F7U, 0xE4727296U, 0x9BC0C05BU,
+  0x75B7B7C2U, 0xE1FDFD1CU, 0x3D9393AEU, 0x4C26266AU,
+  0x6C36365AU, 0x7E3F3F41U, 0xF5F7F702U, 0x83CCCC4FU,
+  0x6834345CU, 0x51A5A5F4U, 0xD1E5E534U, 0xF9F1F108U,
+  0xE2717193U, 0xABD8D873U, 0x62313153U, 0x2A15153FU,
+  0x0804040CU, 0x95C7C752U, 0x46232365U, 0x9DC3C35EU,
+  0x30181828U, 0x379696A1U, 0x0A05050FU, 0x2F9A9AB5U,
+  0x0E070709U, 0x24121236U, 0x1B80809BU, 0xDFE2E23DU,
+  0xCDEBEB26U, 0x4E272769U, 0x7FB2B2CDU, 0xEA75759FU,
+  0x1209091BU, 0x1D83839EU, 0x582C2C74U, 0x341A1A2EU,
+  0x361B1B2DU, 0xDC6E6EB2U, 0xB45A5AEEU, 0x5BA0A0FBU,
+  0xA45252F6U, 0x763B3B4DU, 0xB7D6D661U, 0x7DB3B3CEU,
+  0x5229297BU, 0xDDE3E33EU, 0x5E2F2F71U, 0x13848497U,
+  0xA65353F5U, 0xB9D1D168U, 0x00000000U, 0xC1EDED2CU,
+  0x40202060U, 0xE3FCFC1FU, 0x79B1B1C8U, 0xB65B5BEDU,
+  0xD46A6ABEU, 0x8DCBCB46U, 0x67BEBED9U, 0x7239394BU,
+  0x944A4ADEU, 0x984C4CD4U, 0xB05858E8U, 0x85CFCF4AU,
+  0xBBD0D06BU, 0xC5EFEF2AU, 0x4FAAAAE5U, 0xEDFBFB16U,
+  0x864343C5U, 0x9A4D4DD7U, 0x66333355U, 0x11858594U,
+  0x8A4545CFU, 0xE9F9F910U, 0x04020206U, 0xFE7F7F81U,
+  0xA05050F0U, 0x783C3C44U, 0x259F9FBAU, 0x4BA8A8E3U,
+  0xA25151F3U, 0x5DA3A3FEU, 0x804040C0U, 0x058F8F8AU,
+  0x3F9292ADU, 0x219D9DBCU, 0x70383848U, 0xF1F5F504U,
+  0x63BCBCDFU, 0x77B6B6C1U, 0xAFDADA75U, 0x42212163U,
+  0x20101030U, 0xE5FFFF1AU, 0xFDF3F30EU, 0xBFD2D26DU,
+  0x81CDCD4CU, 0x180C0C14U, 0x26131335U, 0xC3ECEC2FU,
+  0xBE5F5FE1U, 0x359797A2U, 0x884444CCU, 0x2E171739U,
+  0x93C4C457U, 0x55A7A7F2U, 0xFC7E7E82U, 0x7A3D3D47U,
+  0xC86464ACU, 0xBA5D5DE7U, 0x3219192BU, 0xE6737395U,
+  0xC06060A0U, 0x19818198U, 0x9E4F4FD1U, 0xA3DCDC7FU,
+  0x44222266U, 0x542A2A7EU, 0x3B9090ABU, 0x0B888883U,
+  0x8C4646CAU, 0xC7EEEE29U, 0x6BB8B8D3U, 0x2814143CU,
+  0xA7DEDE79U, 0xBC5E5EE2U, 0x160B0B1DU, 0xADDBDB76U,
+  0xDBE0E03BU, 0x64323256U, 0x743A3A4EU, 0x140A0A1EU,
+  0x924949DBU, 0x0C06060AU, 0x4824246CU, 0xB85C5CE4U,
+  0x9FC2C25DU, 0xBDD3D36EU, 0x43ACACEFU, 0xC46262A6U,
+  0x399191A8U, 0x319595A4U, 0xD3E4E437U, 0xF279798BU,
+  0xD5E7E732U, 0x8BC8C843U, 0x6E373759U, 0xDA6D6DB7U,
+  0x018D8D8CU, 0xB1D5D564U, 0x9C4E4ED2U, 0x49A9A9E0U,
+  0xD86C6CB4U, 0xAC5656FAU, 0xF3F4F407U, 0xCFEAEA25U,
+  0xCA6565AFU, 0xF47A7A8EU, 0x47AEAEE9U, 0x10080818U,
+  0x6FBABAD5U, 0xF0787888U, 0x4A25256FU, 0x5C2E2E72U,
+  0x381C1C24U, 0x57A6A6F1U, 0x73B4B4C7U, 0x97C6C651U,
+  0xCBE8E823U, 0xA1DDDD7CU, 0xE874749CU, 0x3E1F1F21U,
+  0x964B4BDDU, 0x61BDBDDCU, 0x0D8B8B86U, 0x0F8A8A85U,
+  0xE0707090U, 0x7C3E3E42U, 0x71B5B5C4U, 0xCC6666AAU,
+  0x904848D8U, 0x06030305U, 0xF7F6F601U, 0x1C0E0E12U,
+  0xC26161A3U, 0x6A35355FU, 0xAE5757F9U, 0x69B9B9D0U,
+  0x17868691U, 0x99C1C158U, 0x3A1D1D27U, 0x279E9EB9U,
+  0xD9E1E138U, 0xEBF8F813U, 0x2B9898B3U, 0x22111133U,
+  0xD26969BBU, 0xA9D9D970U, 0x078E8E89U, 0x339494A7U,
+  0x2D9B9BB6U, 0x3C1E1E22U, 0x15878792U, 0xC9E9E920U,
+  0x87CECE49U, 0xAA5555FFU, 0x50282878U, 0xA5DFDF7AU,
+  0x038C8C8FU, 0x59A1A1F8U, 0x09898980U, 0x1A0D0D17U,
+  0x65BFBFDAU, 0xD7E6E631U, 0x844242C6U, 0xD06868B8U,
+  0x824141C3U, 0x299999B0U, 0x5A2D2D77U, 0x1E0F0F11U,
+  0x7BB0B0CBU, 0xA85454FCU, 0x6DBBBBD6U, 0x2C16163AU
+};
+
+/**
+ * @brief   AES decryption round table.
+ * @details Each entry is the inverse S-box output multiplied by the
+ *          InvMixColumns column (14, 9, 13, 11).
+ */
+static const uint32_t aes_td[256] = {
+  0x51F4A750U, 0x7E416553U, 0x1A17A4C3U, 0x3A275E96U,
+  0x3BAB6BCBU, 0x1F9D45F1U, 0xACFA58ABU, 0x4BE30393U,
+  0x2030FA55U, 0xAD766DF6U, 0x88CC7691U, 0xF5024C25U,
+  0x4FE5D7FCU, 0xC52ACBD7U, 0x26354480U, 0xB562A38FU,
+  0xDEB15A49U, 0x25BA1B67U, 0x45EA0E98U, 0x5DFEC0E1U,
+  0xC32F7502U, 0x814CF012U, 0x8D4697A3U, 0x6BD3F9C6U,
+  0x038F5FE7U, 0x15929C95U, 0xBF6D7AEBU, 0x955259DAU,
+  0xD4BE832DU, 0x587421D3U, 0x49E06929U, 0x8EC9C844U,
+  0x75C2896AU, 0xF48E7978U, 0x99583E6BU, 0x27B971DDU,
+  0xBEE14FB6U, 0xF088AD17U, 0xC920AC66U, 0x7DCE3AB4U,
+  0x63DF4A18U, 0xE51A3182U, 0x97513360U, 0x62537F45U,
+  0xB16477E0U, 0xBB6BAE84U, 0xFE81A01CU, 0xF9082B94U,
+  0x70486858U, 0x8F45FD19U, 0x94DE6C87U, 0x527BF8B7U,
+  0xAB73D323U, 0x724B02E2U, 0xE31F8F57U, 0x6655AB2AU,
+  0xB2EB2807U, 0x2FB5C203U, 0x86C57B9AU, 0xD33708A5U,
+  0x302887F2U, 0x23BFA5B2U, 0x02036ABAU, 0xED16825CU,
+  0x8ACF1C2BU, 0xA779B492U, 0xF307F2F0U, 0x4E69E2A1U,
+  0x65DAF4CDU, 0x0605BED5U, 0xD134621FU, 0xC4A6FE8AU,
+  0x342E539DU, 0xA2F355A0U, 0x058AE132U, 0xA4F6EB75U,
+  0x0B83EC39U, 0x4060EFAAU, 0x5E719F06U, 0xBD6E1051U,
+  0x3E218AF9U, 0x96DD063DU, 0xDD3E05AEU, 0x4DE6BD46U,
+  0x91548DB5U, 0x71C45D05U, 0x0406D46FU, 0x605015FFU,
+  0x1998FB24U, 0xD6BDE997U, 0x894043CCU, 0x67D99E77U,
+  0xB0E842BDU, 0x07898B88U, 0xE7195B38U, 0x79C8EEDBU,
+  0xA17C0A47U, 0x7C420FE9U, 0xF8841EC9U, 0x00000000U,
+  0x09808683U, 0x322BED48U, 0x1E1170ACU, 0x6C5A724EU,
+  0xFD0EFFFBU, 0x0F853856U, 0x3DAED51EU, 0x362D3927U,
+  0x0A0FD964U, 0x685CA621U, 0x9B5B54D1U, 0x24362E3AU,
+  0x0C0A67B1U, 0x9357E70FU, 0xB4EE96D2U, 0x1B9B919EU,
+  0x80C0C54FU, 0x61DC20A2U, 0x5A774B69U, 0x1C121A16U,
+  0xE293BA0AU, 0xC0A02AE5U, 0x3C22E043U, 0x121B171DU,
+  0x0E090D0BU, 0xF28BC7ADU, 0x2DB6A8B9U, 0x141EA9C8U,
+  0x57F11985U, 0xAF75074CU, 0xEE99DDBBU, 0xA37F60FDU,
+  0xF701269FU, 0x5C72F5BCU, 0x44663BC5U, 0x5BFB7E34U,
+  0x8B432976U, 0xCB23C6DCU, 0xB6EDFC68U, 0xB8E4F163U,
+  0xD731DCCAU, 0x42638510U, 0x13972240U, 0x84C61120U,
+  0x854A247DU, 0xD2BB3DF8U, 0xAEF93211U, 0xC729A16DU,
+  0x1D9E2F4BU, 0xDCB230F3U, 0x0D8652ECU, 0x77C1E3D0U,
+  0x2BB3166CU, 0xA970B999U, 0x119448FAU, 0x47E96422U,
+  0xA8FC8CC4U, 0xA0F03F1AU, 0x567D2CD8U, 0x223390EFU,
+  0x87494EC7U, 0xD938D1C1U, 0x8CCAA2FEU, 0x98D40B36U,
+  0xA6F581CFU, 0xA57ADE28U, 0xDAB78E26U, 0x3FADBFA4U,
+  0x2C3A9DE4U, 0x5078920DU, 0x6A5FCC9BU, 0x547E4662U,
+  0xF68D13C2U, 0x90D8B8E8U, 0x2E39F75EU, 0x82C3AFF5U,
+  0x9F5D80BEU, 0x69D0937CU, 0x6FD52DA9U, 0xCF2512B3U,
+  0xC8AC993BU, 0x10187DA7U, 0xE89C636EU, 0xDB3BBB7BU,
+  0xCD267809U, 0x6E5918F4U, 0xEC9AB701U, 0x834F9AA8U,
+  0xE6956E65U, 0xAAFFE67EU, 0x21BCCF08U, 0xEF15E8E6U,
+  0xBAE79BD9U, 0x4A6F36CEU, 0xEA9F09D4U, 0x29B07CD6U,
+  0x31A4B2AFU, 0x2A3F2331U, 0xC6A59430U, 0x35A266C0U,
+  0x744EBC37U, 0xFC82CAA6U, 0xE090D0B0U, 0x33A7D815U,
+  0xF104984AU, 0x41ECDAF7U, 0x7FCD500EU, 0x1791F62FU,
+  0x764DD68DU, 0x43EFB04DU, 0xCCAA4D54U, 0xE49604DFU,
+  0x9ED1B5E3U, 0x4C6A881BU, 0xC12C1FB8U, 0x4665517FU,
+  0x9D5EEA04U, 0x018C355DU, 0xFA877473U, 0xFB0B412EU,
+  0xB3671D5AU, 0x92DBD252U, 0xE9105633U, 0x6DD64713U,
+  0x9AD7618CU, 0x37A10C7AU, 0x59F8148EU, 0xEB133C89U,
+  0xCEA927EEU, 0xB761C935U, 0xE11CE5EDU, 0x7A47B13CU,
+  0x9CD2DF59U, 0x55F2733FU, 0x1814CE79U, 0x73C737BFU,
+  0x53F7CDEAU, 0x5FFDAA5BU, 0xDF3D6F14U, 0x7844DB86U,
+  0xCAAFF381U, 0xB968C43EU, 0x3824342CU, 0xC2A3405FU,
+  0x161DC372U, 0xBCE2250CU, 0x283C498BU, 0xFF0D9541U,
+  0x39A80171U, 0x080CB3DEU, 0xD8B4E49CU, 0x6456C190U,
+  0x7BCB8461U, 0xD532B670U, 0x486C5C74U, 0xD0B85742U
+};
+
+/**
+ * @brief   DES S-boxes combined with the P permutation.
+ */
+static const uint32_t des_sp[8][64] = {
+  {
+    0x00808200U, 0x00000000U, 0x00008000U, 0x00808202U,
+    0x00808002U, 0x00008202U, 0x00000002U, 0x00008000U,
+    0x00000200U, 0x00808200U, 0x00808202U, 0x00000200U,
+    0x00800202U, 0x00808002U, 0x00800000U, 0x00000002U,
+    0x00000202U, 0x00800200U, 0x00800200U, 0x00008200U,
+    0x00008200U, 0x00808000U, 0x00808000U, 0x00800202U,
+    0x00008002U, 0x00800002U, 0x00800002U, 0x00008002U,
+    0x00000000U, 0x00000202U, 0x00008202U, 0x00800000U,
+    0x00008000U, 0x00808202U, 0x00000002U, 0x00808000U,
+    0x00808200U, 0x00800000U, 0x00800000U, 0x00000200U,
+    0x00808002U, 0x00008000U, 0x00008200U, 0x00800002U,
+    0x00000200U, 0x00000002U, 0x00800202U, 0x00008202U,
+    0x00808202U, 0x00008002U, 0x00808000U, 0x00800202U,
+    0x00800002U, 0x00000202U, 0x00008202U, 0x00808200U,
+    0x00000202U, 0x00800200U, 0x00800200U, 0x00000000U,
+    0x00008002U, 0x00008200U, 0x00000000U, 0x00808002U
+  },
+  {
+    0x40084010U, 0x40004000U, 0x00004000U, 0x00084010U,
+    0x00080000U, 0x00000010U, 0x40080010U, 0x40004010U,
+    0x40000010U, 0x40084010U, 0x40084000U, 0x40000000U,
+    0x40004000U, 0x00080000U, 0x00000010U, 0x40080010U,
+    0x00084000U, 0x00080010U, 0x40004010U, 0x00000000U,
+    0x40000000U, 0x00004000U, 0x00084010U, 0x40080000U,
+    0x00080010U, 0x40000010U, 0x00000000U, 0x00084000U,
+    0x00004010U, 0x40084000U, 0x40080000U, 0x00004010U,
+    0x00000000U, 0x00084010U, 0x40080010U, 0x00080000U,
+    0x40004010U, 0x40080000U, 0x40084000U, 0x00004000U,
+    0x40080000U, 0x40004000U, 0x00000010U, 0x40084010U,
+    0x00084010U, 0x00000010U, 0x00004000U, 0x40000000U,
+    0x00004010U, 0x40084000U, 0x00080000U, 0x40000010U,
+    0x00080010U, 0x40004010U, 0x40000010U, 0x00080010U,
+    0x00084000U, 0x00000000U, 0x40004000U, 0x00004010U,
+    0x40000000U, 0x40080010U, 0x40084010U, 0x00084000U
+  },
+  {
+    0x00000104U, 0x04010100U, 0x00000000U, 0x04010004U,
+    0x04000100U, 0x00000000U, 0x00010104U, 0x04000100U,
+    0x00010004U, 0x04000004U, 0x04000004U, 0x00010000U,
+    0x04010104U, 0x00010004U, 0x04010000U, 0x00000104U,
+    0x04000000U, 0x00000004U, 0x04010100U, 0x00000100U,
+    0x00010100U, 0x04010000U, 0x04010004U, 0x00010104U,
+    0x04000104U, 0x00010100U, 0x00010000U, 0x04000104U,
+    0x00000004U, 0x04010104U, 0x00000100U, 0x04000000U,
+    0x04010100U, 0x04000000U, 0x00010004U, 0x00000104U,
+    0x00010000U, 0x04010100U, 0x04000100U, 0x00000000U,
+    0x00000100U, 0x00010004U, 0x04010104U, 0x04000100U,
+    0x04000004U, 0x00000100U, 0x00000000U, 0x04010004U,
+    0x04000104U, 0x00010000U, 0x04000000U, 0x04010104U,
+    0x00000004U, 0x00010104U, 0x00010100U, 0x04000004U,
+    0x04010000U, 0x04000104U, 0x00000104U, 0x04010000U,
+    0x00010104U, 0x00000004U, 0x04010004U, 0x00010100U
+  },
+  {
+    0x80401000U, 0x80001040U, 0x80001040U, 0x00000040U,
+    0x00401040U, 0x80400040U, 0x80400000U, 0x80001000U,
+    0x00000000U, 0x00401000U, 0x00401000U, 0x80401040U,
+    0x80000040U, 0x00000000U, 0x00400040U, 0x80400000U,
+    0x80000000U, 0x00001000U, 0x00400000U, 0x80401000U,
+    0x00000040U, 0x00400000U, 0x80001000U, 0x00001040U,
+    0x80400040U, 0x80000000U, 0x00001040U, 0x00400040U,
+    0x00001000U, 0x00401040U, 0x80401040U, 0x80000040U,
+    0x00400040U, 0x80400000U, 0x00401000U, 0x80401040U,
+    0x80000040U, 0x00000000U, 0x00000000U, 0x00401000U,
+    0x00001040U, 0x00400040U, 0x80400040U, 0x80000000U,
+    0x80401000U, 0x80001040U, 0x80001040U, 0x00000040U,
+    0x80401040U, 0x80000040U, 0x80000000U, 0x00001000U,
+    0x80400000U, 0x80001000U, 0x00401040U, 0x80400040U,
+    0x80001000U, 0x00001040U, 0x00400000U, 0x80401000U,
+    0x00000040U, 0x00400000U, 0x00001000U, 0x00401040U
+  },
+  {
+    0x00000080U, 0x01040080U, 0x01040000U, 0x21000080U,
+    0x00040000U, 0x00000080U, 0x20000000U, 0x01040000U,
+    0x20040080U, 0x00040000U, 0x01000080U, 0x20040080U,
+    0x21000080U, 0x21040000U, 0x00040080U, 0x20000000U,
+    0x01000000U, 0x20040000U, 0x20040000U, 0x00000000U,
+    0x20000080U, 0x21040080U, 0x21040080U, 0x01000080U,
+    0x21040000U, 0x20000080U, 0x00000000U, 0x21000000U,
+    0x01040080U, 0x01000000U, 0x21000000U, 0x00040080U,
+    0x00040000U, 0x21000080U, 0x00000080U, 0x01000000U,
+    0x20000000U, 0x01040000U, 0x21000080U, 0x20040080U,
+    0x01000080U, 0x20000000U, 0x21040000U, 0x01040080U,
+    0x20040080U, 0x00000080U, 0x01000000U, 0x21040000U,
+    0x21040080U, 0x00040080U, 0x21000000U, 0x21040080U,
+    0x01040000U, 0x00000000U, 0x20040000U, 0x21000000U,
+    0x00040080U, 0x01000080U, 0x20000080U, 0x00040000U,
+    0x00000000U, 0x20040000U, 0x01040080U, 0x20000080U
+  },
+  {
+    0x10000008U, 0x10200000U, 0x00002000U, 0x10202008U,
+    0x10200000U, 0x00000008U, 0x10202008U, 0x00200000U,
+    0x10002000U, 0x00202008U, 0x00200000U, 0x10000008U,
+    0x00200008U, 0x10002000U, 0x10000000U, 0x00002008U,
+    0x00000000U, 0x00200008U, 0x10002008U, 0x00002000U,
+    0x00202000U, 0x10002008U, 0x00000008U, 0x10200008U,
+    0x10200008U, 0x00000000U, 0x00202008U, 0x10202000U,
+    0x00002008U, 0x00202000U, 0x10202000U, 0x10000000U,
+    0x10002000U, 0x00000008U, 0x10200008U, 0x00202000U,
+    0x10202008U, 0x00200000U, 0x00002008U, 0x10000008U,
+    0x00200000U, 0x10002000U, 0x10000000U, 0x00002008U,
+    0x10000008U, 0x10202008U, 0x00202000U, 0x10200000U,
+    0x00202008U, 0x10202000U, 0x00000000U, 0x10200008U,
+    0x00000008U, 0x00002000U, 0x10200000U, 0x00202008U,
+    0x00002000U, 0x00200008U, 0x10002008U, 0x00000000U,
+    0x10202000U, 0x10000000U, 0x00200008U, 0x10002008U
+  },
+  {
+    0x00100000U, 0x02100001U, 0x02000401U, 0x00000000U,
+    0x00000400U, 0x02000401U, 0x00100401U, 0x02100400U,
+    0x02100401U, 0x00100000U, 0x00000000U, 0x02000001U,
+    0x00000001U, 0x02000000U, 0x02100001U, 0x00000401U,
+    0x02000400U, 0x00100401U, 0x00100001U, 0x02000400U,
+    0x02000001U, 0x02100000U, 0x02100400U, 0x00100001U,
+    0x02100000U, 0x00000400U, 0x00000401U, 0x02100401U,
+    0x00100400U, 0x00000001U, 0x02000000U, 0x00100400U,
+    0x02000000U, 0x00100400U, 0x00100000U, 0x02000401U,
+    0x02000401U, 0x02100001U, 0x02100001U, 0x00000001U,
+    0x00100001U, 0x02000000U, 0x02000400U, 0x00100000U,
+    0x02100400U, 0x00000401U, 0x00100401U, 0x02100400U,
+    0x00000401U, 0x02000001U, 0x02100401U, 0x02100000U,
+    0x00100400U, 0x00000000U, 0x00000001U, 0x02100401U,
+    0x00000000U, 0x00100401U, 0x02100000U, 0x00000400U,
+    0x02000001U, 0x02000400U, 0x00000400U, 0x00100001U
+  },
+  {
+    0x08000820U, 0x00000800U, 0x00020000U, 0x08020820U,
+    0x08000000U, 0x08000820U, 0x00000020U, 0x08000000U,
+    0x00020020U, 0x08020000U, 0x08020820U, 0x00020800U,
+    0x08020800U, 0x00020820U, 0x00000800U, 0x00000020U,
+    0x08020000U, 0x08000020U, 0x08000800U, 0x00000820U,
+    0x00020800U, 0x00020020U, 0x08020020U, 0x08020800U,
+    0x00000820U, 0x00000000U, 0x00000000U, 0x08020020U,
+    0x08000020U, 0x08000800U, 0x00020820U, 0x00020000U,
+    0x00020820U, 0x00020000U, 0x08020800U, 0x00000800U,
+    0x00000020U, 0x08020020U, 0x00000800U, 0x00020820U,
+    0x08000800U, 0x00000020U, 0x08000020U, 0x08020000U,
+    0x08020020U, 0x08000000U, 0x00020000U, 0x08000820U,
+    0x00000000U, 0x08020820U, 0x00020020U, 0x08000020U,
+    0x08020000U, 0x08000800U, 0x08000820U, 0x00000000U,
+    0x08020820U, 0x00020800U, 0x00020800U, 0x00000820U,
+    0x00000820U, 0x00020020U, 0x08000000U, 0x08020800U
+  }
+};
+
+/**
+ * @brief   DES key schedule permuted choice 1.
+ */
+static const uint8_t des_pc1[56] = {
+  57, 49, 41, 33, 25, 17,  9,  1, 58, 50, 42, 34, 26, 18,
+  10,  2, 59, 51, 43, 35, 27, 19, 11,  3, 60, 52, 44, 36,
+  63, 55, 47, 39, 31, 23, 15,  7, 62, 54, 46, 38, 30, 22,
+  14,  6, 61, 53, 45, 37, 29, 21, 13,  5, 28, 20, 12,  4
+};
+
+/**
+ * @brief   DES key schedule permuted choice 2.
+ */
+static const uint8_t des_pc2[48] = {
+  14, 17, 11, 24,  1,  5,  3, 28, 15,  6, 21, 10,
+  23, 19, 12,  4, 26,  8, 16,  7, 27, 20, 13,  2,
+  41, 52, 31, 37, 47, 55, 30, 40, 51, 45, 33, 48,
+  44, 49, 39, 56, 34, 53, 46, 42, 50, 36, 29, 32
+};
+
+/**
+ * @brief   DES key schedule rotations.
+ */
+static const uint8_t des_shifts[DES_ROUNDS] = {
+  1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2, 2, 2, 1
+};
+
+/**
+ * @brief   GHASH reduction table for the 4 bits Shoup method.
+ */
+static const uint16_t ghash_last4[16] = {
+  0x0000U, 0x1C20U, 0x3840U, 0x2460U, 0x7080U, 0x6CA0U, 0x48C0U, 0x54E0U,
+  0xE100U, 0xFD20U, 0xD940U, 0xC560U, 0x9180U, 0x8DA0U, 0xA9C0U, 0xB5E0U
+};
+
+/**
+ * @brief   SHA-1 initial hash value.
+ */
+static const uint32_t sha1_h0[5] = {
+  0x67452301U, 0xEFCDAB89U, 0x98BADCFEU, 0x10325476U, 0xC3D2E1F0U
+};
+
+/**
+ * @brief   SHA-256 initial hash value.
+ */
+static const uint32_t sha256_h0[8] = {
+  0x6A09E667U, 0xBB67AE85U, 0x3C6EF372U, 0xA54FF53AU,
+  0x510E527FU, 0x9B05688CU, 0x1F83D9ABU, 0x5BE0CD19U
+};
+
+/**
+ * @brief   SHA-256 round constants.
+ */
+static const uint32_t sha256_k[64] = {
+  0x428A2F98U, 0x71374491U, 0xB5C0FBCFU, 0xE9B5DBA5U,
+  0x3956C25BU, 0x59F111F1U, 0x923F82A4U, 0xAB1C5ED5U,
+  0xD807AA98U, 0x12835B01U, 0x243185BEU, 0x550C7DC3U,
+  0x72BE5D74U, 0x80DEB1FEU, 0x9BDC06A7U, 0xC19BF174U,
+  0xE49B69C1U, 0xEFBE4786U, 0x0FC19DC6U, 0x240CA1CCU,
+  0x2DE92C6FU, 0x4A7484AAU, 0x5CB0A9DCU, 0x76F988DAU,
+  0x983E5152U, 0xA831C66DU, 0xB00327C8U, 0xBF597FC7U,
+  0xC6E00BF3U, 0xD5A79147U, 0x06CA6351U, 0x14292967U,
+  0x27B70A85U, 0x2E1B2138U, 0x4D2C6DFCU, 0x53380D13U,
+  0x650A7354U, 0x766A0ABBU, 0x81C2C92EU, 0x92722C85U,
+  0xA2BFE8A1U, 0xA81A664BU, 0xC24B8B70U, 0xC76C51A3U,
+  0xD192E819U, 0xD6990624U, 0xF40E3585U, 0x106AA070U,
+  0x19A4C116U, 0x1E376C08U, 0x2748774CU, 0x34B0BCB5U,
+  0x391C0CB3U, 0x4ED8AA4AU, 0x5B9CCA4FU, 0x682E6FF3U,
+  0x748F82EEU, 0x78A5636FU, 0x84C87814U, 0x8CC70208U,
+  0x90BEFFFAU, 0xA4506CEBU, 0xBEF9A3F7U, 0xC67178F2U
+};
+
+/**
+ * @brief   SHA-512 round constants.
+ */
+static const uint64_t sha512_k[80] = {
+  0x428A2F98D728AE22U, 0x7137449123EF65CDU,
+  0xB5C0FBCFEC4D3B2FU, 0xE9B5DBA58189DBBCU,
+  0x3956C25BF348B538U, 0x59F111F1B605D019U,
+  0x923F82A4AF194F9BU, 0xAB1C5ED5DA6D8118U,
+  0xD807AA98A3030242U, 0x12835B0145706FBEU,
+  0x243185BE4EE4B28CU, 0x550C7DC3D5FFB4E2U,
+  0x72BE5D74F27B896FU, 0x80DEB1FE3B1696B1U,
+  0x9BDC06A725C71235U, 0xC19BF174CF692694U,
+  0xE49B69C19EF14AD2U, 0xEFBE4786384F25E3U,
+  0x0FC19DC68B8CD5B5U, 0x240CA1CC77AC9C65U,
+  0x2DE92C6F592B0275U, 0x4A7484AA6EA6E483U,
+  0x5CB0A9DCBD41FBD4U, 0x76F988DA831153B5U,
+  0x983E5152EE66DFABU, 0xA831C66D2DB43210U,
+  0xB00327C898FB213FU, 0xBF597FC7BEEF0EE4U,
+  0xC6E00BF33DA88FC2U, 0xD5A79147930AA725U,
+  0x06CA6351E003826FU, 0x142929670A0E6E70U,
+  0x27B70A8546D22FFCU, 0x2E1B21385C26C926U,
+  0x4D2C6DFC5AC42AEDU, 0x53380D139D95B3DFU,
+  0x650A73548BAF63DEU, 0x766A0ABB3C77B2A8U,
+  0x81C2C92E47EDAEE6U, 0x92722C851482353BU,
+  0xA2BFE8A14CF10364U, 0xA81A664BBC423001U,
+  0xC24B8B70D0F89791U, 0xC76C51A30654BE30U,
+  0xD192E819D6EF5218U, 0xD69906245565A910U,
+  0xF40E35855771202AU, 0x106AA07032BBD1B8U,
+  0x19A4C116B8D2D0C8U, 0x1E376C085141AB53U,
+  0x2748774CDF8EEB99U, 0x34B0BCB5E19B48A8U,
+  0x391C0CB3C5C95A63U, 0x4ED8AA4AE3418ACBU,
+  0x5B9CCA4F7763E373U, 0x682E6FF3D6B2B8A3U,
+  0x748F82EE5DEFB2FCU, 0x78A5636F43172F60U,
+  0x84C87814A1F0AB72U, 0x8CC702081A6439ECU,
+  0x90BEFFFA23631E28U, 0xA4506CEBDE82BDE9U,
+  0xBEF9A3F7B2C67915U, 0xC67178F2E372532BU,
+  0xCA273ECEEA26619CU, 0xD186B8C721C0C207U,
+  0xEADA7DD6CDE0EB1EU, 0xF57D4F7FEE6ED178U,
+  0x06F067AA72176FBAU, 0x0A637DC5A2C898A6U,
+  0x113F9804BEF90DAEU, 0x1B710B35131C471BU,
+  0x28DB77F523047D84U, 0x32CAAB7B40C72493U,
+  0x3C9EBE0A15C9BEBCU, 0x431D67C49C100D4CU,
+  0x4CC5D4BECB3E42B6U, 0x597F299CFC657E2AU,
+  0x5FCB6FAB3AD6FAECU, 0x6C44198C4A475817U
+};
+
+/**
+ * @brief   SHA-512 initial hash value.
+ */
+static const uint64_t sha512_h0[8] = {
+  0x6A09E667F3BCC908U, 0xBB67AE8584CAA73BU,
+  0x3C6EF372FE94F82BU, 0xA54FF53A5F1D36F1U,
+  0x510E527FADE682D1U, 0x9B05688C2B3E6C1FU,
+  0x1F83D9ABFB41BD6BU, 0x5BE0CD19137E2179U
+};
+
+/*===========================================================================*/
+/* Driver local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @name    AES round helpers
+ * @{
+ */
+#define AES_TE(a, b, c, d)                                                  \
+  (aes_te[(a) >> 24] ^ ROR32(aes_te[((b) >> 16) & 0xFFU], 8U) ^             \
+   ROR32(aes_te[((c) >> 8) & 0xFFU], 16U) ^                                 \
+   ROR32(aes_te[(d) & 0xFFU], 24U))
+
+#define AES_TD(a, b, c, d)                                                  \
+  (aes_td[(a) >> 24] ^ ROR32(aes_td[((b) >> 16) & 0xFFU], 8U) ^             \
+   ROR32(aes_td[((c) >> 8) & 0xFFU], 16U) ^                                 \
+   ROR32(aes_td[(d) & 0xFFU], 24U))
+
+#define AES_SB(sb, a, b, c, d)                                              \
+  (((uint32_t)(sb)[(a) >> 24] << 24) |                                      \
+   ((uint32_t)(sb)[((b) >> 16) & 0xFFU] << 16) |                            \
+   ((uint32_t)(sb)[((c) >> 8) & 0xFFU] << 8) |                              \
+   ((uint32_t)(sb)[(d) & 0xFFU]))
+/** @} */
+
+/**
+ * @brief   DES swap-move step of the initial and final permutations.
+ */
+#define DES_PERM(a, b, t, n, m) do {                                        \
+  (t) = (((a) >> (n)) ^ (b)) & (m);                                         \
+  (b) ^= (t);                                                               \
+  (a) ^= (t) << (n);                                                        \
+} while (false)
+
+/**
+ * @brief   Verifies that the specified key is usable for an algorithm.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation
+ * @param[in] algorithm the algorithm the key is required for
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static cryerror_t cry_check_key(CRYDriver *cryp,
+                                crykey_t key_id,
+                                cryalgorithm_t algorithm) {
+
+  /* Only the transient key is available to the fall-back.*/
+  if (key_id != (crykey_t)0) {
+    return CRY_ERR_INV_KEY_ID;
+  }
+
+  if (cryp->key0_type != algorithm) {
+    return CRY_ERR_INV_KEY_TYPE;
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   XOR of two buffers.
+ *
+ * @param[out] out      output buffer, it can coincide with one of the inputs
+ * @param[in] a         first input buffer
+ * @param[in] b         second input buffer
+ * @param[in] n         number of bytes
+ *
+ * @notapi
+ */
+static void cry_xor(uint8_t *out, const uint8_t *a, const uint8_t *b,
+                    size_t n) {
+
+  while (n > (size_t)0) {
+    *out++ = *a++ ^ *b++;
+    n--;
+  }
+}
+
+/**
+ * @brief   Increments the 32 bits big endian counter of a block.
+ *
+ * @param[in,out] ctr   the counter block
+ *
+ * @notapi
+ */
+static void cry_inc32(uint8_t *ctr) {
+  unsigned i = AES_BLOCK_SIZE;
+
+  do {
+    i--;
+    ctr[i]++;
+  } while ((ctr[i] == 0U) && (i > AES_BLOCK_SIZE - 4U));
+}
+
+/**
+ * @brief   Applies the S-box to each byte of a word.
+ *
+ * @param[in] w         the input word
+ * @return              The substituted word.
+ *
+ * @notapi
+ */
+static uint32_t aes_sub_word(uint32_t w) {
+
+  return AES_SB(aes_sbox, w, w, w, w);
+}
+
+/**
+ * @brief   Applies InvMixColumns to a round key word.
+ *
+ * @param[in] w         the input word
+ * @return              The transformed word.
+ *
+ * @notapi
+ */
+static uint32_t aes_inv_mix(uint32_t w) {
+
+  /* The decryption table includes the inverse S-box, it is cancelled
+     by applying the direct S-box first.*/
+  w = aes_sub_word(w);
+
+  return AES_TD(w, w, w, w);
+}
+
+/**
+ * @brief   AES key expansion.
+ *
+ * @param[out] ctxp     pointer to the AES context
+ * @param[in] key       the key data
+ * @param[in] size      the key size in bytes, 16, 24 or 32
+ * @param[in] decrypt   if @p true the decryption key is generated
+ *
+ * @notapi
+ */
+static void aes_expand_key(cryaesstate_t *ctxp, const uint8_t *key,
+                           size_t size, bool decrypt) {
+  uint32_t i, n, nk = (uint32_t)size / 4U;
+  uint32_t rcon = 0x01U;
+
+  ctxp->nr = nk + 6U;
+  n = 4U * (ctxp->nr + 1U);
+  for (i = 0U; i < nk; i++) {
+    ctxp->rk[i] = GET_U32_BE(&key[i * 4U]);
+  }
+  for (i = nk; i < n; i++) {
+    uint32_t t = ctxp->rk[i - 1U];
+
+    if ((i % nk) == 0U) {
+      t = aes_sub_word(ROR32(t, 24U)) ^ (rcon << 24);
+      rcon = (rcon << 1) ^ (((rcon >> 7) & 1U) * 0x11BU);
+    }
+    else if ((nk > 6U) && ((i % nk) == 4U)) {
+      t = aes_sub_word(t);
+    }
+    ctxp->rk[i] = ctxp->rk[i - nk] ^ t;
+  }
+
+  if (decrypt) {
+    uint32_t j;
+
+    /* Equivalent inverse cipher, round keys in reverse order and
+       InvMixColumns applied to all the inner round keys.*/
+    for (i = 0U, j = n - 4U; i < j; i += 4U, j -= 4U) {
+      uint32_t k;
+
+      for (k = 0U; k < 4U; k++) {
+        uint32_t t = ctxp->rk[i + k];
+        ctxp->rk[i + k] = ctxp->rk[j + k];
+        ctxp->rk[j + k] = t;
+      }
+    }
+    for (i = 4U; i < n - 4U; i++) {
+      ctxp->rk[i] = aes_inv_mix(ctxp->rk[i]);
+    }
+  }
+}
+
+/**
+ * @brief   Loads and expands the AES key.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation
+ * @param[out] ctxp     pointer to the AES context
+ * @param[in] decrypt   if @p true the decryption key is generated
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static cryerror_t aes_init(CRYDriver *cryp, crykey_t key_id,
+                           cryaesstate_t *ctxp, bool decrypt) {
+  cryerror_t err;
+
+  err = cry_check_key(cryp, key_id, cry_algo_aes);
+  if (err == CRY_NOERROR) {
+    aes_expand_key(ctxp, (const uint8_t *)cryp->key0_buffer,
+                   cryp->key0_size, decrypt);
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Encrypts a single AES block.
+ *
+ * @param[in] ctxp      pointer to the AES context
+ * @param[in] in        input block
+ * @param[out] out      output block, it can coincide with @p in
+ *
+ * @notapi
+ */
+static void aes_encrypt_block(const cryaesstate_t *ctxp,
+                              const uint8_t *in, uint8_t *out) {
+  const uint32_t *rk = ctxp->rk;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint32_t r;
+
+  s0 = GET_U32_BE(&in[0])  ^ rk[0];
+  s1 = GET_U32_BE(&in[4])  ^ rk[1];
+  s2 = GET_U32_BE(&in[8])  ^ rk[2];
+  s3 = GET_U32_BE(&in[12]) ^ rk[3];
+  for (r = 1U; r < ctxp->nr; r++) {
+    rk += 4;
+    t0 = AES_TE(s0, s1, s2, s3) ^ rk[0];
+    t1 = AES_TE(s1, s2, s3, s0) ^ rk[1];
+    t2 = AES_TE(s2, s3, s0, s1) ^ rk[2];
+    t3 = AES_TE(s3, s0, s1, s2) ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+  rk += 4;
+  t0 = AES_SB(aes_sbox, s0, s1, s2, s3) ^ rk[0];
+  t1 = AES_SB(aes_sbox, s1, s2, s3, s0) ^ rk[1];
+  t2 = AES_SB(aes_sbox, s2, s3, s0, s1) ^ rk[2];
+  t3 = AES_SB(aes_sbox, s3, s0, s1, s2) ^ rk[3];
+  PUT_U32_BE(&out[0],  t0);
+  PUT_U32_BE(&out[4],  t1);
+  PUT_U32_BE(&out[8],  t2);
+  PUT_U32_BE(&out[12], t3);
+}
+
+/**
+ * @brief   Decrypts a single AES block.
+ *
+ * @param[in] ctxp      pointer to the AES context, expanded for decryption
+ * @param[in] in        input block
+ * @param[out] out      output block, it can coincide with @p in
+ *
+ * @notapi
+ */
+static void aes_decrypt_block(const cryaesstate_t *ctxp,
+                              const uint8_t *in, uint8_t *out) {
+  const uint32_t *rk = ctxp->rk;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint32_t r;
+
+  s0 = GET_U32_BE(&in[0])  ^ rk[0];
+  s1 = GET_U32_BE(&in[4])  ^ rk[1];
+  s2 = GET_U32_BE(&in[8])  ^ rk[2];
+  s3 = GET_U32_BE(&in[12]) ^ rk[3];
+  for (r = 1U; r < ctxp->nr; r++) {
+    rk += 4;
+    t0 = AES_TD(s0, s3, s2, s1) ^ rk[0];
+    t1 = AES_TD(s1, s0, s3, s2) ^ rk[1];
+    t2 = AES_TD(s2, s1, s0, s3) ^ rk[2];
+    t3 = AES_TD(s3, s2, s1, s0) ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+  rk += 4;
+  t0 = AES_SB(aes_isbox, s0, s3, s2, s1) ^ rk[0];
+  t1 = AES_SB(aes_isbox, s1, s0, s3, s2) ^ rk[1];
+  t2 = AES_SB(aes_isbox, s2, s1, s0, s3) ^ rk[2];
+  t3 = AES_SB(aes_isbox, s3, s2, s1, s0) ^ rk[3];
+  PUT_U32_BE(&out[0],  t0);
+  PUT_U32_BE(&out[4],  t1);
+  PUT_U32_BE(&out[8],  t2);
+  PUT_U32_BE(&out[12], t3);
+}
+
+/**
+ * @brief   Processes a block in counter mode.
+ *
+ * @param[in] ctxp      pointer to the AES context
+ * @param[in,out] ctr   counter block, incremented after use
+ * @param[in] in        input block
+ * @param[out] out      output block, it can coincide with @p in
+ *
+ * @notapi
+ */
+static void aes_ctr_block(const cryaesstate_t *ctxp, uint8_t *ctr,
+                          const uint8_t *in, uint8_t *out) {
+  uint8_t ks[AES_BLOCK_SIZE];
+
+  aes_encrypt_block(ctxp, ctr, ks);
+  cry_inc32(ctr);
+  cry_xor(out, in, ks, AES_BLOCK_SIZE);
+}
+
+/**
+ * @brief   GHASH initialization.
+ *
+ * @param[out] gp       pointer to the GHASH context
+ * @param[in] h         the hash subkey
+ *
+ * @notapi
+ */
+static void ghash_init(cryghashstate_t *gp, const uint8_t *h) {
+  uint64_t vh, vl;
+  unsigned i, j;
+
+  vh = GET_U64_BE(&h[0]);
+  vl = GET_U64_BE(&h[8]);
+  gp->hh[0] = 0U;
+  gp->hl[0] = 0U;
+  gp->hh[8] = vh;
+  gp->hl[8] = vl;
+  for (i = 4U; i > 0U; i >>= 1) {
+    uint64_t t = (vl & 1U) * 0xE100000000000000U;
+
+    vl = (vh << 63) | (vl >> 1);
+    vh = (vh >> 1) ^ t;
+    gp->hh[i] = vh;
+    gp->hl[i] = vl;
+  }
+  for (i = 2U; i <= 8U; i <<= 1) {
+    for (j = 1U; j < i; j++) {
+      gp->hh[i + j] = gp->hh[i] ^ gp->hh[j];
+      gp->hl[i + j] = gp->hl[i] ^ gp->hl[j];
+    }
+  }
+  memset(gp->y, 0, AES_BLOCK_SIZE);
+}
+
+/**
+ * @brief   GHASH of a single block.
+ *
+ * @param[in,out] gp    pointer to the GHASH context
+ * @param[in] x         the input block
+ *
+ * @notapi
+ */
+static void ghash_update(cryghashstate_t *gp, const uint8_t *x) {
+  uint64_t zh, zl;
+  unsigned i, rem, lo, hi;
+
+  cry_xor(gp->y, gp->y, x, AES_BLOCK_SIZE);
+
+  /* Multiplication by H, four bits at time starting from the last byte.*/
+  lo = gp->y[15] & 0x0FU;
+  zh = gp->hh[lo];
+  zl = gp->hl[lo];
+  i = AES_BLOCK_SIZE;
+  do {
+    i--;
+    lo = gp->y[i] & 0x0FU;
+    hi = gp->y[i] >> 4;
+    if (i != AES_BLOCK_SIZE - 1U) {
+      rem = (unsigned)zl & 0x0FU;
+      zl = (zh << 60) | (zl >> 4);
+      zh = (zh >> 4) ^ ((uint64_t)ghash_last4[rem] << 48);
+      zh ^= gp->hh[lo];
+      zl ^= gp->hl[lo];
+    }
+    rem = (unsigned)zl & 0x0FU;
+    zl = (zh << 60) | (zl >> 4);
+    zh = (zh >> 4) ^ ((uint64_t)ghash_last4[rem] << 48);
+    zh ^= gp->hh[hi];
+    zl ^= gp->hl[hi];
+  } while (i > 0U);
+
+  PUT_U64_BE(&gp->y[0], zh);
+  PUT_U64_BE(&gp->y[8], zl);
+}
+
+/**
+ * @brief   Pads and hashes the partial GHASH block.
+ *
+ * @param[in,out] gcmp  pointer to the AES-GCM state
+ * @param[in] pos       number of valid bytes in the partial block
+ *
+ * @notapi
+ */
+static void gcm_flush(crygcmstate_t *gcmp, unsigned pos) {
+
+  memset(&gcmp->buf[pos], 0, AES_BLOCK_SIZE - pos);
+  ghash_update(&gcmp->ghash, gcmp->buf);
+}
+
+/**
+ * @brief   AES-GCM text processing.
+ *
+ * @param[in,out] gcmp  pointer to the AES-GCM state
+ * @param[in] size      size of both buffers
+ * @param[in] in        input buffer
+ * @param[out] out      output buffer, it can coincide with @p in
+ * @param[in] decrypt   @p true for decryption
+ *
+ * @notapi
+ */
+static void gcm_crypt(crygcmstate_t *gcmp, size_t size,
+                      const uint8_t *in, uint8_t *out, bool decrypt) {
+  unsigned pos;
+
+  if (size == (size_t)0) {
+    return;
+  }
+
+  /* Closing the authentication data on the first text chunk.*/
+  if ((gcmp->size == 0U) && ((gcmp->aadsize & 15U) != 0U)) {
+    gcm_flush(gcmp, (unsigned)(gcmp->aadsize & 15U));
+  }
+
+  pos = (unsigned)(gcmp->size & 15U);
+  gcmp->size += size;
+  while (size > (size_t)0) {
+    if ((pos == 0U) && (size >= AES_BLOCK_SIZE)) {
+      /* Aligned whole block.*/
+      if (decrypt) {
+        ghash_update(&gcmp->ghash, in);
+        aes_ctr_block(&gcmp->aes, gcmp->ctr, in, out);
+      }
+      else {
+        aes_ctr_block(&gcmp->aes, gcmp->ctr, in, out);
+        ghash_update(&gcmp->ghash, out);
+      }
+      in   += AES_BLOCK_SIZE;
+      out  += AES_BLOCK_SIZE;
+      size -= AES_BLOCK_SIZE;
+    }
+    else {
+      /* Partial block, the key stream and the cyphertext are buffered.*/
+      uint8_t x, y;
+
+      if (pos == 0U) {
+        aes_encrypt_block(&gcmp->aes, gcmp->ctr, gcmp->ks);
+        cry_inc32(gcmp->ctr);
+      }
+      x = *in++;
+      y = x ^ gcmp->ks[pos];
+      gcmp->buf[pos] = decrypt ? x : y;
+      *out++ = y;
+      pos = (pos + 1U) & 15U;
+      if (pos == 0U) {
+        ghash_update(&gcmp->ghash, gcmp->buf);
+      }
+      size--;
+    }
+  }
+}
+
+/**
+ * @brief   DES key schedule.
+ *
+ * @param[out] sk       the generated sub-keys
+ * @param[in] key       the 64 bits key, parity bits are ignored
+ *
+ * @notapi
+ */
+static void des_key_schedule(uint8_t sk[DES_ROUNDS][8], const uint8_t *key) {
+  uint64_t k, cd;
+  uint32_t c, d;
+  unsigned i, j, r;
+
+  k = GET_U64_BE(key);
+  c = 0U;
+  d = 0U;
+  for (i = 0U; i < 28U; i++) {
+    c = (c << 1) | (uint32_t)((k >> (64U - des_pc1[i])) & 1U);
+    d = (d << 1) | (uint32_t)((k >> (64U - des_pc1[i + 28U])) & 1U);
+  }
+
+  for (r = 0U; r < DES_ROUNDS; r++) {
+    unsigned n = des_shifts[r];
+
+    c = ((c << n) | (c >> (28U - n))) & 0x0FFFFFFFU;
+    d = ((d << n) | (d >> (28U - n))) & 0x0FFFFFFFU;
+    cd = ((uint64_t)c << 28) | (uint64_t)d;
+    for (i = 0U; i < 8U; i++) {
+      uint8_t chunk = 0U;
+
+      for (j = 0U; j < 6U; j++) {
+        chunk = (uint8_t)((chunk << 1) |
+                          ((cd >> (56U - des_pc2[(i * 6U) + j])) & 1U));
+      }
+      sk[r][i] = chunk;
+    }
+  }
+}
+
+/**
+ * @brief   Loads and expands the DES/TDES key.
+ * @note    A 16 bytes key is used as 2-keys TDES (K1, K2, K1).
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation
+ * @param[out] ctxp     pointer to the DES context
+ * @return              The operation status.
+ *
+ * @notapi
+ */
+static cryerror_t des_init(CRYDriver *cryp, crykey_t key_id,
+                           des_context_t *ctxp) {
+  const uint8_t *key = (const uint8_t *)cryp->key0_buffer;
+  cryerror_t err;
+
+  err = cry_check_key(cryp, key_id, cry_algo_des);
+  if (err == CRY_NOERROR) {
+    des_key_schedule(ctxp->sk[0], &key[0]);
+    if (cryp->key0_size == DES_BLOCK_SIZE) {
+      ctxp->stages = 1U;
+    }
+    else {
+      ctxp->stages = 3U;
+      des_key_schedule(ctxp->sk[1], &key[8]);
+      if (cryp->key0_size == DES_BLOCK_SIZE * 3U) {
+        des_key_schedule(ctxp->sk[2], &key[16]);
+      }
+      else {
+        memcpy(ctxp->sk[2], ctxp->sk[0], sizeof (ctxp->sk[0]));
+      }
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   DES round function.
+ *
+ * @param[in] r         the right half
+ * @param[in] k         the round sub-key
+ * @return              The function output.
+ *
+ * @notapi
+ */
+static uint32_t des_f(uint32_t r, const uint8_t *k) {
+
+  /* The expansion E is implicit, each S-box input is a 6 bits window
+     of the rotated right half.*/
+  return des_sp[0][(ROR32(r, 27U) ^ k[0]) & 0x3FU] ^
+         des_sp[1][(ROR32(r, 23U) ^ k[1]) & 0x3FU] ^
+         des_sp[2][(ROR32(r, 19U) ^ k[2]) & 0x3FU] ^
+         des_sp[3][(ROR32(r, 15U) ^ k[3]) & 0x3FU] ^
+         des_sp[4][(ROR32(r, 11U) ^ k[4]) & 0x3FU] ^
+         des_sp[5][(ROR32(r, 7U)  ^ k[5]) & 0x3FU] ^
+         des_sp[6][(ROR32(r, 3U)  ^ k[6]) & 0x3FU] ^
+         des_sp[7][(ROR32(r, 31U) ^ k[7]) & 0x3FU];
+}
+
+/**
+ * @brief   Processes a single DES/TDES block.
+ * @note    In TDES mode the initial and final permutations between the
+ *          stages cancel out and are omitted.
+ *
+ * @param[in] ctxp      pointer to the DES context
+ * @param[in] in        input block
+ * @param[out] out      output block, it can coincide with @p in
+ * @param[in] decrypt   @p true for decryption
+ *
+ * @notapi
+ */
+static void des_crypt_block(const des_context_t *ctxp, const uint8_t *in,
+                            uint8_t *out, bool decrypt) {
+  uint32_t l, r, t;
+  unsigned i, s;
+
+  l = GET_U32_BE(&in[0]);
+  r = GET_U32_BE(&in[4]);
+
+  /* Initial permutation.*/
+  DES_PERM(l, r, t, 4U,  0x0F0F0F0FU);
+  DES_PERM(l, r, t, 16U, 0x0000FFFFU);
+  DES_PERM(r, l, t, 2U,  0x33333333U);
+  DES_PERM(r, l, t, 8U,  0x00FF00FFU);
+  DES_PERM(l, r, t, 1U,  0x55555555U);
+
+  for (s = 0U; s < ctxp->stages; s++) {
+    const uint8_t (*sk)[8];
+    bool dec;
+
+    /* TDES is encrypt-decrypt-encrypt, the inverse is
+       decrypt-encrypt-decrypt with the keys in reverse order.*/
+    if (decrypt) {
+      sk  = ctxp->sk[ctxp->stages - 1U - s];
+      dec = (s & 1U) == 0U;
+    }
+    else {
+      sk  = ctxp->sk[s];
+      dec = (s & 1U) != 0U;
+    }
+
+    for (i = 0U; i < DES_ROUNDS; i++) {
+      t = l ^ des_f(r, sk[dec ? (DES_ROUNDS - 1U - i) : i]);
+      l = r;
+      r = t;
+    }
+
+    /* The last round does not swap the halves.*/
+    t = l;
+    l = r;
+    r = t;
+  }
+
+  /* Final permutation.*/
+  DES_PERM(l, r, t, 1U,  0x55555555U);
+  DES_PERM(r, l, t, 8U,  0x00FF00FFU);
+  DES_PERM(r, l, t, 2U,  0x33333333U);
+  DES_PERM(l, r, t, 16U, 0x0000FFFFU);
+  DES_PERM(l, r, t, 4U,  0x0F0F0F0FU);
+
+  PUT_U32_BE(&out[0], l);
+  PUT_U32_BE(&out[4], r);
+}
+
+/**
+ * @brief   SHA-1 compression function.
+ *
+ * @param[in,out] h     the intermediate hash value
+ * @param[in] data      a 64 bytes block
+ *
+ * @notapi
+ */
+static void sha1_compress(uint32_t *h, const uint8_t *data) {
+  uint32_t w[16], a, b, c, d, e, f, k, t;
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = GET_U32_BE(&data[i * 4U]);
+  }
+  a = h[0];
+  b = h[1];
+  c = h[2];
+  d = h[3];
+  e = h[4];
+  for (i = 0U; i < 80U; i++) {
+    if (i >= 16U) {
+      t = w[(i + 13U) & 15U] ^ w[(i + 8U) & 15U] ^
+          w[(i + 2U) & 15U] ^ w[i & 15U];
+      w[i & 15U] = ROR32(t, 31U);
+    }
+    if (i < 20U) {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999U;
+    }
+    else if (i < 40U) {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1U;
+    }
+    else if (i < 60U) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDCU;
+    }
+    else {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6U;
+    }
+    t = ROR32(a, 27U) + f + e + k + w[i & 15U];
+    e = d;
+    d = c;
+    c = ROR32(b, 2U);
+    b = a;
+    a = t;
+  }
+  h[0] += a;
+  h[1] += b;
+  h[2] += c;
+  h[3] += d;
+  h[4] += e;
+}
+
+/**
+ * @brief   SHA-256 compression function.
+ *
+ * @param[in,out] h     the intermediate hash value
+ * @param[in] data      a 64 bytes block
+ *
+ * @notapi
+ */
+static void sha256_compress(uint32_t *h, const uint8_t *data) {
+  uint32_t w[16], v[8], s0, s1, t1, t2;
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = GET_U32_BE(&data[i * 4U]);
+  }
+  for (i = 0U; i < 8U; i++) {
+    v[i] = h[i];
+  }
+  for (i = 0U; i < 64U; i++) {
+    if (i >= 16U) {
+      s0 = w[(i + 1U) & 15U];
+      s0 = ROR32(s0, 7U) ^ ROR32(s0, 18U) ^ (s0 >> 3);
+      s1 = w[(i + 14U) & 15U];
+      s1 = ROR32(s1, 17U) ^ ROR32(s1, 19U) ^ (s1 >> 10);
+      w[i & 15U] += s0 + w[(i + 9U) & 15U] + s1;
+    }
+    t1 = v[7] + (ROR32(v[4], 6U) ^ ROR32(v[4], 11U) ^ ROR32(v[4], 25U)) +
+         ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha256_k[i] + w[i & 15U];
+    t2 = (ROR32(v[0], 2U) ^ ROR32(v[0], 13U) ^ ROR32(v[0], 22U)) +
+         ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+    v[7] = v[6];
+    v[6] = v[5];
+    v[5] = v[4];
+    v[4] = v[3] + t1;
+    v[3] = v[2];
+    v[2] = v[1];
+    v[1] = v[0];
+    v[0] = t1 + t2;
+  }
+  for (i = 0U; i < 8U; i++) {
+    h[i] += v[i];
+  }
+}
+
+/**
+ * @brief   SHA-512 compression function.
+ *
+ * @param[in,out] h     the intermediate hash value
+ * @param[in] data      a 128 bytes block
+ *
+ * @notapi
+ */
+static void sha512_compress(uint64_t *h, const uint8_t *data) {
+  uint64_t w[16], v[8], s0, s1, t1, t2;
+  unsigned i;
+
+  for (i = 0U; i < 16U; i++) {
+    w[i] = GET_U64_BE(&data[i * 8U]);
+  }
+  for (i = 0U; i < 8U; i++) {
+    v[i] = h[i];
+  }
+  for (i = 0U; i < 80U; i++) {
+    if (i >= 16U) {
+      s0 = w[(i + 1U) & 15U];
+      s0 = ROR64(s0, 1U) ^ ROR64(s0, 8U) ^ (s0 >> 7);
+      s1 = w[(i + 14U) & 15U];
+      s1 = ROR64(s1, 19U) ^ ROR64(s1, 61U) ^ (s1 >> 6);
+      w[i & 15U] += s0 + w[(i + 9U) & 15U] + s1;
+    }
+    t1 = v[7] + (ROR64(v[4], 14U) ^ ROR64(v[4], 18U) ^ ROR64(v[4], 41U)) +
+         ((v[4] & v[5]) ^ (~v[4] & v[6])) + sha512_k[i] + w[i & 15U];
+    t2 = (ROR64(v[0], 28U) ^ ROR64(v[0], 34U) ^ ROR64(v[0], 39U)) +
+         ((v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]));
+    v[7] = v[6];
+    v[6] = v[5];
+    v[5] = v[4];
+    v[4] = v[3] + t1;
+    v[3] = v[2];
+    v[2] = v[1];
+    v[1] = v[0];
+    v[0] = t1 + t2;
+  }
+  for (i = 0U; i < 8U; i++) {
+    h[i] += v[i];
+  }
+}
+
+/**
+ * @brief   SHA-1/SHA-256 data input.
+ *
+ * @param[in,out] ctxp  pointer to the SHA context
+ * @param[in] compress  the compression function
+ * @param[in] in        input data
+ * @param[in] size      size of the input data
+ *
+ * @notapi
+ */
+static void sha32_update(crysha32state_t *ctxp, sha32_compress_t compress,
+                         const uint8_t *in, size_t size) {
+  size_t n = (size_t)(ctxp->length & 63U);
+
+  ctxp->length += size;
+  if (n > (size_t)0) {
+    size_t m = (size_t)64 - n;
+
+    if (size < m) {
+      memcpy(&ctxp->buf[n], in, size);
+      return;
+    }
+    memcpy(&ctxp->buf[n], in, m);
+    compress(ctxp->h, ctxp->buf);
+    in   += m;
+    size -= m;
+  }
+  while (size >= (size_t)64) {
+    compress(ctxp->h, in);
+    in   += 64;
+    size -= (size_t)64;
+  }
+  if (size > (size_t)0) {
+    memcpy(ctxp->buf, in, size);
+  }
+}
+
+/**
+ * @brief   SHA-1/SHA-256 padding and digest output.
+ *
+ * @param[in,out] ctxp  pointer to the SHA context
+ * @param[in] compress  the compression function
+ * @param[out] out      output buffer
+ * @param[in] words     number of digest words
+ *
+ * @notapi
+ */
+static void sha32_final(crysha32state_t *ctxp, sha32_compress_t compress,
+                        uint8_t *out, unsigned words) {
+  size_t n = (size_t)(ctxp->length & 63U);
+  unsigned i;
+
+  ctxp->buf[n++] = 0x80U;
+  if (n > (size_t)56) {
+    memset(&ctxp->buf[n], 0, (size_t)64 - n);
+    compress(ctxp->h, ctxp->buf);
+    n = (size_t)0;
+  }
+  memset(&ctxp->buf[n], 0, (size_t)56 - n);
+  PUT_U64_BE(&ctxp->buf[56], ctxp->length * 8U);
+  compress(ctxp->h, ctxp->buf);
+
+  for (i = 0U; i < words; i++) {
+    PUT_U32_BE(&out[i * 4U], ctxp->h[i]);
+  }
+}
+
+/**
+ * @brief   SHA-512 data input.
+ *
+ * @param[in,out] ctxp  pointer to the SHA context
+ * @param[in] in        input data
+ * @param[in] size      size of the input data
+ *
+ * @notapi
+ */
+static void sha64_update(crysha64state_t *ctxp,
+                         const uint8_t *in, size_t size) {
+  size_t n = (size_t)(ctxp->length & 127U);
+
+  ctxp->length += size;
+  if (n > (size_t)0) {
+    size_t m = (size_t)128 - n;
+
+    if (size < m) {
+      memcpy(&ctxp->buf[n], in, size);
+      return;
+    }
+    memcpy(&ctxp->buf[n], in, m);
+    sha512_compress(ctxp->h, ctxp->buf);
+    in   += m;
+    size -= m;
+  }
+  while (size >= (size_t)128) {
+    sha512_compress(ctxp->h, in);
+    in   += 128;
+    size -= (size_t)128;
+  }
+  if (size > (size_t)0) {
+    memcpy(ctxp->buf, in, size);
+  }
+}
+
+/**
+ * @brief   SHA-512 padding and digest output.
+ *
+ * @param[in,out] ctxp  pointer to the SHA context
+ * @param[out] out      output buffer
+ *
+ * @notapi
+ */
+static void sha64_final(crysha64state_t *ctxp, uint8_t *out) {
+  size_t n = (size_t)(ctxp->length & 127U);
+  unsigned i;
+
+  ctxp->buf[n++] = 0x80U;
+  if (n > (size_t)112) {
+    memset(&ctxp->buf[n], 0, (size_t)128 - n);
+    sha512_compress(ctxp->h, ctxp->buf);
+    n = (size_t)0;
+  }
+  memset(&ctxp->buf[n], 0, (size_t)112 - n);
+  PUT_U64_BE(&ctxp->buf[112], ctxp->length >> 61);
+  PUT_U64_BE(&ctxp->buf[120], ctxp->length * 8U);
+  sha512_compress(ctxp->h, ctxp->buf);
+
+  for (i = 0U; i < 8U; i++) {
+    PUT_U64_BE(&out[i * 8U], ctxp->h[i]);
+  }
+}
+
+/*===========================================================================*/
+/* Driver exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes the transient key for the fall-back implementation.
+ * @note    The key is copied in the driver, it is expanded on each
+ *          operation.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] algorithm the algorithm identifier
+ * @param[in] size      key size in bytes
+ * @param[in] keyp      pointer to the key data
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_ALGO     if the specified algorithm is unknown or
+ *                              unsupported.
+ * @retval CRY_ERR_INV_KEY_SIZE if the specified key size is invalid for
+ *                              the specified algorithm.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_loadkey(CRYDriver *cryp,
+                                cryalgorithm_t algorithm,
+                                size_t size,
+                                const uint8_t *keyp) {
+
+  switch (algorithm) {
+  case cry_algo_aes:
+    if ((size != 16U) && (size != 24U) && (size != 32U)) {
+      return CRY_ERR_INV_KEY_SIZE;
+    }
+    break;
+  case cry_algo_des:
+    if ((size != 8U) && (size != 16U) && (size != 24U)) {
+      return CRY_ERR_INV_KEY_SIZE;
+    }
+    break;
+  default:
+    return CRY_ERR_INV_ALGO;
+  }
+
+  memcpy(cryp->key0_buffer, keyp, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Encryption of a single block using AES.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  return cry_fallback_encrypt_AES_ECB(cryp, key_id, AES_BLOCK_SIZE, in, out);
+}
+
+/**
+ * @brief   Decryption of a single block using AES.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  return cry_fallback_decrypt_AES_ECB(cryp, key_id, AES_BLOCK_SIZE, in, out);
+}
+
+/**
+ * @brief   Encryption operation using AES-ECB.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  cryaesstate_t ctx;
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, false);
+  if (err == CRY_NOERROR) {
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      aes_encrypt_block(&ctx, &in[i], &out[i]);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-ECB.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  cryaesstate_t ctx;
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, true);
+  if (err == CRY_NOERROR) {
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      aes_decrypt_block(&ctx, &in[i], &out[i]);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Encryption operation using AES-CBC.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @param[in] iv        128 bits input vector
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  cryaesstate_t ctx;
+  uint8_t chain[AES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, false);
+  if (err == CRY_NOERROR) {
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      cry_xor(chain, chain, &in[i], AES_BLOCK_SIZE);
+      aes_encrypt_block(&ctx, chain, chain);
+      memcpy(&out[i], chain, AES_BLOCK_SIZE);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-CBC.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @param[in] iv        128 bits input vector
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  cryaesstate_t ctx;
+  uint8_t chain[AES_BLOCK_SIZE], blk[AES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, true);
+  if (err == CRY_NOERROR) {
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      aes_decrypt_block(&ctx, &in[i], blk);
+      cry_xor(blk, blk, chain, AES_BLOCK_SIZE);
+      memcpy(chain, &in[i], AES_BLOCK_SIZE);
+      memcpy(&out[i], blk, AES_BLOCK_SIZE);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Encryption operation using AES-CFB.
+ * @note    The fall-back implements CFB with 128 bits segments.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @param[in] iv        128 bits input vector
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CFB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  cryaesstate_t ctx;
+  uint8_t chain[AES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, false);
+  if (err == CRY_NOERROR) {
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      aes_encrypt_block(&ctx, chain, chain);
+      cry_xor(chain, chain, &in[i], AES_BLOCK_SIZE);
+      memcpy(&out[i], chain, AES_BLOCK_SIZE);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-CFB.
+ * @note    The fall-back implements CFB with 128 bits segments.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @param[in] iv        128 bits input vector
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CFB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  cryaesstate_t ctx;
+  uint8_t chain[AES_BLOCK_SIZE], ks[AES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, false);
+  if (err == CRY_NOERROR) {
+    memcpy(chain, iv, AES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      aes_encrypt_block(&ctx, chain, ks);
+      memcpy(chain, &in[i], AES_BLOCK_SIZE);
+      cry_xor(&out[i], ks, chain, AES_BLOCK_SIZE);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Encryption operation using AES-CTR.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_CTR(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  cryaesstate_t ctx;
+  uint8_t ctr[AES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &ctx, false);
+  if (err == CRY_NOERROR) {
+    memcpy(ctr, iv, AES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += AES_BLOCK_SIZE) {
+      aes_ctr_block(&ctx, ctr, &in[i], &out[i]);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-CTR.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of both buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_CTR(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+
+  return cry_fallback_encrypt_AES_CTR(cryp, key_id, size, in, out, iv);
+}
+
+/**
+ * @brief   Encryption operation using AES-GCM.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of the text buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @param[in] aadsize   size of the authentication data, this number must be a
+ *                      multiple of 16
+ * @param[in] aad       buffer containing the authentication data
+ * @param[out] authtag  128 bits buffer for the generated authentication tag
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_GCM(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv,
+                                        size_t aadsize,
+                                        const uint8_t *aad,
+                                        uint8_t *authtag) {
+
+  crygcmstate_t gcm;
+  cryerror_t err;
+
+  err = cry_fallback_AES_GCM_init(cryp, &gcm, key_id, iv);
+  if (err == CRY_NOERROR) {
+    (void) cry_fallback_AES_GCM_update_aad(cryp, &gcm, aadsize, aad);
+    (void) cry_fallback_encrypt_AES_GCM_update(cryp, &gcm, size, in, out);
+    (void) cry_fallback_AES_GCM_final(cryp, &gcm, authtag);
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using AES-GCM.
+ * @note    The computed authentication tag is returned, it is
+ *          responsibility of the caller to compare it with the received
+ *          one.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of the text buffers, this number must be a
+ *                      multiple of 16
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @param[in] aadsize   size of the authentication data, this number must be a
+ *                      multiple of 16
+ * @param[in] aad       buffer containing the authentication data
+ * @param[out] authtag  128 bits buffer for the generated authentication tag
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_GCM(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv,
+                                        size_t aadsize,
+                                        const uint8_t *aad,
+                                        uint8_t *authtag) {
+
+  crygcmstate_t gcm;
+  cryerror_t err;
+
+  err = cry_fallback_AES_GCM_init(cryp, &gcm, key_id, iv);
+  if (err == CRY_NOERROR) {
+    (void) cry_fallback_AES_GCM_update_aad(cryp, &gcm, aadsize, aad);
+    (void) cry_fallback_decrypt_AES_GCM_update(cryp, &gcm, size, in, out);
+    (void) cry_fallback_AES_GCM_final(cryp, &gcm, authtag);
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Incremental AES-GCM initialization.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] gcmp     pointer to the AES-GCM state
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] iv        128 bits input vector + counter, it contains
+ *                      a 96 bits IV and a 32 bits counter
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_AES_GCM_init(CRYDriver *cryp,
+                                     crygcmstate_t *gcmp,
+                                     crykey_t key_id,
+                                     const uint8_t *iv) {
+  uint8_t h[AES_BLOCK_SIZE];
+  cryerror_t err;
+
+  err = aes_init(cryp, key_id, &gcmp->aes, false);
+  if (err == CRY_NOERROR) {
+    /* Hash subkey H = E(K, 0^128).*/
+    memset(h, 0, AES_BLOCK_SIZE);
+    aes_encrypt_block(&gcmp->aes, h, h);
+    ghash_init(&gcmp->ghash, h);
+
+    /* The first counter block is reserved for the tag.*/
+    memcpy(gcmp->j0, iv, AES_BLOCK_SIZE);
+    memcpy(gcmp->ctr, iv, AES_BLOCK_SIZE);
+    cry_inc32(gcmp->ctr);
+    gcmp->aadsize = 0U;
+    gcmp->size    = 0U;
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Incremental AES-GCM authentication data input.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmp  pointer to the AES-GCM state
+ * @param[in] size      size of the authentication data
+ * @param[in] aad       buffer containing the authentication data
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_AES_GCM_update_aad(CRYDriver *cryp,
+                                           crygcmstate_t *gcmp,
+                                           size_t size,
+                                           const uint8_t *aad) {
+  unsigned pos;
+
+  (void)cryp;
+
+  osalDbgAssert(gcmp->size == 0U, "text already processed");
+
+  pos = (unsigned)(gcmp->aadsize & 15U);
+  gcmp->aadsize += size;
+  while (size > (size_t)0) {
+    if ((pos == 0U) && (size >= AES_BLOCK_SIZE)) {
+      ghash_update(&gcmp->ghash, aad);
+      aad  += AES_BLOCK_SIZE;
+      size -= AES_BLOCK_SIZE;
+    }
+    else {
+      gcmp->buf[pos++] = *aad++;
+      if (pos == AES_BLOCK_SIZE) {
+        ghash_update(&gcmp->ghash, gcmp->buf);
+        pos = 0U;
+      }
+      size--;
+    }
+  }
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Incremental AES-GCM encryption.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmp  pointer to the AES-GCM state
+ * @param[in] size      size of both buffers
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_AES_GCM_update(CRYDriver *cryp,
+                                               crygcmstate_t *gcmp,
+                                               size_t size,
+                                               const uint8_t *in,
+                                               uint8_t *out) {
+
+  (void)cryp;
+
+  gcm_crypt(gcmp, size, in, out, false);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Incremental AES-GCM decryption.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmp  pointer to the AES-GCM state
+ * @param[in] size      size of both buffers
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_AES_GCM_update(CRYDriver *cryp,
+                                               crygcmstate_t *gcmp,
+                                               size_t size,
+                                               const uint8_t *in,
+                                               uint8_t *out) {
+
+  (void)cryp;
+
+  gcm_crypt(gcmp, size, in, out, true);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Incremental AES-GCM finalization.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] gcmp  pointer to the AES-GCM state
+ * @param[out] authtag  128 bits buffer for the generated authentication tag
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_AES_GCM_final(CRYDriver *cryp,
+                                      crygcmstate_t *gcmp,
+                                      uint8_t *authtag) {
+  uint8_t blk[AES_BLOCK_SIZE];
+
+  (void)cryp;
+
+  /* Closing the last partial block, if any.*/
+  if (gcmp->size == 0U) {
+    if ((gcmp->aadsize & 15U) != 0U) {
+      gcm_flush(gcmp, (unsigned)(gcmp->aadsize & 15U));
+    }
+  }
+  else if ((gcmp->size & 15U) != 0U) {
+    gcm_flush(gcmp, (unsigned)(gcmp->size & 15U));
+  }
+
+  /* Lengths block and final tag.*/
+  PUT_U64_BE(&blk[0], gcmp->aadsize * 8U);
+  PUT_U64_BE(&blk[8], gcmp->size * 8U);
+  ghash_update(&gcmp->ghash, blk);
+  aes_encrypt_block(&gcmp->aes, gcmp->j0, blk);
+  cry_xor(authtag, blk, gcmp->ghash.y, AES_BLOCK_SIZE);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Encryption of a single block using (T)DES.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  return cry_fallback_encrypt_DES_ECB(cryp, key_id, DES_BLOCK_SIZE, in, out);
+}
+
+/**
+ * @brief   Decryption of a single block using (T)DES.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES(CRYDriver *cryp,
+                                    crykey_t key_id,
+                                    const uint8_t *in,
+                                    uint8_t *out) {
+
+  return cry_fallback_decrypt_DES_ECB(cryp, key_id, DES_BLOCK_SIZE, in, out);
+}
+
+/**
+ * @brief   Encryption operation using (T)DES-ECB.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of the plaintext buffer, this number must
+ *                      be a multiple of 8
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  des_context_t ctx;
+  size_t i;
+  cryerror_t err;
+
+  err = des_init(cryp, key_id, &ctx);
+  if (err == CRY_NOERROR) {
+    for (i = 0U; i < size; i += DES_BLOCK_SIZE) {
+      des_crypt_block(&ctx, &in[i], &out[i], false);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using (T)DES-ECB.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of the plaintext buffer, this number must
+ *                      be a multiple of 8
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES_ECB(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out) {
+  des_context_t ctx;
+  size_t i;
+  cryerror_t err;
+
+  err = des_init(cryp, key_id, &ctx);
+  if (err == CRY_NOERROR) {
+    for (i = 0U; i < size; i += DES_BLOCK_SIZE) {
+      des_crypt_block(&ctx, &in[i], &out[i], true);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Encryption operation using (T)DES-CBC.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of the plaintext buffer, this number must
+ *                      be a multiple of 8
+ * @param[in] in        buffer containing the input plaintext
+ * @param[out] out      buffer for the output cyphertext
+ * @param[in] iv        64 bits input vector
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_encrypt_DES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  des_context_t ctx;
+  uint8_t chain[DES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = des_init(cryp, key_id, &ctx);
+  if (err == CRY_NOERROR) {
+    memcpy(chain, iv, DES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += DES_BLOCK_SIZE) {
+      cry_xor(chain, chain, &in[i], DES_BLOCK_SIZE);
+      des_crypt_block(&ctx, chain, chain, false);
+      memcpy(&out[i], chain, DES_BLOCK_SIZE);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Decryption operation using (T)DES-CBC.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] key_id    the key to be used for the operation, only the
+ *                      transient key (zero) is supported
+ * @param[in] size      size of the plaintext buffer, this number must
+ *                      be a multiple of 8
+ * @param[in] in        buffer containing the input cyphertext
+ * @param[out] out      buffer for the output plaintext
+ * @param[in] iv        64 bits input vector
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ * @retval CRY_ERR_INV_KEY_TYPE the selected key is invalid for this operation.
+ * @retval CRY_ERR_INV_KEY_ID   if the specified key identifier is invalid.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_decrypt_DES_CBC(CRYDriver *cryp,
+                                        crykey_t key_id,
+                                        size_t size,
+                                        const uint8_t *in,
+                                        uint8_t *out,
+                                        const uint8_t *iv) {
+  des_context_t ctx;
+  uint8_t chain[DES_BLOCK_SIZE], blk[DES_BLOCK_SIZE];
+  size_t i;
+  cryerror_t err;
+
+  err = des_init(cryp, key_id, &ctx);
+  if (err == CRY_NOERROR) {
+    memcpy(chain, iv, DES_BLOCK_SIZE);
+    for (i = 0U; i < size; i += DES_BLOCK_SIZE) {
+      des_crypt_block(&ctx, &in[i], blk, true);
+      cry_xor(blk, blk, chain, DES_BLOCK_SIZE);
+      memcpy(chain, &in[i], DES_BLOCK_SIZE);
+      memcpy(&out[i], blk, DES_BLOCK_SIZE);
+    }
+  }
+
+  return err;
+}
+
+/**
+ * @brief   Hash using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @param[out] out      160 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1(CRYDriver *cryp, size_t size,
+                             const uint8_t *in, uint8_t *out) {
+  crysha32state_t sha;
+
+  (void) cry_fallback_SHA1_init(cryp, &sha);
+  (void) cry_fallback_SHA1_update(cryp, &sha, size, in);
+
+  return cry_fallback_SHA1_final(cryp, &sha, out);
+}
+
+/**
+ * @brief   Hash initialization using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] shap     pointer to the SHA1 state
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_init(CRYDriver *cryp, crysha32state_t *shap) {
+
+  (void)cryp;
+
+  memcpy(shap->h, sha1_h0, sizeof (sha1_h0));
+  shap->length = 0U;
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] shap  pointer to the SHA1 state
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_update(CRYDriver *cryp, crysha32state_t *shap,
+                                    size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha32_update(shap, sha1_compress, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA1.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] shap  pointer to the SHA1 state
+ * @param[out] out      160 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA1_final(CRYDriver *cryp, crysha32state_t *shap,
+                                   uint8_t *out) {
+
+  (void)cryp;
+
+  sha32_final(shap, sha1_compress, out, 5U);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @param[out] out      256 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256(CRYDriver *cryp, size_t size,
+                               const uint8_t *in, uint8_t *out) {
+  crysha32state_t sha;
+
+  (void) cry_fallback_SHA256_init(cryp, &sha);
+  (void) cry_fallback_SHA256_update(cryp, &sha, size, in);
+
+  return cry_fallback_SHA256_final(cryp, &sha, out);
+}
+
+/**
+ * @brief   Hash initialization using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] shap     pointer to the SHA256 state
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_init(CRYDriver *cryp, crysha32state_t *shap) {
+
+  (void)cryp;
+
+  memcpy(shap->h, sha256_h0, sizeof (sha256_h0));
+  shap->length = 0U;
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] shap  pointer to the SHA256 state
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_update(CRYDriver *cryp, crysha32state_t *shap,
+                                      size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha32_update(shap, sha256_compress, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA256.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] shap  pointer to the SHA256 state
+ * @param[out] out      256 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA256_final(CRYDriver *cryp, crysha32state_t *shap,
+                                     uint8_t *out) {
+
+  (void)cryp;
+
+  sha32_final(shap, sha256_compress, out, 8U);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @param[out] out      512 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512(CRYDriver *cryp, size_t size,
+                               const uint8_t *in, uint8_t *out) {
+  crysha64state_t sha;
+
+  (void) cry_fallback_SHA512_init(cryp, &sha);
+  (void) cry_fallback_SHA512_update(cryp, &sha, size, in);
+
+  return cry_fallback_SHA512_final(cryp, &sha, out);
+}
+
+/**
+ * @brief   Hash initialization using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] shap     pointer to the SHA512 state
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_init(CRYDriver *cryp, crysha64state_t *shap) {
+
+  (void)cryp;
+
+  memcpy(shap->h, sha512_h0, sizeof (sha512_h0));
+  shap->length = 0U;
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash update using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] shap  pointer to the SHA512 state
+ * @param[in] size      size of input buffer
+ * @param[in] in        buffer containing the input text
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_update(CRYDriver *cryp, crysha64state_t *shap,
+                                      size_t size, const uint8_t *in) {
+
+  (void)cryp;
+
+  sha64_update(shap, in, size);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   Hash finalization using SHA512.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[in,out] shap  pointer to the SHA512 state
+ * @param[out] out      512 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_NOERROR          if the operation succeeded.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_SHA512_final(CRYDriver *cryp, crysha64state_t *shap,
+                                     uint8_t *out) {
+
+  (void)cryp;
+
+  sha64_final(shap, out);
+
+  return CRY_NOERROR;
+}
+
+/**
+ * @brief   True random numbers generator.
+ * @note    There is no software source of true randomness, the fall-back
+ *          always fails.
+ *
+ * @param[in] cryp      pointer to the @p CRYDriver object
+ * @param[out] out      128 bits output buffer
+ * @return              The operation status.
+ * @retval CRY_ERR_INV_ALGO     the operation is unsupported.
+ *
+ * @notapi
+ */
+cryerror_t cry_fallback_TRNG(CRYDriver *cryp, uint8_t *out) {
+
+  (void)cryp;
+  (void)out;
+
+  return CRY_ERR_INV_ALGO;
+}
+
+#endif /* (HAL_USE_CRY == TRUE) && (HAL_CRY_USE_FALLBACK == TRUE) */
+
+/** @} */
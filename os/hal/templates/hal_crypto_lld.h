@@ -48,6 +48,7 @@
 #define CRY_LLD_SUPPORTS_SHA256             TRUE
 #define CRY_LLD_SUPPORTS_SHA512             TRUE
 #define CRY_LLD_SUPPORTS_TRNG               TRUE
+#define CRY_LLD_SUPPORTS_ASYNC              TRUE
 /** @{ */
 
 /*===========================================================================*/
@@ -94,6 +95,34 @@ typedef struct {
   uint32_t                  dummy;
 } CRYConfig;
 
+/**
+ * @brief   Type of a SHA1 context.
+ */
+typedef struct {
+  uint32_t                  dummy;
+} SHA1Context;
+
+/**
+ * @brief   Type of a SHA256 context.
+ */
+typedef struct {
+  uint32_t                  dummy;
+} SHA256Context;
+
+/**
+ * @brief   Type of a SHA512 context.
+ */
+typedef struct {
+  uint32_t                  dummy;
+} SHA512Context;
+
+/**
+ * @brief   Type of an incremental AES-GCM context.
+ */
+typedef struct {
+  uint32_t                  dummy;
+} AESGCMContext;
+
 /**
  * @brief   Structure representing an CRY driver.
  */
@@ -120,6 +149,16 @@ struct CRYDriver {
    */
   uint8_t                   key0_buffer[HAL_CRY_MAX_KEY_SIZE];
 #endif
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Head of the jobs queue, the first job is the active one.
+   */
+  cryjob_t                  *jqhead;
+  /**
+   * @brief   Tail of the jobs queue.
+   */
+  cryjob_t                  *jqtail;
+#endif
 #if defined(CRY_DRIVER_EXT_FIELDS)
   CRY_DRIVER_EXT_FIELDS
 #endif
@@ -220,6 +259,27 @@ extern "C" {
                                      size_t aadsize,
                                      const uint8_t *aad,
                                      uint8_t *authtag);
+  cryerror_t cry_lld_AES_GCM_init(CRYDriver *cryp,
+                                  AESGCMContext *gcmctxp,
+                                  crykey_t key_id,
+                                  const uint8_t *iv);
+  cryerror_t cry_lld_AES_GCM_update_aad(CRYDriver *cryp,
+                                        AESGCMContext *gcmctxp,
+                                        size_t size,
+                                        const uint8_t *aad);
+  cryerror_t cry_lld_encrypt_AES_GCM_update(CRYDriver *cryp,
+                                            AESGCMContext *gcmctxp,
+                                            size_t size,
+                                            const uint8_t *in,
+                                            uint8_t *out);
+  cryerror_t cry_lld_decrypt_AES_GCM_update(CRYDriver *cryp,
+                                            AESGCMContext *gcmctxp,
+                                            size_t size,
+                                            const uint8_t *in,
+                                            uint8_t *out);
+  cryerror_t cry_lld_AES_GCM_final(CRYDriver *cryp,
+                                   AESGCMContext *gcmctxp,
+                                   uint8_t *authtag);
   cryerror_t cry_lld_encrypt_DES(CRYDriver *cryp,
                                  crykey_t key_id,
                                  const uint8_t *in,
@@ -252,11 +312,29 @@ extern "C" {
                                      const uint8_t *iv);
   cryerror_t cry_lld_SHA1(CRYDriver *cryp, size_t size,
                           const uint8_t *in, uint8_t *out);
+  cryerror_t cry_lld_SHA1_init(CRYDriver *cryp, SHA1Context *sha1ctxp);
+  cryerror_t cry_lld_SHA1_update(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                 size_t size, const uint8_t *in);
+  cryerror_t cry_lld_SHA1_final(CRYDriver *cryp, SHA1Context *sha1ctxp,
+                                uint8_t *out);
   cryerror_t cry_lld_SHA256(CRYDriver *cryp, size_t size,
                             const uint8_t *in, uint8_t *out);
+  cryerror_t cry_lld_SHA256_init(CRYDriver *cryp, SHA256Context *sha256ctxp);
+  cryerror_t cry_lld_SHA256_update(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                                   size_t size, const uint8_t *in);
+  cryerror_t cry_lld_SHA256_final(CRYDriver *cryp, SHA256Context *sha256ctxp,
+                                  uint8_t *out);
   cryerror_t cry_lld_SHA512(CRYDriver *cryp, size_t size,
                             const uint8_t *in, uint8_t *out);
+  cryerror_t cry_lld_SHA512_init(CRYDriver *cryp, SHA512Context *sha512ctxp);
+  cryerror_t cry_lld_SHA512_update(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                                   size_t size, const uint8_t *in);
+  cryerror_t cry_lld_SHA512_final(CRYDriver *cryp, SHA512Context *sha512ctxp,
+                                  uint8_t *out);
   cryerror_t cry_lld_TRNG(CRYDriver *cryp, uint8_t *out);
+#if HAL_CRY_USE_ASYNC == TRUE
+  void cry_lld_start_job(CRYDriver *cryp, cryjob_t *jobp);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -152,6 +152,37 @@
  */
 #define CH_CFG_USE_HEAP                     TRUE
 
+/**
+ * @brief   TLSF heap allocator.
+ * @details If enabled the heap allocator uses a two-level segregated fit
+ *          algorithm with constant time allocation and release instead
+ *          of first-fit.
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+
+/**
+ * @brief   Default heap size classes cache.
+ * @details If enabled the small blocks of the default heap are served by
+ *          per size class memory pools fed by the heap.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP and @p CH_CFG_USE_MEMPOOLS.
+ */
+#define CH_CFG_USE_HEAP_CACHE               FALSE
+
+/**
+ * @brief   Memory allocators profiling.
+ * @details If enabled the core allocator and the heaps record allocation
+ *          counters, high-water marks, size histograms and per-thread
+ *          statistics.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MEMCORE.
+ */
+#define CH_CFG_USE_MEM_PROFILING            FALSE
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
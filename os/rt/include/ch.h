@@ -118,6 +118,7 @@ extern "C" {
 
 /* Optional subsystems headers.*/
 #include "chregistry.h"
+#include "chlocks.h"
 #include "chsem.h"
 #include "chbsem.h"
 #include "chmtx.h"
@@ -0,0 +1,252 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chlocks.h
+ * @brief   Lock profiler macros and structures.
+ *
+ * @addtogroup lock_profiling
+ * @{
+ */
+
+#ifndef CHLOCKS_H
+#define CHLOCKS_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Debug option, locks contention profiling.
+ * @details If enabled then each mutex and semaphore keeps a contention
+ *          profile measured using the realtime counter.
+ */
+#if !defined(CH_DBG_LOCK_PROFILING) || defined(__DOXYGEN__)
+#define CH_DBG_LOCK_PROFILING               FALSE
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+#if (CH_DBG_LOCK_PROFILING == TRUE) && (PORT_SUPPORTS_RT == FALSE)
+#error "CH_DBG_LOCK_PROFILING requires PORT_SUPPORTS_RT"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+#if (CH_DBG_LOCK_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Type of a lock contention profile.
+ * @note    Times are expressed in realtime counter cycles.
+ */
+typedef struct ch_lock_stats lock_stats_t;
+
+/**
+ * @brief   Structure representing a lock contention profile.
+ */
+struct ch_lock_stats {
+  /**
+   * @brief   Next registered profile.
+   */
+  lock_stats_t          *next;
+  /**
+   * @brief   Registration name or @p NULL if not registered.
+   */
+  const char            *name;
+  /**
+   * @brief   Number of acquisitions.
+   */
+  ucnt_t                n_acquire;
+  /**
+   * @brief   Number of times a thread had to wait.
+   */
+  ucnt_t                n_contended;
+  /**
+   * @brief   Number of priority inheritance boosts.
+   */
+  ucnt_t                n_boost;
+  /**
+   * @brief   Longest wait.
+   */
+  rtcnt_t               wait_max;
+  /**
+   * @brief   Longest hold.
+   * @note    Only measured for mutexes.
+   */
+  rtcnt_t               hold_max;
+  /**
+   * @brief   Start of the current hold.
+   */
+  rtcnt_t               hold_start;
+  /**
+   * @brief   Cumulative wait time.
+   */
+  rttime_t              wait_cumulative;
+};
+#endif /* CH_DBG_LOCK_PROFILING == TRUE */
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief   Data part of a static lock profile initializer.
+ */
+#define _LOCK_STATS_DATA {NULL, NULL, (ucnt_t)0, (ucnt_t)0, (ucnt_t)0,      \
+                          (rtcnt_t)0, (rtcnt_t)0, (rtcnt_t)0, (rttime_t)0}
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#if (CH_DBG_LOCK_PROFILING == TRUE) || defined(__DOXYGEN__)
+#ifdef __cplusplus
+extern "C" {
+#endif
+  void _lock_stats_init(lock_stats_t *lsp);
+  void chLockStatsRegister(lock_stats_t *lsp, const char *name);
+  void chLockStatsUnregister(lock_stats_t *lsp);
+  bool chLockStatsGet(unsigned n, lock_stats_t *dstp);
+  void chLockStatsReset(lock_stats_t *lsp);
+  void chLockStatsResetAll(void);
+#ifdef __cplusplus
+}
+#endif
+#endif /* CH_DBG_LOCK_PROFILING == TRUE */
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#if (CH_DBG_LOCK_PROFILING == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Records an acquisition.
+ * @note    The hold time measurement starts here.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ *
+ * @notapi
+ */
+static inline void _lock_stats_acquired(lock_stats_t *lsp) {
+
+  lsp->n_acquire++;
+  lsp->hold_start = chSysGetRealtimeCounterX();
+}
+
+/**
+ * @brief   Records a release.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ *
+ * @notapi
+ */
+static inline void _lock_stats_released(lock_stats_t *lsp) {
+  rtcnt_t hold = chSysGetRealtimeCounterX() - lsp->hold_start;
+
+  if (hold > lsp->hold_max) {
+    lsp->hold_max = hold;
+  }
+}
+
+/**
+ * @brief   Records a mutex passed to a waiting thread.
+ * @details The hold of the previous owner ends and the hold of the new
+ *          owner starts.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ *
+ * @notapi
+ */
+static inline void _lock_stats_handover(lock_stats_t *lsp) {
+  rtcnt_t now = chSysGetRealtimeCounterX();
+
+  if ((now - lsp->hold_start) > lsp->hold_max) {
+    lsp->hold_max = now - lsp->hold_start;
+  }
+  lsp->n_acquire++;
+  lsp->hold_start = now;
+}
+
+/**
+ * @brief   Records the start of a wait.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ * @return              The wait start time.
+ *
+ * @notapi
+ */
+static inline rtcnt_t _lock_stats_wait_start(lock_stats_t *lsp) {
+
+  lsp->n_contended++;
+
+  return chSysGetRealtimeCounterX();
+}
+
+/**
+ * @brief   Records the end of a wait.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ * @param[in] start     the wait start time
+ *
+ * @notapi
+ */
+static inline void _lock_stats_wait_end(lock_stats_t *lsp, rtcnt_t start) {
+  rtcnt_t wait = chSysGetRealtimeCounterX() - start;
+
+  lsp->wait_cumulative += (rttime_t)wait;
+  if (wait > lsp->wait_max) {
+    lsp->wait_max = wait;
+  }
+}
+
+/**
+ * @brief   Records a priority inheritance boost.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ *
+ * @notapi
+ */
+static inline void _lock_stats_boost(lock_stats_t *lsp) {
+
+  lsp->n_boost++;
+}
+
+#else /* CH_DBG_LOCK_PROFILING == FALSE */
+
+/* Stub functions for when the lock profiler is disabled. */
+#define _lock_stats_init(lsp)
+#define _lock_stats_acquired(lsp)
+#define _lock_stats_released(lsp)
+#define _lock_stats_handover(lsp)
+#define _lock_stats_wait_start(lsp) ((rtcnt_t)0)
+#define _lock_stats_wait_end(lsp, start) ((void)(start))
+#define _lock_stats_boost(lsp)
+
+#endif /* CH_DBG_LOCK_PROFILING == FALSE */
+
+#endif /* CHLOCKS_H */
+
+/** @} */
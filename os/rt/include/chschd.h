@@ -110,10 +110,41 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Virtual timers store implementation.
+ * @details If enabled the armed virtual timers are kept in a pairing heap
+ *          ordered by absolute deadline instead of the classic delta list.
+ *          Arming a timer becomes O(1) and disarming it O(log n) amortized,
+ *          the delta list requires an O(n) scan on each insertion.
+ * @note    The heap is convenient when many timers are armed at the same
+ *          time, with few timers the delta list is smaller and faster.
+ */
+#if !defined(CH_CFG_USE_TIMERS_HEAP) || defined(__DOXYGEN__)
+#define CH_CFG_USE_TIMERS_HEAP              FALSE
+#endif
+
+/**
+ * @brief   Ready list priority bitmap.
+ * @details If enabled the ready list is indexed by a bitmap of the non-empty
+ *          priority levels and by a table of pointers to the last thread of
+ *          each level. Insertion in the ready list becomes O(1) instead of
+ *          a scan of all the threads with higher or equal priority.
+ * @note    The index requires @p HIGHPRIO+1 pointers of RAM, it is
+ *          convenient when many threads are ready at the same time.
+ */
+#if !defined(CH_CFG_USE_READY_BITMAP) || defined(__DOXYGEN__)
+#define CH_CFG_USE_READY_BITMAP             FALSE
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+/**
+ * @brief   Number of 32 bits words in the ready list priority bitmap.
+ */
+#define CH_READY_BITMAP_WORDS   (((unsigned)HIGHPRIO + 32U) / 32U)
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -296,8 +327,21 @@ struct ch_thread {
 #if (CH_DBG_STATISTICS == TRUE) || defined(__DOXYGEN__)
   /**
    * @brief   Thread statistics.
+   * @details Measurement of the time spent running between context
+   *          switches, the cumulative value is the thread runtime.
    */
   time_measurement_t    stats;
+  /**
+   * @brief   Thread ready-to-run latency statistics.
+   * @details Measurement of the time spent in the ready list before being
+   *          switched in.
+   */
+  time_measurement_t    latency;
+  /**
+   * @brief   Number of times the thread has been switched out while ready.
+   * @note    This includes preemptions and voluntary yields.
+   */
+  ucnt_t                n_preempt;
 #endif
 #if defined(CH_CFG_THREAD_EXTRA_FIELDS)
   /* Extra fields defined in chconf.h.*/
@@ -305,6 +349,7 @@ struct ch_thread {
 #endif
 };
 
+#if (CH_CFG_USE_TIMERS_HEAP == FALSE) || defined(__DOXYGEN__)
 /**
  * @extends virtual_timers_list_t
  *
@@ -343,6 +388,46 @@ struct ch_virtual_timers_list {
                                                 tick event.                 */
 #endif
 };
+#else /* CH_CFG_USE_TIMERS_HEAP == TRUE */
+/**
+ * @brief   Virtual Timer descriptor structure.
+ * @note    Timers are nodes of a pairing heap, the first child of a node is
+ *          linked through @p child, the siblings are linked through
+ *          @p next. The @p prev field points to the previous sibling or to
+ *          the parent node for the first child.
+ */
+struct ch_virtual_timer {
+  virtual_timer_t       *next;      /**< @brief Next sibling in the heap.   */
+  virtual_timer_t       *prev;      /**< @brief Previous sibling or parent
+                                                node.                       */
+  virtual_timer_t       *child;     /**< @brief First child node.           */
+  uint64_t              deadline;   /**< @brief Absolute expiration time.   */
+  vtfunc_t              func;       /**< @brief Timer callback function
+                                                pointer.                    */
+  void                  *par;       /**< @brief Timer callback function
+                                                parameter.                  */
+};
+
+/**
+ * @brief   Virtual timers heap header.
+ * @note    Deadlines are expressed in a 64 bits time base that does not
+ *          wrap, the system time is extended to 64 bits each time the
+ *          timers are processed.
+ */
+struct ch_virtual_timers_list {
+  virtual_timer_t       *root;      /**< @brief Heap root, the timer with
+                                                the nearest deadline.       */
+  uint64_t              abstime;    /**< @brief Extended time of the last
+                                                tick event.                 */
+#if (CH_CFG_ST_TIMEDELTA == 0) || defined(__DOXYGEN__)
+  volatile systime_t    systime;    /**< @brief System Time counter.        */
+#endif
+#if (CH_CFG_ST_TIMEDELTA > 0) || defined(__DOXYGEN__)
+  systime_t             lasttime;   /**< @brief System time of the last
+                                                tick event.                 */
+#endif
+};
+#endif /* CH_CFG_USE_TIMERS_HEAP == TRUE */
 
 /**
  * @extends threads_queue_t
@@ -360,6 +445,22 @@ struct ch_ready_list {
   /* End of the fields shared with the thread_t structure.*/
   thread_t              *current;   /**< @brief The currently running
                                                 thread.                     */
+#if (CH_CFG_USE_READY_BITMAP == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Mask of the non-zero words in @p prmap.
+   */
+  uint32_t              prmask;
+  /**
+   * @brief   Bitmap of the priority levels having ready threads.
+   */
+  uint32_t              prmap[CH_READY_BITMAP_WORDS];
+  /**
+   * @brief   Last ready thread of each priority level.
+   * @note    Entries are only meaningful if the corresponding bit in
+   *          @p prmap is set.
+   */
+  thread_t              *prlast[HIGHPRIO + 1];
+#endif
 };
 
 /**
@@ -472,6 +573,9 @@ extern "C" {
   void chSchDoRescheduleBehind(void);
   void chSchDoRescheduleAhead(void);
   void chSchDoReschedule(void);
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  thread_t *ready_dequeue(thread_t *tp);
+#endif
 #if CH_CFG_OPTIMIZE_SPEED == FALSE
   void queue_prio_insert(thread_t *tp, threads_queue_t *tqp);
   void queue_insert(thread_t *tp, threads_queue_t *tqp);
@@ -630,6 +734,49 @@ static inline thread_t *queue_dequeue(thread_t *tp) {
 }
 #endif /* CH_CFG_OPTIMIZE_SPEED == TRUE */
 
+/**
+ * @brief   Removes the first thread from the ready list and returns it.
+ *
+ * @return              The removed thread pointer.
+ *
+ * @notapi
+ */
+static inline thread_t *ready_fifo_remove(void) {
+  thread_t *tp = queue_fifo_remove(&ch.rlist.queue);
+
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  /* If it was the only thread at its level then the level is empty now.*/
+  if (tp->queue.next->prio != tp->prio) {
+    unsigned w = (unsigned)tp->prio / 32U;
+
+    ch.rlist.prmap[w] &= ~((uint32_t)1U << ((unsigned)tp->prio % 32U));
+    if (ch.rlist.prmap[w] == 0U) {
+      ch.rlist.prmask &= ~((uint32_t)1U << w);
+    }
+  }
+#endif
+
+  return tp;
+}
+
+#if (CH_CFG_USE_READY_BITMAP == FALSE) || defined(__DOXYGEN__)
+/**
+ * @brief   Removes a thread from the ready list and returns it.
+ * @note    The thread priority can have been modified while the thread was
+ *          in the ready list, this function is meant to be used before
+ *          re-inserting the thread at its new priority level.
+ *
+ * @param[in] tp        the pointer to the thread to be removed from the list
+ * @return              The removed thread pointer.
+ *
+ * @notapi
+ */
+static inline thread_t *ready_dequeue(thread_t *tp) {
+
+  return queue_dequeue(tp);
+}
+#endif /* CH_CFG_USE_READY_BITMAP == FALSE */
+
 /**
  * @brief   Determines if the current thread must reschedule.
  * @details This function returns @p true if there is a ready thread with
@@ -38,6 +38,15 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Critical zones histograms.
+ * @details If enabled then the durations of the critical zones are also
+ *          recorded in time histograms.
+ */
+#if !defined(CH_DBG_STATISTICS_HISTOGRAMS) || defined(__DOXYGEN__)
+#define CH_DBG_STATISTICS_HISTOGRAMS        FALSE
+#endif
+
 #if CH_CFG_USE_TM == FALSE
 #error "CH_DBG_STATISTICS requires CH_CFG_USE_TM"
 #endif
@@ -60,6 +69,12 @@ typedef struct {
                                                 critical zones duration.    */
   time_measurement_t    m_crit_isr; /**< @brief Measurement of ISRs critical
                                                 zones duration.             */
+#if (CH_DBG_STATISTICS_HISTOGRAMS == TRUE) || defined(__DOXYGEN__)
+  time_histogram_t      h_crit_thd; /**< @brief Histogram of threads
+                                                critical zones duration.    */
+  time_histogram_t      h_crit_isr; /**< @brief Histogram of ISRs critical
+                                                zones duration.             */
+#endif
 } kernel_stats_t;
 
 /*===========================================================================*/
@@ -75,6 +90,7 @@ extern "C" {
 #endif
   void _stats_init(void);
   void _stats_increase_irq(void);
+  void _stats_ready(thread_t *tp);
   void _stats_ctxswc(thread_t *ntp, thread_t *otp);
   void _stats_start_measure_crit_thd(void);
   void _stats_stop_measure_crit_thd(void);
@@ -92,6 +108,7 @@ extern "C" {
 
 /* Stub functions for when the statistics module is disabled. */
 #define _stats_increase_irq()
+#define _stats_ready(tp)
 #define _stats_ctxswc(old, new)
 #define _stats_start_measure_crit_thd()
 #define _stats_stop_measure_crit_thd()
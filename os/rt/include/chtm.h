@@ -38,6 +38,24 @@
 /* Module pre-compile time settings.                                         */
 /*===========================================================================*/
 
+/**
+ * @brief   Histograms resolution.
+ * @details Each power of two range is divided in 2^N linear buckets, the
+ *          relative error of a recorded time is at most 2^-N.
+ */
+#if !defined(CH_TM_HISTOGRAM_SUB_BITS) || defined(__DOXYGEN__)
+#define CH_TM_HISTOGRAM_SUB_BITS            2
+#endif
+
+/**
+ * @brief   Histograms range.
+ * @details Times up to 2^N-1 realtime counter cycles are recorded in
+ *          their bucket, longer times are accumulated in the last bucket.
+ */
+#if !defined(CH_TM_HISTOGRAM_RANGE_BITS) || defined(__DOXYGEN__)
+#define CH_TM_HISTOGRAM_RANGE_BITS          20
+#endif
+
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
@@ -46,6 +64,22 @@
 #error "CH_CFG_USE_TM requires PORT_SUPPORTS_RT"
 #endif
 
+#if (CH_TM_HISTOGRAM_SUB_BITS < 0) || (CH_TM_HISTOGRAM_SUB_BITS > 8)
+#error "invalid CH_TM_HISTOGRAM_SUB_BITS value"
+#endif
+
+#if (CH_TM_HISTOGRAM_RANGE_BITS <= CH_TM_HISTOGRAM_SUB_BITS) ||             \
+    (CH_TM_HISTOGRAM_RANGE_BITS > 32)
+#error "invalid CH_TM_HISTOGRAM_RANGE_BITS value"
+#endif
+
+/**
+ * @brief   Number of buckets in a time histogram.
+ */
+#define CH_TM_HISTOGRAM_SIZE                                                \
+  ((CH_TM_HISTOGRAM_RANGE_BITS - CH_TM_HISTOGRAM_SUB_BITS + 1) <<           \
+   CH_TM_HISTOGRAM_SUB_BITS)
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -77,6 +111,27 @@ typedef struct {
   rttime_t              cumulative;     /**< @brief Cumulative measurement. */
 } time_measurement_t;
 
+/**
+ * @brief   Type of a Time Histogram object.
+ * @details Log-linear distribution of measured times, times below
+ *          2^CH_TM_HISTOGRAM_SUB_BITS cycles have their own bucket, above
+ *          that each power of two range is divided in
+ *          2^CH_TM_HISTOGRAM_SUB_BITS equal buckets. Recording a time is
+ *          a constant time operation and the memory is fixed.
+ * @note    A histogram is not updated atomically, concurrent updates and
+ *          readings must be serialized by the caller.
+ */
+typedef struct {
+  /**
+   * @brief   Number of recorded times.
+   */
+  ucnt_t                n;
+  /**
+   * @brief   Counters of the recorded times, one for each bucket.
+   */
+  ucnt_t                buckets[CH_TM_HISTOGRAM_SIZE];
+} time_histogram_t;
+
 /*===========================================================================*/
 /* Module macros.                                                            */
 /*===========================================================================*/
@@ -94,6 +149,19 @@ extern "C" {
   NOINLINE void chTMStopMeasurementX(time_measurement_t *tmp);
   NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
                                         time_measurement_t *tmp2);
+  void chTMHistogramObjectInit(time_histogram_t *thp);
+  void chTMHistogramRecordX(time_histogram_t *thp, rtcnt_t t);
+  NOINLINE void chTMHistogramStopMeasurementX(time_measurement_t *tmp,
+                                              time_histogram_t *thp);
+  void chTMHistogramResetI(time_histogram_t *thp);
+  void chTMHistogramReset(time_histogram_t *thp);
+  void chTMHistogramSnapshotI(const time_histogram_t *thp,
+                              time_histogram_t *dstp);
+  void chTMHistogramSnapshot(const time_histogram_t *thp,
+                             time_histogram_t *dstp);
+  rtcnt_t chTMHistogramGetBucketLimitX(unsigned i);
+  rtcnt_t chTMHistogramGetPercentileX(const time_histogram_t *thp,
+                                      unsigned permille);
 #ifdef __cplusplus
 }
 #endif
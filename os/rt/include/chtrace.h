@@ -42,25 +42,61 @@
 #define CH_TRACE_TYPE_ISR_LEAVE             3U
 #define CH_TRACE_TYPE_HALT                  4U
 #define CH_TRACE_TYPE_USER                  5U
+#define CH_TRACE_TYPE_SEM                   6U
+#define CH_TRACE_TYPE_MTX                   7U
+#define CH_TRACE_TYPE_MB                    8U
+#define CH_TRACE_TYPE_VT                    9U
+/** @} */
+
+/**
+ * @name    Object trace events
+ * @note    The event code is stored in the @p state field of the object
+ *          trace records.
+ * @{
+ */
+#define CH_TRACE_SEM_WAIT                   0U  /**< Taken, no wait.        */
+#define CH_TRACE_SEM_BLOCK                  1U  /**< Going to wait.         */
+#define CH_TRACE_SEM_SIGNAL                 2U  /**< Signaled.              */
+#define CH_TRACE_MTX_LOCK                   0U  /**< Acquired.              */
+#define CH_TRACE_MTX_BLOCK                  1U  /**< Going to wait owner.   */
+#define CH_TRACE_MTX_UNLOCK                 2U  /**< Released.              */
+#define CH_TRACE_MB_POST                    0U  /**< Message posted.        */
+#define CH_TRACE_MB_FETCH                   1U  /**< Message fetched.       */
+#define CH_TRACE_MB_FULL                    2U  /**< Poster going to wait.  */
+#define CH_TRACE_MB_EMPTY                   3U  /**< Fetcher going to wait. */
+#define CH_TRACE_VT_SET                     0U  /**< Timer armed.           */
+#define CH_TRACE_VT_FIRE                    1U  /**< Timer callback.        */
 /** @} */
 
 /**
  * @name    Events to trace
  * @{
  */
-#define CH_DBG_TRACE_MASK_DISABLED          255U
+#define CH_DBG_TRACE_MASK_DISABLED          65535U
 #define CH_DBG_TRACE_MASK_NONE              0U
 #define CH_DBG_TRACE_MASK_SWITCH            1U
 #define CH_DBG_TRACE_MASK_ISR               2U
 #define CH_DBG_TRACE_MASK_HALT              4U
 #define CH_DBG_TRACE_MASK_USER              8U
+#define CH_DBG_TRACE_MASK_SEM               16U
+#define CH_DBG_TRACE_MASK_MTX               32U
+#define CH_DBG_TRACE_MASK_MB                64U
+#define CH_DBG_TRACE_MASK_VT                128U
 #define CH_DBG_TRACE_MASK_SLOW              (CH_DBG_TRACE_MASK_SWITCH |     \
                                              CH_DBG_TRACE_MASK_HALT |       \
                                              CH_DBG_TRACE_MASK_USER)
 #define CH_DBG_TRACE_MASK_ALL               (CH_DBG_TRACE_MASK_SWITCH |     \
                                              CH_DBG_TRACE_MASK_ISR |        \
                                              CH_DBG_TRACE_MASK_HALT |       \
-                                             CH_DBG_TRACE_MASK_USER)
+                                             CH_DBG_TRACE_MASK_USER |       \
+                                             CH_DBG_TRACE_MASK_SEM |        \
+                                             CH_DBG_TRACE_MASK_MTX |        \
+                                             CH_DBG_TRACE_MASK_MB |         \
+                                             CH_DBG_TRACE_MASK_VT)
+#define CH_DBG_TRACE_MASK_OBJECTS           (CH_DBG_TRACE_MASK_SEM |        \
+                                             CH_DBG_TRACE_MASK_MTX |        \
+                                             CH_DBG_TRACE_MASK_MB |         \
+                                             CH_DBG_TRACE_MASK_VT)
 /** @} */
 
 /*===========================================================================*/
@@ -72,7 +108,9 @@
  * @{
  */
 /**
- * @brief   Trace buffer entries.
+ * @brief   Trace events mask.
+ * @note    Object events not enabled here are removed at compile time and
+ *          cannot be resumed using @p chDbgResumeTrace().
  */
 #if !defined(CH_DBG_TRACE_MASK) || defined(__DOXYGEN__)
 #define CH_DBG_TRACE_MASK                   CH_DBG_TRACE_MASK_DISABLED
@@ -86,12 +124,27 @@
 #if !defined(CH_DBG_TRACE_BUFFER_SIZE) || defined(__DOXYGEN__)
 #define CH_DBG_TRACE_BUFFER_SIZE            128
 #endif
+
+/**
+ * @brief   Trace buffer streaming mode.
+ * @details If enabled the trace buffer works as a queue drained by a
+ *          consumer using @p chDbgFetchTrace(), unread records are never
+ *          overwritten. New records are dropped and counted when the
+ *          buffer is full.
+ */
+#if !defined(CH_DBG_TRACE_STREAM) || defined(__DOXYGEN__)
+#define CH_DBG_TRACE_STREAM                 FALSE
+#endif
 /** @} */
 
 /*===========================================================================*/
 /* Derived constants and error checks.                                       */
 /*===========================================================================*/
 
+#if (CH_DBG_TRACE_STREAM == TRUE) && (CH_DBG_TRACE_BUFFER_SIZE < 2)
+#error "CH_DBG_TRACE_STREAM requires at least two trace buffer entries"
+#endif
+
 /*===========================================================================*/
 /* Module data structures and types.                                         */
 /*===========================================================================*/
@@ -105,11 +158,11 @@ typedef struct {
   /**
    * @brief   Record type.
    */
-  uint32_t              type:3;
+  uint32_t              type:4;
   /**
-   * @brief   Switched out thread state.
+   * @brief   Switched out thread state or object event code.
    */
-  uint32_t              state:5;
+  uint32_t              state:4;
   /**
    * @brief   Accurate time stamp.
    * @note    This field only available if the post supports
@@ -165,6 +218,45 @@ typedef struct {
        */
       void                  *up2;
     } user;
+    /**
+     * @brief   Structure representing a semaphore or mutex event.
+     */
+    struct {
+      /**
+       * @brief   Semaphore or mutex.
+       */
+      void                  *objp;
+      /**
+       * @brief   Woken thread or mutex owner, can be @p NULL.
+       */
+      thread_t              *tp;
+    } sync;
+    /**
+     * @brief   Structure representing a mailbox event.
+     */
+    struct {
+      /**
+       * @brief   Mailbox.
+       */
+      void                  *mbp;
+      /**
+       * @brief   Posted or fetched message.
+       */
+      msg_t                 msg;
+    } mb;
+    /**
+     * @brief   Structure representing a virtual timer event.
+     */
+    struct {
+      /**
+       * @brief   Virtual timer.
+       */
+      virtual_timer_t       *vtp;
+      /**
+       * @brief   Timer callback function.
+       */
+      vtfunc_t              vtfunc;
+    } vt;
   } u;
 } ch_trace_event_t;
 /*lint -restore*/
@@ -185,6 +277,18 @@ typedef struct {
    * @brief   Pointer to the buffer front.
    */
   ch_trace_event_t      *ptr;
+#if (CH_DBG_TRACE_STREAM == TRUE) || defined(__DOXYGEN__)
+  /**
+   * @brief   Pointer to the first unread record.
+   * @note    The buffer is empty when it is equal to @p ptr, the record
+   *          pointed by @p ptr is never part of the queue.
+   */
+  ch_trace_event_t      *rdptr;
+  /**
+   * @brief   Number of records dropped because the buffer was full.
+   */
+  ucnt_t                lost;
+#endif
   /**
    * @brief   Ring buffer.
    */
@@ -223,6 +327,53 @@ typedef struct {
 #endif
 #endif /* CH_DBG_TRACE_MASK == CH_DBG_TRACE_MASK_DISABLED */
 
+/* Object events are checked inline against the suspended mask, the call
+   is only performed when the event is actually recorded.*/
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_SEM) != 0U)
+#define _trace_sem(event, sp, tp) do {                                      \
+  if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_SEM) == 0U) {      \
+    _trace_sync(CH_TRACE_TYPE_SEM, (event), (sp), (tp));                    \
+  }                                                                         \
+} while (false)
+#endif
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_MTX) != 0U)
+#define _trace_mtx(event, mp, tp) do {                                      \
+  if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_MTX) == 0U) {      \
+    _trace_sync(CH_TRACE_TYPE_MTX, (event), (mp), (tp));                    \
+  }                                                                         \
+} while (false)
+#endif
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_MB) != 0U)
+#define _trace_mb(event, mbp, msg) do {                                     \
+  if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_MB) == 0U) {       \
+    _trace_mailbox((event), (mbp), (msg));                                  \
+  }                                                                         \
+} while (false)
+#endif
+#if (CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED) &&                    \
+    ((CH_DBG_TRACE_MASK & CH_DBG_TRACE_MASK_VT) != 0U)
+#define _trace_vt(event, vtp, vtfunc) do {                                  \
+  if ((ch.dbg.trace_buffer.suspended & CH_DBG_TRACE_MASK_VT) == 0U) {       \
+    _trace_timer((event), (vtp), (vtfunc));                                 \
+  }                                                                         \
+} while (false)
+#endif
+#if !defined(_trace_sem)
+#define _trace_sem(event, sp, tp)
+#endif
+#if !defined(_trace_mtx)
+#define _trace_mtx(event, mp, tp)
+#endif
+#if !defined(_trace_mb)
+#define _trace_mb(event, mbp, msg)
+#endif
+#if !defined(_trace_vt)
+#define _trace_vt(event, vtp, vtfunc)
+#endif
+
 /*===========================================================================*/
 /* External declarations.                                                    */
 /*===========================================================================*/
@@ -236,12 +387,20 @@ extern "C" {
   void _trace_isr_enter(const char *isr);
   void _trace_isr_leave(const char *isr);
   void _trace_halt(const char *reason);
+  void _trace_sync(uint8_t type, uint8_t event, void *objp, thread_t *tp);
+  void _trace_mailbox(uint8_t event, void *mbp, msg_t msg);
+  void _trace_timer(uint8_t event, virtual_timer_t *vtp, vtfunc_t vtfunc);
   void chDbgWriteTraceI(void *up1, void *up2);
   void chDbgWriteTrace(void *up1, void *up2);
   void chDbgSuspendTraceI(uint16_t mask);
   void chDbgSuspendTrace(uint16_t mask);
   void chDbgResumeTraceI(uint16_t mask);
   void chDbgResumeTrace(uint16_t mask);
+#if CH_DBG_TRACE_STREAM == TRUE
+  size_t chDbgFetchTraceI(ch_trace_event_t *tep, size_t n);
+  size_t chDbgFetchTrace(ch_trace_event_t *tep, size_t n);
+  ucnt_t chDbgGetTraceLostX(void);
+#endif
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 #ifdef __cplusplus
 }
@@ -75,6 +75,9 @@ extern "C" {
   void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
                   vtfunc_t vtfunc, void *par);
   void chVTDoResetI(virtual_timer_t *vtp);
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
+  void _vt_heap_tick(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -210,6 +213,27 @@ static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
 
   chDbgCheckClassI();
 
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
+  if (ch.vtlist.root == NULL) {
+    return false;
+  }
+
+  if (timep != NULL) {
+#if CH_CFG_ST_TIMEDELTA == 0
+    *timep = (sysinterval_t)(ch.vtlist.root->deadline - ch.vtlist.abstime);
+#else
+    uint64_t abstime = ch.vtlist.abstime +
+                       (uint64_t)chVTTimeElapsedSinceX(ch.vtlist.lasttime);
+
+    *timep = (sysinterval_t)CH_CFG_ST_TIMEDELTA;
+    if (ch.vtlist.root->deadline > abstime) {
+      *timep += (sysinterval_t)(ch.vtlist.root->deadline - abstime);
+    }
+#endif
+  }
+
+  return true;
+#else /* CH_CFG_USE_TIMERS_HEAP == FALSE */
   if (&ch.vtlist == (virtual_timers_list_t *)ch.vtlist.next) {
     return false;
   }
@@ -226,6 +250,7 @@ static inline bool chVTGetTimersStateI(sysinterval_t *timep) {
   }
 
   return true;
+#endif /* CH_CFG_USE_TIMERS_HEAP == FALSE */
 }
 
 /**
@@ -371,7 +396,18 @@ static inline void chVTDoTickI(void) {
 
   chDbgCheckClassI();
 
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
 #if CH_CFG_ST_TIMEDELTA == 0
+  ch.vtlist.systime++;
+  ch.vtlist.abstime++;
+  if ((ch.vtlist.root != NULL) &&
+      (ch.vtlist.root->deadline <= ch.vtlist.abstime)) {
+    _vt_heap_tick();
+  }
+#else
+  _vt_heap_tick();
+#endif
+#elif CH_CFG_ST_TIMEDELTA == 0
   ch.vtlist.systime++;
   if (&ch.vtlist != (virtual_timers_list_t *)ch.vtlist.next) {
     /* The list is not empty, processing elements on top.*/
@@ -385,6 +421,7 @@ static inline void chVTDoTickI(void) {
       vtp->func = NULL;
       vtp->next->prev = (virtual_timer_t *)&ch.vtlist;
       ch.vtlist.next = vtp->next;
+      _trace_vt(CH_TRACE_VT_FIRE, vtp, fn);
       chSysUnlockFromISR();
       fn(vtp->par);
       chSysLockFromISR();
@@ -428,6 +465,8 @@ static inline void chVTDoTickI(void) {
         port_timer_stop_alarm();
       }
 
+      _trace_vt(CH_TRACE_VT_FIRE, vtp, fn);
+
       /* The callback is invoked outside the kernel critical zone.*/
       chSysUnlockFromISR();
       fn(vtp->par);
@@ -24,6 +24,9 @@ endif
 ifneq ($(findstring CH_CFG_USE_REGISTRY TRUE,$(CHCONF)),)
 KERNSRC += $(CHIBIOS)/os/rt/src/chregistry.c
 endif
+ifneq ($(findstring CH_DBG_LOCK_PROFILING TRUE,$(CHCONF)),)
+KERNSRC += $(CHIBIOS)/os/rt/src/chlocks.c
+endif
 ifneq ($(findstring CH_CFG_USE_SEMAPHORES TRUE,$(CHCONF)),)
 KERNSRC += $(CHIBIOS)/os/rt/src/chsem.c
 endif
@@ -67,6 +70,7 @@ KERNSRC := $(CHIBIOS)/os/rt/src/chsys.c \
            $(CHIBIOS)/os/rt/src/chtm.c \
            $(CHIBIOS)/os/rt/src/chstats.c \
            $(CHIBIOS)/os/rt/src/chregistry.c \
+           $(CHIBIOS)/os/rt/src/chlocks.c \
            $(CHIBIOS)/os/rt/src/chsem.c \
            $(CHIBIOS)/os/rt/src/chmtx.c \
            $(CHIBIOS)/os/rt/src/chcond.c \
@@ -0,0 +1,218 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio.
+
+    This file is part of ChibiOS.
+
+    ChibiOS is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 3 of the License, or
+    (at your option) any later version.
+
+    ChibiOS is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * @file    chlocks.c
+ * @brief   Lock profiler code.
+ *
+ * @addtogroup lock_profiling
+ * @details Mutexes and semaphores contention profiling.<br>
+ *          Each mutex and semaphore embeds a @p lock_stats_t structure
+ *          updated by the kernel, the profiles of interest can be
+ *          registered by name in order to be enumerated at runtime, for
+ *          example by a shell command.
+ * @pre     In order to use the lock profiler the @p CH_DBG_LOCK_PROFILING
+ *          option must be enabled in @p chconf.h.
+ * @{
+ */
+
+#include "ch.h"
+
+#if (CH_DBG_LOCK_PROFILING == TRUE) || defined(__DOXYGEN__)
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   List of the registered lock profiles.
+ */
+static lock_stats_t *locks_list;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief   Clears the counters of a lock profile.
+ *
+ * @param[out] lsp      pointer to the lock profile
+ */
+static void locks_clear(lock_stats_t *lsp) {
+
+  lsp->n_acquire       = (ucnt_t)0;
+  lsp->n_contended     = (ucnt_t)0;
+  lsp->n_boost         = (ucnt_t)0;
+  lsp->wait_max        = (rtcnt_t)0;
+  lsp->hold_max        = (rtcnt_t)0;
+  lsp->wait_cumulative = (rttime_t)0;
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Initializes a lock profile.
+ * @note    Internal use only, it is invoked by the objects initializers.
+ *
+ * @param[out] lsp      pointer to the lock profile
+ *
+ * @notapi
+ */
+void _lock_stats_init(lock_stats_t *lsp) {
+
+  lsp->next       = NULL;
+  lsp->name       = NULL;
+  lsp->hold_start = (rtcnt_t)0;
+  locks_clear(lsp);
+}
+
+/**
+ * @brief   Registers a lock profile by name.
+ * @details The profile is added to the list of the profiles enumerated by
+ *          @p chLockStatsGet().
+ * @note    The profile must be unregistered before the object containing
+ *          it goes out of scope.
+ *
+ * @param[in] lsp       pointer to the lock profile, for example
+ *                      <tt>&mtx.stats</tt>
+ * @param[in] name      name of the lock, the string is not copied
+ *
+ * @api
+ */
+void chLockStatsRegister(lock_stats_t *lsp, const char *name) {
+
+  chDbgCheck((lsp != NULL) && (name != NULL));
+
+  chSysLock();
+  chDbgAssert(lsp->name == NULL, "already registered");
+  lsp->name = name;
+  lsp->next = locks_list;
+  locks_list = lsp;
+  chSysUnlock();
+}
+
+/**
+ * @brief   Unregisters a lock profile.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ *
+ * @api
+ */
+void chLockStatsUnregister(lock_stats_t *lsp) {
+  lock_stats_t **lspp;
+
+  chDbgCheck(lsp != NULL);
+
+  chSysLock();
+  lspp = &locks_list;
+  while (*lspp != NULL) {
+    if (*lspp == lsp) {
+      *lspp = lsp->next;
+      lsp->next = NULL;
+      lsp->name = NULL;
+      break;
+    }
+    lspp = &(*lspp)->next;
+  }
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns a copy of a registered lock profile.
+ * @details The registered profiles are enumerated by index, the copy is
+ *          taken atomically.
+ *
+ * @param[in] n         index of the profile, zero is the most recently
+ *                      registered one
+ * @param[out] dstp     pointer to the copy
+ * @return              The operation status.
+ * @retval false        if there is no profile with index @p n.
+ * @retval true         if the profile has been copied.
+ *
+ * @api
+ */
+bool chLockStatsGet(unsigned n, lock_stats_t *dstp) {
+  lock_stats_t *lsp;
+
+  chDbgCheck(dstp != NULL);
+
+  chSysLock();
+  lsp = locks_list;
+  while ((lsp != NULL) && (n > 0U)) {
+    lsp = lsp->next;
+    n--;
+  }
+  if (lsp != NULL) {
+    *dstp = *lsp;
+  }
+  chSysUnlock();
+
+  return lsp != NULL;
+}
+
+/**
+ * @brief   Resets the counters of a lock profile.
+ *
+ * @param[in] lsp       pointer to the lock profile
+ *
+ * @api
+ */
+void chLockStatsReset(lock_stats_t *lsp) {
+
+  chDbgCheck(lsp != NULL);
+
+  chSysLock();
+  locks_clear(lsp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Resets the counters of all the registered lock profiles.
+ *
+ * @api
+ */
+void chLockStatsResetAll(void) {
+  lock_stats_t *lsp;
+
+  chSysLock();
+  lsp = locks_list;
+  while (lsp != NULL) {
+    locks_clear(lsp);
+    lsp = lsp->next;
+  }
+  chSysUnlock();
+}
+
+#endif /* CH_DBG_LOCK_PROFILING == TRUE */
+
+/** @} */
@@ -109,6 +109,7 @@ void chMtxObjectInit(mutex_t *mp) {
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   mp->cnt = (cnt_t)0;
 #endif
+  _lock_stats_init(&mp->stats);
 }
 
 /**
@@ -159,12 +160,17 @@ void chMtxLockS(mutex_t *mp) {
          boosting the priority of all the affected threads to equal the
          priority of the running thread requesting the mutex.*/
       thread_t *tp = mp->owner;
+      rtcnt_t start;
+
+      _trace_mtx(CH_TRACE_MTX_BLOCK, mp, tp);
+      start = _lock_stats_wait_start(&mp->stats);
 
       /* Does the running thread have higher priority than the mutex
          owning thread? */
       while (tp->prio < ctp->prio) {
         /* Make priority of thread tp match the running thread's priority.*/
         tp->prio = ctp->prio;
+        _lock_stats_boost(&mp->stats);
 
         /* The following states need priority queues reordering.*/
         switch (tp->state) {
@@ -199,7 +205,7 @@ void chMtxLockS(mutex_t *mp) {
           tp->state = CH_STATE_CURRENT;
 #endif
           /* Re-enqueues tp with its new priority on the ready list.*/
-          (void) chSchReadyI(queue_dequeue(tp));
+          (void) chSchReadyI(ready_dequeue(tp));
           break;
         default:
           /* Nothing to do for other states.*/
@@ -212,6 +218,8 @@ void chMtxLockS(mutex_t *mp) {
       queue_prio_insert(ctp, &mp->queue);
       ctp->u.wtmtxp = mp;
       chSchGoSleepS(CH_STATE_WTMTX);
+      _trace_mtx(CH_TRACE_MTX_LOCK, mp, NULL);
+      _lock_stats_wait_end(&mp->stats, start);
 
       /* It is assumed that the thread performing the unlock operation assigns
          the mutex to this thread.*/
@@ -232,6 +240,8 @@ void chMtxLockS(mutex_t *mp) {
     mp->owner = ctp;
     mp->next = ctp->mtxlist;
     ctp->mtxlist = mp;
+    _trace_mtx(CH_TRACE_MTX_LOCK, mp, NULL);
+    _lock_stats_acquired(&mp->stats);
   }
 }
 
@@ -305,6 +315,8 @@ bool chMtxTryLockS(mutex_t *mp) {
   mp->owner = currp;
   mp->next = currp->mtxlist;
   currp->mtxlist = mp;
+  _trace_mtx(CH_TRACE_MTX_LOCK, mp, NULL);
+  _lock_stats_acquired(&mp->stats);
   return true;
 }
 
@@ -375,6 +387,8 @@ void chMtxUnlock(mutex_t *mp) {
       mp->owner = tp;
       mp->next = tp->mtxlist;
       tp->mtxlist = mp;
+      _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, tp);
+      _lock_stats_handover(&mp->stats);
 
       /* Note, not using chSchWakeupS() becuase that function expects the
          current thread to have the higher or equal priority than the ones
@@ -385,6 +399,8 @@ void chMtxUnlock(mutex_t *mp) {
     }
     else {
       mp->owner = NULL;
+      _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, NULL);
+      _lock_stats_released(&mp->stats);
     }
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   }
@@ -461,10 +477,14 @@ void chMtxUnlockS(mutex_t *mp) {
       mp->owner = tp;
       mp->next = tp->mtxlist;
       tp->mtxlist = mp;
+      _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, tp);
+      _lock_stats_handover(&mp->stats);
       (void) chSchReadyI(tp);
     }
     else {
       mp->owner = NULL;
+      _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, NULL);
+      _lock_stats_released(&mp->stats);
     }
 #if CH_CFG_USE_MUTEXES_RECURSIVE == TRUE
   }
@@ -498,6 +518,8 @@ void chMtxUnlockAllS(void) {
       mp->owner = tp;
       mp->next = tp->mtxlist;
       tp->mtxlist = mp;
+      _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, tp);
+      _lock_stats_handover(&mp->stats);
       (void) chSchReadyI(tp);
     }
     else {
@@ -505,6 +527,8 @@ void chMtxUnlockAllS(void) {
       mp->cnt = (cnt_t)0;
 #endif
       mp->owner = NULL;
+      _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, NULL);
+      _lock_stats_released(&mp->stats);
     }
   }
   ctp->prio = ctp->realprio;
@@ -537,6 +561,8 @@ void chMtxUnlockAll(void) {
         mp->owner = tp;
         mp->next = tp->mtxlist;
         tp->mtxlist = mp;
+        _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, tp);
+        _lock_stats_handover(&mp->stats);
         (void) chSchReadyI(tp);
       }
       else {
@@ -544,6 +570,8 @@ void chMtxUnlockAll(void) {
         mp->cnt = (cnt_t)0;
 #endif
         mp->owner = NULL;
+        _trace_mtx(CH_TRACE_MTX_UNLOCK, mp, NULL);
+        _lock_stats_released(&mp->stats);
       }
     } while (ctp->mtxlist != NULL);
     ctp->prio = ctp->realprio;
@@ -53,6 +53,119 @@ ch_system_t ch;
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_READY_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the index of the least significant bit set in a word.
+ *
+ * @param[in] w         the word, it must be different from zero
+ * @return              The bit index.
+ */
+static unsigned sch_lsb(uint32_t w) {
+
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctz(w);
+#else
+  static const uint8_t debruijn[32] = {
+    0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,
+    8U,  31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,
+    10U, 9U
+  };
+
+  return (unsigned)debruijn[((w & (0U - w)) * 0x077CB531U) >> 27];
+#endif
+}
+
+/**
+ * @brief   Marks a priority level as non-empty.
+ *
+ * @param[in] prio      the priority level
+ */
+static void sch_prmap_set(tprio_t prio) {
+  unsigned w = (unsigned)prio / 32U;
+
+  ch.rlist.prmap[w] |= (uint32_t)1U << ((unsigned)prio % 32U);
+  ch.rlist.prmask   |= (uint32_t)1U << w;
+}
+
+/**
+ * @brief   Marks a priority level as empty.
+ *
+ * @param[in] prio      the priority level
+ */
+static void sch_prmap_clear(tprio_t prio) {
+  unsigned w = (unsigned)prio / 32U;
+
+  ch.rlist.prmap[w] &= ~((uint32_t)1U << ((unsigned)prio % 32U));
+  if (ch.rlist.prmap[w] == 0U) {
+    ch.rlist.prmask &= ~((uint32_t)1U << w);
+  }
+}
+
+/**
+ * @brief   Checks if a priority level is non-empty.
+ *
+ * @param[in] prio      the priority level
+ * @return              The level state.
+ */
+static bool sch_prmap_test(tprio_t prio) {
+
+  return (ch.rlist.prmap[(unsigned)prio / 32U] &
+          ((uint32_t)1U << ((unsigned)prio % 32U))) != 0U;
+}
+
+/**
+ * @brief   Finds the lowest non-empty priority level above the specified
+ *          one.
+ *
+ * @param[in] prio      the priority level
+ * @return              The found priority level.
+ * @retval NOPRIO       if there are no ready threads above @p prio.
+ */
+static tprio_t sch_prmap_above(tprio_t prio) {
+  unsigned w;
+  uint32_t m;
+
+  if (prio >= HIGHPRIO) {
+    return NOPRIO;
+  }
+  prio++;
+
+  /* Searching in the word containing the level.*/
+  w = (unsigned)prio / 32U;
+  m = ch.rlist.prmap[w] & ((uint32_t)0xFFFFFFFFU << ((unsigned)prio % 32U));
+  if (m != 0U) {
+    return (tprio_t)((w * 32U) + sch_lsb(m));
+  }
+
+  /* Searching in the following words.*/
+  m = ch.rlist.prmask & ~(((uint32_t)2U << w) - 1U);
+  if (m == 0U) {
+    return NOPRIO;
+  }
+  w = sch_lsb(m);
+
+  return (tprio_t)((w * 32U) + sch_lsb(ch.rlist.prmap[w]));
+}
+
+/**
+ * @brief   Returns the ready list element behind which a thread entering
+ *          the specified priority level ahead of its peers must be inserted.
+ *
+ * @param[in] prio      the priority level
+ * @return              The last thread with higher priority or the ready
+ *                      list header.
+ */
+static thread_t *sch_ready_ahead_of(tprio_t prio) {
+  tprio_t hp = sch_prmap_above(prio);
+
+  if (hp == NOPRIO) {
+    return (thread_t *)&ch.rlist.queue;
+  }
+
+  return ch.rlist.prlast[hp];
+}
+#endif /* CH_CFG_USE_READY_BITMAP == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -66,6 +179,16 @@ void _scheduler_init(void) {
 
   queue_init(&ch.rlist.queue);
   ch.rlist.prio = NOPRIO;
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  {
+    unsigned i;
+
+    ch.rlist.prmask = 0U;
+    for (i = 0U; i < CH_READY_BITMAP_WORDS; i++) {
+      ch.rlist.prmap[i] = 0U;
+    }
+  }
+#endif
 #if CH_CFG_USE_REGISTRY == TRUE
   ch.rlist.newer = (thread_t *)&ch.rlist;
   ch.rlist.older = (thread_t *)&ch.rlist;
@@ -199,6 +322,42 @@ thread_t *list_remove(threads_list_t *tlp) {
 }
 #endif /* CH_CFG_OPTIMIZE_SPEED */
 
+#if (CH_CFG_USE_READY_BITMAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Removes a thread from the ready list and returns it.
+ * @note    The thread priority can have been modified while the thread was
+ *          in the ready list, the priority level the thread was queued at is
+ *          deduced from its neighbors.
+ *
+ * @param[in] tp        the pointer to the thread to be removed from the list
+ * @return              The removed thread pointer.
+ *
+ * @notapi
+ */
+thread_t *ready_dequeue(thread_t *tp) {
+  thread_t *prev = tp->queue.prev;
+  tprio_t prio;
+
+  (void) queue_dequeue(tp);
+
+  /* If the thread was the last of a level also containing the previous
+     thread then the previous thread becomes the last.*/
+  if (sch_prmap_test(prev->prio) && (ch.rlist.prlast[prev->prio] == tp)) {
+    ch.rlist.prlast[prev->prio] = prev;
+    return tp;
+  }
+
+  /* If the thread was alone at its level then that level is the first
+     non-empty level above the next thread.*/
+  prio = sch_prmap_above(tp->queue.next->prio);
+  if ((prio != NOPRIO) && (ch.rlist.prlast[prio] == tp)) {
+    sch_prmap_clear(prio);
+  }
+
+  return tp;
+}
+#endif /* CH_CFG_USE_READY_BITMAP == TRUE */
+
 /**
  * @brief   Inserts a thread in the Ready List placing it behind its peers.
  * @details The thread is positioned behind all threads with higher or equal
@@ -225,6 +384,24 @@ thread_t *chSchReadyI(thread_t *tp) {
               "invalid state");
 
   tp->state = CH_STATE_READY;
+  _stats_ready(tp);
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  /* Insertion behind the last thread with higher or equal priority.*/
+  if (sch_prmap_test(tp->prio)) {
+    cp = ch.rlist.prlast[tp->prio];
+  }
+  else {
+    cp = sch_ready_ahead_of(tp->prio);
+    sch_prmap_set(tp->prio);
+  }
+  ch.rlist.prlast[tp->prio] = tp;
+
+  /* Insertion on next.*/
+  tp->queue.prev             = cp;
+  tp->queue.next             = cp->queue.next;
+  tp->queue.next->queue.prev = tp;
+  cp->queue.next             = tp;
+#else /* CH_CFG_USE_READY_BITMAP == FALSE */
   cp = (thread_t *)&ch.rlist.queue;
   do {
     cp = cp->queue.next;
@@ -234,6 +411,7 @@ thread_t *chSchReadyI(thread_t *tp) {
   tp->queue.prev             = cp->queue.prev;
   tp->queue.prev->queue.next = tp;
   cp->queue.prev             = tp;
+#endif /* CH_CFG_USE_READY_BITMAP == FALSE */
 
   return tp;
 }
@@ -264,6 +442,21 @@ thread_t *chSchReadyAheadI(thread_t *tp) {
               "invalid state");
 
   tp->state = CH_STATE_READY;
+  _stats_ready(tp);
+#if CH_CFG_USE_READY_BITMAP == TRUE
+  /* Insertion behind the last thread with higher priority.*/
+  cp = sch_ready_ahead_of(tp->prio);
+  if (!sch_prmap_test(tp->prio)) {
+    sch_prmap_set(tp->prio);
+    ch.rlist.prlast[tp->prio] = tp;
+  }
+
+  /* Insertion on next.*/
+  tp->queue.prev             = cp;
+  tp->queue.next             = cp->queue.next;
+  tp->queue.next->queue.prev = tp;
+  cp->queue.next             = tp;
+#else /* CH_CFG_USE_READY_BITMAP == FALSE */
   cp = (thread_t *)&ch.rlist.queue;
   do {
     cp = cp->queue.next;
@@ -273,6 +466,7 @@ thread_t *chSchReadyAheadI(thread_t *tp) {
   tp->queue.prev             = cp->queue.prev;
   tp->queue.prev->queue.next = tp;
   cp->queue.prev             = tp;
+#endif /* CH_CFG_USE_READY_BITMAP == FALSE */
 
   return tp;
 }
@@ -301,7 +495,7 @@ void chSchGoSleepS(tstate_t newstate) {
 #endif
 
   /* Next thread in ready list becomes current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = ready_fifo_remove();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-enter hook.*/
@@ -437,9 +631,11 @@ void chSchWakeupS(thread_t *ntp, msg_t msg) {
       CH_CFG_IDLE_LEAVE_HOOK();
     }
 
-    /* The extracted thread is marked as current.*/
+    /* The extracted thread is marked as current, it does not pass
+       through the ready list.*/
     currp = ntp;
     ntp->state = CH_STATE_CURRENT;
+    _stats_ready(ntp);
 
     /* Swap operation as tail call.*/
     chSysSwitch(ntp, otp);
@@ -508,7 +704,7 @@ void chSchDoRescheduleBehind(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = ready_fifo_remove();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
@@ -541,7 +737,7 @@ void chSchDoRescheduleAhead(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = ready_fifo_remove();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
@@ -571,7 +767,7 @@ void chSchDoReschedule(void) {
   thread_t *otp = currp;
 
   /* Picks the first thread from the ready queue and makes it current.*/
-  currp = queue_fifo_remove(&ch.rlist.queue);
+  currp = ready_fifo_remove();
   currp->state = CH_STATE_CURRENT;
 
   /* Handling idle-leave hook.*/
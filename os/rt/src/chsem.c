@@ -100,6 +100,7 @@ void chSemObjectInit(semaphore_t *sp, cnt_t n) {
 
   queue_init(&sp->queue);
   sp->cnt = n;
+  _lock_stats_init(&sp->stats);
 }
 
 /**
@@ -195,6 +196,7 @@ msg_t chSemWait(semaphore_t *sp) {
  * @sclass
  */
 msg_t chSemWaitS(semaphore_t *sp) {
+  rtcnt_t start;
 
   chDbgCheckClassS();
   chDbgCheck(sp != NULL);
@@ -203,12 +205,20 @@ msg_t chSemWaitS(semaphore_t *sp) {
               "inconsistent semaphore");
 
   if (--sp->cnt < (cnt_t)0) {
+    _trace_sem(CH_TRACE_SEM_BLOCK, sp, NULL);
+    start = _lock_stats_wait_start(&sp->stats);
     currp->u.wtsemp = sp;
     sem_insert(currp, &sp->queue);
     chSchGoSleepS(CH_STATE_WTSEM);
+    _lock_stats_wait_end(&sp->stats, start);
+    if (currp->u.rdymsg == MSG_OK) {
+      _lock_stats_acquired(&sp->stats);
+    }
 
     return currp->u.rdymsg;
   }
+  _trace_sem(CH_TRACE_SEM_WAIT, sp, NULL);
+  _lock_stats_acquired(&sp->stats);
 
   return MSG_OK;
 }
@@ -262,6 +272,8 @@ msg_t chSemWaitTimeout(semaphore_t *sp, sysinterval_t timeout) {
  * @sclass
  */
 msg_t chSemWaitTimeoutS(semaphore_t *sp, sysinterval_t timeout) {
+  rtcnt_t start;
+  msg_t msg;
 
   chDbgCheckClassS();
   chDbgCheck(sp != NULL);
@@ -275,11 +287,20 @@ msg_t chSemWaitTimeoutS(semaphore_t *sp, sysinterval_t timeout) {
 
       return MSG_TIMEOUT;
     }
+    _trace_sem(CH_TRACE_SEM_BLOCK, sp, NULL);
+    start = _lock_stats_wait_start(&sp->stats);
     currp->u.wtsemp = sp;
     sem_insert(currp, &sp->queue);
+    msg = chSchGoSleepTimeoutS(CH_STATE_WTSEM, timeout);
+    _lock_stats_wait_end(&sp->stats, start);
+    if (msg == MSG_OK) {
+      _lock_stats_acquired(&sp->stats);
+    }
 
-    return chSchGoSleepTimeoutS(CH_STATE_WTSEM, timeout);
+    return msg;
   }
+  _trace_sem(CH_TRACE_SEM_WAIT, sp, NULL);
+  _lock_stats_acquired(&sp->stats);
 
   return MSG_OK;
 }
@@ -300,7 +321,12 @@ void chSemSignal(semaphore_t *sp) {
               ((sp->cnt < (cnt_t)0) && queue_notempty(&sp->queue)),
               "inconsistent semaphore");
   if (++sp->cnt <= (cnt_t)0) {
-    chSchWakeupS(queue_fifo_remove(&sp->queue), MSG_OK);
+    thread_t *tp = queue_fifo_remove(&sp->queue);
+    _trace_sem(CH_TRACE_SEM_SIGNAL, sp, tp);
+    chSchWakeupS(tp, MSG_OK);
+  }
+  else {
+    _trace_sem(CH_TRACE_SEM_SIGNAL, sp, NULL);
   }
   chSysUnlock();
 }
@@ -328,9 +354,13 @@ void chSemSignalI(semaphore_t *sp) {
     /* Note, it is done this way in order to allow a tail call on
              chSchReadyI().*/
     thread_t *tp = queue_fifo_remove(&sp->queue);
+    _trace_sem(CH_TRACE_SEM_SIGNAL, sp, tp);
     tp->u.rdymsg = MSG_OK;
     (void) chSchReadyI(tp);
   }
+  else {
+    _trace_sem(CH_TRACE_SEM_SIGNAL, sp, NULL);
+  }
 }
 
 /**
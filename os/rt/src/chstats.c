@@ -65,6 +65,10 @@ void _stats_init(void) {
   ch.kernel_stats.n_ctxswc = (ucnt_t)0;
   chTMObjectInit(&ch.kernel_stats.m_crit_thd);
   chTMObjectInit(&ch.kernel_stats.m_crit_isr);
+#if CH_DBG_STATISTICS_HISTOGRAMS == TRUE
+  chTMHistogramObjectInit(&ch.kernel_stats.h_crit_thd);
+  chTMHistogramObjectInit(&ch.kernel_stats.h_crit_isr);
+#endif
 }
 
 /**
@@ -77,6 +81,16 @@ void _stats_increase_irq(void) {
   port_unlock_from_isr();
 }
 
+/**
+ * @brief   Starts the measurement of a thread ready-to-run latency.
+ *
+ * @param[in] tp        the thread entering the ready state
+ */
+void _stats_ready(thread_t *tp) {
+
+  chTMStartMeasurementX(&tp->latency);
+}
+
 /**
  * @brief   Updates context switch related statistics.
  *
@@ -86,6 +100,12 @@ void _stats_increase_irq(void) {
 void _stats_ctxswc(thread_t *ntp, thread_t *otp) {
 
   ch.kernel_stats.n_ctxswc++;
+  if (otp->state == CH_STATE_READY) {
+    otp->n_preempt++;
+  }
+  /* Chained measurements are not offset-compensated, a latency shorter
+     than the calibration offset cannot underflow.*/
+  chTMChainMeasurementToX(&ntp->latency, &ntp->stats);
   chTMChainMeasurementToX(&otp->stats, &ntp->stats);
 }
 
@@ -102,7 +122,12 @@ void _stats_start_measure_crit_thd(void) {
  */
 void _stats_stop_measure_crit_thd(void) {
 
+#if CH_DBG_STATISTICS_HISTOGRAMS == TRUE
+  chTMHistogramStopMeasurementX(&ch.kernel_stats.m_crit_thd,
+                                &ch.kernel_stats.h_crit_thd);
+#else
   chTMStopMeasurementX(&ch.kernel_stats.m_crit_thd);
+#endif
 }
 
 /**
@@ -118,7 +143,12 @@ void _stats_start_measure_crit_isr(void) {
  */
 void _stats_stop_measure_crit_isr(void) {
 
+#if CH_DBG_STATISTICS_HISTOGRAMS == TRUE
+  chTMHistogramStopMeasurementX(&ch.kernel_stats.m_crit_isr,
+                                &ch.kernel_stats.h_crit_isr);
+#else
   chTMStopMeasurementX(&ch.kernel_stats.m_crit_isr);
+#endif
 }
 
 #endif /* CH_DBG_STATISTICS == TRUE */
@@ -58,6 +58,23 @@ THD_WORKING_AREA(ch_idle_thread_wa, PORT_IDLE_THREAD_STACK_SIZE);
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TIMERS_HEAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Returns the parent node of a non-root timer in the timers heap.
+ *
+ * @param[in] vtp       the @p virtual_timer_t structure pointer
+ * @return              The parent node.
+ */
+static virtual_timer_t *vt_get_parent(virtual_timer_t *vtp) {
+
+  while (vtp->prev->child != vtp) {
+    vtp = vtp->prev;
+  }
+
+  return vtp->prev;
+}
+#endif
+
 #if (CH_CFG_NO_IDLE_THREAD == FALSE) || defined(__DOXYGEN__)
 /**
  * @brief   This function implements the idle thread infinite loop.
@@ -265,12 +282,82 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+
+#if CH_CFG_USE_READY_BITMAP == TRUE
+    {
+      unsigned w;
+
+      /* The last thread of each level must be indexed and marked in the
+         bitmap.*/
+      tp = ch.rlist.queue.next;
+      while (tp != (thread_t *)&ch.rlist.queue) {
+        if (tp->queue.next->prio != tp->prio) {
+          if (((ch.rlist.prmap[(unsigned)tp->prio / 32U] &
+                ((uint32_t)1U << ((unsigned)tp->prio % 32U))) == 0U) ||
+              (ch.rlist.prlast[tp->prio] != tp)) {
+            return true;
+          }
+          n++;
+        }
+        tp = tp->queue.next;
+      }
+
+      /* The bitmap must not contain other levels and the words mask must
+         be consistent.*/
+      for (w = 0U; w < CH_READY_BITMAP_WORDS; w++) {
+        uint32_t m = ch.rlist.prmap[w];
+
+        if (((ch.rlist.prmask & ((uint32_t)1U << w)) != 0U) != (m != 0U)) {
+          return true;
+        }
+        while (m != 0U) {
+          m &= m - 1U;
+          n--;
+        }
+      }
+      if (n != (cnt_t)0) {
+        return true;
+      }
+    }
+#endif
   }
 
   /* Timers list integrity check.*/
   if ((testmask & CH_INTEGRITY_VTLIST) != 0U) {
     virtual_timer_t * vtp;
 
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
+    /* Walking the heap in depth-first order, the back links must be
+       consistent and no timer can expire before its parent.*/
+    vtp = ch.vtlist.root;
+    if ((vtp != NULL) && ((vtp->next != NULL) || (vtp->prev != NULL))) {
+      return true;
+    }
+    while (vtp != NULL) {
+      if (vtp->child != NULL) {
+        if ((vtp->child->prev != vtp) ||
+            (vtp->child->deadline < vtp->deadline)) {
+          return true;
+        }
+        vtp = vtp->child;
+        continue;
+      }
+
+      /* Climbing up until a node with a next sibling is found.*/
+      while ((vtp != ch.vtlist.root) && (vtp->next == NULL)) {
+        vtp = vt_get_parent(vtp);
+      }
+      if (vtp == ch.vtlist.root) {
+        break;
+      }
+
+      if ((vtp->next->prev != vtp) ||
+          (vtp->next->deadline < vt_get_parent(vtp)->deadline)) {
+        return true;
+      }
+      vtp = vtp->next;
+    }
+#else /* CH_CFG_USE_TIMERS_HEAP == FALSE */
     /* Scanning the timers list forward.*/
     n = (cnt_t)0;
     vtp = ch.vtlist.next;
@@ -290,6 +377,7 @@ bool chSysIntegrityCheckI(unsigned testmask) {
     if (n != (cnt_t)0) {
       return true;
     }
+#endif /* CH_CFG_USE_TIMERS_HEAP == FALSE */
   }
 
 #if CH_CFG_USE_REGISTRY == TRUE
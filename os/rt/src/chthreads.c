@@ -118,6 +118,8 @@ thread_t *_thread_init(thread_t *tp, const char *name, tprio_t prio) {
 #endif
 #if CH_DBG_STATISTICS == TRUE
   chTMObjectInit(&tp->stats);
+  chTMObjectInit(&tp->latency);
+  tp->n_preempt = (ucnt_t)0;
 #endif
   CH_CFG_THREAD_INIT_HOOK(tp);
   return tp;
@@ -507,6 +509,11 @@ void chThdExitS(msg_t msg) {
   /* Exit handler hook.*/
   CH_CFG_THREAD_EXIT_HOOK(tp);
 
+#if (CH_CFG_USE_HEAP == TRUE) && (CH_CFG_USE_MEM_PROFILING == TRUE)
+  /* The heap statistics entries of the thread can be reused.*/
+  _heap_prof_thread_exit(tp);
+#endif
+
 #if CH_CFG_USE_WAITEXIT == TRUE
   /* Waking up any waiting thread.*/
   while (list_notempty(&tp->waiting)) {
@@ -65,6 +65,71 @@ static inline void tm_stop(time_measurement_t *tmp,
   }
 }
 
+/**
+ * @brief   Returns the index of the most significant bit set in a word.
+ *
+ * @param[in] w         the word, it must be different from zero
+ * @return              The bit index.
+ */
+static inline unsigned tm_msb(rtcnt_t w) {
+
+#if defined(__GNUC__)
+  return (unsigned)((sizeof (unsigned long) * 8U) - 1U) -
+         (unsigned)__builtin_clzl((unsigned long)w);
+#else
+  unsigned n = 0U;
+
+  if (w >= (rtcnt_t)0x10000U) {
+    w >>= 16;
+    n += 16U;
+  }
+  if (w >= (rtcnt_t)0x100U) {
+    w >>= 8;
+    n += 8U;
+  }
+  if (w >= (rtcnt_t)0x10U) {
+    w >>= 4;
+    n += 4U;
+  }
+  if (w >= (rtcnt_t)0x4U) {
+    w >>= 2;
+    n += 2U;
+  }
+  if (w >= (rtcnt_t)0x2U) {
+    n += 1U;
+  }
+
+  return n;
+#endif
+}
+
+/**
+ * @brief   Returns the histogram bucket of a measured time.
+ *
+ * @param[in] t         the measured time
+ * @return              The bucket index.
+ */
+static inline unsigned tm_bucket(rtcnt_t t) {
+  unsigned e;
+
+  /* Short times are recorded exactly.*/
+  if (t < ((rtcnt_t)1 << CH_TM_HISTOGRAM_SUB_BITS)) {
+    return (unsigned)t;
+  }
+
+  /* Longer times are recorded in the linear sub-range of their power of
+     two range, times out of range saturate in the last bucket.*/
+  e = tm_msb(t);
+  if (e >= (unsigned)CH_TM_HISTOGRAM_RANGE_BITS) {
+    return (unsigned)CH_TM_HISTOGRAM_SIZE - 1U;
+  }
+
+  return ((e - (unsigned)CH_TM_HISTOGRAM_SUB_BITS + 1U) <<
+          CH_TM_HISTOGRAM_SUB_BITS) +
+         ((unsigned)(t >> (e - (unsigned)CH_TM_HISTOGRAM_SUB_BITS)) &
+          ((1U << CH_TM_HISTOGRAM_SUB_BITS) - 1U));
+}
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -151,6 +216,190 @@ NOINLINE void chTMChainMeasurementToX(time_measurement_t *tmp1,
   tm_stop(tmp1, tmp2->last, (rtcnt_t)0);
 }
 
+/**
+ * @brief   Initializes a @p time_histogram_t object.
+ *
+ * @param[out] thp      pointer to a @p time_histogram_t structure
+ *
+ * @init
+ */
+void chTMHistogramObjectInit(time_histogram_t *thp) {
+  unsigned i;
+
+  thp->n = (ucnt_t)0;
+  for (i = 0U; i < (unsigned)CH_TM_HISTOGRAM_SIZE; i++) {
+    thp->buckets[i] = (ucnt_t)0;
+  }
+}
+
+/**
+ * @brief   Records a measured time into an histogram.
+ * @pre     The @p time_histogram_t structure must be initialized.
+ *
+ * @param[in,out] thp   pointer to a @p time_histogram_t structure
+ * @param[in] t         the measured time in realtime counter cycles
+ *
+ * @xclass
+ */
+void chTMHistogramRecordX(time_histogram_t *thp, rtcnt_t t) {
+
+  thp->n++;
+  thp->buckets[tm_bucket(t)]++;
+}
+
+/**
+ * @brief   Stops a measurement and records it into an histogram.
+ * @pre     The @p time_measurement_t and @p time_histogram_t structures
+ *          must be initialized.
+ *
+ * @param[in,out] tmp   pointer to a @p time_measurement_t structure
+ * @param[in,out] thp   pointer to a @p time_histogram_t structure
+ *
+ * @xclass
+ */
+NOINLINE void chTMHistogramStopMeasurementX(time_measurement_t *tmp,
+                                            time_histogram_t *thp) {
+
+  tm_stop(tmp, chSysGetRealtimeCounterX(), ch.tm.offset);
+  chTMHistogramRecordX(thp, tmp->last);
+}
+
+/**
+ * @brief   Clears an histogram.
+ *
+ * @param[out] thp      pointer to a @p time_histogram_t structure
+ *
+ * @iclass
+ */
+void chTMHistogramResetI(time_histogram_t *thp) {
+
+  chDbgCheckClassI();
+  chDbgCheck(thp != NULL);
+
+  chTMHistogramObjectInit(thp);
+}
+
+/**
+ * @brief   Clears an histogram.
+ *
+ * @param[out] thp      pointer to a @p time_histogram_t structure
+ *
+ * @api
+ */
+void chTMHistogramReset(time_histogram_t *thp) {
+
+  chSysLock();
+  chTMHistogramResetI(thp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Takes a consistent copy of an histogram.
+ *
+ * @param[in] thp       pointer to a @p time_histogram_t structure
+ * @param[out] dstp     pointer to the copy
+ *
+ * @iclass
+ */
+void chTMHistogramSnapshotI(const time_histogram_t *thp,
+                            time_histogram_t *dstp) {
+
+  chDbgCheckClassI();
+  chDbgCheck((thp != NULL) && (dstp != NULL));
+
+  *dstp = *thp;
+}
+
+/**
+ * @brief   Takes a consistent copy of an histogram.
+ *
+ * @param[in] thp       pointer to a @p time_histogram_t structure
+ * @param[out] dstp     pointer to the copy
+ *
+ * @api
+ */
+void chTMHistogramSnapshot(const time_histogram_t *thp,
+                           time_histogram_t *dstp) {
+
+  chSysLock();
+  chTMHistogramSnapshotI(thp, dstp);
+  chSysUnlock();
+}
+
+/**
+ * @brief   Returns the upper limit of an histogram bucket.
+ * @note    The last bucket also accumulates the times out of range, its
+ *          limit is the maximum realtime counter value.
+ *
+ * @param[in] i         the bucket index
+ * @return              The longest time recorded in the bucket.
+ *
+ * @xclass
+ */
+rtcnt_t chTMHistogramGetBucketLimitX(unsigned i) {
+  unsigned k, sub;
+
+  chDbgCheck(i < (unsigned)CH_TM_HISTOGRAM_SIZE);
+
+  if (i == (unsigned)CH_TM_HISTOGRAM_SIZE - 1U) {
+    return (rtcnt_t)-1;
+  }
+
+  k   = i >> CH_TM_HISTOGRAM_SUB_BITS;
+  sub = i & ((1U << CH_TM_HISTOGRAM_SUB_BITS) - 1U);
+  if (k == 0U) {
+    return (rtcnt_t)sub;
+  }
+
+  return ((((rtcnt_t)1 << CH_TM_HISTOGRAM_SUB_BITS) + (rtcnt_t)sub) <<
+          (k - 1U)) + (((rtcnt_t)1 << (k - 1U)) - (rtcnt_t)1);
+}
+
+/**
+ * @brief   Returns a percentile of the recorded times.
+ * @details The returned value is the upper limit of the bucket containing
+ *          the percentile, it is an upper bound of the real value with the
+ *          histogram resolution.
+ * @note    The histogram should be a snapshot if it can be updated while
+ *          being scanned.
+ *
+ * @param[in] thp       pointer to a @p time_histogram_t structure
+ * @param[in] permille  the percentile in thousandths, for example 500 for
+ *                      the median or 999 for the 99.9th percentile
+ * @return              The percentile in realtime counter cycles.
+ * @retval 0            if the histogram is empty.
+ *
+ * @xclass
+ */
+rtcnt_t chTMHistogramGetPercentileX(const time_histogram_t *thp,
+                                    unsigned permille) {
+  rttime_t rank, cnt;
+  unsigned i;
+
+  chDbgCheck((thp != NULL) && (permille <= 1000U));
+
+  if (thp->n == (ucnt_t)0) {
+    return (rtcnt_t)0;
+  }
+
+  /* Rank of the wanted record, rounded up.*/
+  rank = (((rttime_t)thp->n * (rttime_t)permille) + (rttime_t)999) /
+         (rttime_t)1000;
+  if (rank == (rttime_t)0) {
+    rank = (rttime_t)1;
+  }
+
+  cnt = (rttime_t)0;
+  for (i = 0U; i < (unsigned)CH_TM_HISTOGRAM_SIZE - 1U; i++) {
+    cnt += (rttime_t)thp->buckets[i];
+    if (cnt >= rank) {
+      break;
+    }
+  }
+
+  return chTMHistogramGetBucketLimitX(i);
+}
+
 #endif /* CH_CFG_USE_TM == TRUE */
 
 /** @} */
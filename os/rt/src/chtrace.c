@@ -55,6 +55,9 @@
  * @notapi
  */
 static NOINLINE void trace_next(void) {
+#if CH_DBG_TRACE_STREAM == TRUE
+  ch_trace_event_t *next;
+#endif
 
   ch.dbg.trace_buffer.ptr->time    = chVTGetSystemTimeX();
 #if PORT_SUPPORTS_RT == TRUE
@@ -66,10 +69,25 @@ static NOINLINE void trace_next(void) {
   /* Trace hook, useful in order to interface debug tools.*/
   CH_CFG_TRACE_HOOK(ch.dbg.trace_buffer.ptr);
 
+#if CH_DBG_TRACE_STREAM == TRUE
+  next = ch.dbg.trace_buffer.ptr + 1;
+  if (next >= &ch.dbg.trace_buffer.buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
+    next = &ch.dbg.trace_buffer.buffer[0];
+  }
+
+  /* If the queue is full then the record is not committed and its slot
+     is reused by the next record.*/
+  if (next == ch.dbg.trace_buffer.rdptr) {
+    ch.dbg.trace_buffer.lost++;
+    return;
+  }
+  ch.dbg.trace_buffer.ptr = next;
+#else
   if (++ch.dbg.trace_buffer.ptr >=
       &ch.dbg.trace_buffer.buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
     ch.dbg.trace_buffer.ptr = &ch.dbg.trace_buffer.buffer[0];
   }
+#endif
 }
 #endif
 
@@ -88,6 +106,10 @@ void _trace_init(void) {
   ch.dbg.trace_buffer.suspended = (uint16_t)~CH_DBG_TRACE_MASK;
   ch.dbg.trace_buffer.size      = CH_DBG_TRACE_BUFFER_SIZE;
   ch.dbg.trace_buffer.ptr       = &ch.dbg.trace_buffer.buffer[0];
+#if CH_DBG_TRACE_STREAM == TRUE
+  ch.dbg.trace_buffer.rdptr     = &ch.dbg.trace_buffer.buffer[0];
+  ch.dbg.trace_buffer.lost      = (ucnt_t)0;
+#endif
   for (i = 0U; i < (unsigned)CH_DBG_TRACE_BUFFER_SIZE; i++) {
     ch.dbg.trace_buffer.buffer[i].type = CH_TRACE_TYPE_UNUSED;
   }
@@ -169,6 +191,65 @@ void _trace_halt(const char *reason) {
   }
 }
 
+/**
+ * @brief   Inserts in the circular debug trace buffer a semaphore or mutex
+ *          record.
+ * @note    The suspended mask is checked by the caller.
+ *
+ * @param[in] type      @p CH_TRACE_TYPE_SEM or @p CH_TRACE_TYPE_MTX
+ * @param[in] event     the object event code
+ * @param[in] objp      pointer to the semaphore or mutex
+ * @param[in] tp        the woken thread, the mutex owner or @p NULL
+ *
+ * @notapi
+ */
+void _trace_sync(uint8_t type, uint8_t event, void *objp, thread_t *tp) {
+
+  ch.dbg.trace_buffer.ptr->type          = type;
+  ch.dbg.trace_buffer.ptr->state         = event;
+  ch.dbg.trace_buffer.ptr->u.sync.objp   = objp;
+  ch.dbg.trace_buffer.ptr->u.sync.tp     = tp;
+  trace_next();
+}
+
+/**
+ * @brief   Inserts in the circular debug trace buffer a mailbox record.
+ * @note    The suspended mask is checked by the caller.
+ *
+ * @param[in] event     the mailbox event code
+ * @param[in] mbp       pointer to the mailbox
+ * @param[in] msg       the posted or fetched message
+ *
+ * @notapi
+ */
+void _trace_mailbox(uint8_t event, void *mbp, msg_t msg) {
+
+  ch.dbg.trace_buffer.ptr->type          = CH_TRACE_TYPE_MB;
+  ch.dbg.trace_buffer.ptr->state         = event;
+  ch.dbg.trace_buffer.ptr->u.mb.mbp      = mbp;
+  ch.dbg.trace_buffer.ptr->u.mb.msg      = msg;
+  trace_next();
+}
+
+/**
+ * @brief   Inserts in the circular debug trace buffer a virtual timer record.
+ * @note    The suspended mask is checked by the caller.
+ *
+ * @param[in] event     the virtual timer event code
+ * @param[in] vtp       pointer to the virtual timer
+ * @param[in] vtfunc    the timer callback function
+ *
+ * @notapi
+ */
+void _trace_timer(uint8_t event, virtual_timer_t *vtp, vtfunc_t vtfunc) {
+
+  ch.dbg.trace_buffer.ptr->type          = CH_TRACE_TYPE_VT;
+  ch.dbg.trace_buffer.ptr->state         = event;
+  ch.dbg.trace_buffer.ptr->u.vt.vtp      = vtp;
+  ch.dbg.trace_buffer.ptr->u.vt.vtfunc   = vtfunc;
+  trace_next();
+}
+
 /**
  * @brief   Adds an user trace record to the trace buffer.
  *
@@ -260,6 +341,74 @@ void chDbgResumeTrace(uint16_t mask) {
   chDbgResumeTraceI(mask);
   chSysUnlock();
 }
+
+#if (CH_DBG_TRACE_STREAM == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Fetches records from the trace buffer.
+ * @details Up to @p n records are removed from the trace buffer, oldest
+ *          first, and copied in the specified array.
+ *
+ * @param[out] tep      pointer to an array of records
+ * @param[in] n         number of records in the array
+ * @return              The number of fetched records.
+ *
+ * @iclass
+ */
+size_t chDbgFetchTraceI(ch_trace_event_t *tep, size_t n) {
+  size_t i;
+
+  chDbgCheckClassI();
+  chDbgCheck((tep != NULL) && (n > 0U));
+
+  i = 0U;
+  while ((i < n) && (ch.dbg.trace_buffer.rdptr != ch.dbg.trace_buffer.ptr)) {
+    tep[i] = *ch.dbg.trace_buffer.rdptr;
+    if (++ch.dbg.trace_buffer.rdptr >=
+        &ch.dbg.trace_buffer.buffer[CH_DBG_TRACE_BUFFER_SIZE]) {
+      ch.dbg.trace_buffer.rdptr = &ch.dbg.trace_buffer.buffer[0];
+    }
+    i++;
+  }
+
+  return i;
+}
+
+/**
+ * @brief   Fetches records from the trace buffer.
+ * @details Up to @p n records are removed from the trace buffer, oldest
+ *          first, and copied in the specified array.
+ * @note    The records are copied within a critical zone, @p n should be
+ *          kept small.
+ *
+ * @param[out] tep      pointer to an array of records
+ * @param[in] n         number of records in the array
+ * @return              The number of fetched records.
+ *
+ * @api
+ */
+size_t chDbgFetchTrace(ch_trace_event_t *tep, size_t n) {
+  size_t i;
+
+  chSysLock();
+  i = chDbgFetchTraceI(tep, n);
+  chSysUnlock();
+
+  return i;
+}
+
+/**
+ * @brief   Returns the number of records dropped because the trace buffer
+ *          was full.
+ *
+ * @return              The number of dropped records.
+ *
+ * @xclass
+ */
+ucnt_t chDbgGetTraceLostX(void) {
+
+  return ch.dbg.trace_buffer.lost;
+}
+#endif /* CH_DBG_TRACE_STREAM == TRUE */
 #endif /* CH_DBG_TRACE_MASK != CH_DBG_TRACE_MASK_DISABLED */
 
 /** @} */
@@ -48,6 +48,128 @@
 /* Module local functions.                                                   */
 /*===========================================================================*/
 
+#if (CH_CFG_USE_TIMERS_HEAP == TRUE) || defined(__DOXYGEN__)
+#if (CH_CFG_ST_TIMEDELTA > 0) || defined(__DOXYGEN__)
+/**
+ * @brief   Extends a system time value to the 64 bits heap time base.
+ * @note    The system time must not have advanced more than a full
+ *          @p systime_t range since the last tick event, this is granted
+ *          by the alarm being never programmed further than
+ *          @p TIME_MAX_SYSTIME ticks.
+ *
+ * @param[in] now       current system time
+ * @return              The extended time.
+ */
+static uint64_t vt_get_abstime(systime_t now) {
+
+  return ch.vtlist.abstime +
+         (uint64_t)chTimeDiffX(ch.vtlist.lasttime, now);
+}
+
+/**
+ * @brief   Programs the alarm for the timer on top of the heap.
+ *
+ * @param[in] now       current system time
+ * @param[in] abstime   current system time in the extended time base
+ */
+static void vt_set_alarm(systime_t now, uint64_t abstime) {
+  uint64_t delta;
+
+  delta = ch.vtlist.root->deadline - abstime;
+
+  /* Making sure to not schedule an event closer than CH_CFG_ST_TIMEDELTA
+     ticks from now.*/
+  if (delta < (uint64_t)CH_CFG_ST_TIMEDELTA) {
+    delta = (uint64_t)CH_CFG_ST_TIMEDELTA;
+  }
+  /* The delta could be too large for the physical timer to handle.*/
+  else if (delta > (uint64_t)TIME_MAX_SYSTIME) {
+    delta = (uint64_t)TIME_MAX_SYSTIME;
+  }
+  port_timer_set_alarm(chTimeAddX(now, (sysinterval_t)delta));
+}
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+
+/**
+ * @brief   Melds two heaps.
+ * @details The root with the later deadline becomes the first child of the
+ *          other root, on equal deadlines @p a is kept on top.
+ * @note    The @p next and @p prev fields of the returned root are not
+ *          updated, it is responsibility of the caller.
+ *
+ * @param[in] a         first heap root
+ * @param[in] b         second heap root
+ * @return              The root of the melded heap.
+ */
+static virtual_timer_t *vt_meld(virtual_timer_t *a, virtual_timer_t *b) {
+
+  if (b->deadline < a->deadline) {
+    virtual_timer_t *tmp = a;
+    a = b;
+    b = tmp;
+  }
+
+  b->prev = a;
+  b->next = a->child;
+  if (a->child != NULL) {
+    a->child->prev = b;
+  }
+  a->child = b;
+
+  return a;
+}
+
+/**
+ * @brief   Melds a list of sibling heaps into a single heap.
+ * @details Standard two passes pairing: siblings are melded in pairs from
+ *          left to right then the resulting heaps are melded from right to
+ *          left.
+ *
+ * @param[in] first     first heap in the siblings list or @p NULL
+ * @return              The root of the resulting heap or @p NULL.
+ */
+static virtual_timer_t *vt_merge_pairs(virtual_timer_t *first) {
+  virtual_timer_t *list, *vtp;
+
+  if (first == NULL) {
+    return NULL;
+  }
+
+  /* First pass, the pairs are melded and the results are chained in
+     reverse order using the "next" field.*/
+  list = NULL;
+  while (first != NULL) {
+    virtual_timer_t *a = first;
+    virtual_timer_t *b = a->next;
+
+    if (b == NULL) {
+      vtp = a;
+      first = NULL;
+    }
+    else {
+      first = b->next;
+      vtp = vt_meld(a, b);
+    }
+    vtp->next = list;
+    list = vtp;
+  }
+
+  /* Second pass, melding the heaps from the last to the first.*/
+  vtp = list;
+  list = list->next;
+  while (list != NULL) {
+    virtual_timer_t *next = list->next;
+
+    vtp = vt_meld(vtp, list);
+    list = next;
+  }
+  vtp->next = NULL;
+  vtp->prev = NULL;
+
+  return vtp;
+}
+#endif /* CH_CFG_USE_TIMERS_HEAP == TRUE */
+
 /*===========================================================================*/
 /* Module exported functions.                                                */
 /*===========================================================================*/
@@ -60,9 +182,14 @@
  */
 void _vt_init(void) {
 
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
+  ch.vtlist.root = NULL;
+  ch.vtlist.abstime = (uint64_t)0;
+#else /* CH_CFG_USE_TIMERS_HEAP == FALSE */
   ch.vtlist.next = (virtual_timer_t *)&ch.vtlist;
   ch.vtlist.prev = (virtual_timer_t *)&ch.vtlist;
   ch.vtlist.delta = (sysinterval_t)-1;
+#endif /* CH_CFG_USE_TIMERS_HEAP == FALSE */
 #if CH_CFG_ST_TIMEDELTA == 0
   ch.vtlist.systime = (systime_t)0;
 #else /* CH_CFG_ST_TIMEDELTA > 0 */
@@ -94,15 +221,77 @@ void _vt_init(void) {
  */
 void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
                 vtfunc_t vtfunc, void *par) {
+#if CH_CFG_USE_TIMERS_HEAP == FALSE
   virtual_timer_t *p;
   sysinterval_t delta;
+#endif
 
   chDbgCheckClassI();
   chDbgCheck((vtp != NULL) && (vtfunc != NULL) && (delay != TIME_IMMEDIATE));
 
   vtp->par = par;
   vtp->func = vtfunc;
+  _trace_vt(CH_TRACE_VT_SET, vtp, vtfunc);
+
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
+  {
+#if CH_CFG_ST_TIMEDELTA > 0
+    systime_t now = chVTGetSystemTimeX();
+
+    /* If the requested delay is lower than the minimum safe delta then it
+       is raised to the minimum safe value.*/
+    if (delay < (sysinterval_t)CH_CFG_ST_TIMEDELTA) {
+      delay = (sysinterval_t)CH_CFG_ST_TIMEDELTA;
+    }
+
+    /* The extended time base is moved to the current time, this also
+       resynchronizes it after the heap has been empty for a long time.*/
+    ch.vtlist.abstime = vt_get_abstime(now);
+    ch.vtlist.lasttime = now;
+#endif
+
+    /* Absolute deadline, saturated in the unlikely case of overflow.*/
+    vtp->deadline = ch.vtlist.abstime + (uint64_t)delay;
+    if (vtp->deadline < ch.vtlist.abstime) {
+      vtp->deadline = UINT64_MAX;
+    }
+    vtp->child = NULL;
+
+    /* Special case where the heap is empty.*/
+    if (ch.vtlist.root == NULL) {
+      vtp->next = NULL;
+      vtp->prev = NULL;
+      ch.vtlist.root = vtp;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+#if CH_CFG_INTERVALS_SIZE > CH_CFG_ST_RESOLUTION
+      /* The delta could be too large for the physical timer to handle.*/
+      if (delay > (sysinterval_t)TIME_MAX_SYSTIME) {
+        delay = (sysinterval_t)TIME_MAX_SYSTIME;
+      }
+#endif
+
+      /* Being the only element in the heap the alarm timer is started.*/
+      port_timer_start_alarm(chTimeAddX(now, delay));
+#endif
+
+      return;
+    }
+
+    /* The timer is melded with the heap, existing timers with the same
+       deadline are kept before the new one.*/
+    ch.vtlist.root = vt_meld(ch.vtlist.root, vtp);
+    ch.vtlist.root->next = NULL;
+    ch.vtlist.root->prev = NULL;
 
+#if CH_CFG_ST_TIMEDELTA > 0
+    /* If the timer became the next deadline then the alarm is moved.*/
+    if (ch.vtlist.root == vtp) {
+      vt_set_alarm(now, ch.vtlist.abstime);
+    }
+#endif
+  }
+#else /* CH_CFG_USE_TIMERS_HEAP == FALSE */
 #if CH_CFG_ST_TIMEDELTA > 0
   {
     systime_t now = chVTGetSystemTimeX();
@@ -198,6 +387,7 @@ void chVTDoSetI(virtual_timer_t *vtp, sysinterval_t delay,
   /* Special case when the timer is in last position in the list, the
      value in the header must be restored.*/
   ch.vtlist.delta = (sysinterval_t)-1;
+#endif /* CH_CFG_USE_TIMERS_HEAP == FALSE */
 }
 
 /**
@@ -214,7 +404,60 @@ void chVTDoResetI(virtual_timer_t *vtp) {
   chDbgCheck(vtp != NULL);
   chDbgAssert(vtp->func != NULL, "timer not set or already triggered");
 
-#if CH_CFG_ST_TIMEDELTA == 0
+#if CH_CFG_USE_TIMERS_HEAP == TRUE
+  /* If the timer is not on top of the heap then its subtree is detached
+     and melded back with the heap, the next deadline is not affected.*/
+  if (ch.vtlist.root != vtp) {
+    virtual_timer_t *subtree;
+
+    if (vtp->prev->child == vtp) {
+      vtp->prev->child = vtp->next;
+    }
+    else {
+      vtp->prev->next = vtp->next;
+    }
+    if (vtp->next != NULL) {
+      vtp->next->prev = vtp->prev;
+    }
+    vtp->func = NULL;
+
+    subtree = vt_merge_pairs(vtp->child);
+    if (subtree != NULL) {
+      ch.vtlist.root = vt_meld(ch.vtlist.root, subtree);
+    }
+
+    return;
+  }
+
+  /* Removing the timer on top of the heap.*/
+  ch.vtlist.root = vt_merge_pairs(vtp->child);
+  vtp->func = NULL;
+
+#if CH_CFG_ST_TIMEDELTA > 0
+  {
+    systime_t now;
+    uint64_t abstime;
+
+    /* If the heap become empty then the alarm timer is stopped and done.*/
+    if (ch.vtlist.root == NULL) {
+      port_timer_stop_alarm();
+
+      return;
+    }
+
+    now = chVTGetSystemTimeX();
+    abstime = vt_get_abstime(now);
+
+    /* If the current time surpassed the deadline of the new top timer
+       then the event interrupt is already pending, just return.*/
+    if (abstime >= ch.vtlist.root->deadline) {
+      return;
+    }
+
+    vt_set_alarm(now, abstime);
+  }
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+#elif CH_CFG_ST_TIMEDELTA == 0
 
   /* The delta of the timer is added to the next timer.*/
   vtp->next->delta += vtp->delta;
@@ -296,4 +539,73 @@ void chVTDoResetI(virtual_timer_t *vtp) {
 #endif /* CH_CFG_ST_TIMEDELTA > 0 */
 }
 
+#if (CH_CFG_USE_TIMERS_HEAP == TRUE) || defined(__DOXYGEN__)
+/**
+ * @brief   Processes the expired timers on top of the heap.
+ * @note    Internal use only, it is invoked by @p chVTDoTickI().
+ *
+ * @notapi
+ */
+void _vt_heap_tick(void) {
+  virtual_timer_t *vtp;
+  vtfunc_t fn;
+
+#if CH_CFG_ST_TIMEDELTA == 0
+  while ((ch.vtlist.root != NULL) &&
+         (ch.vtlist.root->deadline <= ch.vtlist.abstime)) {
+    vtp = ch.vtlist.root;
+    ch.vtlist.root = vt_merge_pairs(vtp->child);
+    fn = vtp->func;
+    vtp->func = NULL;
+
+    _trace_vt(CH_TRACE_VT_FIRE, vtp, fn);
+
+    /* The callback is invoked outside the kernel critical zone.*/
+    chSysUnlockFromISR();
+    fn(vtp->par);
+    chSysLockFromISR();
+  }
+#else /* CH_CFG_ST_TIMEDELTA > 0 */
+  systime_t now;
+
+  while (true) {
+
+    /* The extended time base is moved to the current time.*/
+    now = chVTGetSystemTimeX();
+    ch.vtlist.abstime = vt_get_abstime(now);
+    ch.vtlist.lasttime = now;
+
+    /* If the heap is empty, nothing else to do.*/
+    vtp = ch.vtlist.root;
+    if (vtp == NULL) {
+      return;
+    }
+
+    if (vtp->deadline > ch.vtlist.abstime) {
+      break;
+    }
+
+    ch.vtlist.root = vt_merge_pairs(vtp->child);
+    fn = vtp->func;
+    vtp->func = NULL;
+
+    /* If the heap becomes empty then the timer is stopped.*/
+    if (ch.vtlist.root == NULL) {
+      port_timer_stop_alarm();
+    }
+
+    _trace_vt(CH_TRACE_VT_FIRE, vtp, fn);
+
+    /* The callback is invoked outside the kernel critical zone.*/
+    chSysUnlockFromISR();
+    fn(vtp->par);
+    chSysLockFromISR();
+  }
+
+  /* Recalculating the next alarm time.*/
+  vt_set_alarm(now, ch.vtlist.abstime);
+#endif /* CH_CFG_ST_TIMEDELTA > 0 */
+}
+#endif /* CH_CFG_USE_TIMERS_HEAP == TRUE */
+
 /** @} */
@@ -73,6 +73,15 @@
  */
 #define CH_CFG_ST_TIMEDELTA                 2
 
+/**
+ * @brief   Virtual timers store.
+ * @details If enabled the virtual timers are kept in a pairing heap with
+ *          O(1) insertion instead of a delta list with O(n) insertion.
+ * @note    The heap is convenient when many timers are armed at the same
+ *          time.
+ */
+#define CH_CFG_USE_TIMERS_HEAP              FALSE
+
 /** @} */
 
 /*===========================================================================*/
@@ -96,6 +105,14 @@
  */
 #define CH_CFG_TIME_QUANTUM                 0
 
+/**
+ * @brief   Ready list priority bitmap.
+ * @details If enabled the ready list is indexed by a priority bitmap, the
+ *          insertion of a thread in the ready list becomes O(1).
+ * @note    The index requires a pointer for each priority level.
+ */
+#define CH_CFG_USE_READY_BITMAP             FALSE
+
 /**
  * @brief   Managed RAM size.
  * @details Size of the RAM area to be managed by the OS. If set to zero
@@ -298,6 +315,37 @@
  */
 #define CH_CFG_USE_HEAP                     TRUE
 
+/**
+ * @brief   TLSF heap allocator.
+ * @details If enabled the heap allocator uses a two-level segregated fit
+ *          algorithm with constant time allocation and release instead
+ *          of first-fit.
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+
+/**
+ * @brief   Default heap size classes cache.
+ * @details If enabled the small blocks of the default heap are served by
+ *          per size class memory pools fed by the heap.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP and @p CH_CFG_USE_MEMPOOLS.
+ */
+#define CH_CFG_USE_HEAP_CACHE               FALSE
+
+/**
+ * @brief   Memory allocators profiling.
+ * @details If enabled the core allocator and the heaps record allocation
+ *          counters, high-water marks, size histograms and per-thread
+ *          statistics.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MEMCORE.
+ */
+#define CH_CFG_USE_MEM_PROFILING            FALSE
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
@@ -393,6 +441,24 @@
  */
 #define CH_DBG_STATISTICS                   FALSE
 
+/**
+ * @brief   Debug option, critical zones histograms.
+ * @details If enabled then the kernel statistics also record the duration
+ *          of the critical zones in time histograms.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_DBG_STATISTICS_HISTOGRAMS        FALSE
+
+/**
+ * @brief   Debug option, locks contention profiling.
+ * @details If enabled then mutexes and semaphores keep a contention
+ *          profile measured using the realtime counter.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_DBG_LOCK_PROFILING               FALSE
+
 /**
  * @brief   Debug option, system state check.
  * @details If enabled the correct call protocol for system APIs is checked
@@ -436,6 +502,15 @@
  */
 #define CH_DBG_TRACE_BUFFER_SIZE            128
 
+/**
+ * @brief   Trace buffer streaming mode.
+ * @details If enabled the trace buffer is drained by a consumer instead
+ *          of being overwritten circularly.
+ *
+ * @note    The default is @p FALSE.
+ */
+#define CH_DBG_TRACE_STREAM                 FALSE
+
 /**
  * @brief   Debug option, stack checks.
  * @details If enabled then a runtime stack check is performed.
@@ -130,17 +130,68 @@ static void cmd_systime(BaseSequentialStream *chp, int argc, char *argv[]) {
 #if (SHELL_CMD_MEM_ENABLED == TRUE) || defined(__DOXYGEN__)
 static void cmd_mem(BaseSequentialStream *chp, int argc, char *argv[]) {
   size_t n, total, largest;
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  static heap_stats_t hs;
+  memcore_stats_t cs;
+  unsigned i;
 
+  if ((argc == 1) && (strcmp(argv[0], "reset") == 0)) {
+    chHeapResetStats(NULL);
+    return;
+  }
+  if (argc > 0) {
+    shellUsage(chp, "mem [reset]");
+    return;
+  }
+#else
   (void)argv;
   if (argc > 0) {
     shellUsage(chp, "mem");
     return;
   }
+#endif
   n = chHeapStatus(NULL, &total, &largest);
   chprintf(chp, "core free memory : %u bytes"SHELL_NEWLINE_STR, chCoreGetStatusX());
   chprintf(chp, "heap fragments   : %u"SHELL_NEWLINE_STR, n);
   chprintf(chp, "heap free total  : %u bytes"SHELL_NEWLINE_STR, total);
   chprintf(chp, "heap free largest: %u bytes"SHELL_NEWLINE_STR, largest);
+#if CH_CFG_USE_MEM_PROFILING == TRUE
+  /* Fragmentation index, the free space not usable by the largest
+     possible allocation.*/
+  chprintf(chp, "heap fragmented  : %u%%"SHELL_NEWLINE_STR,
+           total == 0U ? 0U : 100U - (unsigned)((largest * 100U) / total));
+  chCoreGetStats(&cs);
+  chprintf(chp, "core used memory : %u/%u bytes"SHELL_NEWLINE_STR,
+           cs.used, cs.size);
+  chprintf(chp, "core allocations : %lu (%lu failed)"SHELL_NEWLINE_STR,
+           (unsigned long)cs.allocs, (unsigned long)cs.failures);
+  chHeapGetStats(NULL, &hs);
+  chprintf(chp, "heap used memory : %u bytes (peak %u bytes)"SHELL_NEWLINE_STR,
+           hs.used, hs.used_max);
+  chprintf(chp, "heap allocations : %lu (%lu failed)"SHELL_NEWLINE_STR,
+           (unsigned long)hs.allocs, (unsigned long)hs.failures);
+  chprintf(chp, "heap frees       : %lu"SHELL_NEWLINE_STR,
+           (unsigned long)hs.frees);
+  chprintf(chp, "heap sizes       :");
+  for (i = 0U; i < CH_HEAP_PROFILING_BINS - 1U; i++) {
+    chprintf(chp, " <=%u:%lu", CH_HEAP_PROFILING_BIN_SIZE(i),
+             (unsigned long)hs.hist[i]);
+  }
+  chprintf(chp, " >%u:%lu"SHELL_NEWLINE_STR,
+           CH_HEAP_PROFILING_BIN_SIZE(i - 1U), (unsigned long)hs.hist[i]);
+  chprintf(chp, "  thread   allocs    frees  alloc bytes   free bytes"SHELL_NEWLINE_STR);
+  for (i = 0U; i < (unsigned)CH_CFG_HEAP_PROFILING_THREADS; i++) {
+    heap_thread_stats_t *tsp = &hs.threads[i];
+
+    if ((tsp->allocs == 0U) && (tsp->frees == 0U)) {
+      continue;
+    }
+    chprintf(chp, "%08lx %8lu %8lu %12u %12u"SHELL_NEWLINE_STR,
+             (unsigned long)(uintptr_t)tsp->thread,
+             (unsigned long)tsp->allocs, (unsigned long)tsp->frees,
+             tsp->alloc_bytes, tsp->free_bytes);
+  }
+#endif
 }
 #endif
 
@@ -158,19 +209,49 @@ static void cmd_threads(BaseSequentialStream *chp, int argc, char *argv[]) {
   tp = chRegFirstThread();
   do {
 #if (CH_DBG_ENABLE_STACK_CHECK == TRUE) || (CH_CFG_USE_DYNAMIC == TRUE)
-    uint32_t stklimit = (uint32_t)tp->wabase;
+    unsigned long stklimit = (unsigned long)(uintptr_t)tp->wabase;
 #else
-    uint32_t stklimit = 0U;
+    unsigned long stklimit = 0UL;
 #endif
     chprintf(chp, "%08lx %08lx %08lx %4lu %4lu %9s %12s"SHELL_NEWLINE_STR,
-             stklimit, (uint32_t)tp->ctx.sp, (uint32_t)tp,
-             (uint32_t)tp->refs - 1, (uint32_t)tp->prio, states[tp->state],
-             tp->name == NULL ? "" : tp->name);
+             stklimit, (unsigned long)(uintptr_t)tp->ctx.sp,
+             (unsigned long)(uintptr_t)tp,
+             (unsigned long)tp->refs - 1UL, (unsigned long)tp->prio,
+             states[tp->state], tp->name == NULL ? "" : tp->name);
     tp = chRegNextThread(tp);
   } while (tp != NULL);
 }
 #endif
 
+#if ((SHELL_CMD_LOCKS_ENABLED == TRUE) && !defined(_CHIBIOS_NIL_) &&       \
+     (CH_DBG_LOCK_PROFILING == TRUE)) || defined(__DOXYGEN__)
+static void cmd_locks(BaseSequentialStream *chp, int argc, char *argv[]) {
+  lock_stats_t ls;
+  unsigned i;
+
+  if ((argc == 1) && (strcmp(argv[0], "reset") == 0)) {
+    chLockStatsResetAll();
+    return;
+  }
+  if (argc > 0) {
+    shellUsage(chp, "locks [reset]");
+    return;
+  }
+  chprintf(chp, "name         acquired contended  boosts   wait avg   wait max   hold max"SHELL_NEWLINE_STR);
+  for (i = 0U; chLockStatsGet(i, &ls); i++) {
+    rtcnt_t avg = ls.n_contended == (ucnt_t)0 ? (rtcnt_t)0 :
+                  (rtcnt_t)(ls.wait_cumulative / (rttime_t)ls.n_contended);
+
+    chprintf(chp, "%-12s %8lu %9lu %7lu %10lu %10lu %10lu"SHELL_NEWLINE_STR,
+             ls.name, (unsigned long)ls.n_acquire,
+             (unsigned long)ls.n_contended, (unsigned long)ls.n_boost,
+             (unsigned long)avg, (unsigned long)ls.wait_max,
+             (unsigned long)ls.hold_max);
+  }
+  chprintf(chp, "times in realtime counter cycles"SHELL_NEWLINE_STR);
+}
+#endif
+
 #if (SHELL_CMD_TEST_ENABLED == TRUE) || defined(__DOXYGEN__)
 static THD_FUNCTION(test_rt, arg) {
   BaseSequentialStream *chp = (BaseSequentialStream *)arg;
@@ -238,6 +319,10 @@ const ShellCommand shell_local_commands[] = {
 #if SHELL_CMD_THREADS_ENABLED == TRUE
   {"threads", cmd_threads},
 #endif
+#if (SHELL_CMD_LOCKS_ENABLED == TRUE) && !defined(_CHIBIOS_NIL_) &&         \
+    (CH_DBG_LOCK_PROFILING == TRUE)
+  {"locks", cmd_locks},
+#endif
 #if SHELL_CMD_TEST_ENABLED == TRUE
   {"test", cmd_test},
 #endif
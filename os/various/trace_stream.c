@@ -0,0 +1,352 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    trace_stream.c
+ * @brief   Trace buffer streamer code.
+ * @details A low priority thread drains the kernel trace buffer and writes
+ *          the records on a stream in a compact binary format.<br>
+ *          All the records start with a type byte and a length byte, the
+ *          length is the number of bytes following it. Multi-byte fields
+ *          are little endian, pointers and messages are sent with the
+ *          pointer size announced by the header.
+ *          - <b>Header</b>, sent once on start: "CHTS", version, system
+ *            time bits, time stamp bits, pointer size in bytes, system
+ *            time frequency (32 bits), realtime counter frequency
+ *            (32 bits).
+ *          - <b>Name</b>: pointer followed by the name characters, it
+ *            associates a name to a thread or ISR pointer.
+ *          - <b>Lost</b>: total number of records dropped by the trace
+ *            buffer (32 bits).
+ *          - <b>Event</b>: thread state or object event code, realtime
+ *            time stamp (24 bits), system time (32 bits) and two pointers
+ *            for switch and user events or one pointer for ISR and halt
+ *            events. Object events carry the object pointer followed by
+ *            the thread pointer, the message or the timer callback.
+ *          .
+ *          The tools/trace/chtrace2json.py script converts a captured
+ *          stream in a Chrome/Perfetto timeline.
+ * @note    ISRs invoked at a high rate, like the simulator serial driver
+ *          polling, can fill the buffer faster than the streamer drains
+ *          it, in that case @p CH_DBG_TRACE_MASK_ISR should be excluded
+ *          from @p CH_DBG_TRACE_MASK.
+ *
+ * @addtogroup trace_stream
+ * @{
+ */
+
+#include "ch.h"
+#include "hal.h"
+#include "trace_stream.h"
+
+/*===========================================================================*/
+/* Module local definitions.                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief   Maximum length of a sent name.
+ */
+#define TRS_NAME_MAX                32U
+
+/**
+ * @brief   Size of the pointer fields.
+ */
+#define TRS_ID_SIZE                 sizeof (uintptr_t)
+
+/*===========================================================================*/
+/* Module exported variables.                                                */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local types.                                                       */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* Module local variables.                                                   */
+/*===========================================================================*/
+
+static THD_WORKING_AREA(trs_wa, TRACE_STREAM_STACK_SIZE);
+
+static ch_trace_event_t trs_events[TRACE_STREAM_BATCH_SIZE];
+
+static const void *trs_names[TRACE_STREAM_NAMES];
+
+static unsigned trs_names_next;
+
+/*===========================================================================*/
+/* Module local functions.                                                   */
+/*===========================================================================*/
+
+static uint8_t *trs_put32(uint8_t *p, uint32_t w) {
+
+  p[0] = (uint8_t)w;
+  p[1] = (uint8_t)(w >> 8);
+  p[2] = (uint8_t)(w >> 16);
+  p[3] = (uint8_t)(w >> 24);
+
+  return p + 4;
+}
+
+static uint8_t *trs_putid(uint8_t *p, uintptr_t id) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)TRS_ID_SIZE; i++) {
+    p[i] = (uint8_t)id;
+    id >>= 8;
+  }
+
+  return p + TRS_ID_SIZE;
+}
+
+static uintptr_t trs_id(const void *p) {
+
+  return (uintptr_t)p;
+}
+
+/**
+ * @brief   Checks if the name of a pointer has already been sent.
+ *
+ * @param[in] p         pointer to be named
+ * @return              The name state.
+ * @retval false        if the name has not been sent.
+ * @retval true         if the name has been sent.
+ */
+static bool trs_name_sent(const void *p) {
+  unsigned i;
+
+  for (i = 0U; i < (unsigned)TRACE_STREAM_NAMES; i++) {
+    if (trs_names[i] == p) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief   Sends a name record if the name has not already been sent.
+ *
+ * @param[in] chp       output stream
+ * @param[in] p         pointer to be named
+ * @param[in] name      the name or @p NULL if not known
+ */
+static void trs_name(BaseSequentialStream *chp, const void *p,
+                     const char *name) {
+  uint8_t buf[2U + TRS_ID_SIZE + TRS_NAME_MAX];
+  size_t n;
+
+  if ((p == NULL) || (name == NULL) || trs_name_sent(p)) {
+    return;
+  }
+
+  /* The oldest name is forgotten.*/
+  trs_names[trs_names_next] = p;
+  trs_names_next = (trs_names_next + 1U) % (unsigned)TRACE_STREAM_NAMES;
+
+  n = 0U;
+  while ((n < TRS_NAME_MAX) && (name[n] != '\0')) {
+    buf[2U + TRS_ID_SIZE + n] = (uint8_t)name[n];
+    n++;
+  }
+  buf[0] = (uint8_t)TRACE_STREAM_TYPE_NAME;
+  buf[1] = (uint8_t)(TRS_ID_SIZE + n);
+  (void) trs_putid(&buf[2], trs_id(p));
+  (void) streamWrite(chp, buf, 2U + TRS_ID_SIZE + n);
+}
+
+/**
+ * @brief   Sends the name of a thread.
+ *
+ * @param[in] chp       output stream
+ * @param[in] tp        pointer to the thread
+ */
+static void trs_thread_name(BaseSequentialStream *chp, thread_t *tp) {
+#if CH_CFG_USE_REGISTRY == TRUE
+  thread_t *ctp;
+
+  /* Registry scans are not cheap, skipping threads already named.*/
+  if (trs_name_sent(tp)) {
+    return;
+  }
+
+  /* The thread could be already terminated, the name is only taken from
+     threads still in the registry.*/
+  ctp = chRegFindThreadByPointer(tp);
+  if (ctp != NULL) {
+    trs_name(chp, ctp, chRegGetThreadNameX(ctp));
+#if CH_CFG_USE_DYNAMIC == TRUE
+    chThdRelease(ctp);
+#endif
+  }
+#else
+  (void)chp;
+  (void)tp;
+#endif
+}
+
+/**
+ * @brief   Sends a trace buffer event.
+ *
+ * @param[in] chp       output stream
+ * @param[in] tep       pointer to the event
+ */
+static void trs_event(BaseSequentialStream *chp, const ch_trace_event_t *tep) {
+  uint8_t buf[2U + 1U + 3U + 4U + (2U * TRS_ID_SIZE)];
+  uint8_t *p = &buf[2];
+
+  *p++ = (uint8_t)tep->state;
+  *p++ = (uint8_t)tep->rtstamp;
+  *p++ = (uint8_t)(tep->rtstamp >> 8);
+  *p++ = (uint8_t)(tep->rtstamp >> 16);
+  p = trs_put32(p, (uint32_t)tep->time);
+
+  switch (tep->type) {
+  case CH_TRACE_TYPE_SWITCH:
+    trs_thread_name(chp, tep->u.sw.ntp);
+    p = trs_putid(p, trs_id(tep->u.sw.ntp));
+    p = trs_putid(p, trs_id(tep->u.sw.wtobjp));
+    break;
+  case CH_TRACE_TYPE_ISR_ENTER:
+  case CH_TRACE_TYPE_ISR_LEAVE:
+    trs_name(chp, tep->u.isr.name, tep->u.isr.name);
+    p = trs_putid(p, trs_id(tep->u.isr.name));
+    break;
+  case CH_TRACE_TYPE_HALT:
+    trs_name(chp, tep->u.halt.reason, tep->u.halt.reason);
+    p = trs_putid(p, trs_id(tep->u.halt.reason));
+    break;
+  case CH_TRACE_TYPE_USER:
+    p = trs_putid(p, trs_id(tep->u.user.up1));
+    p = trs_putid(p, trs_id(tep->u.user.up2));
+    break;
+  case CH_TRACE_TYPE_SEM:
+  case CH_TRACE_TYPE_MTX:
+    if (tep->u.sync.tp != NULL) {
+      trs_thread_name(chp, tep->u.sync.tp);
+    }
+    p = trs_putid(p, trs_id(tep->u.sync.objp));
+    p = trs_putid(p, trs_id(tep->u.sync.tp));
+    break;
+  case CH_TRACE_TYPE_MB:
+    p = trs_putid(p, trs_id(tep->u.mb.mbp));
+    p = trs_putid(p, (uintptr_t)tep->u.mb.msg);
+    break;
+  case CH_TRACE_TYPE_VT:
+    p = trs_putid(p, trs_id(tep->u.vt.vtp));
+    p = trs_putid(p, (uintptr_t)tep->u.vt.vtfunc);
+    break;
+  default:
+    break;
+  }
+
+  buf[0] = (uint8_t)tep->type;
+  buf[1] = (uint8_t)(p - &buf[2]);
+  (void) streamWrite(chp, buf, (size_t)(p - buf));
+}
+
+/**
+ * @brief   Sends the stream header.
+ *
+ * @param[in] cfgp      pointer to the streamer configuration
+ */
+static void trs_header(const trace_stream_config_t *cfgp) {
+  uint8_t buf[2U + 16U];
+  uint8_t *p = &buf[2];
+
+  *p++ = (uint8_t)'C';
+  *p++ = (uint8_t)'H';
+  *p++ = (uint8_t)'T';
+  *p++ = (uint8_t)'S';
+  *p++ = (uint8_t)TRACE_STREAM_VERSION;
+  *p++ = (uint8_t)CH_CFG_ST_RESOLUTION;
+  *p++ = 24U;
+  *p++ = (uint8_t)TRS_ID_SIZE;
+  p = trs_put32(p, (uint32_t)CH_CFG_ST_FREQUENCY);
+  p = trs_put32(p, cfgp->rtfreq);
+
+  buf[0] = (uint8_t)TRACE_STREAM_TYPE_HEADER;
+  buf[1] = (uint8_t)(p - &buf[2]);
+  (void) streamWrite(cfgp->stream, buf, (size_t)(p - buf));
+}
+
+/**
+ * @brief   Streamer thread.
+ *
+ * @param[in] p         pointer to the streamer configuration
+ */
+static THD_FUNCTION(trs_thread, p) {
+  const trace_stream_config_t *cfgp = p;
+  ucnt_t lost = (ucnt_t)0;
+
+  chRegSetThreadName("trace");
+
+  trs_header(cfgp);
+
+  while (!chThdShouldTerminateX()) {
+    size_t i, n;
+
+    n = chDbgFetchTrace(trs_events, (size_t)TRACE_STREAM_BATCH_SIZE);
+    for (i = 0U; i < n; i++) {
+      trs_event(cfgp->stream, &trs_events[i]);
+    }
+
+    /* Reporting records dropped because the buffer was full.*/
+    if (chDbgGetTraceLostX() != lost) {
+      uint8_t buf[2U + 4U];
+
+      lost = chDbgGetTraceLostX();
+      buf[0] = (uint8_t)TRACE_STREAM_TYPE_LOST;
+      buf[1] = 4U;
+      (void) trs_put32(&buf[2], (uint32_t)lost);
+      (void) streamWrite(cfgp->stream, buf, sizeof buf);
+    }
+
+    if (n == 0U) {
+      chThdSleep(cfgp->period);
+    }
+  }
+}
+
+/*===========================================================================*/
+/* Module exported functions.                                                */
+/*===========================================================================*/
+
+/**
+ * @brief   Starts the trace streamer.
+ * @note    Only one streamer can be active, it is the only consumer of
+ *          the trace buffer.
+ *
+ * @param[in] cfgp      pointer to the streamer configuration, it must stay
+ *                      valid while the streamer is active
+ * @param[in] prio      streamer thread priority, usually a low one
+ * @return              The streamer thread, it can be stopped using
+ *                      @p chThdTerminate().
+ */
+thread_t *trsStart(const trace_stream_config_t *cfgp, tprio_t prio) {
+  unsigned i;
+
+  chDbgCheck((cfgp != NULL) && (cfgp->stream != NULL));
+
+  for (i = 0U; i < (unsigned)TRACE_STREAM_NAMES; i++) {
+    trs_names[i] = NULL;
+  }
+  trs_names_next = 0U;
+
+  return chThdCreateStatic(trs_wa, sizeof trs_wa, prio,
+                           trs_thread, (void *)cfgp);
+}
+
+/** @} */
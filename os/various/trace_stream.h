@@ -0,0 +1,141 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+/**
+ * @file    trace_stream.h
+ * @brief   Trace buffer streamer macros and structures.
+ *
+ * @addtogroup trace_stream
+ * @{
+ */
+
+#ifndef TRACE_STREAM_H
+#define TRACE_STREAM_H
+
+/*===========================================================================*/
+/* Module constants.                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Stream format version.
+ */
+#define TRACE_STREAM_VERSION        2U
+
+/**
+ * @name    Stream records types
+ * @details Records with a type lower than @p TRACE_STREAM_TYPE_HEADER
+ *          are trace buffer events of the same type.
+ * @{
+ */
+#define TRACE_STREAM_TYPE_HEADER    0x80U
+#define TRACE_STREAM_TYPE_NAME      0x81U
+#define TRACE_STREAM_TYPE_LOST      0x82U
+/** @} */
+
+/*===========================================================================*/
+/* Module pre-compile time settings.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Streamer thread stack size.
+ */
+#if !defined(TRACE_STREAM_STACK_SIZE) || defined(__DOXYGEN__)
+#define TRACE_STREAM_STACK_SIZE     512
+#endif
+
+/**
+ * @brief   Number of records fetched from the trace buffer at once.
+ * @note    The records are fetched within a critical zone.
+ */
+#if !defined(TRACE_STREAM_BATCH_SIZE) || defined(__DOXYGEN__)
+#define TRACE_STREAM_BATCH_SIZE     8
+#endif
+
+/**
+ * @brief   Number of names remembered by the streamer.
+ * @details The name of a thread or of an ISR is sent once, the first
+ *          time it is referred by a record.
+ */
+#if !defined(TRACE_STREAM_NAMES) || defined(__DOXYGEN__)
+#define TRACE_STREAM_NAMES          16
+#endif
+
+/*===========================================================================*/
+/* Derived constants and error checks.                                       */
+/*===========================================================================*/
+
+/*
+ * Module dependencies check.
+ */
+#if (CH_DBG_TRACE_MASK == CH_DBG_TRACE_MASK_DISABLED) ||                    \
+    (CH_DBG_TRACE_STREAM == FALSE)
+#error "Trace streamer requires CH_DBG_TRACE_MASK and CH_DBG_TRACE_STREAM"
+#endif
+
+#if TRACE_STREAM_BATCH_SIZE < 1
+#error "invalid TRACE_STREAM_BATCH_SIZE value"
+#endif
+
+#if TRACE_STREAM_NAMES < 1
+#error "invalid TRACE_STREAM_NAMES value"
+#endif
+
+/*===========================================================================*/
+/* Module data structures and types.                                         */
+/*===========================================================================*/
+
+/**
+ * @brief   Type of a trace streamer configuration.
+ */
+typedef struct {
+  /**
+   * @brief   Output stream.
+   */
+  BaseSequentialStream  *stream;
+  /**
+   * @brief   Realtime counter frequency in Hz or zero if not known.
+   * @details If zero then the decoder only uses the system time.
+   */
+  uint32_t              rtfreq;
+  /**
+   * @brief   Trace buffer polling interval when empty.
+   */
+  sysinterval_t         period;
+} trace_stream_config_t;
+
+/*===========================================================================*/
+/* Module macros.                                                            */
+/*===========================================================================*/
+
+/*===========================================================================*/
+/* External declarations.                                                    */
+/*===========================================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+  thread_t *trsStart(const trace_stream_config_t *cfgp, tprio_t prio);
+#ifdef __cplusplus
+}
+#endif
+
+/*===========================================================================*/
+/* Module inline functions.                                                  */
+/*===========================================================================*/
+
+#endif /* TRACE_STREAM_H */
+
+/** @} */
@@ -202,7 +202,6 @@ uint32_t TimeNowInMilliseconds(void)
 
 void *chHeapRealloc (void *addr, uint32_t size)
 {
-    union heap_header *hp;
     uint32_t prev_size, new_size;
 
     void *ptr;
@@ -211,9 +210,7 @@ void *chHeapRealloc (void *addr, uint32_t size)
         return chHeapAlloc(NULL, size);
     }
 
-    /* previous allocated segment is preceded by an heap_header */
-    hp = addr - sizeof(union heap_header);
-    prev_size = hp->used.size; /* size is always multiple of 8 */
+    prev_size = chHeapGetSize(addr);
 
     /* check new size memory alignment */
     if(size % 8 == 0) {
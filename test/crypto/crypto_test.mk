@@ -9,7 +9,9 @@ TESTSRC += 	 ${CHIBIOS}/test/crypto/source/test/cry_test_root.c \
            	 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_004.c		\
 			 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_005.c		\
 			 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_006.c		\
-			 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_007.c
+			 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_007.c		\
+			 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_008.c		\
+			 ${CHIBIOS}/test/crypto/source/test/cry_test_sequence_009.c
 # Required include directories
 TESTINC +=  ${CHIBIOS}/test/crypto/source/testref	\
 			${CHIBIOS}/test/crypto/source/test
@@ -28,6 +28,8 @@
  * - @subpage cry_test_sequence_005
  * - @subpage cry_test_sequence_006
  * - @subpage cry_test_sequence_007
+ * - @subpage cry_test_sequence_008
+ * - @subpage cry_test_sequence_009
  * .
  */
 
@@ -53,9 +55,15 @@ const testsequence_t * const cry_test_suite_array[] = {
   &cry_test_sequence_002,
   &cry_test_sequence_003,
   &cry_test_sequence_004,
+#if (CRY_LLD_SUPPORTS_TRNG == TRUE) || defined(__DOXYGEN__)
   &cry_test_sequence_005,
+#endif
   &cry_test_sequence_006,
   &cry_test_sequence_007,
+  &cry_test_sequence_008,
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+  &cry_test_sequence_009,
+#endif
   NULL
 };
 
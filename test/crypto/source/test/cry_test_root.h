@@ -31,6 +31,8 @@
 #include "cry_test_sequence_005.h"
 #include "cry_test_sequence_006.h"
 #include "cry_test_sequence_007.h"
+#include "cry_test_sequence_008.h"
+#include "cry_test_sequence_009.h"
 
 #if !defined(__DOXYGEN__)
 
@@ -73,6 +73,7 @@ static const CRYConfig config_DMA = {
  * - [1.1.7] loading the key with 32 byte size.
  * - [1.1.8] Encrypt.
  * - [1.1.9] Decrypt.
+ * - [1.1.10] Encrypt and decrypt with a size not multiple of the block size.
  * .
  */
 
@@ -205,6 +206,18 @@ static void cry_test_001_001_execute(void) {
     }
 
   }
+
+  /* [1.1.10] Encrypt and decrypt with a size not multiple of the block size.*/
+  test_set_step(10);
+  {
+    ret = cryEncryptAES_ECB(&CRYD1, 0, 20, (uint8_t*) msg_clear, (uint8_t*) msg_encrypted);
+
+    test_assert(ret == CRY_ERR_INV_ALGO, "invalid size accepted");
+
+    ret = cryDecryptAES_ECB(&CRYD1, 0, 20, (uint8_t*) msg_encrypted, (uint8_t*) msg_decrypted);
+
+    test_assert(ret == CRY_ERR_INV_ALGO, "invalid size accepted");
+  }
 }
 
 static const testcase_t cry_test_001_001 = {
@@ -73,6 +73,7 @@ static const CRYConfig config_DMA = {
  * - [3.1.7] loading the key with 32 byte size.
  * - [3.1.8] Encrypt.
  * - [3.1.9] Decrypt.
+ * - [3.1.10] Encrypt and decrypt with a size not multiple of the block size.
  * .
  */
 
@@ -205,6 +206,18 @@ static void cry_test_003_001_execute(void) {
     }
 
   }
+
+  /* [3.1.10] Encrypt and decrypt with a size not multiple of the block size.*/
+  test_set_step(10);
+  {
+    ret = cryEncryptAES_CBC(&CRYD1, 0, 20, (uint8_t*) msg_clear, (uint8_t*) msg_encrypted,(uint8_t*)test_vectors);
+
+    test_assert(ret == CRY_ERR_INV_ALGO, "invalid size accepted");
+
+    ret = cryDecryptAES_CBC(&CRYD1, 0, 20, (uint8_t*) msg_encrypted, (uint8_t*) msg_decrypted,(uint8_t*)test_vectors);
+
+    test_assert(ret == CRY_ERR_INV_ALGO, "invalid size accepted");
+  }
 }
 
 static const testcase_t cry_test_003_001 = {
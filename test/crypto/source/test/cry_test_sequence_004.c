@@ -157,6 +157,7 @@ static const testcase_t cry_test_004_001 = {
  * - [4.2.4] loading the key with 24 byte size.
  * - [4.2.5] Encrypt.
  * - [4.2.6] Decrypt.
+ * - [4.2.7] Encrypt and decrypt with a size not multiple of the block size.
  * .
  */
 
@@ -251,6 +252,18 @@ static void cry_test_004_002_execute(void) {
     }
 
   }
+
+  /* [4.2.7] Encrypt and decrypt with a size not multiple of the block size.*/
+  test_set_step(7);
+  {
+    ret = cryEncryptDES_CBC(&CRYD1, 0, 20, (uint8_t*) msg_clear, (uint8_t*) msg_encrypted,(uint8_t*)test_vectors);
+
+    test_assert(ret == CRY_ERR_INV_ALGO, "invalid size accepted");
+
+    ret = cryDecryptDES_CBC(&CRYD1, 0, 20, (uint8_t*) msg_encrypted, (uint8_t*) msg_decrypted,(uint8_t*)test_vectors);
+
+    test_assert(ret == CRY_ERR_INV_ALGO, "invalid size accepted");
+  }
 }
 
 static const testcase_t cry_test_004_002 = {
@@ -28,11 +28,19 @@
  * <h2>Description</h2>
  * TRNG testing.
  *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CRY_LLD_SUPPORTS_TRNG == TRUE
+ * .
+ *
  * <h2>Test Cases</h2>
  * - @subpage cry_test_005_001
  * .
  */
 
+#if (CRY_LLD_SUPPORTS_TRNG == TRUE) || defined(__DOXYGEN__)
+
 /****************************************************************************
  * Shared code.
  ****************************************************************************/
@@ -126,3 +134,5 @@ const testsequence_t cry_test_sequence_005 = {
   "TRNG",
   cry_test_sequence_005_array
 };
+
+#endif /* CRY_LLD_SUPPORTS_TRNG == TRUE */
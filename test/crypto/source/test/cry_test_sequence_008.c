@@ -0,0 +1,417 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cry_test_root.h"
+
+/**
+ * @file    cry_test_sequence_008.c
+ * @brief   Test Sequence 008 code.
+ *
+ * @page cry_test_sequence_008 [8] Streaming
+ *
+ * File: @ref cry_test_sequence_008.c
+ *
+ * <h2>Description</h2>
+ * Incremental SHA and AES-GCM operations fed in chunks of uneven sizes.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cry_test_008_001
+ * - @subpage cry_test_008_002
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+
+static const CRYConfig configStream_Polling = {
+  TRANSFER_POLLING,
+  0,
+  0
+};
+
+/*
+ * Chunk sizes used by the incremental operations, they are not multiple
+ * of any block size and include an empty update.
+ */
+static const size_t chunks[] = {1, 3, 0, 7, 13, 29, 64, 5, 127, 17, 200};
+
+#define CHUNKS_NUM          (sizeof chunks / sizeof chunks[0])
+
+/*
+ * SHA256 of one million 'a' characters.
+ */
+static const uint8_t sha256_1m_a[32] = {
+  0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92,
+  0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+  0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e,
+  0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+};
+
+/*
+ * AES-GCM test case 4 from the GCM specification.
+ */
+static const uint8_t gcm_key[16] = {
+  0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+  0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08
+};
+
+static const uint8_t gcm_iv[16] = {
+  0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+  0xde, 0xca, 0xf8, 0x88, 0x00, 0x00, 0x00, 0x01
+};
+
+static const uint8_t gcm_aad[20] = {
+  0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+  0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef,
+  0xab, 0xad, 0xda, 0xd2
+};
+
+static const uint8_t gcm_plain[60] = {
+  0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5,
+  0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+  0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+  0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+  0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53,
+  0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+  0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57,
+  0xba, 0x63, 0x7b, 0x39
+};
+
+static const uint8_t gcm_cypher[60] = {
+  0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+  0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+  0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+  0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+  0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+  0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+  0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+  0x3d, 0x58, 0xe0, 0x91
+};
+
+static const uint8_t gcm_tag[16] = {
+  0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb,
+  0x94, 0xfa, 0xe9, 0x5a, 0xe7, 0x12, 0x1a, 0x47
+};
+
+static uint8_t digest1[64];
+static uint8_t digest2[64];
+static uint8_t stream_buffer[256];
+
+/*
+ * Size of the i-th chunk of an incremental operation.
+ */
+static size_t chunk_size(size_t i, size_t pos, size_t size) {
+  size_t n = chunks[i % CHUNKS_NUM];
+
+  return n < size - pos ? n : size - pos;
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cry_test_008_001 [8.1] SHA streaming
+ *
+ * <h2>Description</h2>
+ * The SHA digests are computed feeding the data in chunks of uneven
+ * sizes and compared with the one-shot results and with a reference.
+ *
+ * <h2>Test Steps</h2>
+ * - [8.1.1] SHA1 of the test data fed in chunks of uneven sizes, the
+ *   digest must match the one-shot result.
+ * - [8.1.2] SHA256 of the test data fed in chunks of uneven sizes, the
+ *   digest must match the one-shot result.
+ * - [8.1.3] SHA512 of the test data fed in chunks of uneven sizes, the
+ *   digest must match the one-shot result.
+ * - [8.1.4] SHA256 of one million 'a' characters fed in chunks of
+ *   uneven sizes, the digest must match the reference.
+ * .
+ */
+
+static void cry_test_008_001_setup(void) {
+  cryStart(&CRYD1, &configStream_Polling);
+}
+
+static void cry_test_008_001_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_008_001_execute(void) {
+  cryerror_t ret;
+  SHA1Context sha1ctx;
+  SHA256Context sha256ctx;
+  SHA512Context sha512ctx;
+  size_t i, n, pos;
+
+  /* [8.1.1] SHA1 of the test data fed in chunks of uneven sizes, the
+     digest must match the one-shot result.*/
+  test_set_step(1);
+  {
+    ret = crySHA1(&CRYD1, TEST_DATA_BYTE_LEN,
+                  (const uint8_t *)test_plain_data, digest1);
+    test_assert(ret == CRY_NOERROR, "sha1 failed");
+
+    ret = crySHA1Init(&CRYD1, &sha1ctx);
+    test_assert(ret == CRY_NOERROR, "sha1 init failed");
+    for (i = 0U, pos = 0U; pos < TEST_DATA_BYTE_LEN; i++, pos += n) {
+      n = chunk_size(i, pos, TEST_DATA_BYTE_LEN);
+      ret = crySHA1Update(&CRYD1, &sha1ctx, n,
+                          (const uint8_t *)&test_plain_data[pos]);
+      test_assert(ret == CRY_NOERROR, "sha1 update failed");
+    }
+    ret = crySHA1Final(&CRYD1, &sha1ctx, digest2);
+    test_assert(ret == CRY_NOERROR, "sha1 final failed");
+
+    test_assert(memcmp(digest1, digest2, 20) == 0, "sha1 digest mismatch");
+  }
+
+  /* [8.1.2] SHA256 of the test data fed in chunks of uneven sizes, the
+     digest must match the one-shot result.*/
+  test_set_step(2);
+  {
+    ret = crySHA256(&CRYD1, TEST_DATA_BYTE_LEN,
+                    (const uint8_t *)test_plain_data, digest1);
+    test_assert(ret == CRY_NOERROR, "sha256 failed");
+
+    ret = crySHA256Init(&CRYD1, &sha256ctx);
+    test_assert(ret == CRY_NOERROR, "sha256 init failed");
+    for (i = 0U, pos = 0U; pos < TEST_DATA_BYTE_LEN; i++, pos += n) {
+      n = chunk_size(i, pos, TEST_DATA_BYTE_LEN);
+      ret = crySHA256Update(&CRYD1, &sha256ctx, n,
+                            (const uint8_t *)&test_plain_data[pos]);
+      test_assert(ret == CRY_NOERROR, "sha256 update failed");
+    }
+    ret = crySHA256Final(&CRYD1, &sha256ctx, digest2);
+    test_assert(ret == CRY_NOERROR, "sha256 final failed");
+
+    test_assert(memcmp(digest1, digest2, 32) == 0, "sha256 digest mismatch");
+  }
+
+  /* [8.1.3] SHA512 of the test data fed in chunks of uneven sizes, the
+     digest must match the one-shot result.*/
+  test_set_step(3);
+  {
+    ret = crySHA512(&CRYD1, TEST_DATA_BYTE_LEN,
+                    (const uint8_t *)test_plain_data, digest1);
+    test_assert(ret == CRY_NOERROR, "sha512 failed");
+
+    ret = crySHA512Init(&CRYD1, &sha512ctx);
+    test_assert(ret == CRY_NOERROR, "sha512 init failed");
+    for (i = 0U, pos = 0U; pos < TEST_DATA_BYTE_LEN; i++, pos += n) {
+      n = chunk_size(i, pos, TEST_DATA_BYTE_LEN);
+      ret = crySHA512Update(&CRYD1, &sha512ctx, n,
+                            (const uint8_t *)&test_plain_data[pos]);
+      test_assert(ret == CRY_NOERROR, "sha512 update failed");
+    }
+    ret = crySHA512Final(&CRYD1, &sha512ctx, digest2);
+    test_assert(ret == CRY_NOERROR, "sha512 final failed");
+
+    test_assert(memcmp(digest1, digest2, 64) == 0, "sha512 digest mismatch");
+  }
+
+  /* [8.1.4] SHA256 of one million 'a' characters fed in chunks of
+     uneven sizes, the digest must match the reference.*/
+  test_set_step(4);
+  {
+    memset(stream_buffer, 'a', sizeof stream_buffer);
+    ret = crySHA256Init(&CRYD1, &sha256ctx);
+    test_assert(ret == CRY_NOERROR, "sha256 init failed");
+    for (i = 0U, pos = 0U; pos < 1000000U; i++, pos += n) {
+      n = chunk_size(i, pos, 1000000U);
+      ret = crySHA256Update(&CRYD1, &sha256ctx, n, stream_buffer);
+      test_assert(ret == CRY_NOERROR, "sha256 update failed");
+    }
+    ret = crySHA256Final(&CRYD1, &sha256ctx, digest2);
+    test_assert(ret == CRY_NOERROR, "sha256 final failed");
+
+    test_assert(memcmp(digest2, sha256_1m_a, 32) == 0,
+                "sha256 digest mismatch");
+  }
+}
+
+static const testcase_t cry_test_008_001 = {
+  "SHA streaming",
+  cry_test_008_001_setup,
+  cry_test_008_001_teardown,
+  cry_test_008_001_execute
+};
+
+#if ((CRY_LLD_SUPPORTS_AES_GCM == FALSE) && (HAL_CRY_USE_FALLBACK == TRUE)) || defined(__DOXYGEN__)
+/**
+ * @page cry_test_008_002 [8.2] AES-GCM streaming
+ *
+ * <h2>Description</h2>
+ * The AES-GCM operations are performed feeding the authentication data
+ * and the text in chunks of uneven sizes and compared with a reference
+ * and with the one-shot results. Chunks of any size are supported by
+ * the fall-back implementation only.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - (CRY_LLD_SUPPORTS_AES_GCM == FALSE) && (HAL_CRY_USE_FALLBACK == TRUE)
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [8.2.1] Loading the test case key.
+ * - [8.2.2] Encrypting the test case in chunks of uneven sizes, the
+ *   cyphertext and the tag must match the reference.
+ * - [8.2.3] Decrypting the test case in chunks of different sizes, the
+ *   plaintext and the tag must match the reference.
+ * - [8.2.4] Encrypting the test data in chunks of uneven sizes, the
+ *   cyphertext and the tag must match the one-shot result.
+ * .
+ */
+
+static void cry_test_008_002_setup(void) {
+  cryStart(&CRYD1, &configStream_Polling);
+}
+
+static void cry_test_008_002_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_008_002_execute(void) {
+  cryerror_t ret;
+  AESGCMContext gcmctx;
+  size_t i, n, pos;
+
+  /* [8.2.1] Loading the test case key.*/
+  test_set_step(1);
+  {
+    ret = cryLoadTransientKey(&CRYD1, cry_algo_aes, sizeof gcm_key, gcm_key);
+    test_assert(ret == CRY_NOERROR, "failed load transient key");
+  }
+
+  /* [8.2.2] Encrypting the test case in chunks of uneven sizes, the
+     cyphertext and the tag must match the reference.*/
+  test_set_step(2);
+  {
+    ret = cryAES_GCMInit(&CRYD1, &gcmctx, 0, gcm_iv);
+    test_assert(ret == CRY_NOERROR, "gcm init failed");
+    for (i = 0U, pos = 0U; pos < sizeof gcm_aad; i++, pos += n) {
+      n = chunk_size(i, pos, sizeof gcm_aad);
+      ret = cryAES_GCMUpdateAAD(&CRYD1, &gcmctx, n, &gcm_aad[pos]);
+      test_assert(ret == CRY_NOERROR, "gcm aad update failed");
+    }
+    for (pos = 0U; pos < sizeof gcm_plain; i++, pos += n) {
+      n = chunk_size(i, pos, sizeof gcm_plain);
+      ret = cryEncryptAES_GCMUpdate(&CRYD1, &gcmctx, n, &gcm_plain[pos],
+                                    &stream_buffer[pos]);
+      test_assert(ret == CRY_NOERROR, "gcm encrypt update failed");
+    }
+    ret = cryAES_GCMFinal(&CRYD1, &gcmctx, digest1);
+    test_assert(ret == CRY_NOERROR, "gcm final failed");
+
+    test_assert(memcmp(stream_buffer, gcm_cypher, sizeof gcm_cypher) == 0,
+                "encrypt mismatch");
+    test_assert(memcmp(digest1, gcm_tag, sizeof gcm_tag) == 0, "tag mismatch");
+  }
+
+  /* [8.2.3] Decrypting the test case in chunks of different sizes, the
+     plaintext and the tag must match the reference.*/
+  test_set_step(3);
+  {
+    ret = cryAES_GCMInit(&CRYD1, &gcmctx, 0, gcm_iv);
+    test_assert(ret == CRY_NOERROR, "gcm init failed");
+    for (i = 5U, pos = 0U; pos < sizeof gcm_aad; i++, pos += n) {
+      n = chunk_size(i, pos, sizeof gcm_aad);
+      ret = cryAES_GCMUpdateAAD(&CRYD1, &gcmctx, n, &gcm_aad[pos]);
+      test_assert(ret == CRY_NOERROR, "gcm aad update failed");
+    }
+    for (pos = 0U; pos < sizeof gcm_cypher; i++, pos += n) {
+      n = chunk_size(i, pos, sizeof gcm_cypher);
+      ret = cryDecryptAES_GCMUpdate(&CRYD1, &gcmctx, n, &gcm_cypher[pos],
+                                    &stream_buffer[pos]);
+      test_assert(ret == CRY_NOERROR, "gcm decrypt update failed");
+    }
+    ret = cryAES_GCMFinal(&CRYD1, &gcmctx, digest1);
+    test_assert(ret == CRY_NOERROR, "gcm final failed");
+
+    test_assert(memcmp(stream_buffer, gcm_plain, sizeof gcm_plain) == 0,
+                "decrypt mismatch");
+    test_assert(memcmp(digest1, gcm_tag, sizeof gcm_tag) == 0, "tag mismatch");
+  }
+
+  /* [8.2.4] Encrypting the test data in chunks of uneven sizes, the
+     cyphertext and the tag must match the one-shot result.*/
+  test_set_step(4);
+  {
+    ret = cryEncryptAES_GCM(&CRYD1, 0, TEST_DATA_BYTE_LEN,
+                            (const uint8_t *)test_plain_data,
+                            (uint8_t *)msg_encrypted, gcm_iv,
+                            32U, (const uint8_t *)test_plain_data, digest1);
+    test_assert(ret == CRY_NOERROR, "encrypt failed");
+
+    ret = cryAES_GCMInit(&CRYD1, &gcmctx, 0, gcm_iv);
+    test_assert(ret == CRY_NOERROR, "gcm init failed");
+    for (i = 0U, pos = 0U; pos < 32U; i++, pos += n) {
+      n = chunk_size(i, pos, 32U);
+      ret = cryAES_GCMUpdateAAD(&CRYD1, &gcmctx, n,
+                                (const uint8_t *)&test_plain_data[pos]);
+      test_assert(ret == CRY_NOERROR, "gcm aad update failed");
+    }
+    for (pos = 0U; pos < TEST_DATA_BYTE_LEN; i++, pos += n) {
+      n = chunk_size(i, pos, TEST_DATA_BYTE_LEN);
+      ret = cryEncryptAES_GCMUpdate(&CRYD1, &gcmctx, n,
+                                    (const uint8_t *)&test_plain_data[pos],
+                                    (uint8_t *)msg_decrypted + pos);
+      test_assert(ret == CRY_NOERROR, "gcm encrypt update failed");
+    }
+    ret = cryAES_GCMFinal(&CRYD1, &gcmctx, digest2);
+    test_assert(ret == CRY_NOERROR, "gcm final failed");
+
+    test_assert(memcmp(msg_encrypted, msg_decrypted, TEST_DATA_BYTE_LEN) == 0,
+                "encrypt mismatch");
+    test_assert(memcmp(digest1, digest2, 16) == 0, "tag mismatch");
+  }
+}
+
+static const testcase_t cry_test_008_002 = {
+  "AES-GCM streaming",
+  cry_test_008_002_setup,
+  cry_test_008_002_teardown,
+  cry_test_008_002_execute
+};
+#endif /* CRY_LLD_SUPPORTS_AES_GCM == FALSE */
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cry_test_sequence_008_array[] = {
+  &cry_test_008_001,
+#if ((CRY_LLD_SUPPORTS_AES_GCM == FALSE) && (HAL_CRY_USE_FALLBACK == TRUE)) || defined(__DOXYGEN__)
+  &cry_test_008_002,
+#endif
+  NULL
+};
+
+/**
+ * @brief   Streaming.
+ */
+const testsequence_t cry_test_sequence_008 = {
+  "Streaming",
+  cry_test_sequence_008_array
+};
@@ -0,0 +1,316 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "cry_test_root.h"
+
+/**
+ * @file    cry_test_sequence_009.c
+ * @brief   Test Sequence 009 code.
+ *
+ * @page cry_test_sequence_009 [9] Jobs
+ *
+ * File: @ref cry_test_sequence_009.c
+ *
+ * <h2>Description</h2>
+ * Asynchronous jobs queue, the jobs are executed by the LLD or
+ * synchronously by the submitting threads depending on the driver
+ * capabilities.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - HAL_CRY_USE_ASYNC == TRUE
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage cry_test_009_001
+ * - @subpage cry_test_009_002
+ * .
+ */
+
+#if (HAL_CRY_USE_ASYNC == TRUE) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include <string.h>
+#include "ref_aes.h"
+
+#define JOBS_THREADS        3U
+#define JOBS_PER_THREAD     8U
+#define JOBS_SLICE_SIZE     20U
+
+static const CRYConfig configJobs_Polling = {
+  TRANSFER_POLLING,
+  0,
+  0
+};
+
+static cryjob_t jobs[4];
+static cryjob_t *jobs_order[4];
+static unsigned jobs_completed;
+static uint8_t digest1[32];
+static uint8_t digest2[32];
+
+static cryjob_t tjobs[JOBS_THREADS][JOBS_PER_THREAD];
+static unsigned texecutions[JOBS_THREADS][JOBS_PER_THREAD];
+static cryerror_t tresults[JOBS_THREADS][JOBS_PER_THREAD];
+static uint8_t tdigests[JOBS_THREADS][JOBS_PER_THREAD][32];
+static THD_WORKING_AREA(waJobs[JOBS_THREADS], 2048);
+
+/*
+ * Records the jobs completion order.
+ */
+static void order_callback(CRYDriver *cryp, cryjob_t *jobp) {
+
+  (void)cryp;
+
+  if (jobs_completed < 4U) {
+    jobs_order[jobs_completed] = jobp;
+  }
+  jobs_completed++;
+}
+
+/*
+ * Counts the executions of a job.
+ */
+static void count_callback(CRYDriver *cryp, cryjob_t *jobp) {
+
+  (void)cryp;
+
+  (*(unsigned *)jobp->arg)++;
+}
+
+/*
+ * Thread submitting a sequence of SHA256 jobs, each job hashes a distinct
+ * slice of the test data.
+ */
+static THD_FUNCTION(jobs_thread, arg) {
+  unsigned t = (unsigned)(uintptr_t)arg;
+  unsigned k;
+
+  for (k = 0U; k < JOBS_PER_THREAD; k++) {
+    size_t pos = (size_t)((t * JOBS_PER_THREAD) + k) * JOBS_SLICE_SIZE;
+
+    cryJobObjectInit(&tjobs[t][k], count_callback, &texecutions[t][k]);
+    crySubmitJob(&CRYD1, &tjobs[t][k], cry_op_sha256, 0, JOBS_SLICE_SIZE,
+                 (const uint8_t *)&test_plain_data[pos], tdigests[t][k],
+                 NULL);
+    if ((k & 1U) != 0U) {
+      chThdYield();
+    }
+  }
+  for (k = 0U; k < JOBS_PER_THREAD; k++) {
+    tresults[t][k] = cryWaitJob(&CRYD1, &tjobs[t][k]);
+  }
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page cry_test_009_001 [9.1] Jobs queue
+ *
+ * <h2>Description</h2>
+ * A batch of jobs is submitted without waiting, the jobs must complete
+ * in submission order with the same results of the synchronous API, a
+ * job with an invalid size must fail without affecting the others.
+ *
+ * <h2>Test Steps</h2>
+ * - [9.1.1] Loading the key with 16 byte size.
+ * - [9.1.2] Submitting AES-ECB, AES-CBC, SHA256 jobs and an AES-CBC job
+ *   with a size not multiple of the block size.
+ * - [9.1.3] Waiting for the jobs, the results must match the references
+ *   and the callbacks must have been invoked in submission order.
+ * .
+ */
+
+static void cry_test_009_001_setup(void) {
+  cryStart(&CRYD1, &configJobs_Polling);
+}
+
+static void cry_test_009_001_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_009_001_execute(void) {
+  cryerror_t ret;
+  unsigned k;
+
+  /* [9.1.1] Loading the key with 16 byte size.*/
+  test_set_step(1);
+  {
+    ret = cryLoadTransientKey(&CRYD1, cry_algo_aes, 16,
+                              (const uint8_t *)test_keys);
+    test_assert(ret == CRY_NOERROR, "failed load transient key");
+  }
+
+  /* [9.1.2] Submitting AES-ECB, AES-CBC, SHA256 jobs and an AES-CBC job
+     with a size not multiple of the block size.*/
+  test_set_step(2);
+  {
+    jobs_completed = 0U;
+    for (k = 0U; k < 4U; k++) {
+      cryJobObjectInit(&jobs[k], order_callback, NULL);
+    }
+    crySubmitJob(&CRYD1, &jobs[0], cry_op_encrypt_aes_ecb, 0,
+                 TEST_DATA_BYTE_LEN, (const uint8_t *)test_plain_data,
+                 (uint8_t *)msg_encrypted, NULL);
+    crySubmitJob(&CRYD1, &jobs[1], cry_op_encrypt_aes_cbc, 0,
+                 TEST_DATA_BYTE_LEN, (const uint8_t *)test_plain_data,
+                 (uint8_t *)msg_decrypted, (const uint8_t *)test_vectors);
+    crySubmitJob(&CRYD1, &jobs[2], cry_op_sha256, 0,
+                 TEST_DATA_BYTE_LEN, (const uint8_t *)test_plain_data,
+                 digest1, NULL);
+    crySubmitJob(&CRYD1, &jobs[3], cry_op_encrypt_aes_cbc, 0,
+                 20U, (const uint8_t *)test_plain_data,
+                 (uint8_t *)msg_clear, (const uint8_t *)test_vectors);
+  }
+
+  /* [9.1.3] Waiting for the jobs, the results must match the references
+     and the callbacks must have been invoked in submission order.*/
+  test_set_step(3);
+  {
+    test_assert(cryWaitJob(&CRYD1, &jobs[0]) == CRY_NOERROR, "ecb job failed");
+    test_assert(cryWaitJob(&CRYD1, &jobs[1]) == CRY_NOERROR, "cbc job failed");
+    test_assert(cryWaitJob(&CRYD1, &jobs[2]) == CRY_NOERROR,
+                "sha256 job failed");
+    test_assert(cryWaitJob(&CRYD1, &jobs[3]) == CRY_ERR_INV_ALGO,
+                "invalid size accepted");
+    test_assert(jobs_completed == 4U, "wrong callbacks count");
+    for (k = 0U; k < 4U; k++) {
+      test_assert(jobs[k].state == CRY_JOB_DONE, "job not done");
+      test_assert(jobs_order[k] == &jobs[k], "wrong completion order");
+    }
+
+    test_assert(memcmp(msg_encrypted, refAES_ECB_128, TEST_DATA_BYTE_LEN) == 0,
+                "ecb mismatch");
+    test_assert(memcmp(msg_decrypted, refAES_CBC_128, TEST_DATA_BYTE_LEN) == 0,
+                "cbc mismatch");
+    ret = crySHA256(&CRYD1, TEST_DATA_BYTE_LEN,
+                    (const uint8_t *)test_plain_data, digest2);
+    test_assert(ret == CRY_NOERROR, "sha256 failed");
+    test_assert(memcmp(digest1, digest2, 32) == 0, "sha256 mismatch");
+  }
+}
+
+static const testcase_t cry_test_009_001 = {
+  "Jobs queue",
+  cry_test_009_001_setup,
+  cry_test_009_001_teardown,
+  cry_test_009_001_execute
+};
+
+/**
+ * @page cry_test_009_002 [9.2] Concurrent jobs
+ *
+ * <h2>Description</h2>
+ * Threads with different priorities submit jobs concurrently and then
+ * wait for them, each job must be executed exactly once and produce the
+ * same result of the synchronous API.
+ *
+ * <h2>Test Steps</h2>
+ * - [9.2.1] Starting the threads, the first one has lower priority than
+ *   the test thread and the last one higher.
+ * - [9.2.2] Waiting for the threads termination.
+ * - [9.2.3] Checking that each job has been executed once with the
+ *   expected result.
+ * .
+ */
+
+static void cry_test_009_002_setup(void) {
+  memset(texecutions, 0, sizeof texecutions);
+cryStart(&CRYD1, &configJobs_Polling);
+}
+
+static void cry_test_009_002_teardown(void) {
+  cryStop(&CRYD1);
+}
+
+static void cry_test_009_002_execute(void) {
+  thread_t *tps[JOBS_THREADS];
+  unsigned t, k;
+
+  /* [9.2.1] Starting the threads, the first one has lower priority than
+     the test thread and the last one higher.*/
+  test_set_step(1);
+  {
+    for (t = 0U; t < JOBS_THREADS; t++) {
+      tps[t] = chThdCreateStatic(waJobs[t], sizeof waJobs[t],
+                                 chThdGetPriorityX() + t - 1U,
+                                 jobs_thread, (void *)(uintptr_t)t);
+    }
+  }
+
+  /* [9.2.2] Waiting for the threads termination.*/
+  test_set_step(2);
+  {
+    for (t = 0U; t < JOBS_THREADS; t++) {
+      chThdWait(tps[t]);
+    }
+  }
+
+  /* [9.2.3] Checking that each job has been executed once with the
+     expected result.*/
+  test_set_step(3);
+  {
+    for (t = 0U; t < JOBS_THREADS; t++) {
+      for (k = 0U; k < JOBS_PER_THREAD; k++) {
+        size_t pos = (size_t)((t * JOBS_PER_THREAD) + k) * JOBS_SLICE_SIZE;
+
+        test_assert(texecutions[t][k] == 1U, "job not executed once");
+        test_assert(tresults[t][k] == CRY_NOERROR, "job failed");
+        (void) crySHA256(&CRYD1, JOBS_SLICE_SIZE,
+                         (const uint8_t *)&test_plain_data[pos], digest2);
+        test_assert(memcmp(tdigests[t][k], digest2, 32) == 0,
+                    "sha256 mismatch");
+      }
+    }
+  }
+}
+
+static const testcase_t cry_test_009_002 = {
+  "Concurrent jobs",
+  cry_test_009_002_setup,
+  cry_test_009_002_teardown,
+  cry_test_009_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const cry_test_sequence_009_array[] = {
+  &cry_test_009_001,
+  &cry_test_009_002,
+  NULL
+};
+
+/**
+ * @brief   Jobs.
+ */
+const testsequence_t cry_test_sequence_009 = {
+  "Jobs",
+  cry_test_sequence_009_array
+};
+
+#endif /* HAL_CRY_USE_ASYNC == TRUE */
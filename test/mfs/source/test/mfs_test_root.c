@@ -23,6 +23,8 @@
  * <h2>Test Sequences</h2>
  * - @subpage mfs_test_sequence_001
  * - @subpage mfs_test_sequence_002
+ * - @subpage mfs_test_sequence_003
+ * - @subpage mfs_test_sequence_004
  * .
  */
 
@@ -44,8 +46,14 @@
  * @brief   Array of test sequences.
  */
 const testsequence_t * const mfs_test_suite_array[] = {
+#if (MFS_CFG_LOG_SECTORS == 0) || defined(__DOXYGEN__)
   &mfs_test_sequence_001,
+#endif
   &mfs_test_sequence_002,
+  &mfs_test_sequence_003,
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+  &mfs_test_sequence_004,
+#endif
   NULL
 };
 
@@ -70,6 +78,7 @@ void test_print_mfs_info(void) {
 
 }
 
+#if MFS_CFG_LOG_SECTORS == 0
 flash_error_t bank_erase(mfs_bank_t bank) {
   flash_sector_t sector, n;
 
@@ -118,5 +127,18 @@ flash_error_t bank_verify_erased(mfs_bank_t bank) {
   }
   return FLASH_NO_ERROR;
 }
+#endif
+
+void gc_complete(void) {
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  uint32_t msec;
+
+  while (mfsPerformGarbageCollectionStep(&mfs1, &msec) == MFS_WARN_GC) {
+    if (msec > 0U) {
+      osalThreadSleepMilliseconds(msec);
+    }
+  }
+#endif
+}
 
 #endif /* !defined(__DOXYGEN__) */
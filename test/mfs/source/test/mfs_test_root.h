@@ -26,6 +26,8 @@
 
 #include "mfs_test_sequence_001.h"
 #include "mfs_test_sequence_002.h"
+#include "mfs_test_sequence_003.h"
+#include "mfs_test_sequence_004.h"
 
 #if !defined(__DOXYGEN__)
 
@@ -56,8 +58,11 @@ extern const MFSConfig mfscfg1;
 extern MFSDriver mfs1;
 extern uint8_t mfs_buffer[512];
 
+#if MFS_CFG_LOG_SECTORS == 0
 flash_error_t bank_erase(mfs_bank_t bank);
 flash_error_t bank_verify_erased(mfs_bank_t bank);
+#endif
+void gc_complete(void);
 void test_print_mfs_info(void);
 
 #endif /* !defined(__DOXYGEN__) */
@@ -29,6 +29,12 @@
  * The APIs are tested for functionality, correct cases and expected
  * error cases are tested.
  *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_LOG_SECTORS == 0
+ * .
+ *
  * <h2>Test Cases</h2>
  * - @subpage mfs_test_001_001
  * - @subpage mfs_test_001_002
@@ -37,9 +43,17 @@
  * - @subpage mfs_test_001_005
  * - @subpage mfs_test_001_006
  * - @subpage mfs_test_001_007
+ * - @subpage mfs_test_001_008
+ * - @subpage mfs_test_001_009
+ * - @subpage mfs_test_001_010
+ * - @subpage mfs_test_001_011
+ * - @subpage mfs_test_001_012
+ * - @subpage mfs_test_001_013
  * .
  */
 
+#if (MFS_CFG_LOG_SECTORS == 0) || defined(__DOXYGEN__)
+
 /****************************************************************************
  * Shared code.
  ****************************************************************************/
@@ -95,6 +109,16 @@ static const uint8_t pattern512[] = {
   48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63
 };
 
+#define TAIL_SIZE           (sizeof (mfs_data_header_t) / 2U)
+
+static size_t tail_space(void) {
+  flash_sector_t sector = mfs1.current_bank == MFS_BANK_0 ?
+                          mfscfg1.bank0_start : mfscfg1.bank1_start;
+
+  return (size_t)flashGetSectorOffset(mfscfg1.flashp, sector) +
+         (size_t)mfscfg1.bank_size - (size_t)mfs1.next_offset;
+}
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -409,7 +433,7 @@ static void mfs_test_001_005_execute(void) {
   test_set_step(1);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + sizeof pattern512);
 
     for (id = 1; id <= id_max; id++) {
@@ -434,7 +458,7 @@ static void mfs_test_001_005_execute(void) {
   test_set_step(2);
   {
     mfs_error_t err;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + sizeof pattern512);
 
     err = mfsWriteRecord(&mfs1, id_max, sizeof pattern512 , pattern512);
@@ -527,7 +551,7 @@ static void mfs_test_001_006_execute(void) {
   test_set_step(1);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + sizeof pattern512);
 
     for (id = 1; id <= id_max; id++) {
@@ -567,17 +591,18 @@ static void mfs_test_001_006_execute(void) {
   {
     mfs_error_t err;
     size_t size;
+    uint32_t counter = mfs1.current_counter;
 
-    test_assert(mfs1.current_counter == 1, "not first instance");
     err = mfsWriteRecord(&mfs1, 1, sizeof pattern512, pattern512);
     test_assert(err == MFS_WARN_GC, "error creating the record");
-    test_assert(mfs1.current_counter == 2, "not second instance");
+    test_assert(mfs1.current_counter == counter + 1U, "not next instance");
     size = sizeof mfs_buffer;
     err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
     test_assert(err == MFS_NO_ERROR, "record not found");
     test_assert(size == sizeof pattern512, "unexpected record length");
     test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
     test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    gc_complete();
     test_assert(bank_verify_erased(MFS_BANK_0) == FLASH_NO_ERROR, "bank 0 not erased");
   }
 
@@ -586,7 +611,7 @@ static void mfs_test_001_006_execute(void) {
   test_set_step(4);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + sizeof pattern512);
 
     for (id = 1; id <= MFS_CFG_MAX_RECORDS; id++) {
@@ -628,17 +653,18 @@ static void mfs_test_001_006_execute(void) {
   {
     mfs_error_t err;
     size_t size;
+    uint32_t counter = mfs1.current_counter;
 
-    test_assert(mfs1.current_counter == 2, "not second instance");
     err = mfsWriteRecord(&mfs1, 1, sizeof pattern512, pattern512);
     test_assert(err == MFS_WARN_GC, "error creating the record");
-    test_assert(mfs1.current_counter == 3, "not third instance");
+    test_assert(mfs1.current_counter == counter + 1U, "not next instance");
     size = sizeof mfs_buffer;
     err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
     test_assert(err == MFS_NO_ERROR, "record not found");
     test_assert(size == sizeof pattern512, "unexpected record length");
     test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
     test_assert(mfs1.current_bank == MFS_BANK_0, "unexpected bank");
+    gc_complete();
     test_assert(bank_verify_erased(MFS_BANK_1) == FLASH_NO_ERROR, "bank 1 not erased");
   }
 
@@ -647,7 +673,7 @@ static void mfs_test_001_006_execute(void) {
   test_set_step(7);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + sizeof pattern512);
 
     for (id = 1; id <= MFS_CFG_MAX_RECORDS; id++) {
@@ -710,7 +736,7 @@ static void mfs_test_001_007_execute(void) {
   test_set_step(1);
   {
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + (sizeof pattern512 / 2));
 
     for (id = 1; id <= id_max; id++) {
@@ -733,9 +759,9 @@ static void mfs_test_001_007_execute(void) {
     mfs_error_t err;
     size_t size;
     mfs_id_t id;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + (sizeof pattern512 / 2));
-    mfs_id_t n = ((mfscfg1.bank_size - sizeof (mfs_bank_header_t)) -
+    mfs_id_t n = ((mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) -
                   (id_max * (sizeof (mfs_data_header_t) + (sizeof pattern512 / 2)))) /
                  sizeof (mfs_data_header_t);
 
@@ -755,17 +781,18 @@ static void mfs_test_001_007_execute(void) {
   {
     mfs_error_t err;
     size_t size;
-    mfs_id_t id_max = (mfscfg1.bank_size - sizeof (mfs_bank_header_t)) /
+    mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
                       (sizeof (mfs_data_header_t) + (sizeof pattern512 / 2));
+    uint32_t counter = mfs1.current_counter;
 
-    test_assert(mfs1.current_counter == 1, "not first instance");
     err = mfsEraseRecord(&mfs1, id_max);
     test_assert(err == MFS_WARN_GC, "error erasing the record");
-    test_assert(mfs1.current_counter == 2, "not second instance");
+    test_assert(mfs1.current_counter == counter + 1U, "not next instance");
     size = sizeof mfs_buffer;
     err = mfsReadRecord(&mfs1, id_max, &size, mfs_buffer);
     test_assert(err == MFS_ERR_NOT_FOUND, "record not erased");
     test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    gc_complete();
     test_assert(bank_verify_erased(MFS_BANK_0) == FLASH_NO_ERROR, "bank 0 not erased");
   }
 }
@@ -777,6 +804,817 @@ static const testcase_t mfs_test_001_007 = {
   mfs_test_001_007_execute
 };
 
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_008 [1.8] Testing sparse records identifiers
+ *
+ * <h2>Description</h2>
+ * Records are written using identifiers spread over the whole
+ * identifiers range until the records index is full, the storage is
+ * then mounted again and records are checked.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_SPARSE_IDS == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [1.8.1] Filling up the records index using sparse identifiers in
+ *   decreasing order, MFS_NO_ERROR is expected.
+ * - [1.8.2] Creating one more record, MFS_ERR_OUT_OF_MEM is expected
+ *   because the records index is full.
+ * - [1.8.3] Mounting the storage again and reading all records,
+ *   MFS_NO_ERROR is expected, record content and size are compared
+ *   with the original. An unused identifier must not be found.
+ * .
+ */
+
+static void mfs_test_001_008_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_008_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_008_execute(void) {
+  size_t size;
+
+  /* [1.8.1] Filling up the records index using sparse identifiers in
+     decreasing order, MFS_NO_ERROR is expected.*/
+  test_set_step(1);
+  {
+    mfs_id_t i;
+
+    for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+      mfs_id_t id = MFS_ID_MAX - (i * (MFS_ID_MAX / MFS_CFG_MAX_RECORDS));
+      mfs_error_t err = mfsWriteRecord(&mfs1, id, sizeof id, (const uint8_t *)&id);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+  }
+
+  /* [1.8.2] Creating one more record, MFS_ERR_OUT_OF_MEM is expected
+     because the records index is full.*/
+  test_set_step(2);
+  {
+    mfs_id_t id = 1U;
+    mfs_error_t err = mfsWriteRecord(&mfs1, id, sizeof id, (const uint8_t *)&id);
+    test_assert(err == MFS_ERR_OUT_OF_MEM, "record index not full");
+  }
+
+  /* [1.8.3] Mounting the storage again and reading all records,
+     MFS_NO_ERROR is expected, record content and size are compared
+     with the original. An unused identifier must not be found.*/
+  test_set_step(3);
+  {
+    mfs_id_t i;
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount failed");
+
+    for (i = 0; i < MFS_CFG_MAX_RECORDS; i++) {
+      mfs_id_t id = MFS_ID_MAX - (i * (MFS_ID_MAX / MFS_CFG_MAX_RECORDS));
+      size = sizeof mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == sizeof id, "unexpected record length");
+      test_assert(memcmp(&id, mfs_buffer, size) == 0, "wrong record content");
+    }
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1U, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record was present");
+  }
+}
+
+static const testcase_t mfs_test_001_008 = {
+  "Testing sparse records identifiers",
+  mfs_test_001_008_setup,
+  mfs_test_001_008_teardown,
+  mfs_test_001_008_execute
+};
+#endif /* MFS_CFG_SPARSE_IDS == TRUE */
+
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_009 [1.9] Testing incremental garbage collection
+ *
+ * <h2>Description</h2>
+ * A garbage collection is triggered by writing, the collection is
+ * left pending while records are read and the storage is mounted
+ * again, then it is completed by steps.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_INCREMENTAL_GC == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [1.9.1] Filling up the storage then updating a record triggers a
+ *   garbage collection, MFS_WARN_GC is expected, the bank is switched
+ *   but the old bank is not yet erased.
+ * - [1.9.2] Reading all records while the collection is pending,
+ *   MFS_NO_ERROR is expected for each record.
+ * - [1.9.3] Mounting the storage while the collection is pending,
+ *   MFS_WARN_REPAIR is expected, all records must be present.
+ * - [1.9.4] Completing the collection by steps, the old bank must be
+ *   erased and statistics updated.
+ * .
+ */
+
+static void mfs_test_001_009_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_009_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_009_execute(void) {
+  mfs_gc_stats_t stats;
+  mfs_id_t id_max = (mfscfg1.bank_size - MFS_BANK_DATA_OFFSET) /
+                    (sizeof (mfs_data_header_t) + sizeof pattern512);
+
+  /* [1.9.1] Filling up the storage then updating a record triggers a
+     garbage collection, MFS_WARN_GC is expected, the bank is switched but
+     the old bank is not yet erased.*/
+  test_set_step(1);
+  {
+    mfs_id_t id;
+    mfs_error_t err;
+
+    for (id = 1; id <= id_max; id++) {
+      err = mfsWriteRecord(&mfs1, id, sizeof pattern512, pattern512);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+    err = mfsEraseRecord(&mfs1, 1);
+    test_assert(err == MFS_NO_ERROR, "error erasing the record");
+
+    stats = *mfsGetGarbageCollectionStats(&mfs1);
+    err = mfsWriteRecord(&mfs1, 1, sizeof pattern512, pattern512);
+    test_assert(err == MFS_WARN_GC, "error creating the record");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.gc_state == MFS_GC_MOVING, "collection not pending");
+    test_assert(bank_verify_erased(MFS_BANK_0) != FLASH_NO_ERROR, "bank 0 erased");
+  }
+
+  /* [1.9.2] Reading all records while the collection is pending,
+     MFS_NO_ERROR is expected for each record.*/
+  test_set_step(2);
+  {
+    mfs_id_t id;
+
+    for (id = 1; id <= id_max; id++) {
+      mfs_error_t err;
+      size_t size;
+
+      size = sizeof mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == sizeof pattern512, "unexpected record length");
+      test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
+    }
+  }
+
+  /* [1.9.3] Mounting the storage while the collection is pending,
+     MFS_WARN_REPAIR is expected, all records must be present.*/
+  test_set_step(3);
+  {
+    mfs_id_t id;
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_WARN_REPAIR, "unexpected mount status");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.gc_state == MFS_GC_MOVING, "collection not resumed");
+
+    for (id = 1; id <= id_max; id++) {
+      size_t size;
+
+      size = sizeof mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == sizeof pattern512, "unexpected record length");
+      test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
+    }
+  }
+
+  /* [1.9.4] Completing the collection by steps, the old bank must be erased
+     and statistics updated.*/
+  test_set_step(4);
+  {
+    const mfs_gc_stats_t *sp = mfsGetGarbageCollectionStats(&mfs1);
+
+    gc_complete();
+    test_assert(mfs1.gc_state == MFS_GC_IDLE, "collection not completed");
+    test_assert(bank_verify_erased(MFS_BANK_0) == FLASH_NO_ERROR, "bank 0 not erased");
+    test_assert(sp->collections == stats.collections + 1U, "wrong collections count");
+    test_assert(sp->moved_records == stats.moved_records + id_max - 1U, "wrong moved records count");
+    test_assert(sp->erased_sectors == stats.erased_sectors + mfscfg1.bank0_sectors, "wrong erased sectors count");
+  }
+}
+
+static const testcase_t mfs_test_001_009 = {
+  "Testing incremental garbage collection",
+  mfs_test_001_009_setup,
+  mfs_test_001_009_teardown,
+  mfs_test_001_009_execute
+};
+#endif /* MFS_CFG_INCREMENTAL_GC == TRUE */
+
+#if (MFS_CFG_INDEX_CHECKPOINT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_010 [1.10] Testing index checkpoint
+ *
+ * <h2>Description</h2>
+ * Records are written, erased and collected, the storage is mounted
+ * again after each operation with and without stopping it, the records
+ * index must be restored from the checkpoint and from records written
+ * after it.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_INDEX_CHECKPOINT == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [1.10.1] Writing some records then mounting the storage again after
+ *   a clean stop, MFS_NO_ERROR is expected, the records index is loaded
+ *   from the checkpoint and no records are scanned.
+ * - [1.10.2] Writing a record then mounting the storage again without
+ *   stopping it, MFS_NO_ERROR is expected, the record written after the
+ *   checkpoint is found by scanning.
+ * - [1.10.3] Erasing a record then mounting the storage again after a
+ *   clean stop, MFS_NO_ERROR is expected, the erased record must not be
+ *   present.
+ * - [1.10.4] Performing a garbage collection then mounting the storage
+ *   again without stopping it, MFS_NO_ERROR is expected, the checkpoint
+ *   written by the collection covers all records.
+ * .
+ */
+
+static void mfs_test_001_010_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_010_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_010_execute(void) {
+
+  /* [1.10.1] Writing some records then mounting the storage again after
+     a clean stop, MFS_NO_ERROR is expected, the records index is loaded
+     from the checkpoint and no records are scanned.*/
+  test_set_step(1);
+  {
+    mfs_id_t id;
+    mfs_error_t err;
+
+    for (id = 1; id <= 4; id++) {
+      err = mfsWriteRecord(&mfs1, id, sizeof pattern512, pattern512);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfs1.checkpoint_offset != 0U, "checkpoint not loaded");
+    test_assert(mfs1.checkpoint_offset == mfs1.next_offset, "records scanned");
+  }
+
+  /* [1.10.2] Writing a record then mounting the storage again without
+     stopping it, MFS_NO_ERROR is expected, the record written after the
+     checkpoint is found by scanning.*/
+  test_set_step(2);
+  {
+    mfs_id_t id;
+    mfs_error_t err;
+
+    err = mfsWriteRecord(&mfs1, 5, sizeof pattern512, pattern512);
+    test_assert(err == MFS_NO_ERROR, "error creating the record");
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfs1.checkpoint_offset != 0U, "checkpoint not loaded");
+    test_assert(mfs1.checkpoint_offset < mfs1.next_offset, "records not scanned");
+
+    for (id = 1; id <= 5; id++) {
+      size_t size;
+
+      size = sizeof mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == sizeof pattern512, "unexpected record length");
+      test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
+    }
+  }
+
+  /* [1.10.3] Erasing a record then mounting the storage again after a
+     clean stop, MFS_NO_ERROR is expected, the erased record must not be
+     present.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    err = mfsEraseRecord(&mfs1, 2);
+    test_assert(err == MFS_NO_ERROR, "error erasing the record");
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfs1.checkpoint_offset == mfs1.next_offset, "records scanned");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record not erased");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 5, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record not found");
+  }
+
+  /* [1.10.4] Performing a garbage collection then mounting the storage
+     again without stopping it, MFS_NO_ERROR is expected, the checkpoint
+     written by the collection covers all records.*/
+  test_set_step(4);
+  {
+    mfs_id_t id;
+    mfs_error_t err;
+    uint32_t counter = mfs1.current_counter;
+
+    err = mfsPerformGarbageCollection(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error performing the collection");
+    gc_complete();
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfs1.current_counter == counter + 1U, "not next instance");
+    test_assert(mfs1.checkpoint_offset == mfs1.next_offset, "records scanned");
+
+    for (id = 1; id <= 5; id++) {
+      size_t size;
+
+      size = sizeof mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, mfs_buffer);
+      if (id == 2) {
+        test_assert(err == MFS_ERR_NOT_FOUND, "record not erased");
+      }
+      else {
+        test_assert(err == MFS_NO_ERROR, "record not found");
+        test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
+      }
+    }
+  }
+}
+
+static const testcase_t mfs_test_001_010 = {
+  "Testing index checkpoint",
+  mfs_test_001_010_setup,
+  mfs_test_001_010_teardown,
+  mfs_test_001_010_execute
+};
+#endif /* MFS_CFG_INDEX_CHECKPOINT == TRUE */
+
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+/**
+ * @page mfs_test_001_011 [1.11] Testing transactions
+ *
+ * <h2>Description</h2>
+ * Records are written and erased within transactions, the changes must
+ * become visible only on commit and must be discarded on rollback and
+ * when the transaction is interrupted.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_TRANSACTION_MAX > 0
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [1.11.1] Writing three records within a transaction then committing
+ *   it, the records must not be visible before the commit and must be
+ *   present after mounting the storage again.
+ * - [1.11.2] Updating a record and erasing another within a transaction
+ *   then rolling it back, the records must be unchanged, also after
+ *   mounting the storage again.
+ * - [1.11.3] Updating a record and erasing another within a transaction
+ *   then mounting the storage again without committing it,
+ *   MFS_WARN_REPAIR is expected, the records must be unchanged.
+ * - [1.11.4] Exceeding the transaction space and performing invalid
+ *   operations within a transaction, the errors must be reported and
+ *   the transaction must still be usable.
+ * .
+ */
+
+static void mfs_test_001_011_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_011_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_011_execute(void) {
+
+  /* [1.11.1] Writing three records within a transaction then committing
+     it, the records must not be visible before the commit and must be
+     present after mounting the storage again.*/
+  test_set_step(1);
+  {
+    mfs_id_t id;
+    mfs_error_t err;
+    size_t size;
+
+    err = mfsStartTransaction(&mfs1, 3 * (sizeof (mfs_data_header_t) +
+                                          sizeof pattern512));
+    test_assert(err == MFS_NO_ERROR, "error starting the transaction");
+
+    for (id = 1; id <= 3; id++) {
+      err = mfsWriteRecord(&mfs1, id, sizeof pattern512, pattern512);
+      test_assert(err == MFS_NO_ERROR, "error writing the record");
+    }
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record visible before commit");
+
+    err = mfsCommitTransaction(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error committing the transaction");
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+
+    for (id = 1; id <= 3; id++) {
+      size = sizeof mfs_buffer;
+      err = mfsReadRecord(&mfs1, id, &size, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      test_assert(size == sizeof pattern512, "unexpected record length");
+      test_assert(memcmp(pattern512, mfs_buffer, size) == 0, "wrong record content");
+    }
+  }
+
+  /* [1.11.2] Updating a record and erasing another within a transaction
+     then rolling it back, the records must be unchanged, also after
+     mounting the storage again.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    err = mfsStartTransaction(&mfs1, 2 * sizeof (mfs_data_header_t) +
+                                     sizeof pattern512 / 2);
+    test_assert(err == MFS_NO_ERROR, "error starting the transaction");
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof pattern512 / 2, pattern512);
+    test_assert(err == MFS_NO_ERROR, "error writing the record");
+    err = mfsEraseRecord(&mfs1, 2);
+    test_assert(err == MFS_NO_ERROR, "error erasing the record");
+    err = mfsRollbackTransaction(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error rolling back the transaction");
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record not found");
+    test_assert(size == sizeof pattern512, "record updated");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record erased");
+  }
+
+  /* [1.11.3] Updating a record and erasing another within a transaction
+     then mounting the storage again without committing it,
+     MFS_WARN_REPAIR is expected, the records must be unchanged.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    err = mfsStartTransaction(&mfs1, 2 * sizeof (mfs_data_header_t) +
+                                     sizeof pattern512 / 2);
+    test_assert(err == MFS_NO_ERROR, "error starting the transaction");
+
+    err = mfsWriteRecord(&mfs1, 1, sizeof pattern512 / 2, pattern512);
+    test_assert(err == MFS_NO_ERROR, "error writing the record");
+    err = mfsEraseRecord(&mfs1, 2);
+    test_assert(err == MFS_NO_ERROR, "error erasing the record");
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_WARN_REPAIR, "unexpected mount status");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record not found");
+    test_assert(size == sizeof pattern512, "record updated");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record erased");
+  }
+
+  /* [1.11.4] Exceeding the transaction space and performing invalid
+     operations within a transaction, the errors must be reported and
+     the transaction must still be usable.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+
+    err = mfsStartTransaction(&mfs1, sizeof (mfs_data_header_t) + 16U);
+    test_assert(err == MFS_NO_ERROR, "error starting the transaction");
+
+    err = mfsWriteRecord(&mfs1, 4, 32U, pattern512);
+    test_assert(err == MFS_ERR_TRANSACTION_SIZE, "transaction space exceeded");
+    err = mfsEraseRecord(&mfs1, 4);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record found");
+    err = mfsStartTransaction(&mfs1, sizeof (mfs_data_header_t));
+    test_assert(err == MFS_ERR_INV_STATE, "nested transaction");
+    err = mfsPerformGarbageCollection(&mfs1);
+    test_assert(err == MFS_ERR_INV_STATE, "collection within a transaction");
+
+    err = mfsWriteRecord(&mfs1, 4, 16U, pattern512);
+    test_assert(err == MFS_NO_ERROR, "error writing the record");
+    err = mfsCommitTransaction(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error committing the transaction");
+    err = mfsCommitTransaction(&mfs1);
+    test_assert(err == MFS_ERR_INV_STATE, "no transaction to commit");
+  }
+}
+
+static const testcase_t mfs_test_001_011 = {
+  "Testing transactions",
+  mfs_test_001_011_setup,
+  mfs_test_001_011_teardown,
+  mfs_test_001_011_execute
+};
+#endif /* MFS_CFG_TRANSACTION_MAX > 0 */
+
+/**
+ * @page mfs_test_001_012 [1.12] Testing bank tails shorter than a header
+ *
+ * <h2>Description</h2>
+ * The free space at the end of a bank is left shorter than a record
+ * header by erase operations, the storage must be mounted without
+ * repairs and without reading beyond the bank boundary.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.12.1] Filling bank 0 so that a record header plus half a header
+ *   of free space is left, then erasing a record, the remaining space
+ *   must be shorter than a header.
+ * - [1.12.2] Mounting the storage again, MFS_NO_ERROR is expected, the
+ *   free space must be unchanged and the records must be readable.
+ * - [1.12.3] Performing a garbage collection, the storage is moved to
+ *   bank 1.
+ * - [1.12.4] Filling bank 1 the same way with new records then erasing
+ *   an old one, the remaining space must be shorter than a header.
+ * - [1.12.5] Mounting the storage again, MFS_NO_ERROR is expected, the
+ *   free space must be unchanged and the records must be readable.
+ * .
+ */
+
+static void mfs_test_001_012_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_012_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_012_execute(void) {
+  mfs_id_t id_last = 0;
+
+  /* [1.12.1] Filling bank 0 so that a record header plus half a header of
+     free space is left, then erasing a record, the remaining space must
+     be shorter than a header.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+    size_t remaining;
+
+    test_assert(mfs1.current_bank == MFS_BANK_0, "unexpected bank");
+
+    for (;;) {
+      size_t n;
+
+      remaining = tail_space();
+      if (remaining <= (sizeof (mfs_data_header_t) * 2U) + TAIL_SIZE) {
+        break;
+      }
+      n = remaining - (sizeof (mfs_data_header_t) * 2U) - TAIL_SIZE;
+      if (n > 1024U) {
+        n = 512U;
+      }
+      else if (n > 512U) {
+        n = n / 2U;
+      }
+      id_last++;
+      err = mfsWriteRecord(&mfs1, id_last, n, pattern512);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+    test_assert(remaining == sizeof (mfs_data_header_t) + TAIL_SIZE,
+                "unexpected remaining space");
+
+    err = mfsEraseRecord(&mfs1, 1);
+    test_assert(err == MFS_NO_ERROR, "error erasing the record");
+    test_assert(tail_space() == TAIL_SIZE, "unexpected remaining space");
+  }
+
+  /* [1.12.2] Mounting the storage again, MFS_NO_ERROR is expected, the
+     free space must be unchanged and the records must be readable.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+    flash_offset_t next_offset = mfs1.next_offset;
+    size_t size;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfs1.current_bank == MFS_BANK_0, "unexpected bank");
+    test_assert(mfs1.next_offset == next_offset, "unexpected next offset");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record not erased");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, id_last, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record not found");
+    test_assert(memcmp(pattern512, mfs_buffer, size) == 0,
+                "wrong record content");
+  }
+
+  /* [1.12.3] Performing a garbage collection, the storage is moved to
+     bank 1.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    err = mfsPerformGarbageCollection(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error performing garbage collection");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+  }
+
+  /* [1.12.4] Filling bank 1 the same way with new records then erasing an
+     old one, the remaining space must be shorter than a header.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+    size_t remaining;
+
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+
+    for (;;) {
+      size_t n;
+
+      remaining = tail_space();
+      if (remaining <= (sizeof (mfs_data_header_t) * 2U) + TAIL_SIZE) {
+        break;
+      }
+      n = remaining - (sizeof (mfs_data_header_t) * 2U) - TAIL_SIZE;
+      if (n > 1024U) {
+        n = 512U;
+      }
+      else if (n > 512U) {
+        n = n / 2U;
+      }
+      id_last++;
+      err = mfsWriteRecord(&mfs1, id_last, n, pattern512);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+    test_assert(remaining == sizeof (mfs_data_header_t) + TAIL_SIZE,
+                "unexpected remaining space");
+
+    err = mfsEraseRecord(&mfs1, 2);
+    test_assert(err == MFS_NO_ERROR, "error erasing the record");
+    test_assert(tail_space() == TAIL_SIZE, "unexpected remaining space");
+  }
+
+  /* [1.12.5] Mounting the storage again, MFS_NO_ERROR is expected, the
+     free space must be unchanged and the records must be readable.*/
+  test_set_step(5);
+  {
+    mfs_error_t err;
+    flash_offset_t next_offset = mfs1.next_offset;
+    size_t size;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfs1.current_bank == MFS_BANK_1, "unexpected bank");
+    test_assert(mfs1.next_offset == next_offset, "unexpected next offset");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 2, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "record not erased");
+
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, id_last, &size, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "record not found");
+    test_assert(memcmp(pattern512, mfs_buffer, size) == 0,
+                "wrong record content");
+  }
+}
+
+static const testcase_t mfs_test_001_012 = {
+  "Testing bank tails shorter than a header",
+  mfs_test_001_012_setup,
+  mfs_test_001_012_teardown,
+  mfs_test_001_012_execute
+};
+
+/**
+ * @page mfs_test_001_013 [1.13] Testing bank swaps counter
+ *
+ * <h2>Description</h2>
+ * Garbage collections and erase operations are performed, the bank
+ * swaps counter must be increased by each of them and preserved across
+ * mounts.
+ *
+ * <h2>Test Steps</h2>
+ * - [1.13.1] Performing two garbage collections, the swaps counter and
+ *   the collections statistic must be increased by two.
+ * - [1.13.2] Erasing the storage, the swaps counter must be increased
+ *   by one and not restarted.
+ * - [1.13.3] Mounting the storage again, MFS_NO_ERROR is expected, the
+ *   swaps counter must be unchanged.
+ * .
+ */
+
+static void mfs_test_001_013_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_001_013_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_001_013_execute(void) {
+  uint32_t swaps;
+
+  /* [1.13.1] Performing two garbage collections, the swaps counter and
+     the collections statistic must be increased by two.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+    uint32_t collections = mfsGetGarbageCollectionStats(&mfs1)->collections;
+
+    swaps = mfsGetBankSwaps(&mfs1);
+    err = mfsPerformGarbageCollection(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error performing the collection");
+    err = mfsPerformGarbageCollection(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error performing the collection");
+    test_assert(mfsGetBankSwaps(&mfs1) == swaps + 2U, "unexpected bank swaps");
+    test_assert(mfsGetGarbageCollectionStats(&mfs1)->collections ==
+                collections + 2U, "unexpected collections");
+  }
+
+  /* [1.13.2] Erasing the storage, the swaps counter must be increased by
+     one and not restarted.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+
+    err = mfsErase(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "error erasing the storage");
+    test_assert(mfs1.current_bank == MFS_BANK_0, "unexpected bank");
+    test_assert(mfsGetBankSwaps(&mfs1) == swaps + 3U, "unexpected bank swaps");
+  }
+
+  /* [1.13.3] Mounting the storage again, MFS_NO_ERROR is expected, the
+     swaps counter must be unchanged.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "unexpected mount status");
+    test_assert(mfsGetBankSwaps(&mfs1) == swaps + 3U, "unexpected bank swaps");
+  }
+}
+
+static const testcase_t mfs_test_001_013 = {
+  "Testing bank swaps counter",
+  mfs_test_001_013_setup,
+  mfs_test_001_013_teardown,
+  mfs_test_001_013_execute
+};
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -792,6 +1630,20 @@ const testcase_t * const mfs_test_sequence_001_array[] = {
   &mfs_test_001_005,
   &mfs_test_001_006,
   &mfs_test_001_007,
+#if (MFS_CFG_SPARSE_IDS == TRUE) || defined(__DOXYGEN__)
+  &mfs_test_001_008,
+#endif
+#if (MFS_CFG_INCREMENTAL_GC == TRUE) || defined(__DOXYGEN__)
+  &mfs_test_001_009,
+#endif
+#if (MFS_CFG_INDEX_CHECKPOINT == TRUE) || defined(__DOXYGEN__)
+  &mfs_test_001_010,
+#endif
+#if (MFS_CFG_TRANSACTION_MAX > 0) || defined(__DOXYGEN__)
+  &mfs_test_001_011,
+#endif
+  &mfs_test_001_012,
+  &mfs_test_001_013,
   NULL
 };
 
@@ -802,3 +1654,5 @@ const testsequence_t mfs_test_sequence_001 = {
   "Functional tests",
   mfs_test_sequence_001_array
 };
+
+#endif /* MFS_CFG_LOG_SECTORS == 0 */
@@ -0,0 +1,231 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "mfs_test_root.h"
+
+/**
+ * @file    mfs_test_sequence_003.c
+ * @brief   Test Sequence 003 code.
+ *
+ * @page mfs_test_sequence_003 [3] Benchmarks
+ *
+ * File: @ref mfs_test_sequence_003.c
+ *
+ * <h2>Description</h2>
+ * This sequence measures the performance of the most common MFS
+ * operations. The scores include the flash access time and the records
+ * checksum calculation, they are useful for comparing different flash
+ * devices and MFS configurations.
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage mfs_test_003_001
+ * - @subpage mfs_test_003_002
+ * .
+ */
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "mfs.h"
+
+static void fill_buffer(void) {
+  unsigned i;
+
+  for (i = 0U; i < sizeof mfs_buffer; i++) {
+    mfs_buffer[i] = (uint8_t)i;
+  }
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page mfs_test_003_001 [3.1] Record read performance
+ *
+ * <h2>Description</h2>
+ * A 512 bytes record is written then it is read back repeatedly, the
+ * record checksum is verified on each read operation.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.1.1] Record one is written using a 512 bytes pattern.
+ * - [3.1.2] The number of read operations is counted in a one second
+ *   time window.
+ * - [3.1.3] Score is printed.
+ * .
+ */
+
+static void mfs_test_003_001_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_003_001_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_003_001_execute(void) {
+  uint32_t n;
+
+  /* [3.1.1] Record one is written using a 512 bytes pattern.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    fill_buffer();
+    err = mfsWriteRecord(&mfs1, 1, sizeof mfs_buffer, mfs_buffer);
+    test_assert(err == MFS_NO_ERROR, "error creating the record");
+  }
+
+  /* [3.1.2] The number of read operations is counted in a one second
+     time window.*/
+  test_set_step(2);
+  {
+    systime_t start, end;
+
+    n = 0;
+    start = osalOsGetSystemTimeX();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      size_t size = sizeof mfs_buffer;
+      mfs_error_t err;
+
+      err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "record not found");
+      n++;
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+  }
+
+  /* [3.1.3] Score is printed.*/
+  test_set_step(3);
+  {
+    test_print("--- Score : ");
+    test_printn(n);
+    test_print(" reads/S, ");
+    test_printn(n * (uint32_t)sizeof mfs_buffer);
+    test_println(" bytes/S");
+  }
+}
+
+static const testcase_t mfs_test_003_001 = {
+  "Record read performance",
+  mfs_test_003_001_setup,
+  mfs_test_003_001_teardown,
+  mfs_test_003_001_execute
+};
+
+/**
+ * @page mfs_test_003_002 [3.2] Mount performance
+ *
+ * <h2>Description</h2>
+ * Four 512 bytes records are written then the storage is mounted
+ * repeatedly, records are scanned on each mount operation unless
+ * covered by an index checkpoint.
+ *
+ * <h2>Test Steps</h2>
+ * - [3.2.1] Records from one to four are written using a 512 bytes
+ *   pattern, then the storage is stopped and started again.
+ * - [3.2.2] The number of mount operations is counted in a one second
+ *   time window.
+ * - [3.2.3] Score is printed.
+ * .
+ */
+
+static void mfs_test_003_002_setup(void) {
+  mfsStart(&mfs1, &mfscfg1);
+  mfsErase(&mfs1);
+}
+
+static void mfs_test_003_002_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_003_002_execute(void) {
+  uint32_t n;
+
+  /* [3.2.1] Records from one to four are written using a 512 bytes
+     pattern, then the storage is stopped and started again.*/
+  test_set_step(1);
+  {
+    mfs_id_t id;
+
+    fill_buffer();
+    for (id = 1; id <= 4; id++) {
+      mfs_error_t err;
+
+      err = mfsWriteRecord(&mfs1, id, sizeof mfs_buffer, mfs_buffer);
+      test_assert(err == MFS_NO_ERROR, "error creating the record");
+    }
+    mfsStop(&mfs1);
+    mfsStart(&mfs1, &mfscfg1);
+  }
+
+  /* [3.2.2] The number of mount operations is counted in a one second
+     time window.*/
+  test_set_step(2);
+  {
+    systime_t start, end;
+
+    n = 0;
+    start = osalOsGetSystemTimeX();
+    end = osalTimeAddX(start, OSAL_MS2I(1000));
+    do {
+      mfs_error_t err;
+
+      err = mfsStart(&mfs1, &mfscfg1);
+      test_assert(err == MFS_NO_ERROR, "mount error");
+      n++;
+    } while (osalTimeIsInRangeX(osalOsGetSystemTimeX(), start, end));
+  }
+
+  /* [3.2.3] Score is printed.*/
+  test_set_step(3);
+  {
+    test_print("--- Score : ");
+    test_printn(n);
+    test_println(" mounts/S");
+  }
+}
+
+static const testcase_t mfs_test_003_002 = {
+  "Mount performance",
+  mfs_test_003_002_setup,
+  mfs_test_003_002_teardown,
+  mfs_test_003_002_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const mfs_test_sequence_003_array[] = {
+  &mfs_test_003_001,
+  &mfs_test_003_002,
+  NULL
+};
+
+/**
+ * @brief   Benchmarks.
+ */
+const testsequence_t mfs_test_sequence_003 = {
+  "Benchmarks",
+  mfs_test_sequence_003_array
+};
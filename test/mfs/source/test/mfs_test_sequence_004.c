@@ -0,0 +1,500 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "hal.h"
+#include "mfs_test_root.h"
+
+/**
+ * @file    mfs_test_sequence_004.c
+ * @brief   Test Sequence 004 code.
+ *
+ * @page mfs_test_sequence_004 [4] Log-structured storage
+ *
+ * File: @ref mfs_test_sequence_004.c
+ *
+ * <h2>Description</h2>
+ * The log-structured storage is tested: sectors usage, selection of
+ * the sectors to be collected, erase markers and erase counters
+ * handling. The flash is assumed to be split in sectors able to
+ * contain three 512 bytes records.
+ *
+ * <h2>Conditions</h2>
+ * This sequence is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - MFS_CFG_LOG_SECTORS > 0
+ * .
+ *
+ * <h2>Test Cases</h2>
+ * - @subpage mfs_test_004_001
+ * - @subpage mfs_test_004_002
+ * - @subpage mfs_test_004_003
+ * - @subpage mfs_test_004_004
+ * .
+ */
+
+#if (MFS_CFG_LOG_SECTORS > 0) || defined(__DOXYGEN__)
+
+/****************************************************************************
+ * Shared code.
+ ****************************************************************************/
+
+#include "mfs.h"
+
+#define LOG_RECORD_SIZE     512U
+
+static void log_erase_flash(void) {
+  flash_sector_t i;
+
+  for (i = 0U; i < mfscfg1.log_sectors; i++) {
+    flashStartEraseSector(mfscfg1.flashp, mfscfg1.log_start + i);
+    flashWaitErase(mfscfg1.flashp);
+  }
+}
+
+static uint32_t log_free_sectors(void) {
+  uint32_t i, n = 0U;
+
+  for (i = 0U; i < mfscfg1.log_sectors; i++) {
+    if (mfs1.log[i].sequence == 0U) {
+      n++;
+    }
+  }
+  return n;
+}
+
+static bool log_write_records(mfs_id_t first, mfs_id_t last) {
+  mfs_id_t id;
+
+  for (id = first; id <= last; id++) {
+    if (MFS_IS_ERROR(mfsWriteRecord(&mfs1, id, LOG_RECORD_SIZE,
+                                    mfs_buffer))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool log_read_records(mfs_id_t first, mfs_id_t last) {
+  mfs_id_t id;
+
+  for (id = first; id <= last; id++) {
+    size_t size = sizeof mfs_buffer;
+
+    if ((mfsReadRecord(&mfs1, id, &size, mfs_buffer) != MFS_NO_ERROR) ||
+        (size != LOG_RECORD_SIZE)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/****************************************************************************
+ * Test cases.
+ ****************************************************************************/
+
+/**
+ * @page mfs_test_004_001 [4.1] Log initialization
+ *
+ * <h2>Description</h2>
+ * The storage is initialized over an erased flash, records are written
+ * and found again after a restart.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.1.1] MFS is started over an erased flash, a single sector is
+ *   expected in the log and all erase counters are expected to be zero.
+ * - [4.1.2] Records 1 to 7 are written, three sectors are expected in
+ *   the log.
+ * - [4.1.3] The driver is restarted, the records are expected to be
+ *   found without repairs.
+ * .
+ */
+
+static void mfs_test_004_001_setup(void) {
+  log_erase_flash();
+}
+
+static void mfs_test_004_001_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_004_001_execute(void) {
+  uint32_t i;
+
+  /* [4.1.1] MFS is started over an erased flash, a single sector is
+     expected in the log and all erase counters are expected to be
+     zero.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "initialization error");
+    test_assert(log_free_sectors() == mfscfg1.log_sectors - 1U,
+                "wrong number of free sectors");
+    for (i = 0U; i < mfscfg1.log_sectors; i++) {
+      test_assert(mfsGetSectorErases(&mfs1, i) == 0U, "wrong erase counter");
+    }
+  }
+
+  /* [4.1.2] Records 1 to 7 are written, three sectors are expected in
+     the log.*/
+  test_set_step(2);
+  {
+    test_assert(log_write_records(1, 7), "write error");
+    test_assert(log_free_sectors() == mfscfg1.log_sectors - 3U,
+                "wrong number of free sectors");
+  }
+
+  /* [4.1.3] The driver is restarted, the records are expected to be
+     found without repairs.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount error");
+    test_assert(log_free_sectors() == mfscfg1.log_sectors - 3U,
+                "wrong number of free sectors");
+    test_assert(log_read_records(1, 7), "record not found");
+  }
+}
+
+static const testcase_t mfs_test_004_001 = {
+  "Log initialization",
+  mfs_test_004_001_setup,
+  mfs_test_004_001_teardown,
+  mfs_test_004_001_execute
+};
+
+/**
+ * @page mfs_test_004_002 [4.2] Selection of the sectors to be collected
+ *
+ * <h2>Description</h2>
+ * The sector with the most space used by obsolete records is collected
+ * first, live records are moved to a new sector if they do not fit the
+ * sector being written.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.2.1] Records 1 to 6 are written, then records 4 to 6 and record
+ *   1 are rewritten, the second sector only contains obsolete records.
+ * - [4.2.2] Records are written until a garbage collection is required,
+ *   the second sector is expected to be collected without moving
+ *   records.
+ * - [4.2.3] Records are written until a garbage collection is required
+ *   again, the first sector is expected to be collected and its two
+ *   live records moved to a new sector.
+ * - [4.2.4] The driver is restarted, all records are expected to be
+ *   found without repairs.
+ * .
+ */
+
+static void mfs_test_004_002_setup(void) {
+  log_erase_flash();
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_004_002_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_004_002_execute(void) {
+  const mfs_gc_stats_t *gcsp = mfsGetGarbageCollectionStats(&mfs1);
+  uint32_t moved;
+
+  /* [4.2.1] Records 1 to 6 are written, then records 4 to 6 and record
+     1 are rewritten, the second sector only contains obsolete
+     records.*/
+  test_set_step(1);
+  {
+    test_assert(log_write_records(1, 6), "write error");
+    test_assert(log_write_records(4, 6), "write error");
+    test_assert(log_write_records(1, 1), "write error");
+    test_assert(log_free_sectors() == mfscfg1.log_sectors - 4U,
+                "wrong number of free sectors");
+    moved = gcsp->moved_records;
+  }
+
+  /* [4.2.2] Records are written until a garbage collection is required,
+     the second sector is expected to be collected without moving
+     records.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+
+    test_assert(log_write_records(7, 17), "write error");
+    test_assert(log_free_sectors() == 1U, "wrong number of free sectors");
+    err = mfsWriteRecord(&mfs1, 18, LOG_RECORD_SIZE, mfs_buffer);
+    test_assert(err == MFS_WARN_GC, "garbage collection not performed");
+    test_assert(mfsGetSectorErases(&mfs1, 0) == 0U, "wrong sector collected");
+    test_assert(mfsGetSectorErases(&mfs1, 1) == 1U, "wrong sector collected");
+    test_assert(gcsp->moved_records == moved, "records moved");
+  }
+
+  /* [4.2.3] Records are written until a garbage collection is required
+     again, the first sector is expected to be collected and its two
+     live records moved to a new sector.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    test_assert(log_write_records(19, 20), "write error");
+    err = mfsWriteRecord(&mfs1, 21, LOG_RECORD_SIZE, mfs_buffer);
+    test_assert(err == MFS_WARN_GC, "garbage collection not performed");
+    test_assert(mfsGetSectorErases(&mfs1, 0) == 1U, "wrong sector collected");
+    test_assert(gcsp->moved_records == moved + 2U,
+                "wrong number of moved records");
+    test_assert(mfs1.log_head == 1U, "records not moved to a new sector");
+  }
+
+  /* [4.2.4] The driver is restarted, all records are expected to be
+     found without repairs.*/
+  test_set_step(4);
+  {
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount error");
+    test_assert(log_read_records(1, 21), "record not found");
+  }
+}
+
+static const testcase_t mfs_test_004_002 = {
+  "Selection of the sectors to be collected",
+  mfs_test_004_002_setup,
+  mfs_test_004_002_teardown,
+  mfs_test_004_002_execute
+};
+
+/**
+ * @page mfs_test_004_003 [4.3] Erase markers
+ *
+ * <h2>Description</h2>
+ * An erase marker is moved along with the live records while an older
+ * sector still contains an instance of the erased record, the record
+ * must not reappear after a restart.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.3.1] Records 1 to 4 are written, then record 1 is erased and
+ *   record 5 is written twice, the second sector contains the erase
+ *   marker.
+ * - [4.3.2] Records are written until a garbage collection is required,
+ *   the second sector is expected to be collected while the first one
+ *   is left in place.
+ * - [4.3.3] The driver is restarted, record 1 is expected to be not
+ *   found while the other records are expected to be found.
+ * .
+ */
+
+static void mfs_test_004_003_setup(void) {
+  log_erase_flash();
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_004_003_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_004_003_execute(void) {
+  const mfs_gc_stats_t *gcsp = mfsGetGarbageCollectionStats(&mfs1);
+  uint32_t moved;
+
+  /* [4.3.1] Records 1 to 4 are written, then record 1 is erased and
+     record 5 is written twice, the second sector contains the erase
+     marker.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    test_assert(log_write_records(1, 4), "write error");
+    err = mfsEraseRecord(&mfs1, 1);
+    test_assert(err == MFS_NO_ERROR, "erase error");
+    test_assert(log_write_records(5, 5), "write error");
+    test_assert(log_write_records(5, 5), "write error");
+    test_assert(log_free_sectors() == mfscfg1.log_sectors - 2U,
+                "wrong number of free sectors");
+    moved = gcsp->moved_records;
+  }
+
+  /* [4.3.2] Records are written until a garbage collection is required,
+     the second sector is expected to be collected while the first one
+     is left in place.*/
+  test_set_step(2);
+  {
+    mfs_error_t err;
+
+    test_assert(log_write_records(6, 20), "write error");
+    test_assert(log_free_sectors() == 1U, "wrong number of free sectors");
+    err = mfsWriteRecord(&mfs1, 21, LOG_RECORD_SIZE, mfs_buffer);
+    test_assert(err == MFS_WARN_GC, "garbage collection not performed");
+    test_assert(mfsGetSectorErases(&mfs1, 0) == 0U, "wrong sector collected");
+    test_assert(mfsGetSectorErases(&mfs1, 1) == 1U, "wrong sector collected");
+    test_assert(gcsp->moved_records == moved + 3U,
+                "erase marker not moved");
+  }
+
+  /* [4.3.3] The driver is restarted, record 1 is expected to be not
+     found while the other records are expected to be found.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+    size_t size;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount error");
+    size = sizeof mfs_buffer;
+    err = mfsReadRecord(&mfs1, 1, &size, mfs_buffer);
+    test_assert(err == MFS_ERR_NOT_FOUND, "erased record found");
+    test_assert(log_read_records(2, 21), "record not found");
+  }
+}
+
+static const testcase_t mfs_test_004_003 = {
+  "Erase markers",
+  mfs_test_004_003_setup,
+  mfs_test_004_003_teardown,
+  mfs_test_004_003_execute
+};
+
+/**
+ * @page mfs_test_004_004 [4.4] Erase counters and wear leveling
+ *
+ * <h2>Description</h2>
+ * The erase counters are preserved by erase operations and restarts, a
+ * sector containing static data is collected when it lags behind the
+ * other sectors in wear.
+ *
+ * <h2>Test Steps</h2>
+ * - [4.4.1] The storage is erased twice, all erase counters are expected
+ *   to be two, also after a restart.
+ * - [4.4.2] Records 1 to 6 are written once filling two sectors, then
+ *   record 7 is rewritten many times, the sectors containing static data
+ *   are expected to be collected and the difference between the most
+ *   and the least erased sectors to stay close to the wear leveling
+ *   threshold.
+ * - [4.4.3] The driver is restarted, the erase counters and the records
+ *   are expected to be preserved.
+ * .
+ */
+
+static void mfs_test_004_004_setup(void) {
+  log_erase_flash();
+  mfsStart(&mfs1, &mfscfg1);
+}
+
+static void mfs_test_004_004_teardown(void) {
+  mfsStop(&mfs1);
+}
+
+static void mfs_test_004_004_execute(void) {
+  uint32_t erases[MFS_CFG_LOG_SECTORS];
+  uint32_t i, min, max;
+
+  /* [4.4.1] The storage is erased twice, all erase counters are expected
+     to be two, also after a restart.*/
+  test_set_step(1);
+  {
+    mfs_error_t err;
+
+    err = mfsErase(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "erase error");
+    err = mfsErase(&mfs1);
+    test_assert(err == MFS_NO_ERROR, "erase error");
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount error");
+    for (i = 0U; i < mfscfg1.log_sectors; i++) {
+      test_assert(mfsGetSectorErases(&mfs1, i) == 2U, "wrong erase counter");
+    }
+  }
+
+  /* [4.4.2] Records 1 to 6 are written once filling two sectors, then
+     record 7 is rewritten many times, the sectors containing static data
+     are expected to be collected and the difference between the most
+     and the least erased sectors to stay close to the wear leveling
+     threshold.*/
+  test_set_step(2);
+  {
+    test_assert(log_write_records(1, 6), "write error");
+    for (i = 0U; i < 1000U; i++) {
+      test_assert(log_write_records(7, 7), "write error");
+    }
+    min = 0xFFFFFFFFU;
+    max = 0U;
+    for (i = 0U; i < mfscfg1.log_sectors; i++) {
+      erases[i] = mfsGetSectorErases(&mfs1, i);
+      if (erases[i] < min) {
+        min = erases[i];
+      }
+      if (erases[i] > max) {
+        max = erases[i];
+      }
+    }
+    test_assert(min > 2U, "static data not moved");
+    test_assert(max - min <= (uint32_t)MFS_CFG_LOG_WEAR_THRESHOLD + 1U,
+                "uneven wear");
+  }
+
+  /* [4.4.3] The driver is restarted, the erase counters and the records
+     are expected to be preserved.*/
+  test_set_step(3);
+  {
+    mfs_error_t err;
+
+    mfsStop(&mfs1);
+    err = mfsStart(&mfs1, &mfscfg1);
+    test_assert(err == MFS_NO_ERROR, "mount error");
+    for (i = 0U; i < mfscfg1.log_sectors; i++) {
+      test_assert(mfsGetSectorErases(&mfs1, i) == erases[i],
+                  "erase counter changed");
+    }
+    test_assert(log_read_records(1, 7), "record not found");
+  }
+}
+
+static const testcase_t mfs_test_004_004 = {
+  "Erase counters and wear leveling",
+  mfs_test_004_004_setup,
+  mfs_test_004_004_teardown,
+  mfs_test_004_004_execute
+};
+
+/****************************************************************************
+ * Exported data.
+ ****************************************************************************/
+
+/**
+ * @brief   Array of test cases.
+ */
+const testcase_t * const mfs_test_sequence_004_array[] = {
+  &mfs_test_004_001,
+  &mfs_test_004_002,
+  &mfs_test_004_003,
+  &mfs_test_004_004,
+  NULL
+};
+
+/**
+ * @brief   Log-structured storage.
+ */
+const testsequence_t mfs_test_sequence_004 = {
+  "Log-structured storage",
+  mfs_test_sequence_004_array
+};
+
+#endif /* MFS_CFG_LOG_SECTORS > 0 */
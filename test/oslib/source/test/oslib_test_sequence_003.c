@@ -38,6 +38,9 @@
  * <h2>Test Cases</h2>
  * - @subpage oslib_test_003_001
  * - @subpage oslib_test_003_002
+ * - @subpage oslib_test_003_003
+ * - @subpage oslib_test_003_004
+ * - @subpage oslib_test_003_005
  * .
  */
 
@@ -53,6 +56,138 @@
 static memory_heap_t test_heap;
 static uint8_t test_heap_buffer[HEAP_SIZE];
 
+#if PORT_SUPPORTS_RT == TRUE
+#if defined(SIMULATOR)
+#define BENCH_HEAP_SIZE 65536
+#define BENCH_SLOTS 256
+#define BENCH_OCTAVES 8
+#define BENCH_OPS 100000
+#else
+#define BENCH_HEAP_SIZE 2048
+#define BENCH_SLOTS 16
+#define BENCH_OCTAVES 4
+#define BENCH_OPS 2000
+#endif
+#define BENCH_SUB_BITS 2
+#define BENCH_BUCKETS ((32 - BENCH_SUB_BITS + 1) << BENCH_SUB_BITS)
+
+typedef struct {
+  uint32_t n;
+  rtcnt_t max;
+  uint64_t total;
+  uint32_t buckets[BENCH_BUCKETS];
+} bench_times_t;
+
+static uint8_t bench_heap_buffer[BENCH_HEAP_SIZE];
+static void *bench_slots[BENCH_SLOTS];
+static bench_times_t bench_alloc_times, bench_free_times;
+static rtcnt_t bench_offset;
+static uint32_t bench_seed;
+
+static uint32_t bench_rand(void) {
+
+  bench_seed ^= bench_seed << 13;
+  bench_seed ^= bench_seed >> 17;
+  bench_seed ^= bench_seed << 5;
+
+  return bench_seed;
+}
+
+/* Sizes are log-uniform from 8 bytes up to 8 << BENCH_OCTAVES bytes, most
+   blocks are small but most of the memory goes to the large ones.*/
+static size_t bench_size(void) {
+  size_t base = (size_t)8U << (bench_rand() % BENCH_OCTAVES);
+
+  return base + (size_t)(bench_rand() % (uint32_t)base);
+}
+
+/* Times are recorded in a log-linear histogram, each power of two range
+   is divided in 2^BENCH_SUB_BITS buckets.*/
+static unsigned bench_bucket(rtcnt_t t) {
+  unsigned msb = 0U;
+
+  if (t < ((rtcnt_t)1 << BENCH_SUB_BITS)) {
+    return (unsigned)t;
+  }
+  while ((t >> msb) > (rtcnt_t)1) {
+    msb++;
+  }
+  return ((msb - BENCH_SUB_BITS + 1U) << BENCH_SUB_BITS) +
+         (unsigned)((t >> (msb - BENCH_SUB_BITS)) &
+                    (((rtcnt_t)1 << BENCH_SUB_BITS) - 1U));
+}
+
+static void bench_reset(bench_times_t *btp) {
+  unsigned i;
+
+  btp->n = 0U;
+  btp->max = (rtcnt_t)0;
+  btp->total = 0U;
+  for (i = 0U; i < BENCH_BUCKETS; i++) {
+    btp->buckets[i] = 0U;
+  }
+}
+
+/* Cost of a measurement without code in between.*/
+static void bench_calibrate(void) {
+  rtcnt_t start, t;
+  unsigned i;
+
+  bench_offset = (rtcnt_t)-1;
+  for (i = 0U; i < 16U; i++) {
+    start = chSysGetRealtimeCounterX();
+    t = chSysGetRealtimeCounterX() - start;
+    if (t < bench_offset) {
+      bench_offset = t;
+    }
+  }
+}
+
+static void bench_record(bench_times_t *btp, rtcnt_t t) {
+
+  t = t > bench_offset ? t - bench_offset : (rtcnt_t)0;
+  btp->n++;
+  btp->total += t;
+  if (t > btp->max) {
+    btp->max = t;
+  }
+  btp->buckets[bench_bucket(t)]++;
+}
+
+/* Upper bound of the bucket containing the specified percentile.*/
+static uint32_t bench_percentile(const bench_times_t *btp, unsigned pc) {
+  uint32_t target = (uint32_t)(((uint64_t)btp->n * pc + 99U) / 100U);
+  uint32_t count = 0U;
+  unsigned i, shift;
+
+  for (i = 0U; i < BENCH_BUCKETS - 1U; i++) {
+    count += btp->buckets[i];
+    if (count >= target) {
+      break;
+    }
+  }
+  if (i < (1U << BENCH_SUB_BITS)) {
+    return (uint32_t)i;
+  }
+  shift = (i >> BENCH_SUB_BITS) - 1U;
+  return (((uint32_t)(i & ((1U << BENCH_SUB_BITS) - 1U)) +
+           (1U << BENCH_SUB_BITS) + 1U) << shift) - 1U;
+}
+
+static void bench_print(const char *name, const bench_times_t *btp) {
+
+  test_print(name);
+  test_printn(bench_percentile(btp, 50U));
+  test_print(" p50, ");
+  test_printn(bench_percentile(btp, 99U));
+  test_print(" p99, ");
+  test_printn((uint32_t)btp->max);
+  test_print(" max, ");
+  test_printn(btp->n > 0U ? (uint32_t)(btp->total / btp->n) : 0U);
+  test_println(" mean cycles");
+}
+#endif /* PORT_SUPPORTS_RT == TRUE */
+
 /****************************************************************************
  * Test cases.
  ****************************************************************************/
@@ -256,6 +391,369 @@ static const testcase_t oslib_test_003_002 = {
   oslib_test_003_002_execute
 };
 
+#if (PORT_SUPPORTS_RT == TRUE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_003_003 [3.3] Allocators benchmark
+ *
+ * <h2>Description</h2>
+ * The heap is fragmented by filling it with blocks of log-uniformly
+ * distributed sizes and releasing one block every two, then a
+ * pseudo-random sequence of allocations and releases is performed on
+ * random slots. The time of each operation is measured with the realtime
+ * counter, the median, 99th percentile, worst and mean times are
+ * reported with the allocation failures and the final fragmentation. The
+ * sequence is the same for both the first-fit and the TLSF allocators.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - PORT_SUPPORTS_RT == TRUE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [3.3.1] The heap is filled with blocks of random size then one
+ *   block every two is released.
+ * - [3.3.2] Allocations and releases of random slots are performed, the
+ *   time of each operation is recorded.
+ * - [3.3.3] Score is printed.
+ * - [3.3.4] Releasing all the blocks, the heap must not be fragmented.
+ * .
+ */
+
+static void oslib_test_003_003_setup(void) {
+  chHeapObjectInit(&test_heap, bench_heap_buffer, sizeof(bench_heap_buffer));
+}
+
+static void oslib_test_003_003_execute(void) {
+  uint32_t n, failures;
+  size_t frags, total_size, largest_size;
+  rtcnt_t start;
+  unsigned i;
+
+  /* [3.3.1] The heap is filled with blocks of random size then one
+     block every two is released.*/
+  test_set_step(1);
+  {
+    bench_seed = 0x2545F491U;
+    for (i = 0U; i < BENCH_SLOTS; i++) {
+      bench_slots[i] = chHeapAlloc(&test_heap, bench_size());
+    }
+    for (i = 0U; i < BENCH_SLOTS; i += 2U) {
+      if (bench_slots[i] != NULL) {
+        chHeapFree(bench_slots[i]);
+        bench_slots[i] = NULL;
+      }
+    }
+  }
+
+  /* [3.3.2] Allocations and releases of random slots are performed, the
+     time of each operation is recorded.*/
+  test_set_step(2);
+  {
+    bench_reset(&bench_alloc_times);
+    bench_reset(&bench_free_times);
+    bench_calibrate();
+    failures = 0U;
+    for (n = 0U; n < BENCH_OPS; n++) {
+      i = (unsigned)(bench_rand() % BENCH_SLOTS);
+      if (bench_slots[i] == NULL) {
+        size_t size = bench_size();
+
+        start = chSysGetRealtimeCounterX();
+        bench_slots[i] = chHeapAlloc(&test_heap, size);
+        bench_record(&bench_alloc_times, chSysGetRealtimeCounterX() - start);
+        if (bench_slots[i] == NULL) {
+          failures++;
+        }
+      }
+      else {
+        start = chSysGetRealtimeCounterX();
+        chHeapFree(bench_slots[i]);
+        bench_record(&bench_free_times, chSysGetRealtimeCounterX() - start);
+        bench_slots[i] = NULL;
+      }
+#if defined(SIMULATOR)
+      _sim_check_for_interrupts();
+#endif
+    }
+    frags = chHeapStatus(&test_heap, &total_size, &largest_size);
+  }
+
+  /* [3.3.3] Score is printed.*/
+  test_set_step(3);
+  {
+    bench_print("--- Alloc : ", &bench_alloc_times);
+    bench_print("--- Free  : ", &bench_free_times);
+    test_print("--- Fails : ");
+    test_printn(failures);
+    test_print("/");
+    test_printn(bench_alloc_times.n);
+    test_println(" allocations");
+    test_print("--- Frags : ");
+    test_printn((uint32_t)frags);
+    test_print(" blocks, ");
+    test_printn((uint32_t)largest_size);
+    test_print("/");
+    test_printn((uint32_t)total_size);
+    test_println(" bytes largest/free");
+  }
+
+  /* [3.3.4] Releasing all the blocks, the heap must not be fragmented.*/
+  test_set_step(4);
+  {
+    for (i = 0U; i < BENCH_SLOTS; i++) {
+      if (bench_slots[i] != NULL) {
+        chHeapFree(bench_slots[i]);
+      }
+    }
+    test_assert(chHeapStatus(&test_heap, NULL, NULL) == 1, "heap fragmented");
+  }
+}
+
+static const testcase_t oslib_test_003_003 = {
+  "Allocators benchmark",
+  oslib_test_003_003_setup,
+  NULL,
+  oslib_test_003_003_execute
+};
+#endif /* PORT_SUPPORTS_RT == TRUE */
+
+#if (CH_CFG_USE_HEAP_CACHE) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_003_004 [3.4] Default heap cache
+ *
+ * <h2>Description</h2>
+ * The size classes cache of the default heap is tested. Released small
+ * blocks must be reused by the following allocations of the same class,
+ * the cache must be usable from I-class context and large blocks must
+ * bypass it.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_HEAP_CACHE
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [3.4.1] A small block is allocated then freed, allocating a block
+ *   of the same class again must return the same block and count a hit.
+ * - [3.4.2] A block is allocated and freed using the I-class APIs, the
+ *   class pool must be used.
+ * - [3.4.3] A block larger than the largest class is allocated and
+ *   freed, the cache must not be used.
+ * .
+ */
+
+static void oslib_test_003_004_execute(void) {
+  void *p1, *p2;
+  uint32_t hits1, misses1, hits2, misses2;
+  size_t n;
+
+  /* [3.4.1] A small block is allocated then freed, allocating a block
+     of the same class again must return the same block and count a hit.*/
+  test_set_step(1);
+  {
+    p1 = chHeapAlloc(NULL, CH_CFG_HEAP_CACHE_MIN_SIZE);
+    test_assert(p1 != NULL, "allocation failed");
+    test_assert(chHeapGetSize(p1) == CH_CFG_HEAP_CACHE_MIN_SIZE, "wrong size");
+    chHeapFree(p1);
+    (void)chHeapCacheStatus(0U, &hits1, &misses1);
+    p2 = chHeapAlloc(NULL, CH_CFG_HEAP_CACHE_MIN_SIZE - 1);
+    test_assert(p2 == p1, "block not reused");
+    (void)chHeapCacheStatus(0U, &hits2, &misses2);
+    test_assert(hits2 == hits1 + 1U, "hit not counted");
+    test_assert(misses2 == misses1, "miss counted");
+    chHeapFree(p2);
+  }
+
+  /* [3.4.2] A block is allocated and freed using the I-class APIs, the
+     class pool must be used.*/
+  test_set_step(2);
+  {
+    n = chHeapCacheStatus(0U, NULL, NULL);
+    test_assert(n >= 1U, "empty pool");
+    chSysLock();
+    p1 = chHeapCacheAllocI(CH_CFG_HEAP_CACHE_MIN_SIZE);
+    chSysUnlock();
+    test_assert(p1 != NULL, "allocation failed");
+    test_assert(chHeapCacheStatus(0U, NULL, NULL) == n - 1U, "pool not used");
+    chSysLock();
+    chHeapCacheFreeI(p1);
+    chSysUnlock();
+    test_assert(chHeapCacheStatus(0U, NULL, NULL) == n, "block not returned");
+  }
+
+  /* [3.4.3] A block larger than the largest class is allocated and
+     freed, the cache must not be used.*/
+  test_set_step(3);
+  {
+    (void)chHeapCacheStatus(CH_CFG_HEAP_CACHE_CLASSES - 1U, &hits1, &misses1);
+    p1 = chHeapAlloc(NULL, CH_HEAP_CACHE_CLASS_SIZE(CH_CFG_HEAP_CACHE_CLASSES - 1U) + 1U);
+    test_assert(p1 != NULL, "allocation failed");
+    chHeapFree(p1);
+    (void)chHeapCacheStatus(CH_CFG_HEAP_CACHE_CLASSES - 1U, &hits2, &misses2);
+    test_assert((hits2 == hits1) && (misses2 == misses1), "cache used");
+  }
+}
+
+static const testcase_t oslib_test_003_004 = {
+  "Default heap cache",
+  NULL,
+  NULL,
+  oslib_test_003_004_execute
+};
+#endif /* CH_CFG_USE_HEAP_CACHE */
+
+#if (CH_CFG_USE_MEM_PROFILING) || defined(__DOXYGEN__)
+/**
+ * @page oslib_test_003_005 [3.5] Heap profiling
+ *
+ * <h2>Description</h2>
+ * The heap statistics are tested. Allocations, releases and failures
+ * must be counted, the allocated bytes and their high-water mark must
+ * be tracked and the allocations must be charged to the current thread.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_MEM_PROFILING
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [3.5.1] Testing initial conditions, the statistics must be cleared.
+ * - [3.5.2] Two blocks of different size classes are allocated, the
+ *   counters, the histogram and the current thread statistics must be
+ *   updated.
+ * - [3.5.3] Trying to allocate a block bigger than the heap, the
+ *   failure must be counted.
+ * - [3.5.4] The blocks are freed, the allocated size must return to
+ *   zero and the high-water mark must be retained.
+ * - [3.5.5] The entry of the current thread is released as done on
+ *   thread exit, its counters must be moved in the shared entry and the
+ *   entry must be reused by the next allocation.
+ * - [3.5.6] The statistics are reset, the counters and the high-water
+ *   mark must be cleared.
+ * - [3.5.7] The core memory statistics are read, the used and free
+ *   memory must add up to the managed size and a failed core allocation
+ *   must be counted.
+ * .
+ */
+
+static void oslib_test_003_005_setup(void) {
+  chHeapObjectInit(&test_heap, test_heap_buffer, sizeof(test_heap_buffer));
+}
+
+static void oslib_test_003_005_execute(void) {
+  static heap_stats_t hs;
+  memcore_stats_t cs1, cs2;
+  void *p1, *p2;
+
+  /* [3.5.1] Testing initial conditions, the statistics must be cleared.*/
+  test_set_step(1);
+  {
+    chHeapGetStats(&test_heap, &hs);
+    test_assert((hs.allocs == 0U) && (hs.frees == 0U) && (hs.failures == 0U),
+                "counters not cleared");
+    test_assert((hs.used == 0U) && (hs.used_max == 0U), "sizes not cleared");
+    test_assert(hs.threads[0].thread == NULL, "threads not cleared");
+  }
+
+  /* [3.5.2] Two blocks of different size classes are allocated, the
+     counters, the histogram and the current thread statistics must be
+     updated.*/
+  test_set_step(2);
+  {
+    p1 = chHeapAlloc(&test_heap, 8);
+    p2 = chHeapAlloc(&test_heap, 40);
+    test_assert((p1 != NULL) && (p2 != NULL), "allocation failed");
+    chHeapGetStats(&test_heap, &hs);
+    test_assert(hs.allocs == 2U, "wrong allocations count");
+    test_assert((hs.used == 48U) && (hs.used_max == 48U), "wrong allocated size");
+    test_assert((hs.hist[0] == 1U) && (hs.hist[1] == 0U) && (hs.hist[2] == 1U),
+                "wrong histogram");
+    test_assert(hs.threads[0].thread == chThdGetSelfX(), "wrong thread");
+    test_assert((hs.threads[0].allocs == 2U) && (hs.threads[0].alloc_bytes == 48U),
+                "wrong thread statistics");
+  }
+
+  /* [3.5.3] Trying to allocate a block bigger than the heap, the
+     failure must be counted.*/
+  test_set_step(3);
+  {
+    test_assert(chHeapAlloc(&test_heap, sizeof test_heap_buffer * 2) == NULL,
+                "allocation not failed");
+    chHeapGetStats(&test_heap, &hs);
+    test_assert((hs.failures == 1U) && (hs.allocs == 2U), "failure not counted");
+  }
+
+  /* [3.5.4] The blocks are freed, the allocated size must return to
+     zero and the high-water mark must be retained.*/
+  test_set_step(4);
+  {
+    chHeapFree(p1);
+    chHeapFree(p2);
+    chHeapGetStats(&test_heap, &hs);
+    test_assert(hs.frees == 2U, "wrong releases count");
+    test_assert((hs.used == 0U) && (hs.used_max == 48U), "wrong allocated size");
+    test_assert((hs.threads[0].frees == 2U) && (hs.threads[0].free_bytes == 48U),
+                "wrong thread statistics");
+  }
+
+  /* [3.5.5] The entry of the current thread is released as done on
+     thread exit, its counters must be moved in the shared entry and the
+     entry must be reused by the next allocation.*/
+  test_set_step(5);
+  {
+    chSysLock();
+    _heap_prof_thread_exit(chThdGetSelfX());
+    chSysUnlock();
+    chHeapGetStats(&test_heap, &hs);
+    test_assert(hs.threads[0].thread == NULL, "entry not released");
+    test_assert((hs.threads[CH_CFG_HEAP_PROFILING_THREADS - 1].allocs == 2U) &&
+                (hs.threads[CH_CFG_HEAP_PROFILING_THREADS - 1].free_bytes == 48U),
+                "counters not moved");
+    p1 = chHeapAlloc(&test_heap, 8);
+    chHeapGetStats(&test_heap, &hs);
+    test_assert((hs.threads[0].thread == chThdGetSelfX()) &&
+                (hs.threads[0].allocs == 1U), "entry not reused");
+    chHeapFree(p1);
+  }
+
+  /* [3.5.6] The statistics are reset, the counters and the high-water
+     mark must be cleared.*/
+  test_set_step(6);
+  {
+    chHeapResetStats(&test_heap);
+    chHeapGetStats(&test_heap, &hs);
+    test_assert((hs.allocs == 0U) && (hs.frees == 0U) && (hs.failures == 0U),
+                "counters not cleared");
+    test_assert(hs.used_max == 0U, "high-water mark not cleared");
+    test_assert(hs.threads[0].thread == NULL, "threads not cleared");
+  }
+
+  /* [3.5.7] The core memory statistics are read, the used and free
+     memory must add up to the managed size and a failed core allocation
+     must be counted.*/
+  test_set_step(7);
+  {
+    chCoreGetStats(&cs1);
+    test_assert(cs1.used + chCoreGetStatusX() == cs1.size, "inconsistent sizes");
+    test_assert(chCoreAlloc(cs1.size + 1U) == NULL, "allocation not failed");
+    chCoreGetStats(&cs2);
+    test_assert(cs2.failures == cs1.failures + 1U, "failure not counted");
+    test_assert((cs2.allocs == cs1.allocs) && (cs2.used == cs1.used),
+                "allocation counted");
+  }
+}
+
+static const testcase_t oslib_test_003_005 = {
+  "Heap profiling",
+  oslib_test_003_005_setup,
+  NULL,
+  oslib_test_003_005_execute
+};
+#endif /* CH_CFG_USE_MEM_PROFILING */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -266,6 +764,15 @@ static const testcase_t oslib_test_003_002 = {
 const testcase_t * const oslib_test_sequence_003_array[] = {
   &oslib_test_003_001,
   &oslib_test_003_002,
+#if (PORT_SUPPORTS_RT == TRUE) || defined(__DOXYGEN__)
+  &oslib_test_003_003,
+#endif
+#if (CH_CFG_USE_HEAP_CACHE) || defined(__DOXYGEN__)
+  &oslib_test_003_004,
+#endif
+#if (CH_CFG_USE_MEM_PROFILING) || defined(__DOXYGEN__)
+  &oslib_test_003_005,
+#endif
   NULL
 };
 
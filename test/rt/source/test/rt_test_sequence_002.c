@@ -37,6 +37,7 @@
  * - @subpage rt_test_002_002
  * - @subpage rt_test_002_003
  * - @subpage rt_test_002_004
+ * - @subpage rt_test_002_005
  * .
  */
 
@@ -265,6 +266,122 @@ static const testcase_t rt_test_002_004 = {
   rt_test_002_004_execute
 };
 
+#if (CH_CFG_USE_TM) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_002_005 [2.5] Time measurement histograms
+ *
+ * <h2>Description</h2>
+ * The time histograms are tested. Recorded times must be counted in
+ * log-linear buckets, the percentiles must be within the histogram
+ * resolution and the histograms must be copied and cleared atomically.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_CFG_USE_TM
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [2.5.1] Initializing an histogram, it must be empty.
+ * - [2.5.2] Checking the buckets limits, they must be strictly
+ *   increasing and the last one must be the maximum counter value.
+ * - [2.5.3] Recording the times from 1 to 100, the percentiles must be
+ *   within the histogram resolution.
+ * - [2.5.4] Recording a time out of range, it must be accumulated in
+ *   the last bucket.
+ * - [2.5.5] Taking a snapshot and clearing the histogram from a
+ *   critical zone, the copy must be preserved.
+ * - [2.5.6] Checking the kernel critical zones histogram, critical
+ *   zones must have been recorded.
+ * .
+ */
+
+static void rt_test_002_005_execute(void) {
+  static time_histogram_t th1, th2;
+  unsigned i;
+  rtcnt_t t;
+
+  /* [2.5.1] Initializing an histogram, it must be empty.*/
+  test_set_step(1);
+  {
+    chTMHistogramObjectInit(&th1);
+    test_assert(th1.n == 0U, "not empty");
+    test_assert(chTMHistogramGetPercentileX(&th1, 500U) == (rtcnt_t)0,
+                "wrong percentile");
+  }
+
+  /* [2.5.2] Checking the buckets limits, they must be strictly
+     increasing and the last one must be the maximum counter value.*/
+  test_set_step(2);
+  {
+    for (i = 0U; i < CH_TM_HISTOGRAM_SIZE - 1U; i++) {
+      test_assert(chTMHistogramGetBucketLimitX(i) <
+                  chTMHistogramGetBucketLimitX(i + 1U),
+                  "limits not increasing");
+    }
+    test_assert(chTMHistogramGetBucketLimitX(CH_TM_HISTOGRAM_SIZE - 1U) ==
+                (rtcnt_t)-1, "wrong last limit");
+  }
+
+  /* [2.5.3] Recording the times from 1 to 100, the percentiles must be
+     within the histogram resolution.*/
+  test_set_step(3);
+  {
+    for (t = (rtcnt_t)1; t <= (rtcnt_t)100; t++) {
+      chTMHistogramRecordX(&th1, t);
+    }
+    test_assert(th1.n == 100U, "wrong records count");
+    test_assert(chTMHistogramGetPercentileX(&th1, 0U) == (rtcnt_t)1,
+                "wrong minimum");
+    t = chTMHistogramGetPercentileX(&th1, 500U);
+    test_assert((t >= 50U) && (t <= 50U + (50U >> CH_TM_HISTOGRAM_SUB_BITS)),
+                "wrong median");
+    t = chTMHistogramGetPercentileX(&th1, 1000U);
+    test_assert((t >= 100U) && (t <= 100U + (100U >> CH_TM_HISTOGRAM_SUB_BITS)),
+                "wrong maximum");
+  }
+
+  /* [2.5.4] Recording a time out of range, it must be accumulated in
+     the last bucket.*/
+  test_set_step(4);
+  {
+    chTMHistogramRecordX(&th1, (rtcnt_t)-1);
+    test_assert(th1.buckets[CH_TM_HISTOGRAM_SIZE - 1U] == 1U, "not saturated");
+    test_assert(chTMHistogramGetPercentileX(&th1, 1000U) == (rtcnt_t)-1,
+                "wrong maximum");
+  }
+
+  /* [2.5.5] Taking a snapshot and clearing the histogram from a
+     critical zone, the copy must be preserved.*/
+  test_set_step(5);
+  {
+    chSysLock();
+    chTMHistogramSnapshotI(&th1, &th2);
+    chTMHistogramResetI(&th1);
+    chSysUnlock();
+    test_assert(th1.n == 0U, "not cleared");
+    test_assert(th2.n == 101U, "wrong snapshot");
+  }
+
+  /* [2.5.6] Checking the kernel critical zones histogram, critical
+     zones must have been recorded.*/
+  test_set_step(6);
+  {
+#if (CH_DBG_STATISTICS == TRUE) && (CH_DBG_STATISTICS_HISTOGRAMS == TRUE)
+    chTMHistogramSnapshot(&ch.kernel_stats.h_crit_thd, &th2);
+    test_assert(th2.n > 0U, "critical zones not recorded");
+#endif
+  }
+}
+
+static const testcase_t rt_test_002_005 = {
+  "Time measurement histograms",
+  NULL,
+  NULL,
+  rt_test_002_005_execute
+};
+#endif /* CH_CFG_USE_TM */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -277,6 +394,9 @@ const testcase_t * const rt_test_sequence_002_array[] = {
   &rt_test_002_002,
   &rt_test_002_003,
   &rt_test_002_004,
+#if (CH_CFG_USE_TM) || defined(__DOXYGEN__)
+  &rt_test_002_005,
+#endif
   NULL
 };
 
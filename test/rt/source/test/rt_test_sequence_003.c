@@ -34,6 +34,7 @@
  * - @subpage rt_test_003_002
  * - @subpage rt_test_003_003
  * - @subpage rt_test_003_004
+ * - @subpage rt_test_003_005
  * .
  */
 
@@ -325,6 +326,75 @@ static const testcase_t rt_test_003_004 = {
 };
 #endif /* CH_CFG_USE_MUTEXES */
 
+#if (CH_DBG_STATISTICS) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_003_005 [3.5] Threads statistics
+ *
+ * <h2>Description</h2>
+ * The per-thread statistics are tested. Preemptions must be counted and
+ * the time spent by threads in the ready list and running must be
+ * measured.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_DBG_STATISTICS
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [3.5.1] Creating a thread with higher priority, the current thread
+ *   must count a preemption and the created thread must have a ready-
+ *   to-run latency measurement.
+ * - [3.5.2] Creating a thread with lower priority then busy waiting,
+ *   the created thread latency must include the busy wait time.
+ * .
+ */
+
+static void rt_test_003_005_execute(void) {
+  thread_t *tp;
+  ucnt_t n;
+  rtcnt_t start, delay;
+
+  /* [3.5.1] Creating a thread with higher priority, the current thread
+     must count a preemption and the created thread must have a ready-
+     to-run latency measurement.*/
+  test_set_step(1);
+  {
+    n = chThdGetSelfX()->n_preempt;
+    tp = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()+1, thread, "A");
+    threads[0] = tp;
+    test_assert(chThdGetSelfX()->n_preempt == n + 1U, "preemption not counted");
+    test_wait_threads();
+    test_assert_sequence("A", "invalid sequence");
+    test_assert(tp->latency.n == 1U, "latency not measured");
+    test_assert(tp->stats.n == 1U, "runtime not measured");
+  }
+
+  /* [3.5.2] Creating a thread with lower priority then busy waiting,
+     the created thread latency must include the busy wait time.*/
+  test_set_step(2);
+  {
+    tp = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()-1, thread, "B");
+    threads[0] = tp;
+    start = chSysGetRealtimeCounterX();
+    chSysPolledDelayX(1000U);
+    delay = chSysGetRealtimeCounterX() - start;
+    test_wait_threads();
+    test_assert_sequence("B", "invalid sequence");
+    test_assert(tp->latency.n == 1U, "latency not measured");
+    test_assert(tp->latency.last >= delay, "latency too short");
+    test_assert(tp->latency.worst == tp->latency.last, "wrong worst latency");
+  }
+}
+
+static const testcase_t rt_test_003_005 = {
+  "Threads statistics",
+  NULL,
+  NULL,
+  rt_test_003_005_execute
+};
+#endif /* CH_DBG_STATISTICS */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -338,6 +408,9 @@ const testcase_t * const rt_test_sequence_003_array[] = {
   &rt_test_003_003,
 #if (CH_CFG_USE_MUTEXES) || defined(__DOXYGEN__)
   &rt_test_003_004,
+#endif
+#if (CH_DBG_STATISTICS) || defined(__DOXYGEN__)
+  &rt_test_003_005,
 #endif
   NULL
 };
@@ -45,6 +45,7 @@
  * - @subpage rt_test_006_007
  * - @subpage rt_test_006_008
  * - @subpage rt_test_006_009
+ * - @subpage rt_test_006_010
  * .
  */
 
@@ -1033,6 +1034,123 @@ static const testcase_t rt_test_006_009 = {
 };
 #endif /* CH_CFG_USE_CONDVARS */
 
+#if (CH_DBG_LOCK_PROFILING) || defined(__DOXYGEN__)
+/**
+ * @page rt_test_006_010 [6.10] Lock profiling
+ *
+ * <h2>Description</h2>
+ * The lock contention profiler is tested. Acquisitions, contended waits
+ * and priority boosts must be counted, the waiting and holding times
+ * must be measured and the profile must be enumerable after
+ * registration.
+ *
+ * <h2>Conditions</h2>
+ * This test is only executed if the following preprocessor condition
+ * evaluates to true:
+ * - CH_DBG_LOCK_PROFILING
+ * .
+ *
+ * <h2>Test Steps</h2>
+ * - [6.10.1] Registering the mutex profile, the profile must be found
+ *   by enumeration with cleared counters.
+ * - [6.10.2] Locking and unlocking the mutex without contention, the
+ *   acquisition must be counted without waits.
+ * - [6.10.3] Locking the mutex then creating a thread with higher
+ *   priority trying to lock it, the contention and the priority boost
+ *   must be counted. Busy waiting before unlocking, the measured wait
+ *   and hold times must include the busy wait time.
+ * - [6.10.4] Resetting the profile, the counters must be cleared and
+ *   the profile must still be registered.
+ * .
+ */
+
+static void rt_test_006_010_setup(void) {
+  chMtxObjectInit(&m1);
+}
+
+static void rt_test_006_010_teardown(void) {
+  chLockStatsUnregister(&m1.stats);
+}
+
+static void rt_test_006_010_execute(void) {
+  lock_stats_t ls;
+  unsigned i;
+  bool found;
+  rtcnt_t start, delay;
+
+  /* [6.10.1] Registering the mutex profile, the profile must be found
+     by enumeration with cleared counters.*/
+  test_set_step(1);
+  {
+    chLockStatsRegister(&m1.stats, "m1");
+    found = false;
+    for (i = 0U; chLockStatsGet(i, &ls); i++) {
+      if (ls.name == m1.stats.name) {
+        found = true;
+        break;
+      }
+    }
+    test_assert(found, "profile not found");
+    test_assert((ls.n_acquire == 0U) && (ls.n_contended == 0U) &&
+                (ls.n_boost == 0U), "counters not cleared");
+  }
+
+  /* [6.10.2] Locking and unlocking the mutex without contention, the
+     acquisition must be counted without waits.*/
+  test_set_step(2);
+  {
+    chMtxLock(&m1);
+    chMtxUnlock(&m1);
+    test_assert(m1.stats.n_acquire == 1U, "acquisition not counted");
+    test_assert(m1.stats.n_contended == 0U, "unexpected contention");
+    test_assert(m1.stats.wait_cumulative == (rttime_t)0, "unexpected wait");
+  }
+
+  /* [6.10.3] Locking the mutex then creating a thread with higher
+     priority trying to lock it, the contention and the priority boost
+     must be counted. Busy waiting before unlocking, the measured wait
+     and hold times must include the busy wait time.*/
+  test_set_step(3);
+  {
+    chMtxLock(&m1);
+    threads[0] = chThdCreateStatic(wa[0], WA_SIZE, chThdGetPriorityX()+1,
+                                   thread1, "A");
+    test_assert(m1.stats.n_contended == 1U, "contention not counted");
+    test_assert(m1.stats.n_boost == 1U, "boost not counted");
+    start = chSysGetRealtimeCounterX();
+    chSysPolledDelayX(1000U);
+    delay = chSysGetRealtimeCounterX() - start;
+    chMtxUnlock(&m1);
+    test_wait_threads();
+    test_assert_sequence("A", "invalid sequence");
+    test_assert(m1.stats.n_acquire == 3U, "acquisitions not counted");
+    test_assert(m1.stats.wait_max >= delay, "wait too short");
+    test_assert(m1.stats.wait_cumulative == (rttime_t)m1.stats.wait_max,
+                "wrong cumulative wait");
+    test_assert(m1.stats.hold_max >= delay, "hold too short");
+  }
+
+  /* [6.10.4] Resetting the profile, the counters must be cleared and
+     the profile must still be registered.*/
+  test_set_step(4);
+  {
+    chLockStatsReset(&m1.stats);
+    test_assert((m1.stats.n_acquire == 0U) && (m1.stats.n_contended == 0U) &&
+                (m1.stats.n_boost == 0U), "counters not cleared");
+    test_assert((m1.stats.wait_max == (rtcnt_t)0) &&
+                (m1.stats.hold_max == (rtcnt_t)0), "times not cleared");
+    test_assert(m1.stats.name != NULL, "profile unregistered");
+  }
+}
+
+static const testcase_t rt_test_006_010 = {
+  "Lock profiling",
+  rt_test_006_010_setup,
+  rt_test_006_010_teardown,
+  rt_test_006_010_execute
+};
+#endif /* CH_DBG_LOCK_PROFILING */
+
 /****************************************************************************
  * Exported data.
  ****************************************************************************/
@@ -1063,6 +1181,9 @@ const testcase_t * const rt_test_sequence_006_array[] = {
 #endif
 #if (CH_CFG_USE_CONDVARS) || defined(__DOXYGEN__)
   &rt_test_006_009,
+#endif
+#if (CH_DBG_LOCK_PROFILING) || defined(__DOXYGEN__)
+  &rt_test_006_010,
 #endif
   NULL
 };
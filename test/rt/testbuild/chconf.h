@@ -83,6 +83,17 @@
 #define CH_CFG_ST_TIMEDELTA                 0
 #endif
 
+/**
+ * @brief   Virtual timers store.
+ * @details If enabled the virtual timers are kept in a pairing heap with
+ *          O(1) insertion instead of a delta list with O(n) insertion.
+ * @note    The heap is convenient when many timers are armed at the same
+ *          time.
+ */
+#if !defined(CH_CFG_USE_TIMERS_HEAP) || defined(__DOXYGEN__)
+#define CH_CFG_USE_TIMERS_HEAP              FALSE
+#endif
+
 /** @} */
 
 /*===========================================================================*/
@@ -108,6 +119,16 @@
 #define CH_CFG_TIME_QUANTUM                 20
 #endif
 
+/**
+ * @brief   Ready list priority bitmap.
+ * @details If enabled the ready list is indexed by a priority bitmap, the
+ *          insertion of a thread in the ready list becomes O(1).
+ * @note    The index requires a pointer for each priority level.
+ */
+#if !defined(CH_CFG_USE_READY_BITMAP) || defined(__DOXYGEN__)
+#define CH_CFG_USE_READY_BITMAP             FALSE
+#endif
+
 /**
  * @brief   Managed RAM size.
  * @details Size of the RAM area to be managed by the OS. If set to zero
@@ -348,6 +369,43 @@
 #define CH_CFG_USE_HEAP                     TRUE
 #endif
 
+/**
+ * @brief   TLSF heap allocator.
+ * @details If enabled the heap allocator uses a two-level segregated fit
+ *          algorithm with constant time allocation and release instead
+ *          of first-fit.
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP.
+ */
+#if !defined(CH_CFG_USE_HEAP_TLSF) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_TLSF                FALSE
+#endif
+
+/**
+ * @brief   Default heap size classes cache.
+ * @details If enabled the small blocks of the default heap are served by
+ *          per size class memory pools fed by the heap.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_HEAP and @p CH_CFG_USE_MEMPOOLS.
+ */
+#if !defined(CH_CFG_USE_HEAP_CACHE) || defined(__DOXYGEN__)
+#define CH_CFG_USE_HEAP_CACHE               FALSE
+#endif
+
+/**
+ * @brief   Memory allocators profiling.
+ * @details If enabled the core allocator and the heaps record allocation
+ *          counters, high-water marks, size histograms and per-thread
+ *          statistics.
+ *
+ * @note    The default is @p FALSE.
+ * @note    Requires @p CH_CFG_USE_MEMCORE.
+ */
+#if !defined(CH_CFG_USE_MEM_PROFILING) || defined(__DOXYGEN__)
+#define CH_CFG_USE_MEM_PROFILING            FALSE
+#endif
+
 /**
  * @brief   Memory Pools Allocator APIs.
  * @details If enabled then the memory pools allocator APIs are included
@@ -453,6 +511,28 @@
 #define CH_DBG_STATISTICS                   FALSE
 #endif
 
+/**
+ * @brief   Debug option, critical zones histograms.
+ * @details If enabled then the kernel statistics also record the duration
+ *          of the critical zones in time histograms.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_STATISTICS_HISTOGRAMS) || defined(__DOXYGEN__)
+#define CH_DBG_STATISTICS_HISTOGRAMS        FALSE
+#endif
+
+/**
+ * @brief   Debug option, locks contention profiling.
+ * @details If enabled then mutexes and semaphores keep a contention
+ *          profile measured using the realtime counter.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_LOCK_PROFILING) || defined(__DOXYGEN__)
+#define CH_DBG_LOCK_PROFILING               FALSE
+#endif
+
 /**
  * @brief   Debug option, system state check.
  * @details If enabled the correct call protocol for system APIs is checked
@@ -506,6 +586,17 @@
 #define CH_DBG_TRACE_BUFFER_SIZE            128
 #endif
 
+/**
+ * @brief   Trace buffer streaming mode.
+ * @details If enabled the trace buffer is drained by a consumer instead
+ *          of being overwritten circularly.
+ *
+ * @note    The default is @p FALSE.
+ */
+#if !defined(CH_DBG_TRACE_STREAM) || defined(__DOXYGEN__)
+#define CH_DBG_TRACE_STREAM                 FALSE
+#endif
+
 /**
  * @brief   Debug option, stack checks.
  * @details If enabled then a runtime stack check is performed.
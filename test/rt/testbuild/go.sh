@@ -122,6 +122,10 @@ test cfg32 "-DCH_CFG_ST_RESOLUTION=16 -DCH_CFG_INTERVALS_SIZE=64"
 test cfg33 "-DCH_CFG_INTERVALS_SIZE=64"
 test cfg34 "-DCH_CFG_USE_OBJ_FIFOS=FALSE"
 test cfg35 "-DCH_CFG_USE_FACTORY=FALSE"
+test cfg36 "-DCH_CFG_ST_TIMEDELTA=2 -DCH_DBG_THREADS_PROFILING=FALSE"
+test cfg37 "-DCH_CFG_ST_TIMEDELTA=2 -DCH_DBG_THREADS_PROFILING=FALSE -DCH_CFG_USE_TIMERS_HEAP=TRUE"
+test cfg38 "-DCH_CFG_ST_TIMEDELTA=2 -DCH_DBG_THREADS_PROFILING=FALSE -DCH_CFG_ST_RESOLUTION=16"
+test cfg39 "-DCH_CFG_ST_TIMEDELTA=2 -DCH_DBG_THREADS_PROFILING=FALSE -DCH_CFG_ST_RESOLUTION=16 -DSIM_USE_EVENT_WAIT=TRUE -DTEST_LONG_SLEEP=TRUE"
 
 rm *log.txt 2> /dev/null
 echo
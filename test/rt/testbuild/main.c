@@ -17,6 +17,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
 
 #include "ch.h"
 #include "hal.h"
@@ -24,6 +25,48 @@
 #include "oslib_test_root.h"
 #include "console.h"
 
+#if !defined(TEST_LONG_SLEEP) || defined(__DOXYGEN__)
+#define TEST_LONG_SLEEP                     FALSE
+#endif
+
+#if (TEST_LONG_SLEEP == TRUE) && (CH_CFG_ST_RESOLUTION != 16)
+#error "TEST_LONG_SLEEP requires CH_CFG_ST_RESOLUTION == 16"
+#endif
+
+#if (TEST_LONG_SLEEP == TRUE) || defined(__DOXYGEN__)
+/*
+ * Sleeps longer than half the system time range, the alarm must neither
+ * fire early nor keep the host busy while waiting.
+ */
+static bool test_long_sleep(void) {
+  sysinterval_t delay = (sysinterval_t)(TIME_MAX_SYSTIME / 2U) + 8000U;
+  systime_t start;
+  sysinterval_t elapsed;
+  clock_t cpu;
+
+  printf("Long sleep: %lu ticks...", (unsigned long)delay);
+  fflush(stdout);
+  cpu = clock();
+  start = chVTGetSystemTimeX();
+  chThdSleep(delay);
+  elapsed = chTimeDiffX(start, chVTGetSystemTimeX());
+  cpu = clock() - cpu;
+
+  if (elapsed < delay) {
+    printf("failed, woken after %lu ticks\n", (unsigned long)elapsed);
+    return false;
+  }
+  if (cpu > CLOCKS_PER_SEC) {
+    printf("failed, host busy for %lu ms\n",
+           (unsigned long)(cpu * 1000 / CLOCKS_PER_SEC));
+    return false;
+  }
+  printf("OK\n");
+
+  return true;
+}
+#endif
+
 /*
  * Simulator main.
  */
@@ -45,6 +88,10 @@ int main(int argc, char *argv[]) {
 
   test_execute((BaseSequentialStream *)&CD1, &rt_test_suite);
   test_execute((BaseSequentialStream *)&CD1, &oslib_test_suite);
+#if TEST_LONG_SLEEP == TRUE
+  if (!test_long_sleep())
+    exit(1);
+#endif
   if (test_global_fail)
     exit(1);
   else
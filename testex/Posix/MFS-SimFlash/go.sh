@@ -0,0 +1,39 @@
+#!/bin/bash
+# Builds and runs the MFS test suite and the power cut test in all the
+# features variants, the results are saved under ./reports.
+
+VARIANTS=("default:"
+          "sparse:sparse"
+          "incgc:incgc"
+          "checkpoint:checkpoint"
+          "transactions:transactions"
+          "crc32:crc32"
+          "all:sparse incgc checkpoint transactions crc32"
+          "log:log"
+          "log-all:log sparse transactions crc32")
+
+mkdir -p reports
+
+for v in "${VARIANTS[@]}"
+do
+  name=${v%%:*}
+  features=${v#*:}
+  echo "Variant: ${name}"
+
+  echo -n "  * Building..."
+  if ! make BUILDDIR=build/${name} USE_MFS_FEATURES="${features}" \
+            > reports/${name}_build.txt 2>&1
+  then
+    echo "failed"
+    exit 1
+  fi
+  echo "OK"
+
+  echo -n "  * Testing..."
+  if ! ./build/${name}/ch > reports/${name}_test.txt
+  then
+    echo "failed"
+    exit 1
+  fi
+  echo "OK"
+done
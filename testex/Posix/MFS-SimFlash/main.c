@@ -0,0 +1,503 @@
+/*
+    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ch.h"
+#include "hal.h"
+
+#include "console.h"
+#include "sim_flash.h"
+#include "mfs.h"
+#include "ch_test.h"
+#include "mfs_test_root.h"
+
+#if MFS_CFG_LOG_SECTORS > 0
+#define SECTOR_SIZE         2048U
+#define SECTORS_COUNT       8U
+#else
+#define SECTOR_SIZE         4096U
+#define SECTORS_COUNT       4U
+#endif
+
+/*
+ * Simulated flash device, 16kB split in 4 sectors of 4kB each or in 8
+ * sectors of 2kB each for the log-structured storage.
+ */
+static uint8_t flash_memory[SECTORS_COUNT * SECTOR_SIZE];
+static uint32_t flash_erase_counters[SECTORS_COUNT];
+
+static const SimFlashConfig simflashcfg1 = {
+  .memory           = flash_memory,
+  .filename         = NULL,
+  .attributes       = FLASH_ATTR_REWRITABLE,
+  .page_size        = 256U,
+  .sectors_count    = SECTORS_COUNT,
+  .sectors          = NULL,
+  .sectors_size     = SECTOR_SIZE,
+  .program_time     = 500U,
+  .erase_time       = 1U,
+  .erase_counters   = flash_erase_counters
+};
+
+SimFlashDriver simflash1;
+
+/*
+ * Staging buffer for MFS data transfers, four flash pages.
+ */
+static uint8_t mfs_staging_buffer[1024];
+
+#if MFS_CFG_LOG_SECTORS > 0
+/*
+ * MFS configuration, log of 8 sectors.
+ */
+const MFSConfig mfscfg1 = {
+  .flashp           = (BaseFlash *)&simflash1,
+  .erased           = 0xFFFFFFFFU,
+  .log_start        = 0U,
+  .log_sectors      = SECTORS_COUNT,
+  .buffer           = mfs_staging_buffer,
+  .buffer_size      = sizeof mfs_staging_buffer
+};
+#else
+/*
+ * MFS configuration, two banks of 8kB each.
+ */
+const MFSConfig mfscfg1 = {
+  .flashp           = (BaseFlash *)&simflash1,
+  .erased           = 0xFFFFFFFFU,
+  .bank_size        = 2U * SECTOR_SIZE,
+  .bank0_start      = 0U,
+  .bank0_sectors    = 2U,
+  .bank1_start      = 2U,
+  .bank1_sectors    = 2U,
+  .buffer           = mfs_staging_buffer,
+  .buffer_size      = sizeof mfs_staging_buffer
+};
+#endif
+
+/*
+ * Record contents used by the power cut test.
+ */
+static uint8_t old_record[128];
+static uint8_t new_record[128];
+static uint8_t read_buffer[128];
+
+/*
+ * Power cuts are injected at increasing positions while a record is being
+ * rewritten, after each cut the storage must mount again and the record
+ * must contain either the old or the new data. The log-structured storage
+ * requires a wider range in order to reach its first collections.
+ */
+#if MFS_CFG_LOG_SECTORS > 0
+#define POWER_CUT_RANGE     (SECTORS_COUNT * SECTOR_SIZE)
+#else
+#define POWER_CUT_RANGE     (2U * SECTOR_SIZE)
+#endif
+
+static bool power_cut_test(void) {
+  uint32_t cut;
+  bool failed = false;
+
+  for (cut = 1U; cut <= POWER_CUT_RANGE; cut += 7U) {
+    mfs_error_t err;
+    size_t n;
+
+    /* Known initial state, record 2 is rewritten until the space is
+       exhausted and garbage collection is triggered too.*/
+    mfsStart(&mfs1, &mfscfg1);
+    mfsErase(&mfs1);
+    mfsWriteRecord(&mfs1, 1, sizeof old_record, old_record);
+    mfsWriteRecord(&mfs1, 2, sizeof old_record, old_record);
+    simflashSchedulePowerCut(&simflash1, cut);
+    do {
+      err = mfsWriteRecord(&mfs1, 2, sizeof new_record, new_record);
+    } while (!MFS_IS_ERROR(err));
+    mfsStop(&mfs1);
+
+    /* Reboot.*/
+    simflashStop(&simflash1);
+    simflashStart(&simflash1, &simflashcfg1);
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    if (MFS_IS_ERROR(err)) {
+      printf("cut at %u: mount failed (%d)\n", (unsigned)cut, (int)err);
+      failed = true;
+      continue;
+    }
+
+    /* Record 1 has never been touched.*/
+    n = sizeof read_buffer;
+    err = mfsReadRecord(&mfs1, 1, &n, read_buffer);
+    if ((err != MFS_NO_ERROR) || (n != sizeof old_record) ||
+        (memcmp(read_buffer, old_record, n) != 0)) {
+      printf("cut at %u: record 1 lost (%d)\n", (unsigned)cut, (int)err);
+      failed = true;
+    }
+
+    /* Record 2 is either old or new.*/
+    n = sizeof read_buffer;
+    err = mfsReadRecord(&mfs1, 2, &n, read_buffer);
+    if ((err != MFS_NO_ERROR) || (n != sizeof old_record) ||
+        ((memcmp(read_buffer, old_record, n) != 0) &&
+         (memcmp(read_buffer, new_record, n) != 0))) {
+      printf("cut at %u: record 2 corrupted (%d)\n", (unsigned)cut, (int)err);
+      failed = true;
+    }
+    mfsStop(&mfs1);
+  }
+
+  return failed;
+}
+
+#if (MFS_CFG_TRANSACTION_MAX > 0) || (MFS_CFG_INCREMENTAL_GC == TRUE) ||     \
+    (MFS_CFG_INDEX_CHECKPOINT == TRUE)
+/*
+ * Model of the expected records content, records from 1 to MODEL_RECORDS,
+ * a NULL data pointer means that the record is not present.
+ */
+#define MODEL_RECORDS       8U
+
+typedef struct {
+  const uint8_t     *data;
+  size_t            size;
+} model_record_t;
+
+static model_record_t old_model[MODEL_RECORDS];
+static model_record_t new_model[MODEL_RECORDS];
+
+static mfs_error_t model_write(model_record_t *model, mfs_id_t id,
+                               const uint8_t *data, size_t size) {
+  mfs_error_t err;
+
+  err = mfsWriteRecord(&mfs1, id, size, data);
+  if (!MFS_IS_ERROR(err)) {
+    model[id - 1U].data = data;
+    model[id - 1U].size = size;
+  }
+
+  return err;
+}
+
+static mfs_error_t model_erase(model_record_t *model, mfs_id_t id) {
+  mfs_error_t err;
+
+  err = mfsEraseRecord(&mfs1, id);
+  if (!MFS_IS_ERROR(err)) {
+    model[id - 1U].data = NULL;
+  }
+
+  return err;
+}
+
+static bool model_check(const model_record_t *model) {
+  mfs_id_t id;
+
+  for (id = 1U; id <= MODEL_RECORDS; id++) {
+    const model_record_t *mrp = &model[id - 1U];
+    mfs_error_t err;
+    size_t n;
+
+    n = sizeof read_buffer;
+    err = mfsReadRecord(&mfs1, id, &n, read_buffer);
+    if (mrp->data == NULL) {
+      if (err != MFS_ERR_NOT_FOUND) {
+        return false;
+      }
+    }
+    else if ((err != MFS_NO_ERROR) || (n != mrp->size) ||
+             (memcmp(read_buffer, mrp->data, n) != 0)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Power cuts are injected at increasing positions while an operation is
+ * performed, the loop ends when the operation completes before the cut.
+ * After each cut the storage must mount again and the records must match
+ * either the model before the operation or the model after it, after the
+ * completed operation only the latter.
+ */
+static bool power_cut_loop(const char *name, uint32_t step,
+                           void (*prepare)(void),
+                           void (*operation)(void)) {
+  uint32_t cut;
+  bool failed = false;
+
+  for (cut = 1U; ; cut += step) {
+    mfs_error_t err;
+    bool completed;
+
+    /* Known initial state and models.*/
+    memset(old_model, 0, sizeof old_model);
+    mfsStart(&mfs1, &mfscfg1);
+    mfsErase(&mfs1);
+    prepare();
+    simflashSchedulePowerCut(&simflash1, cut);
+    operation();
+    completed = !simflash1.powered_off;
+    simflashSchedulePowerCut(&simflash1, 0U);
+    mfsStop(&mfs1);
+
+    /* Reboot.*/
+    simflashStop(&simflash1);
+    simflashStart(&simflash1, &simflashcfg1);
+
+    err = mfsStart(&mfs1, &mfscfg1);
+    if (MFS_IS_ERROR(err)) {
+      printf("%s cut at %u: mount failed (%d)\n",
+             name, (unsigned)cut, (int)err);
+      failed = true;
+    }
+    else if (!model_check(new_model) &&
+             (completed || !model_check(old_model))) {
+      printf("%s cut at %u: unexpected records content\n",
+             name, (unsigned)cut);
+      failed = true;
+    }
+    mfsStop(&mfs1);
+
+    if (completed) {
+      break;
+    }
+  }
+
+  return failed;
+}
+#endif
+
+#if (MFS_CFG_TRANSACTION_MAX > 0)
+/*
+ * Transaction updating two records, erasing one and creating one, the
+ * records must be either all old or all new.
+ */
+static void transaction_prepare(void) {
+  mfs_id_t id;
+
+  for (id = 1U; id <= 4U; id++) {
+    (void) model_write(old_model, id, old_record, 32U + (size_t)id);
+  }
+  (void) model_erase(old_model, 4U);
+  memcpy(new_model, old_model, sizeof new_model);
+  new_model[0].data = new_record;
+  new_model[0].size = 16U;
+  new_model[1].data = new_record;
+  new_model[1].size = 64U;
+  new_model[2].data = NULL;
+  new_model[4].data = new_record;
+  new_model[4].size = 48U;
+}
+
+static void transaction_operation(void) {
+
+  if ((mfsStartTransaction(&mfs1, 4U * (sizeof (mfs_data_header_t) +
+                                        sizeof new_record)) != MFS_NO_ERROR) ||
+      (mfsWriteRecord(&mfs1, 1U, 16U, new_record) != MFS_NO_ERROR) ||
+      (mfsWriteRecord(&mfs1, 2U, 64U, new_record) != MFS_NO_ERROR) ||
+      (mfsEraseRecord(&mfs1, 3U) != MFS_NO_ERROR) ||
+      (mfsWriteRecord(&mfs1, 5U, 48U, new_record) != MFS_NO_ERROR)) {
+    return;
+  }
+  (void) mfsCommitTransaction(&mfs1);
+}
+#endif
+
+#if (MFS_CFG_INCREMENTAL_GC == TRUE)
+/*
+ * Record 1 is rewritten until a garbage collection is started, the
+ * collection is then completed by steps.
+ */
+static void gc_step_prepare(void) {
+  mfs_error_t err;
+  mfs_id_t id;
+
+  for (id = 1U; id <= MODEL_RECORDS; id++) {
+    (void) model_write(old_model, id, old_record, sizeof old_record);
+  }
+  (void) model_erase(old_model, MODEL_RECORDS);
+  do {
+    err = model_write(old_model, 1U,
+                      old_model[0].data == old_record ? new_record : old_record,
+                      sizeof new_record);
+  } while (err == MFS_NO_ERROR);
+  memcpy(new_model, old_model, sizeof new_model);
+}
+
+static void gc_step_operation(void) {
+  mfs_error_t err;
+
+  do {
+    uint32_t msec = 0U;
+
+    err = mfsPerformGarbageCollectionStep(&mfs1, &msec);
+    if (msec > 0U) {
+      chThdSleepMilliseconds(msec);
+    }
+  } while (err == MFS_WARN_GC);
+}
+#endif
+
+#if (MFS_CFG_INDEX_CHECKPOINT == TRUE)
+/*
+ * A checkpoint is written on a clean stop, then records are erased and
+ * rewritten and a second checkpoint is written by stopping again.
+ */
+static void checkpoint_prepare(void) {
+  mfs_id_t id;
+
+  for (id = 1U; id <= MODEL_RECORDS; id++) {
+    (void) model_write(old_model, id, old_record, 16U * (size_t)id);
+  }
+  mfsStop(&mfs1);
+  mfsStart(&mfs1, &mfscfg1);
+  (void) model_erase(old_model, 3U);
+  (void) model_write(old_model, 4U, new_record, sizeof new_record);
+  memcpy(new_model, old_model, sizeof new_model);
+}
+
+static void checkpoint_operation(void) {
+
+  mfsStop(&mfs1);
+}
+#endif
+
+/*
+ * Application entry point.
+ */
+int main(void) {
+  const sim_flash_stats_t *stp;
+  const mfs_gc_stats_t *gcsp;
+  msg_t result;
+  unsigned i;
+
+  /*
+   * System initializations.
+   * - HAL initialization, this also initializes the configured device drivers
+   *   and performs the board-specific initializations.
+   * - Kernel initialization, the main() function becomes a thread and the
+   *   RTOS is active.
+   */
+  halInit();
+  conInit();
+  chSysInit();
+
+  /*
+   * Simulated flash device.
+   */
+  simflashObjectInit(&simflash1);
+  simflashStart(&simflash1, &simflashcfg1);
+
+  /*
+   * MFS test suite.
+   */
+  mfsObjectInit(&mfs1);
+  result = test_execute((BaseSequentialStream *)&CD1, &mfs_test_suite);
+
+  stp = simflashGetStats(&simflash1);
+  printf("Flash reads    : %u (%u bytes)\n",
+         (unsigned)stp->reads, (unsigned)stp->read_bytes);
+  printf("Flash programs : %u (%u bytes)\n",
+         (unsigned)stp->programs, (unsigned)stp->program_bytes);
+  printf("Flash erases   : %u\n", (unsigned)stp->erases);
+  printf("Modeled time   : %u ms\n", (unsigned)(stp->busy_time / 1000U));
+  printf("Sector erases  :");
+  for (i = 0U; i < SECTORS_COUNT; i++) {
+    printf(" %u", (unsigned)flash_erase_counters[i]);
+  }
+  printf("\n");
+  gcsp = mfsGetGarbageCollectionStats(&mfs1);
+  printf("MFS collections: %u (%u records moved, %u sectors erased)\n",
+         (unsigned)gcsp->collections, (unsigned)gcsp->moved_records,
+         (unsigned)gcsp->erased_sectors);
+  printf("MFS GC time    : %u ms total, %u ms worst\n",
+         (unsigned)TIME_I2MS(gcsp->total_time),
+         (unsigned)TIME_I2MS(gcsp->worst_time));
+  printf("MFS bytes      : %u written, %u moved, %u programmed\n",
+         (unsigned)gcsp->written_bytes, (unsigned)gcsp->moved_bytes,
+         (unsigned)gcsp->programmed_bytes);
+  printf("MFS write ampl.: %u.%02u\n",
+         (unsigned)(gcsp->programmed_bytes / gcsp->written_bytes),
+         (unsigned)((gcsp->programmed_bytes % gcsp->written_bytes) * 100U /
+                    gcsp->written_bytes));
+#if MFS_CFG_LOG_SECTORS > 0
+  printf("MFS log erases :");
+  for (i = 0U; i < mfscfg1.log_sectors; i++) {
+    printf(" %u", (unsigned)mfsGetSectorErases(&mfs1, i));
+  }
+  printf("\n");
+#else
+  printf("MFS bank swaps : %u\n", (unsigned)mfsGetBankSwaps(&mfs1));
+#endif
+
+  /*
+   * Power cut injection tests.
+   */
+  for (i = 0U; i < sizeof old_record; i++) {
+    old_record[i] = (uint8_t)i;
+    new_record[i] = (uint8_t)~i;
+  }
+
+  printf("Power cut test : ");
+  fflush(stdout);
+  if (power_cut_test()) {
+    printf("FAILURE\n");
+    result = (msg_t)true;
+  }
+  else {
+    printf("SUCCESS\n");
+  }
+#if MFS_CFG_TRANSACTION_MAX > 0
+  printf("Transaction cut: ");
+  fflush(stdout);
+  if (power_cut_loop("transaction", 1U,
+                     transaction_prepare, transaction_operation)) {
+    printf("FAILURE\n");
+    result = (msg_t)true;
+  }
+  else {
+    printf("SUCCESS\n");
+  }
+#endif
+#if MFS_CFG_INCREMENTAL_GC == TRUE
+  printf("GC step cut    : ");
+  fflush(stdout);
+  if (power_cut_loop("gc step", 7U, gc_step_prepare, gc_step_operation)) {
+    printf("FAILURE\n");
+    result = (msg_t)true;
+  }
+  else {
+    printf("SUCCESS\n");
+  }
+#endif
+#if MFS_CFG_INDEX_CHECKPOINT == TRUE
+  printf("Checkpoint cut : ");
+  fflush(stdout);
+  if (power_cut_loop("checkpoint", 1U,
+                     checkpoint_prepare, checkpoint_operation)) {
+    printf("FAILURE\n");
+    result = (msg_t)true;
+  }
+  else {
+    printf("SUCCESS\n");
+  }
+#endif
+
+  return (int)result;
+}
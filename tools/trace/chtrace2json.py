@@ -0,0 +1,272 @@
+#
+#    ChibiOS - Copyright (C) 2006..2018 Giovanni Di Sirio
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+# Converts a trace stream captured from os/various/trace_stream.c into a
+# Chrome/Perfetto timeline (JSON trace event format).
+#
+# Usage: python3 chtrace2json.py <stream.bin> [<trace.json>]
+#
+# The output can be loaded in chrome://tracing or https://ui.perfetto.dev.
+#
+
+import json
+import struct
+import sys
+
+TYPE_SWITCH = 1
+TYPE_ISR_ENTER = 2
+TYPE_ISR_LEAVE = 3
+TYPE_HALT = 4
+TYPE_USER = 5
+TYPE_SEM = 6
+TYPE_MTX = 7
+TYPE_MB = 8
+TYPE_VT = 9
+TYPE_HEADER = 0x80
+TYPE_NAME = 0x81
+TYPE_LOST = 0x82
+
+STATE_NAMES = ["READY", "CURRENT", "WTSTART", "SUSPENDED", "QUEUED",
+               "WTSEM", "WTMTX", "WTCOND", "SLEEPING", "WTEXIT", "WTOREVT",
+               "WTANDEVT", "SNDMSGQ", "SNDMSG", "WTMSG", "FINAL"]
+
+OBJECT_EVENTS = {
+    TYPE_SEM: ("sem", ["wait", "block", "signal"]),
+    TYPE_MTX: ("mtx", ["lock", "block", "unlock"]),
+    TYPE_MB: ("mb", ["post", "fetch", "full", "empty"]),
+    TYPE_VT: ("vt", ["set", "fire"]),
+}
+MTX_LOCK, MTX_BLOCK, MTX_UNLOCK = 0, 1, 2
+
+PID = 1
+ISR_TID = 0
+
+
+class Clock:
+    """Rebuilds an absolute time from the system time and the truncated
+    realtime counter time stamps."""
+
+    def __init__(self):
+        self.st_bits = 32
+        self.rt_bits = 24
+        self.st_freq = 1000
+        self.rt_freq = 0
+        self.last = None
+        self.us = 0.0
+
+    def update(self, st, rt):
+        if self.last is None:
+            self.last = (st, rt)
+            return self.us
+        st_delta = (st - self.last[0]) % (1 << self.st_bits)
+        rt_delta = (rt - self.last[1]) % (1 << self.rt_bits)
+        self.last = (st, rt)
+        if self.rt_freq == 0:
+            self.us += st_delta * 1e6 / self.st_freq
+            return self.us
+        # The time stamp wraps quickly, the number of wraps is estimated
+        # from the system time, precise within one tick.
+        expected = st_delta * self.rt_freq / self.st_freq
+        wraps = round((expected - rt_delta) / (1 << self.rt_bits))
+        rt_delta += max(0, wraps) * (1 << self.rt_bits)
+        self.us += rt_delta * 1e6 / self.rt_freq
+        return self.us
+
+
+class Decoder:
+
+    def __init__(self):
+        self.clock = Clock()
+        self.names = {}
+        self.events = []
+        self.current = None
+        self.since = 0.0
+        self.isr_depth = 0
+        self.lost = 0
+        self.threads = set()
+        self.mtx_waits = set()
+        # Version 1 streams have a zero pointer size, always 32 bits.
+        self.id_size = 4
+
+    def ids(self, body, offset):
+        w = self.id_size
+        return [int.from_bytes(body[o:o + w], "little")
+                for o in range(offset, len(body) - w + 1, w)]
+
+    def name(self, ptr):
+        return self.names.get(ptr, "0x%08x" % ptr)
+
+    def close_slice(self, us, args=None):
+        if self.current is not None:
+            self.threads.add(self.current)
+            self.events.append({"name": self.name(self.current), "ph": "X",
+                                "pid": PID, "tid": self.current,
+                                "ts": self.since, "dur": us - self.since,
+                                "args": args or {}})
+
+    def async_span(self, ph, name, cat, key, tid, us):
+        self.events.append({"name": name, "cat": cat, "ph": ph,
+                            "id": "0x%08x.%08x" % key, "pid": PID,
+                            "tid": tid, "ts": us})
+
+    def object_event(self, rtype, code, objp, arg, us):
+        cls, codes = OBJECT_EVENTS[rtype]
+        what = codes[code] if code < len(codes) else str(code)
+        # Timer callbacks and ISR posts are shown on the ISRs track.
+        tid = self.current or ISR_TID
+        if self.isr_depth > 0 or (rtype == TYPE_VT and what == "fire"):
+            tid = ISR_TID
+        if rtype == TYPE_MB:
+            bits = self.id_size * 8
+            args = {"msg": arg - (1 << bits) if arg >= (1 << (bits - 1))
+                    else arg}
+        elif rtype == TYPE_VT:
+            args = {"func": "0x%08x" % arg}
+        else:
+            args = {"thread": self.name(arg)} if arg != 0 else {}
+        self.events.append({"name": "%s %s %s" % (cls, what,
+                                                  self.name(objp)),
+                            "cat": cls, "ph": "i", "s": "t", "pid": PID,
+                            "tid": tid, "ts": us, "args": args})
+        # Mutexes also get wait and hold spans.
+        if rtype == TYPE_MTX and tid != ISR_TID:
+            name = "mtx " + self.name(objp)
+            if code == MTX_BLOCK:
+                self.mtx_waits.add((objp, tid))
+                self.async_span("b", name + " wait", "mtx", (objp, tid),
+                                tid, us)
+            elif code == MTX_LOCK:
+                if (objp, tid) in self.mtx_waits:
+                    self.mtx_waits.discard((objp, tid))
+                    self.async_span("e", name + " wait", "mtx", (objp, tid),
+                                    tid, us)
+                self.async_span("b", name + " held", "mtx", (objp, 0),
+                                tid, us)
+            elif code == MTX_UNLOCK:
+                self.async_span("e", name + " held", "mtx", (objp, 0),
+                                tid, us)
+
+    def event(self, rtype, body):
+        state = body[0]
+        rt = body[1] | (body[2] << 8) | (body[3] << 16)
+        st = struct.unpack_from("<I", body, 4)[0]
+        ptrs = self.ids(body, 8)
+        us = self.clock.update(st, rt)
+        if rtype == TYPE_SWITCH:
+            ntp, wtobj = ptrs[0], ptrs[1]
+            state_name = STATE_NAMES[state] if state < len(STATE_NAMES) \
+                else str(state)
+            self.close_slice(us, {"out_state": state_name,
+                                  "wtobj": "0x%08x" % wtobj})
+            self.current = ntp
+            self.since = us
+        elif rtype == TYPE_ISR_ENTER:
+            self.isr_depth += 1
+            self.events.append({"name": self.name(ptrs[0]), "ph": "B",
+                                "pid": PID, "tid": ISR_TID, "ts": us})
+        elif rtype == TYPE_ISR_LEAVE:
+            # Records lost or captured mid-ISR leave unbalanced ends.
+            if self.isr_depth > 0:
+                self.isr_depth -= 1
+                self.events.append({"name": self.name(ptrs[0]), "ph": "E",
+                                    "pid": PID, "tid": ISR_TID, "ts": us})
+        elif rtype == TYPE_HALT:
+            self.events.append({"name": "halt: " + self.name(ptrs[0]),
+                                "ph": "i", "s": "g", "pid": PID,
+                                "tid": ISR_TID, "ts": us})
+        elif rtype == TYPE_USER:
+            self.events.append({"name": "user", "ph": "i", "s": "t",
+                                "pid": PID,
+                                "tid": self.current or ISR_TID, "ts": us,
+                                "args": {"up1": "0x%08x" % ptrs[0],
+                                         "up2": "0x%08x" % ptrs[1]}})
+        elif rtype in OBJECT_EVENTS:
+            self.object_event(rtype, state, ptrs[0], ptrs[1], us)
+        else:
+            self.events.append({"name": "event %d" % rtype, "ph": "i",
+                                "s": "t", "pid": PID,
+                                "tid": self.current or ISR_TID, "ts": us,
+                                "args": {"state": state,
+                                         "ptrs": ["0x%08x" % p
+                                                  for p in ptrs]}})
+
+    def record(self, rtype, body):
+        if rtype == TYPE_HEADER:
+            if body[0:4] != b"CHTS":
+                raise ValueError("invalid stream header")
+            self.clock.st_bits = body[5]
+            self.clock.rt_bits = body[6]
+            self.id_size = body[7] or 4
+            self.clock.st_freq, self.clock.rt_freq = \
+                struct.unpack_from("<II", body, 8)
+        elif rtype == TYPE_NAME:
+            ptr = self.ids(body[:self.id_size], 0)[0]
+            self.names[ptr] = body[self.id_size:].decode("ascii", "replace")
+        elif rtype == TYPE_LOST:
+            lost = struct.unpack_from("<I", body, 0)[0]
+            self.events.append({"name": "%d records lost" % (lost - self.lost),
+                                "ph": "i", "s": "g", "pid": PID,
+                                "tid": ISR_TID, "ts": self.clock.us})
+            self.lost = lost
+        elif rtype < TYPE_HEADER and len(body) >= 8:
+            self.event(rtype, body)
+
+    def decode(self, data):
+        # Skipping anything before the first header.
+        start = data.find(bytes([TYPE_HEADER, 16]) + b"CHTS")
+        if start < 0:
+            raise ValueError("stream header not found")
+        i = start
+        while i + 2 <= len(data):
+            rtype, length = data[i], data[i + 1]
+            if i + 2 + length > len(data):
+                break
+            self.record(rtype, data[i + 2:i + 2 + length])
+            i += 2 + length
+        self.close_slice(self.clock.us)
+
+    def json(self):
+        meta = [{"name": "process_name", "ph": "M", "pid": PID,
+                 "args": {"name": "ChibiOS/RT"}},
+                {"name": "thread_name", "ph": "M", "pid": PID,
+                 "tid": ISR_TID, "args": {"name": "ISRs"}}]
+        for tp in sorted(self.threads):
+            meta.append({"name": "thread_name", "ph": "M", "pid": PID,
+                         "tid": tp, "args": {"name": self.name(tp)}})
+        return {"traceEvents": meta + self.events,
+                "displayTimeUnit": "ns",
+                "otherData": {"lost_records": self.lost}}
+
+
+def main(argv):
+    if len(argv) < 2:
+        sys.stderr.write("usage: chtrace2json.py <stream.bin> "
+                         "[<trace.json>]\n")
+        return 1
+    with open(argv[1], "rb") as f:
+        data = f.read()
+    decoder = Decoder()
+    decoder.decode(data)
+    out = open(argv[2], "w") if len(argv) > 2 else sys.stdout
+    json.dump(decoder.json(), out, indent=1)
+    if out is not sys.stdout:
+        out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))